@@ -584,6 +584,16 @@ void ChipLinuxAppMainLoop(AppMainLoopImplementation * impl)
     chip::app::RuntimeOptionsProvider::Instance().SetSimulateNoInternalTime(
         LinuxDeviceOptions::GetInstance().mSimulateNoInternalTime);
 
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+    // Run background work (e.g. CASE certificate and signature checks) off the CHIP thread.
+    // If the pool cannot be started, background work keeps running on the event loop.
+    CHIP_ERROR bgErr = DeviceLayer::PlatformMgr().StartBackgroundEventLoopTask();
+    if (bgErr != CHIP_NO_ERROR)
+    {
+        ChipLogError(NotSpecified, "Failed to start background event loop: %" CHIP_ERROR_FORMAT, bgErr.Format());
+    }
+#endif // CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+
     // Init ZCL Data Model and CHIP App Server
     Server::GetInstance().Init(initParams);
 
@@ -636,6 +646,11 @@ void ChipLinuxAppMainLoop(AppMainLoopImplementation * impl)
     }
     gMainLoopImplementation = nullptr;
 
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+    // Join the background threads before the objects their work refers to are shut down.
+    DeviceLayer::PlatformMgr().StopBackgroundEventLoopTask();
+#endif // CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+
     ApplicationShutdown();
 
 #if CHIP_DEVICE_CONFIG_ENABLE_BOTH_COMMISSIONER_AND_COMMISSIONEE
@@ -24,6 +24,12 @@
 #include "AccessControl.h"
 
 #include <lib/core/Global.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/SortUtils.h>
+
+#include <algorithm>
+#include <new>
+#include <type_traits>
 
 namespace chip {
 namespace Access {
@@ -199,6 +205,7 @@ void AccessControl::Finish()
 {
     VerifyOrReturn(IsInitialized());
     ChipLogProgress(DataManagement, "AccessControl: finishing");
+    InvalidateCache(nullptr);
     mDelegate->Finish();
     mDelegate = nullptr;
 }
@@ -355,6 +362,34 @@ CHIP_ERROR AccessControl::Check(const SubjectDescriptor & subjectDescriptor, con
         return CHIP_NO_ERROR;
     }
 
+    CHIP_ERROR result = CHIP_ERROR_NOT_IMPLEMENTED;
+#if CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE > 0
+    result = CheckCached(subjectDescriptor, requestPath, requestPrivilege);
+#endif // CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE > 0
+    if (result == CHIP_ERROR_NOT_IMPLEMENTED)
+    {
+        result = CheckEntries(subjectDescriptor, requestPath, requestPrivilege);
+    }
+
+#if CHIP_CONFIG_ACCESS_CONTROL_POLICY_LOGGING_VERBOSITY > 0
+    if (result == CHIP_NO_ERROR)
+    {
+        ChipLogProgress(DataManagement, "AccessControl: allowed");
+    }
+#endif // CHIP_CONFIG_ACCESS_CONTROL_POLICY_LOGGING_VERBOSITY > 0
+
+    if (result == CHIP_ERROR_ACCESS_DENIED)
+    {
+        // No entry was found which passed all checks: access is denied.
+        ChipLogProgress(DataManagement, "AccessControl: denied");
+    }
+
+    return result;
+}
+
+CHIP_ERROR AccessControl::CheckEntries(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                                       Privilege requestPrivilege)
+{
     EntryIterator iterator;
     ReturnErrorOnFailure(Entries(iterator, &subjectDescriptor.fabricIndex));
 
@@ -456,16 +491,10 @@ CHIP_ERROR AccessControl::Check(const SubjectDescriptor & subjectDescriptor, con
             }
         }
         // Entry passed all checks: access is allowed.
-
-#if CHIP_CONFIG_ACCESS_CONTROL_POLICY_LOGGING_VERBOSITY > 0
-        ChipLogProgress(DataManagement, "AccessControl: allowed");
-#endif // CHIP_CONFIG_ACCESS_CONTROL_POLICY_LOGGING_VERBOSITY > 0
-
         return CHIP_NO_ERROR;
     }
 
     // No entry was found which passed all checks: access is denied.
-    ChipLogProgress(DataManagement, "AccessControl: denied");
     return CHIP_ERROR_ACCESS_DENIED;
 }
 
@@ -626,12 +655,447 @@ exit:
 void AccessControl::NotifyEntryChanged(const SubjectDescriptor * subjectDescriptor, FabricIndex fabric, size_t index,
                                        const Entry * entry, EntryListener::ChangeType changeType)
 {
+    // Before any listener gets a chance to check access against the new entries.
+    InvalidateCache(&fabric);
+
     for (EntryListener * listener = mEntryListener; listener != nullptr; listener = listener->mNext)
     {
         listener->OnEntryChanged(subjectDescriptor, fabric, index, entry, changeType);
     }
 }
 
+#if CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE > 0
+
+/**
+ * The entries of a fabric, decoded once so that checks do not have to go through the delegate.
+ *
+ * Everything lives in a single allocation: this header, followed by the subjects and targets of all entries, the
+ * cluster index, the entries, and the indices of the entries that are not in the cluster index. An entry that has
+ * targets, all of which name a cluster, is in the cluster index once per cluster it targets, so a check only visits
+ * it for these clusters; the other entries are visited by every check.
+ */
+class AccessControl::CompiledEntries
+{
+public:
+    // On failure (including an entry that would make the default check fail), compiled is set to null.
+    static CHIP_ERROR Compile(const AccessControl & accessControl, FabricIndex fabricIndex, CompiledEntries *& compiled);
+    static void Free(CompiledEntries * compiled) { Platform::MemoryFree(compiled); }
+
+    // Same result as the default check for a subject of the fabric. deviceTypeChecked is set if the device type
+    // resolver was consulted, in which case the result may change without any entry changing.
+    bool Check(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath, Privilege requestPrivilege,
+               DeviceTypeResolver & deviceTypeResolver, bool & deviceTypeChecked) const;
+
+private:
+    struct CompiledEntry
+    {
+        uint16_t firstSubject;
+        uint16_t subjectCount;
+        uint16_t firstTarget;
+        uint16_t targetCount;
+        AuthMode authMode;
+        Privilege privilege;
+    };
+
+    struct ClusterIndexEntry
+    {
+        ClusterId cluster;
+        uint16_t entry;
+    };
+
+    struct Counts
+    {
+        size_t entries      = 0;
+        size_t subjects     = 0;
+        size_t targets      = 0;
+        size_t clusterIndex = 0;
+        size_t otherEntries = 0;
+    };
+
+    // Decode the entries of the fabric and count them, also filling the arrays of compiled if not null.
+    static CHIP_ERROR Decode(const AccessControl & accessControl, FabricIndex fabricIndex, Counts & counts,
+                             CompiledEntries * compiled);
+
+    bool CheckEntry(const CompiledEntry & entry, const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                    Privilege requestPrivilege, DeviceTypeResolver & deviceTypeResolver, bool & deviceTypeChecked) const;
+
+    Counts mCounts;
+    NodeId * mSubjects;
+    Entry::Target * mTargets;
+    ClusterIndexEntry * mClusterIndex; // sorted by cluster
+    CompiledEntry * mEntries;
+    uint16_t * mOtherEntries;
+};
+
+CHIP_ERROR AccessControl::CompiledEntries::Compile(const AccessControl & accessControl, FabricIndex fabricIndex,
+                                                   CompiledEntries *& compiled)
+{
+    // The arrays follow the header by decreasing alignment, so none of them needs padding.
+    static_assert(std::is_trivially_destructible<CompiledEntries>::value, "Compiled entries are freed without destruction");
+    static_assert(sizeof(CompiledEntries) % alignof(NodeId) == 0 && alignof(NodeId) >= alignof(Entry::Target),
+                  "Unexpected alignment of compiled entries");
+    static_assert(sizeof(Entry::Target) % alignof(ClusterIndexEntry) == 0 &&
+                      sizeof(ClusterIndexEntry) % alignof(CompiledEntry) == 0 && sizeof(CompiledEntry) % alignof(uint16_t) == 0,
+                  "Unexpected alignment of compiled entries");
+
+    compiled = nullptr;
+
+    Counts counts;
+    ReturnErrorOnFailure(Decode(accessControl, fabricIndex, counts, nullptr));
+    VerifyOrReturnError(counts.entries <= UINT16_MAX && counts.subjects <= UINT16_MAX && counts.targets <= UINT16_MAX,
+                        CHIP_ERROR_NO_MEMORY);
+
+    const size_t size = sizeof(CompiledEntries) + counts.subjects * sizeof(NodeId) + counts.targets * sizeof(Entry::Target) +
+        counts.clusterIndex * sizeof(ClusterIndexEntry) + counts.entries * sizeof(CompiledEntry) +
+        counts.otherEntries * sizeof(uint16_t);
+    uint8_t * storage = static_cast<uint8_t *>(Platform::MemoryAlloc(size));
+    VerifyOrReturnError(storage != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    CompiledEntries * result = new (storage) CompiledEntries();
+    uint8_t * next           = storage + sizeof(CompiledEntries);
+    result->mCounts          = counts;
+    result->mSubjects        = reinterpret_cast<NodeId *>(next);
+    next += counts.subjects * sizeof(NodeId);
+    result->mTargets = reinterpret_cast<Entry::Target *>(next);
+    next += counts.targets * sizeof(Entry::Target);
+    result->mClusterIndex = reinterpret_cast<ClusterIndexEntry *>(next);
+    next += counts.clusterIndex * sizeof(ClusterIndexEntry);
+    result->mEntries = reinterpret_cast<CompiledEntry *>(next);
+    next += counts.entries * sizeof(CompiledEntry);
+    result->mOtherEntries = reinterpret_cast<uint16_t *>(next);
+
+    Counts decoded;
+    CHIP_ERROR err = Decode(accessControl, fabricIndex, decoded, result);
+    if (err == CHIP_NO_ERROR &&
+        (decoded.entries != counts.entries || decoded.clusterIndex != counts.clusterIndex ||
+         decoded.otherEntries != counts.otherEntries))
+    {
+        err = CHIP_ERROR_INCORRECT_STATE;
+    }
+    if (err != CHIP_NO_ERROR)
+    {
+        Free(result);
+        return err;
+    }
+
+    // Entries were added in order, and the sort is stable, so an entry that targets the same cluster more than once
+    // (e.g. on different endpoints) ends up next to itself.
+    Sorting::InsertionSort(result->mClusterIndex, counts.clusterIndex,
+                           [](const ClusterIndexEntry & a, const ClusterIndexEntry & b) { return a.cluster < b.cluster; });
+    size_t unique = 0;
+    for (size_t i = 0; i < counts.clusterIndex; ++i)
+    {
+        const ClusterIndexEntry & indexEntry = result->mClusterIndex[i];
+        if (unique == 0 || indexEntry.cluster != result->mClusterIndex[unique - 1].cluster ||
+            indexEntry.entry != result->mClusterIndex[unique - 1].entry)
+        {
+            result->mClusterIndex[unique++] = indexEntry;
+        }
+    }
+    result->mCounts.clusterIndex = unique;
+
+    compiled = result;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AccessControl::CompiledEntries::Decode(const AccessControl & accessControl, FabricIndex fabricIndex, Counts & counts,
+                                                  CompiledEntries * compiled)
+{
+    EntryIterator iterator;
+    ReturnErrorOnFailure(accessControl.Entries(fabricIndex, iterator));
+
+    Entry entry;
+    CHIP_ERROR err;
+    while ((err = iterator.Next(entry)) == CHIP_NO_ERROR)
+    {
+        CompiledEntry compiledEntry;
+        compiledEntry.firstSubject = static_cast<uint16_t>(counts.subjects);
+        compiledEntry.firstTarget  = static_cast<uint16_t>(counts.targets);
+
+        ReturnErrorOnFailure(entry.GetAuthMode(compiledEntry.authMode));
+        // Operational PASE not supported for v1.0.
+        VerifyOrReturnError(compiledEntry.authMode == AuthMode::kCase || compiledEntry.authMode == AuthMode::kGroup,
+                            CHIP_ERROR_INCORRECT_STATE);
+        ReturnErrorOnFailure(entry.GetPrivilege(compiledEntry.privilege));
+
+        size_t subjectCount = 0;
+        ReturnErrorOnFailure(entry.GetSubjectCount(subjectCount));
+        for (size_t i = 0; i < subjectCount; ++i)
+        {
+            NodeId subject = kUndefinedNodeId;
+            ReturnErrorOnFailure(entry.GetSubject(i, subject));
+            // Same subjects as the default check accepts.
+            const bool isCaseSubject  = IsOperationalNodeId(subject) || IsCASEAuthTag(subject);
+            const bool isGroupSubject = IsGroupId(subject);
+            VerifyOrReturnError((isCaseSubject && compiledEntry.authMode == AuthMode::kCase) ||
+                                    (isGroupSubject && compiledEntry.authMode == AuthMode::kGroup),
+                                CHIP_ERROR_INCORRECT_STATE);
+            if (compiled != nullptr)
+            {
+                VerifyOrReturnError(counts.subjects < compiled->mCounts.subjects, CHIP_ERROR_INCORRECT_STATE);
+                compiled->mSubjects[counts.subjects] = subject;
+            }
+            counts.subjects++;
+        }
+
+        size_t targetCount = 0;
+        ReturnErrorOnFailure(entry.GetTargetCount(targetCount));
+        bool allTargetsHaveCluster = (targetCount > 0);
+        for (size_t i = 0; i < targetCount; ++i)
+        {
+            Entry::Target target;
+            ReturnErrorOnFailure(entry.GetTarget(i, target));
+            allTargetsHaveCluster = allTargetsHaveCluster && (target.flags & Entry::Target::kCluster);
+            if (compiled != nullptr)
+            {
+                VerifyOrReturnError(counts.targets < compiled->mCounts.targets, CHIP_ERROR_INCORRECT_STATE);
+                compiled->mTargets[counts.targets] = target;
+            }
+            counts.targets++;
+        }
+
+        VerifyOrReturnError(counts.entries < UINT16_MAX && counts.subjects <= UINT16_MAX && counts.targets <= UINT16_MAX,
+                            CHIP_ERROR_NO_MEMORY);
+        const uint16_t entryIndex  = static_cast<uint16_t>(counts.entries);
+        compiledEntry.subjectCount = static_cast<uint16_t>(counts.subjects - compiledEntry.firstSubject);
+        compiledEntry.targetCount  = static_cast<uint16_t>(counts.targets - compiledEntry.firstTarget);
+
+        if (allTargetsHaveCluster)
+        {
+            for (size_t i = 0; i < compiledEntry.targetCount; ++i)
+            {
+                if (compiled != nullptr)
+                {
+                    VerifyOrReturnError(counts.clusterIndex < compiled->mCounts.clusterIndex, CHIP_ERROR_INCORRECT_STATE);
+                    compiled->mClusterIndex[counts.clusterIndex] = { compiled->mTargets[compiledEntry.firstTarget + i].cluster,
+                                                                     entryIndex };
+                }
+                counts.clusterIndex++;
+            }
+        }
+        else
+        {
+            if (compiled != nullptr)
+            {
+                VerifyOrReturnError(counts.otherEntries < compiled->mCounts.otherEntries, CHIP_ERROR_INCORRECT_STATE);
+                compiled->mOtherEntries[counts.otherEntries] = entryIndex;
+            }
+            counts.otherEntries++;
+        }
+
+        if (compiled != nullptr)
+        {
+            VerifyOrReturnError(counts.entries < compiled->mCounts.entries, CHIP_ERROR_INCORRECT_STATE);
+            compiled->mEntries[counts.entries] = compiledEntry;
+        }
+        counts.entries++;
+    }
+
+    VerifyOrReturnError(err == CHIP_ERROR_SENTINEL, err);
+    return CHIP_NO_ERROR;
+}
+
+bool AccessControl::CompiledEntries::Check(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                                           Privilege requestPrivilege, DeviceTypeResolver & deviceTypeResolver,
+                                           bool & deviceTypeChecked) const
+{
+    const ClusterIndexEntry * indexBegin = mClusterIndex;
+    const ClusterIndexEntry * indexEnd   = mClusterIndex + mCounts.clusterIndex;
+    const ClusterIndexEntry * indexEntry =
+        std::lower_bound(indexBegin, indexEnd, requestPath.cluster,
+                         [](const ClusterIndexEntry & a, ClusterId cluster) { return a.cluster < cluster; });
+    for (; indexEntry != indexEnd && indexEntry->cluster == requestPath.cluster; ++indexEntry)
+    {
+        if (CheckEntry(mEntries[indexEntry->entry], subjectDescriptor, requestPath, requestPrivilege, deviceTypeResolver,
+                       deviceTypeChecked))
+        {
+            return true;
+        }
+    }
+
+    for (size_t i = 0; i < mCounts.otherEntries; ++i)
+    {
+        if (CheckEntry(mEntries[mOtherEntries[i]], subjectDescriptor, requestPath, requestPrivilege, deviceTypeResolver,
+                       deviceTypeChecked))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool AccessControl::CompiledEntries::CheckEntry(const CompiledEntry & entry, const SubjectDescriptor & subjectDescriptor,
+                                                const RequestPath & requestPath, Privilege requestPrivilege,
+                                                DeviceTypeResolver & deviceTypeResolver, bool & deviceTypeChecked) const
+{
+    VerifyOrReturnValue(entry.authMode == subjectDescriptor.authMode, false);
+    VerifyOrReturnValue(CheckRequestPrivilegeAgainstEntryPrivilege(requestPrivilege, entry.privilege), false);
+
+    if (entry.subjectCount > 0)
+    {
+        bool subjectMatched = false;
+        for (size_t i = entry.firstSubject; i < entry.firstSubject + entry.subjectCount && !subjectMatched; ++i)
+        {
+            const NodeId subject = mSubjects[i];
+            subjectMatched       = IsCASEAuthTag(subject) ? subjectDescriptor.cats.CheckSubjectAgainstCATs(subject)
+                                                          : (subject == subjectDescriptor.subject);
+        }
+        VerifyOrReturnValue(subjectMatched, false);
+    }
+
+    if (entry.targetCount == 0)
+    {
+        return true;
+    }
+
+    for (size_t i = entry.firstTarget; i < entry.firstTarget + entry.targetCount; ++i)
+    {
+        const Entry::Target & target = mTargets[i];
+        if ((target.flags & Entry::Target::kCluster) && target.cluster != requestPath.cluster)
+        {
+            continue;
+        }
+        if ((target.flags & Entry::Target::kEndpoint) && target.endpoint != requestPath.endpoint)
+        {
+            continue;
+        }
+        if (target.flags & Entry::Target::kDeviceType)
+        {
+            deviceTypeChecked = true;
+            if (!deviceTypeResolver.IsDeviceTypeOnEndpoint(target.deviceType, requestPath.endpoint))
+            {
+                continue;
+            }
+        }
+        return true;
+    }
+
+    return false;
+}
+
+CHIP_ERROR AccessControl::CheckCached(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                                      Privilege requestPrivilege)
+{
+    VerifyOrReturnError(subjectDescriptor.fabricIndex != kUndefinedFabricIndex, CHIP_ERROR_NOT_IMPLEMENTED);
+
+    const CachedDecision * decision = FindCachedDecision(subjectDescriptor, requestPath, requestPrivilege);
+    if (decision != nullptr)
+    {
+        return decision->allowed ? CHIP_NO_ERROR : CHIP_ERROR_ACCESS_DENIED;
+    }
+
+    const CompiledEntries * entries = GetCompiledEntries(subjectDescriptor.fabricIndex);
+    VerifyOrReturnError(entries != nullptr, CHIP_ERROR_NOT_IMPLEMENTED);
+
+    bool deviceTypeChecked = false;
+    const bool allowed =
+        entries->Check(subjectDescriptor, requestPath, requestPrivilege, *mDeviceTypeResolver, deviceTypeChecked);
+    // Device types can come and go with dynamic endpoints, without any entry changing, so such decisions are not cached.
+    if (!deviceTypeChecked)
+    {
+        CacheDecision(subjectDescriptor, requestPath, requestPrivilege, allowed);
+    }
+
+    return allowed ? CHIP_NO_ERROR : CHIP_ERROR_ACCESS_DENIED;
+}
+
+const AccessControl::CompiledEntries * AccessControl::GetCompiledEntries(FabricIndex fabricIndex)
+{
+    CompiledFabric * slot = nullptr;
+    for (auto & fabric : mCompiledFabrics)
+    {
+        if (fabric.fabricIndex == fabricIndex)
+        {
+            return fabric.entries;
+        }
+        if (slot == nullptr && fabric.fabricIndex == kUndefinedFabricIndex)
+        {
+            slot = &fabric;
+        }
+    }
+
+    if (slot == nullptr)
+    {
+        // Fabric indices are not reused right away, so more fabrics than there are slots may have been checked.
+        slot                = &mCompiledFabrics[mNextCompiledFabric];
+        mNextCompiledFabric = (mNextCompiledFabric + 1) % ArraySize(mCompiledFabrics);
+        if (slot->entries != nullptr)
+        {
+            CompiledEntries::Free(slot->entries);
+        }
+    }
+
+    // A fabric whose entries cannot be compiled is remembered as such, so that they are not decoded on every check.
+    slot->fabricIndex = fabricIndex;
+    CHIP_ERROR err    = CompiledEntries::Compile(*this, fabricIndex, slot->entries);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DataManagement, "AccessControl: cannot compile entries of fabric %u: %" CHIP_ERROR_FORMAT, fabricIndex,
+                     err.Format());
+    }
+    return slot->entries;
+}
+
+const AccessControl::CachedDecision * AccessControl::FindCachedDecision(const SubjectDescriptor & subjectDescriptor,
+                                                                        const RequestPath & requestPath,
+                                                                        Privilege requestPrivilege) const
+{
+    for (const auto & decision : mCachedDecisions)
+    {
+        if (decision.subjectDescriptor.fabricIndex == subjectDescriptor.fabricIndex &&
+            decision.subjectDescriptor.authMode == subjectDescriptor.authMode &&
+            decision.subjectDescriptor.subject == subjectDescriptor.subject &&
+            decision.subjectDescriptor.cats == subjectDescriptor.cats && decision.requestPath.cluster == requestPath.cluster &&
+            decision.requestPath.endpoint == requestPath.endpoint && decision.privilege == requestPrivilege)
+        {
+            return &decision;
+        }
+    }
+    return nullptr;
+}
+
+void AccessControl::CacheDecision(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                                  Privilege requestPrivilege, bool allowed)
+{
+    CachedDecision & decision = mCachedDecisions[mNextCachedDecision];
+    mNextCachedDecision       = (mNextCachedDecision + 1) % ArraySize(mCachedDecisions);
+
+    decision.subjectDescriptor = subjectDescriptor;
+    decision.requestPath       = requestPath;
+    decision.privilege         = requestPrivilege;
+    decision.allowed           = allowed;
+}
+
+#endif // CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE > 0
+
+void AccessControl::InvalidateCache(const FabricIndex * fabricIndex)
+{
+#if CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE > 0
+    for (auto & fabric : mCompiledFabrics)
+    {
+        if (fabric.fabricIndex != kUndefinedFabricIndex && (fabricIndex == nullptr || fabric.fabricIndex == *fabricIndex))
+        {
+            if (fabric.entries != nullptr)
+            {
+                CompiledEntries::Free(fabric.entries);
+            }
+            fabric = CompiledFabric();
+        }
+    }
+
+    for (auto & decision : mCachedDecisions)
+    {
+        if (fabricIndex == nullptr || decision.subjectDescriptor.fabricIndex == *fabricIndex)
+        {
+            decision.subjectDescriptor.fabricIndex = kUndefinedFabricIndex;
+        }
+    }
+#else
+    IgnoreUnusedVariable(fabricIndex);
+#endif // CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE > 0
+}
+
 AccessControl & GetAccessControl()
 {
     return (globalAccessControl) ? *globalAccessControl : defaultAccessControl.get();
@@ -405,6 +405,8 @@ public:
 
     ~AccessControl()
     {
+        InvalidateCache(nullptr);
+
         // Never-initialized AccessControl instances will not have the delegate set.
         if (IsInitialized())
         {
@@ -497,6 +499,7 @@ public:
     {
         ReturnErrorCodeIf(!IsValid(entry), CHIP_ERROR_INVALID_ARGUMENT);
         VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+        InvalidateCache(nullptr);
         return mDelegate->CreateEntry(index, entry, fabricIndex);
     }
 
@@ -547,6 +550,7 @@ public:
     {
         ReturnErrorCodeIf(!IsValid(entry), CHIP_ERROR_INVALID_ARGUMENT);
         VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+        InvalidateCache(fabricIndex);
         return mDelegate->UpdateEntry(index, entry, fabricIndex);
     }
 
@@ -568,6 +572,7 @@ public:
     CHIP_ERROR DeleteEntry(size_t index, const FabricIndex * fabricIndex = nullptr)
     {
         VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+        InvalidateCache(fabricIndex);
         return mDelegate->DeleteEntry(index, fabricIndex);
     }
 
@@ -649,12 +654,59 @@ private:
     void NotifyEntryChanged(const SubjectDescriptor * subjectDescriptor, FabricIndex fabric, size_t index, const Entry * entry,
                             EntryListener::ChangeType changeType);
 
+    // Default check algorithm, against the entries of the delegate.
+    CHIP_ERROR CheckEntries(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                            Privilege requestPrivilege);
+
+    // Drop what was cached about the entries of a fabric, or of all fabrics if fabricIndex is null.
+    void InvalidateCache(const FabricIndex * fabricIndex);
+
+#if CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE > 0
+    // Entries of a fabric, decoded out of the delegate (see AccessControl.cpp).
+    class CompiledEntries;
+
+    struct CompiledFabric
+    {
+        FabricIndex fabricIndex = kUndefinedFabricIndex;
+        // Null if the entries of the fabric could not be compiled, in which case checks go through the delegate.
+        CompiledEntries * entries = nullptr;
+    };
+
+    struct CachedDecision
+    {
+        // Unused if the fabric index is undefined.
+        SubjectDescriptor subjectDescriptor;
+        RequestPath requestPath;
+        Privilege privilege = Privilege::kView;
+        bool allowed        = false;
+    };
+
+    // Check against what is cached about the entries of the fabric, or return CHIP_ERROR_NOT_IMPLEMENTED to check against
+    // the delegate.
+    CHIP_ERROR CheckCached(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                           Privilege requestPrivilege);
+    // Returns null if checks must go through the delegate.
+    const CompiledEntries * GetCompiledEntries(FabricIndex fabricIndex);
+    const CachedDecision * FindCachedDecision(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath,
+                                              Privilege requestPrivilege) const;
+    void CacheDecision(const SubjectDescriptor & subjectDescriptor, const RequestPath & requestPath, Privilege requestPrivilege,
+                       bool allowed);
+#endif // CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE > 0
+
 private:
     Delegate * mDelegate = nullptr;
 
     DeviceTypeResolver * mDeviceTypeResolver = nullptr;
 
     EntryListener * mEntryListener = nullptr;
+
+#if CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE > 0
+    CompiledFabric mCompiledFabrics[CHIP_CONFIG_MAX_FABRICS];
+    size_t mNextCompiledFabric = 0;
+
+    CachedDecision mCachedDecisions[CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE];
+    size_t mNextCachedDecision = 0;
+#endif // CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE > 0
 };
 
 /**
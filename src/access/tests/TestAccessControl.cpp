@@ -20,6 +20,7 @@
 #include "access/examples/ExampleAccessControlDelegate.h"
 
 #include <lib/core/CHIPCore.h>
+#include <lib/support/CHIPMem.h>
 #include <lib/support/UnitTestRegistration.h>
 
 #include <nlunit-test.h>
@@ -421,7 +422,9 @@ constexpr DeviceTypeId invalidDeviceTypes[] = {
 class DeviceTypeResolver : public AccessControl::DeviceTypeResolver
 {
 public:
-    bool IsDeviceTypeOnEndpoint(DeviceTypeId deviceType, EndpointId endpoint) override { return false; }
+    bool IsDeviceTypeOnEndpoint(DeviceTypeId deviceType, EndpointId endpoint) override { return mDeviceTypesOnEndpoints; }
+
+    bool mDeviceTypesOnEndpoints = false;
 } testDeviceTypeResolver;
 
 // For testing, supports one subject and target, allows any value (valid or invalid)
@@ -1760,6 +1763,90 @@ void TestCheck(nlTestSuite * inSuite, void * inContext)
     }
 }
 
+void TestCheckCache(nlTestSuite * inSuite, void * inContext)
+{
+    // The second time around, decisions come from the cache.
+    LoadAccessControl(accessControl, entryData1, entryData1Count);
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        for (const auto & checkData : checkData1)
+        {
+            CHIP_ERROR expectedResult = checkData.allow ? CHIP_NO_ERROR : CHIP_ERROR_ACCESS_DENIED;
+            NL_TEST_ASSERT(inSuite,
+                           accessControl.Check(checkData.subjectDescriptor, checkData.requestPath, checkData.privilege) ==
+                               expectedResult);
+        }
+    }
+
+    // Entry changes are seen by the next check.
+    constexpr FabricIndex fabricIndex  = 3;
+    constexpr RequestPath onOff        = { .cluster = kOnOffCluster, .endpoint = 1 };
+    constexpr RequestPath levelControl = { .cluster = kLevelControlCluster, .endpoint = 1 };
+
+    SubjectDescriptor subjectDescriptor;
+    subjectDescriptor.fabricIndex = fabricIndex;
+    subjectDescriptor.authMode    = AuthMode::kCase;
+    subjectDescriptor.subject     = kOperationalNodeId1;
+
+    NL_TEST_ASSERT(inSuite, accessControl.Check(subjectDescriptor, onOff, Privilege::kOperate) == CHIP_ERROR_ACCESS_DENIED);
+
+    EntryData entryData = {
+        .fabricIndex = fabricIndex,
+        .privilege   = Privilege::kOperate,
+        .authMode    = AuthMode::kCase,
+        .subjects    = { kOperationalNodeId1 },
+        .targets     = { { .flags = Target::kCluster, .cluster = kOnOffCluster } },
+    };
+    size_t index = 0;
+    {
+        Entry entry;
+        NL_TEST_ASSERT(inSuite, accessControl.PrepareEntry(entry) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, LoadEntry(entry, entryData) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, accessControl.CreateEntry(nullptr, fabricIndex, &index, entry) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, accessControl.Check(subjectDescriptor, onOff, Privilege::kOperate) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, accessControl.Check(subjectDescriptor, levelControl, Privilege::kOperate) == CHIP_ERROR_ACCESS_DENIED);
+
+    entryData.targets[0].cluster = kLevelControlCluster;
+    {
+        Entry entry;
+        NL_TEST_ASSERT(inSuite, accessControl.PrepareEntry(entry) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, LoadEntry(entry, entryData) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, accessControl.UpdateEntry(nullptr, fabricIndex, index, entry) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, accessControl.Check(subjectDescriptor, onOff, Privilege::kOperate) == CHIP_ERROR_ACCESS_DENIED);
+    NL_TEST_ASSERT(inSuite, accessControl.Check(subjectDescriptor, levelControl, Privilege::kOperate) == CHIP_NO_ERROR);
+
+    // Including changes that are not notified to entry listeners.
+    entryData.targets[0].cluster = kOnOffCluster;
+    {
+        Entry entry;
+        NL_TEST_ASSERT(inSuite, accessControl.PrepareEntry(entry) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, LoadEntry(entry, entryData) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, accessControl.UpdateEntry(index, entry, &fabricIndex) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, accessControl.Check(subjectDescriptor, onOff, Privilege::kOperate) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, accessControl.Check(subjectDescriptor, levelControl, Privilege::kOperate) == CHIP_ERROR_ACCESS_DENIED);
+
+    NL_TEST_ASSERT(inSuite, accessControl.DeleteEntry(nullptr, fabricIndex, index) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, accessControl.Check(subjectDescriptor, onOff, Privilege::kOperate) == CHIP_ERROR_ACCESS_DENIED);
+
+    // Decisions that depend on which device types are on an endpoint must not be cached.
+    entryData.targets[0] = { .flags = Target::kDeviceType, .deviceType = 0x0000'0100 };
+    {
+        Entry entry;
+        NL_TEST_ASSERT(inSuite, accessControl.PrepareEntry(entry) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, LoadEntry(entry, entryData) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, accessControl.CreateEntry(nullptr, fabricIndex, &index, entry) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, accessControl.Check(subjectDescriptor, onOff, Privilege::kOperate) == CHIP_ERROR_ACCESS_DENIED);
+    testDeviceTypeResolver.mDeviceTypesOnEndpoints = true;
+    NL_TEST_ASSERT(inSuite, accessControl.Check(subjectDescriptor, onOff, Privilege::kOperate) == CHIP_NO_ERROR);
+    testDeviceTypeResolver.mDeviceTypesOnEndpoints = false;
+    NL_TEST_ASSERT(inSuite, accessControl.Check(subjectDescriptor, onOff, Privilege::kOperate) == CHIP_ERROR_ACCESS_DENIED);
+    NL_TEST_ASSERT(inSuite, accessControl.DeleteEntry(nullptr, fabricIndex, index) == CHIP_NO_ERROR);
+}
+
 void TestCreateReadEntry(nlTestSuite * inSuite, void * inContext)
 {
     for (size_t i = 0; i < entryData1Count; ++i)
@@ -2192,6 +2279,7 @@ void TestUpdateEntry(nlTestSuite * inSuite, void * inContext)
 
 int Setup(void * inContext)
 {
+    VerifyOrDie(Platform::MemoryInit() == CHIP_NO_ERROR);
     AccessControl::Delegate * delegate = Examples::GetAccessControlDelegate();
     SetAccessControl(accessControl);
     VerifyOrDie(GetAccessControl().Init(delegate, testDeviceTypeResolver) == CHIP_NO_ERROR);
@@ -2202,6 +2290,7 @@ int Teardown(void * inContext)
 {
     GetAccessControl().Finish();
     ResetAccessControlToDefault();
+    Platform::MemoryShutdown();
     return SUCCESS;
 }
 
@@ -2235,6 +2324,7 @@ int TestAccessControl()
         NL_TEST_DEF("TestFabricFilteredReadEntry", TestFabricFilteredReadEntry),
         NL_TEST_DEF("TestFabricFilteredCreateEntry", TestFabricFilteredCreateEntry),
         NL_TEST_DEF("TestCheck", TestCheck),
+        NL_TEST_DEF("TestCheckCache", TestCheckCache),
         NL_TEST_SENTINEL()
     };
     // clang-format on
@@ -37,6 +37,7 @@ using namespace chip;
 typedef uint8_t EmberAfClusterMask;
 
 extern uint16_t emberAfEndpointCount();
+extern unsigned emberAfMetadataStructureGeneration();
 extern uint16_t emberAfIndexFromEndpoint(EndpointId endpoint);
 extern uint8_t emberAfClusterCount(EndpointId endpoint, bool server);
 extern uint16_t emberAfGetServerAttributeCount(chip::EndpointId endpoint, chip::ClusterId cluster);
@@ -67,6 +68,8 @@ AttributePathExpandIterator::AttributePathExpandIterator(ObjectList<AttributePat
                   "If this changes audit all uses where we set to UINT8_MAX");
     mGlobalAttributeIndex = UINT8_MAX;
 
+    mMetadataGeneration = emberAfMetadataStructureGeneration();
+
     // Make the iterator ready to emit the first valid path in the list.
     Next();
 }
@@ -149,12 +152,89 @@ void AttributePathExpandIterator::PrepareAttributeIndexRange(const AttributePath
     }
 }
 
+void AttributePathExpandIterator::RevalidateIndices()
+{
+    const unsigned generation = emberAfMetadataStructureGeneration();
+    VerifyOrReturn(generation != mMetadataGeneration);
+    mMetadataGeneration = generation;
+
+    // Concrete paths are emitted as-is, so there is nothing to fix up for them.  For a wildcard path that we have started
+    // expanding, the last call to Next() returned mOutputPath, which is in the endpoint at mEndpointIndex and the cluster at
+    // mClusterIndex.
+    VerifyOrReturn(mpAttributePath != nullptr && mpAttributePath->mValue.IsWildcardPath());
+    VerifyOrReturn(mEndpointIndex != UINT16_MAX && mClusterIndex != UINT8_MAX);
+
+    const AttributePathParams & attributePath = mpAttributePath->mValue;
+    const EndpointId endpointId               = mOutputPath.mEndpointId;
+    const ClusterId clusterId                 = mOutputPath.mClusterId;
+
+    if (attributePath.HasWildcardEndpointId())
+    {
+        // Endpoint indices are positions in the endpoint table.  If ours no longer holds the endpoint we were expanding, expand
+        // whatever it holds now from its first cluster.
+        mEndEndpointIndex = emberAfEndpointCount();
+        if (mEndpointIndex >= mEndEndpointIndex || emberAfEndpointFromIndex(mEndpointIndex) != endpointId)
+        {
+            mClusterIndex = UINT8_MAX;
+            return;
+        }
+    }
+    else
+    {
+        // If the endpoint is gone, Next() will find the same empty range again and move on to the next path.
+        PrepareEndpointIndexRange(attributePath);
+        VerifyOrReturn(mEndpointIndex != UINT16_MAX);
+    }
+
+    if (attributePath.HasWildcardClusterId())
+    {
+        mEndClusterIndex           = emberAfClusterCount(endpointId, true /* server */);
+        const uint8_t clusterIndex = emberAfClusterIndex(endpointId, clusterId, CLUSTER_MASK_SERVER);
+        if (clusterIndex == UINT8_MAX)
+        {
+            // The cluster is gone, and the one that took its position has not been expanded yet.
+            mAttributeIndex       = UINT16_MAX;
+            mGlobalAttributeIndex = UINT8_MAX;
+            return;
+        }
+        mClusterIndex = clusterIndex;
+    }
+    else
+    {
+        PrepareClusterIndexRange(attributePath, endpointId);
+        VerifyOrReturn(mClusterIndex != UINT8_MAX);
+    }
+
+    // A concrete attribute id has already been emitted for this cluster, whatever its index is now.
+    VerifyOrReturn(attributePath.HasWildcardAttributeId());
+
+    mEndAttributeIndex = emberAfGetServerAttributeCount(endpointId, clusterId);
+    if (mGlobalAttributeIndex != 0)
+    {
+        // We are past the attributes in the metadata.
+        mAttributeIndex = mEndAttributeIndex;
+        return;
+    }
+
+    const uint16_t attributeIndex = emberAfGetServerAttributeIndexByAttributeId(endpointId, clusterId, mOutputPath.mAttributeId);
+    if (attributeIndex == UINT16_MAX)
+    {
+        // The attribute we emitted last is gone; start the cluster over so that it is reported coherently.
+        mAttributeIndex       = UINT16_MAX;
+        mGlobalAttributeIndex = UINT8_MAX;
+        return;
+    }
+    mAttributeIndex = static_cast<uint16_t>(attributeIndex + 1);
+}
+
 void AttributePathExpandIterator::ResetCurrentCluster()
 {
     // If this is a null iterator, or the attribute id of current cluster info is not a wildcard attribute id, then this function
     // will do nothing, since we won't be expanding the wildcard attribute ids under a cluster.
     VerifyOrReturn(mpAttributePath != nullptr && mpAttributePath->mValue.HasWildcardAttributeId());
 
+    RevalidateIndices();
+
     // Otherwise, we will reset the index for iterating the attributes, so we report the attributes for this cluster again. This
     // will ensure that the client sees a coherent view of the cluster from the reports generated by a single (wildcard) attribute
     // path in the request.
@@ -172,6 +252,8 @@ void AttributePathExpandIterator::ResetCurrentCluster()
 
 bool AttributePathExpandIterator::Next()
 {
+    RevalidateIndices();
+
     for (; mpAttributePath != nullptr; (mpAttributePath = mpAttributePath->mpNext, mEndpointIndex = UINT16_MAX))
     {
         mOutputPath.mExpanded = mpAttributePath->mValue.IsWildcardPath();
@@ -215,13 +297,19 @@ bool AttributePathExpandIterator::Next()
             for (; mClusterIndex < mEndClusterIndex;
                  (mClusterIndex++, mAttributeIndex = UINT16_MAX, mGlobalAttributeIndex = UINT8_MAX))
             {
-                // emberAfGetNthClusterId must return a valid cluster id here since we have verified the mClusterIndex does
-                // not exceed the mEndClusterIndex.
-                ClusterId clusterId = emberAfGetNthClusterId(endpointId, mClusterIndex, true /* server */).Value();
+                ClusterId clusterId;
                 if (mAttributeIndex == UINT16_MAX && mGlobalAttributeIndex == UINT8_MAX)
                 {
+                    // emberAfGetNthClusterId must return a valid cluster id here since we have verified the mClusterIndex does
+                    // not exceed the mEndClusterIndex.
+                    clusterId = emberAfGetNthClusterId(endpointId, mClusterIndex, true /* server */).Value();
                     PrepareAttributeIndexRange(mpAttributePath->mValue, endpointId, clusterId);
                 }
+                else
+                {
+                    // We are resuming the cluster of the path we returned last time, so there is no need to look it up again.
+                    clusterId = mOutputPath.mClusterId;
+                }
 
                 if (mAttributeIndex < mEndAttributeIndex)
                 {
@@ -54,7 +54,9 @@ namespace app {
  * for (AttributePathExpandIterator iterator(AttributePathParams); iterator.Get(path); iterator.Next()) {...}
  *
  * The iterator does not copy the given AttributePathParams, The given AttributePathParams must be valid when using the iterator.
- * If the set of endpoints, clusters, or attributes that are supported changes, AttributePathExpandIterator must be reinitialized.
+ * If the set of endpoints, clusters, or attributes that are supported changes (see emberAfMetadataStructureGeneration), the
+ * iterator resumes after the last path it emitted: it continues with the next attribute of that cluster if the cluster still
+ * exists, and otherwise with whatever now occupies the position of the cluster or endpoint it was expanding.
  *
  * A initialized iterator will return the first valid path, no need to call Next() before calling Get() for the first time.
  *
@@ -118,6 +120,9 @@ private:
     // metadata.
     uint8_t mGlobalAttributeIndex, mGlobalAttributeEndIndex;
 
+    // emberAfMetadataStructureGeneration() when the indices above were last known to be valid.
+    unsigned mMetadataGeneration;
+
     /**
      * Prepare*IndexRange will update mBegin*Index and mEnd*Index variables.
      * If AttributePathParams contains a wildcard field, it will set mBegin*Index to 0 and mEnd*Index to count.
@@ -130,6 +135,12 @@ private:
     void PrepareEndpointIndexRange(const AttributePathParams & aAttributePath);
     void PrepareClusterIndexRange(const AttributePathParams & aAttributePath, EndpointId aEndpointId);
     void PrepareAttributeIndexRange(const AttributePathParams & aAttributePath, EndpointId aEndpointId, ClusterId aClusterId);
+
+    /**
+     * Re-resolve the indices of the endpoint, cluster and attribute of the last emitted path if the metadata structure has
+     * changed since they were computed.
+     */
+    void RevalidateIndices();
 };
 } // namespace app
 } // namespace chip
@@ -68,24 +68,25 @@ CHIP_ERROR ClusterStateCache::UpdateCache(const ConcreteDataAttributePath & aPat
                                           const StatusIB & aStatus)
 {
     AttributeState state;
-    bool endpointIsNew = false;
 
-    if (mCache.find(aPath.mEndpointId) == mCache.end())
-    {
-        //
-        // Since we might potentially be creating a new entry at mCache[aPath.mEndpointId][aPath.mClusterId] that
-        // wasn't there before, we need to check if an entry didn't exist there previously and remember that so that
-        // we can appropriately notify our clients of the addition of a new endpoint.
-        //
-        endpointIsNew = true;
-    }
+    //
+    // Since we might potentially be creating a new entry for aPath.mEndpointId that wasn't there before, we need to
+    // check if an entry didn't exist there previously and remember that so that we can appropriately notify our
+    // clients of the addition of a new endpoint.
+    //
+    bool endpointIsNew = !HasEndpoint(aPath.mEndpointId);
 
     if (apData)
     {
         size_t elementSize = 0;
         ReturnErrorOnFailure(GetElementTLVSize(apData, elementSize));
 
-        if (mCacheData)
+        if (mStorageMode == StorageMode::kFlat)
+        {
+            ReturnErrorOnFailure(mCacheData ? mFlatStore.SetData(aPath, *apData, elementSize)
+                                            : mFlatStore.SetSize(aPath, elementSize));
+        }
+        else if (mCacheData)
         {
             Platform::ScopedMemoryBufferWithSize<uint8_t> backingBuffer;
             backingBuffer.Calloc(elementSize);
@@ -104,7 +105,9 @@ CHIP_ERROR ClusterStateCache::UpdateCache(const ConcreteDataAttributePath & aPat
         // Clear out the committed data version and only set it again once we have received all data for this cluster.
         // Otherwise, we may have incomplete data that looks like it's complete since it has a valid data version.
         //
-        mCache[aPath.mEndpointId][aPath.mClusterId].mCommittedDataVersion.ClearValue();
+        ClusterVersions * versions = GetClusterVersions(aPath);
+        VerifyOrReturnError(versions != nullptr, CHIP_ERROR_INCORRECT_STATE);
+        versions->mCommittedDataVersion.ClearValue();
 
         // This commits a pending data version if the last report path is valid and it is different from the current path.
         if (mLastReportDataPath.IsValidConcreteClusterPath() && mLastReportDataPath != aPath)
@@ -125,11 +128,17 @@ CHIP_ERROR ClusterStateCache::UpdateCache(const ConcreteDataAttributePath & aPat
         // if this data item is encompassed by a wildcard path, let's go ahead and update its pending data version.
         if (foundEncompassingWildcardPath)
         {
-            mCache[aPath.mEndpointId][aPath.mClusterId].mPendingDataVersion = aPath.mDataVersion;
+            // Committing the previous cluster's version does not add any cluster, so versions is still valid.
+            versions->mPendingDataVersion = aPath.mDataVersion;
         }
 
         mLastReportDataPath = aPath;
     }
+    else if (mStorageMode == StorageMode::kFlat)
+    {
+        ReturnErrorOnFailure(mCacheData ? mFlatStore.SetStatus(aPath, aStatus)
+                                        : mFlatStore.SetSize(aPath, SizeOfStatusIB(aStatus)));
+    }
     else
     {
         if (mCacheData)
@@ -151,7 +160,10 @@ CHIP_ERROR ClusterStateCache::UpdateCache(const ConcreteDataAttributePath & aPat
         mAddedEndpoints.push_back(aPath.mEndpointId);
     }
 
-    mCache[aPath.mEndpointId][aPath.mClusterId].mAttributes[aPath.mAttributeId] = std::move(state);
+    if (mStorageMode != StorageMode::kFlat)
+    {
+        mCache[aPath.mEndpointId][aPath.mClusterId].mAttributes[aPath.mAttributeId] = std::move(state);
+    }
 
     if (mCacheData)
     {
@@ -213,6 +225,11 @@ void ClusterStateCache::OnReportBegin()
     mLastReportDataPath = ConcreteClusterPath(kInvalidEndpointId, kInvalidClusterId);
     mChangedAttributeSet.clear();
     mAddedEndpoints.clear();
+    if (mStorageMode == StorageMode::kFlat)
+    {
+        // Nothing obtained from the cache may be held across reports, so this is when values can move.
+        mFlatStore.Compact();
+    }
     mCallback.OnReportBegin();
 }
 
@@ -223,11 +240,11 @@ void ClusterStateCache::CommitPendingDataVersion()
         return;
     }
 
-    auto & lastClusterInfo = mCache[mLastReportDataPath.mEndpointId][mLastReportDataPath.mClusterId];
-    if (lastClusterInfo.mPendingDataVersion.HasValue())
+    ClusterVersions * lastClusterInfo = GetClusterVersions(mLastReportDataPath);
+    if (lastClusterInfo != nullptr && lastClusterInfo->mPendingDataVersion.HasValue())
     {
-        lastClusterInfo.mCommittedDataVersion = lastClusterInfo.mPendingDataVersion;
-        lastClusterInfo.mPendingDataVersion.ClearValue();
+        lastClusterInfo->mCommittedDataVersion = lastClusterInfo->mPendingDataVersion;
+        lastClusterInfo->mPendingDataVersion.ClearValue();
     }
 }
 
@@ -262,6 +279,17 @@ void ClusterStateCache::OnReportEnd()
 
 CHIP_ERROR ClusterStateCache::Get(const ConcreteAttributePath & path, TLV::TLVReader & reader) const
 {
+    if (mStorageMode == StorageMode::kFlat)
+    {
+        auto attribute = mFlatStore.FindAttribute(path);
+        VerifyOrReturnError(attribute != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+        VerifyOrReturnError(!attribute->IsStatus(), CHIP_ERROR_IM_STATUS_CODE_RECEIVED);
+        VerifyOrReturnError(attribute->IsData(), CHIP_ERROR_KEY_NOT_FOUND);
+
+        reader.Init(attribute->GetData());
+        return reader.Next();
+    }
+
     CHIP_ERROR err;
     auto attributeState = GetAttributeState(path.mEndpointId, path.mClusterId, path.mAttributeId, err);
     ReturnErrorOnFailure(err);
@@ -295,6 +323,35 @@ CHIP_ERROR ClusterStateCache::Get(EventNumber eventNumber, TLV::TLVReader & read
     return CHIP_NO_ERROR;
 }
 
+bool ClusterStateCache::HasEndpoint(EndpointId endpointId) const
+{
+    if (mStorageMode == StorageMode::kFlat)
+    {
+        return mFlatStore.HasEndpoint(endpointId);
+    }
+    return mCache.find(endpointId) != mCache.end();
+}
+
+ClusterStateCache::ClusterVersions * ClusterStateCache::GetClusterVersions(const ConcreteClusterPath & path)
+{
+    if (mStorageMode == StorageMode::kFlat)
+    {
+        return mFlatStore.FindCluster(path.mEndpointId, path.mClusterId);
+    }
+    return &mCache[path.mEndpointId][path.mClusterId];
+}
+
+const ClusterStateCache::ClusterVersions * ClusterStateCache::FindClusterVersions(const ConcreteClusterPath & path) const
+{
+    if (mStorageMode == StorageMode::kFlat)
+    {
+        return mFlatStore.FindCluster(path.mEndpointId, path.mClusterId);
+    }
+
+    CHIP_ERROR err;
+    return GetClusterState(path.mEndpointId, path.mClusterId, err);
+}
+
 const ClusterStateCache::EndpointState * ClusterStateCache::GetEndpointState(EndpointId endpointId, CHIP_ERROR & err) const
 {
     auto endpointIter = mCache.find(endpointId);
@@ -397,10 +454,9 @@ void ClusterStateCache::OnAttributeData(const ConcreteDataAttributePath & aPath,
 CHIP_ERROR ClusterStateCache::GetVersion(const ConcreteClusterPath & aPath, Optional<DataVersion> & aVersion) const
 {
     VerifyOrReturnError(aPath.IsValidConcreteClusterPath(), CHIP_ERROR_INVALID_ARGUMENT);
-    CHIP_ERROR err;
-    auto clusterState = GetClusterState(aPath.mEndpointId, aPath.mClusterId, err);
-    ReturnErrorOnFailure(err);
-    aVersion = clusterState->mCommittedDataVersion;
+    auto versions = FindClusterVersions(aPath);
+    VerifyOrReturnError(versions != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+    aVersion = versions->mCommittedDataVersion;
     return CHIP_NO_ERROR;
 }
 
@@ -420,6 +476,16 @@ void ClusterStateCache::OnEventData(const EventHeader & aEventHeader, TLV::TLVRe
 
 CHIP_ERROR ClusterStateCache::GetStatus(const ConcreteAttributePath & path, StatusIB & status) const
 {
+    if (mStorageMode == StorageMode::kFlat)
+    {
+        auto attribute = mFlatStore.FindAttribute(path);
+        VerifyOrReturnError(attribute != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+        VerifyOrReturnError(attribute->IsStatus(), CHIP_ERROR_INVALID_ARGUMENT);
+
+        status = attribute->GetStatus();
+        return CHIP_NO_ERROR;
+    }
+
     CHIP_ERROR err;
 
     auto attributeState = GetAttributeState(path.mEndpointId, path.mClusterId, path.mAttributeId, err);
@@ -448,6 +514,29 @@ CHIP_ERROR ClusterStateCache::GetStatus(const ConcreteEventPath & path, StatusIB
 
 void ClusterStateCache::GetSortedFilters(std::vector<std::pair<DataVersionFilter, size_t>> & aVector) const
 {
+    if (mStorageMode == StorageMode::kFlat)
+    {
+        mFlatStore.ForEachCluster([this, &aVector](EndpointId endpointId, ClusterId clusterId, const ClusterVersions & versions) {
+            VerifyOrReturnError(versions.mCommittedDataVersion.HasValue(), CHIP_NO_ERROR);
+
+            size_t clusterSize = 0;
+            mFlatStore.ForEachAttribute(endpointId, clusterId,
+                                        [&clusterSize](AttributeId, const FlatAttributeStore::Attribute & attribute) {
+                                            clusterSize += attribute.IsStatus() ? SizeOfStatusIB(attribute.GetStatus())
+                                                                                : attribute.GetSize();
+                                            return CHIP_NO_ERROR;
+                                        });
+
+            // No data in this cluster, so no point in sending a dataVersion along at all.
+            VerifyOrReturnError(clusterSize != 0, CHIP_NO_ERROR);
+
+            DataVersionFilter filter(endpointId, clusterId, versions.mCommittedDataVersion.Value());
+            aVector.push_back(std::make_pair(filter, clusterSize));
+            return CHIP_NO_ERROR;
+        });
+    }
+
+    // In flat storage mode, mCache is empty.
     for (auto const & endpointIter : mCache)
     {
         EndpointId endpointId = endpointIter.first;
@@ -24,6 +24,7 @@
 #include <app/AppConfig.h>
 #include <app/AttributePathParams.h>
 #include <app/BufferedReadCallback.h>
+#include <app/FlatAttributeStore.h>
 #include <app/ReadClient.h>
 #include <app/data-model/DecodableList.h>
 #include <app/data-model/Decode.h>
@@ -96,6 +97,19 @@ public:
         virtual void OnEndpointAdded(ClusterStateCache * cache, EndpointId endpointId){};
     };
 
+    /*
+     * How attribute states are stored.
+     */
+    enum class StorageMode : uint8_t
+    {
+        // Maps of endpoints, clusters and attributes, with a separate allocation for each attribute value.
+        kNested,
+        // A FlatAttributeStore: hash tables keyed by the packed ids and a single arena for the attribute values, for
+        // caches holding many attributes.  The buffers backing values obtained from the cache only remain valid until
+        // the next report begins, even if the value is not updated by that report.
+        kFlat,
+    };
+
     /**
      *
      * @param [in] callback the derived callback which inherit from ReadClient::Callback
@@ -103,11 +117,12 @@ public:
      *             less than or equal to this value, skip those events
      * @param [in] cacheData boolean to decide whether this cache would store attribute/event data/status,
      *             the default is true.
+     * @param [in] storageMode how to store attribute states, the default is StorageMode::kNested.
      */
     ClusterStateCache(Callback & callback, Optional<EventNumber> highestReceivedEventNumber = Optional<EventNumber>::Missing(),
-                      bool cacheData = true) :
+                      bool cacheData = true, StorageMode storageMode = StorageMode::kNested) :
         mCallback(callback),
-        mBufferedReader(*this), mCacheData(cacheData)
+        mBufferedReader(*this), mCacheData(cacheData), mStorageMode(storageMode)
     {
         mHighestReceivedEventNumber = highestReceivedEventNumber;
     }
@@ -366,6 +381,14 @@ public:
     template <typename IteratorFunc>
     CHIP_ERROR ForEachAttribute(EndpointId endpointId, ClusterId clusterId, IteratorFunc func) const
     {
+        if (mStorageMode == StorageMode::kFlat)
+        {
+            return mFlatStore.ForEachAttribute(endpointId, clusterId,
+                                               [&func, endpointId, clusterId](AttributeId attributeId, const auto &) {
+                                                   return func(ConcreteAttributePath(endpointId, clusterId, attributeId));
+                                               });
+        }
+
         CHIP_ERROR err;
 
         auto clusterState = GetClusterState(endpointId, clusterId, err);
@@ -396,6 +419,17 @@ public:
     template <typename IteratorFunc>
     CHIP_ERROR ForEachAttribute(ClusterId clusterId, IteratorFunc func) const
     {
+        if (mStorageMode == StorageMode::kFlat)
+        {
+            return mFlatStore.ForEachCluster([this, &func, clusterId](EndpointId endpointId, ClusterId id, const auto &) {
+                VerifyOrReturnError(id == clusterId, CHIP_NO_ERROR);
+                return mFlatStore.ForEachAttribute(
+                    endpointId, clusterId, [&func, endpointId, clusterId](AttributeId attributeId, const auto &) {
+                        return func(ConcreteAttributePath(endpointId, clusterId, attributeId));
+                    });
+            });
+        }
+
         for (auto & endpointIter : mCache)
         {
             for (auto & clusterIter : endpointIter.second)
@@ -429,8 +463,16 @@ public:
     template <typename IteratorFunc>
     CHIP_ERROR ForEachCluster(EndpointId endpointId, IteratorFunc func) const
     {
+        if (mStorageMode == StorageMode::kFlat)
+        {
+            return mFlatStore.ForEachCluster([&func, endpointId](EndpointId id, ClusterId clusterId, const auto &) {
+                VerifyOrReturnError(id == endpointId, CHIP_NO_ERROR);
+                return func(clusterId);
+            });
+        }
+
         auto endpointIter = mCache.find(endpointId);
-        if (endpointIter->first == endpointId)
+        if (endpointIter != mCache.end())
         {
             for (auto & clusterIter : endpointIter->second)
             {
@@ -541,11 +583,10 @@ private:
     // mCurrentDataVersion represents a known data version for a cluster.  In order for this to have a
     // value the cluster must be included in a path in mRequestPathSet that has a wildcard attribute
     // and we must not be in the middle of receiving reports for that cluster.
-    struct ClusterState
+    using ClusterVersions = FlatAttributeStore::ClusterVersions;
+    struct ClusterState : public ClusterVersions
     {
         std::map<AttributeId, AttributeState> mAttributes;
-        Optional<DataVersion> mPendingDataVersion;
-        Optional<DataVersion> mCommittedDataVersion;
     };
     using EndpointState = std::map<ClusterId, ClusterState>;
     using NodeState     = std::map<EndpointId, EndpointState>;
@@ -591,6 +632,12 @@ private:
 
     const EventData * GetEventData(EventNumber number, CHIP_ERROR & err) const;
 
+    // Storage mode independent accessors.  In flat storage mode, a cluster only exists once one of its attributes has
+    // been stored, so GetClusterVersions can return nullptr.
+    bool HasEndpoint(EndpointId endpointId) const;
+    ClusterVersions * GetClusterVersions(const ConcreteClusterPath & path);
+    const ClusterVersions * FindClusterVersions(const ConcreteClusterPath & path) const;
+
     /*
      * Updates the state of an attribute in the cache given a reader. If the reader is null, the state is updated
      * with the provided status.
@@ -663,6 +710,7 @@ private:
 
     Callback & mCallback;
     NodeState mCache;
+    FlatAttributeStore mFlatStore;
     std::set<ConcreteAttributePath> mChangedAttributeSet;
     std::set<AttributePathParams, Comparator> mRequestPathSet; // wildcard attribute request path only
     std::vector<EndpointId> mAddedEndpoints;
@@ -673,6 +721,7 @@ private:
     BufferedReadCallback mBufferedReader;
     ConcreteClusterPath mLastReportDataPath = ConcreteClusterPath(kInvalidEndpointId, kInvalidClusterId);
     const bool mCacheData                   = true;
+    const StorageMode mStorageMode          = StorageMode::kNested;
 };
 
 };     // namespace app
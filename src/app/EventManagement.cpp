@@ -19,6 +19,7 @@
 #include <access/AccessControl.h>
 #include <access/RequestPath.h>
 #include <access/SubjectDescriptor.h>
+#include <algorithm>
 #include <app/EventManagement.h>
 #include <app/InteractionModelEngine.h>
 #include <app/RequiredPrivilege.h>
@@ -66,6 +67,8 @@ struct ReclaimEventCtx
 {
     CircularEventBuffer * mpEventBuffer = nullptr;
     size_t mSpaceNeededForMovedEvent    = 0;
+    EventNumber mEvictedEventNumber     = 0;
+    ClusterId mEvictedClusterId         = 0;
 };
 
 /**
@@ -88,6 +91,7 @@ void EventManagement::Init(Messaging::ExchangeManager * apExchangeManager, uint3
     CircularEventBuffer * current = nullptr;
     CircularEventBuffer * prev    = nullptr;
     CircularEventBuffer * next    = nullptr;
+    bool restoreEvents            = false;
 
     if (aNumBuffers == 0)
     {
@@ -110,6 +114,9 @@ void EventManagement::Init(Messaging::ExchangeManager * apExchangeManager, uint3
         current->Init(apLogStorageResources[bufferIndex].mpBuffer, apLogStorageResources[bufferIndex].mBufferSize, prev, next,
                       apLogStorageResources[bufferIndex].mPriority);
 
+        current->SetPersistentState(apLogStorageResources[bufferIndex].mpPersistentState);
+        restoreEvents = restoreEvents || (current->DataLength() != 0);
+
         prev = current;
 
         current->mProcessEvictedElement = nullptr;
@@ -124,6 +131,86 @@ void EventManagement::Init(Messaging::ExchangeManager * apExchangeManager, uint3
     mBytesWritten = 0;
 
     mMonotonicStartupTime = aMonotonicStartupTime;
+
+    if (restoreEvents)
+    {
+        RestoreEvents();
+    }
+}
+
+void EventManagement::RestoreEvents()
+{
+    EventNumber newestEventNumber = 0;
+    bool hasEvents                = false;
+
+    // Walk the buffers from the oldest to the newest event.  Moving an event to the next buffer first copies it and then evicts
+    // it, so an interrupted move leaves the event at the head of both buffers.  Drop these duplicates, and anything following an
+    // event that cannot be parsed or is out of order, which can only be the result of an interrupted write.
+    for (auto * buffer = GetPriorityBuffer(PriorityLevel::Critical); buffer != nullptr;
+         buffer        = buffer->GetPreviousCircularEventBuffer())
+    {
+        uint32_t validLength        = 0;
+        uint32_t duplicateLength    = 0;
+        EventNumber lastEventNumber = newestEventNumber;
+        CircularTLVReader reader;
+
+        reader.Init(*buffer);
+        while (reader.Next() == CHIP_NO_ERROR)
+        {
+            EventEnvelopeContext event;
+            if (ReadEventEnvelope(reader, event) != CHIP_NO_ERROR || reader.Skip() != CHIP_NO_ERROR)
+            {
+                break;
+            }
+
+            if (hasEvents && event.mEventNumber <= newestEventNumber && validLength == duplicateLength)
+            {
+                duplicateLength = reader.GetLengthRead();
+            }
+            else if ((hasEvents || validLength != 0) && event.mEventNumber <= lastEventNumber)
+            {
+                break;
+            }
+            lastEventNumber = event.mEventNumber;
+            validLength     = reader.GetLengthRead();
+        }
+
+        if (validLength != buffer->DataLength() || duplicateLength != 0)
+        {
+            ChipLogError(EventLogging, "Dropping %u bytes of incomplete or duplicated events with priority %u",
+                         static_cast<unsigned>(buffer->DataLength() - validLength + duplicateLength),
+                         static_cast<unsigned>(buffer->GetPriority()));
+            const uint32_t headOffset = static_cast<uint32_t>(buffer->QueueHead() - buffer->GetQueue());
+            buffer->ResetState((headOffset + duplicateLength) % buffer->GetTotalDataLength(), validLength - duplicateLength);
+            buffer->SaveState();
+        }
+
+        reader.Init(*buffer);
+        for (uint32_t offset = 0; reader.Next() == CHIP_NO_ERROR; offset = reader.GetLengthRead())
+        {
+            EventEnvelopeContext event;
+            VerifyOrDie(ReadEventEnvelope(reader, event) == CHIP_NO_ERROR && reader.Skip() == CHIP_NO_ERROR);
+            const uint32_t headOffset = static_cast<uint32_t>(buffer->QueueHead() - buffer->GetQueue());
+            buffer->RecordEvent(event.mEventNumber, event.mClusterId,
+                                buffer->GetQueue() + (headOffset + offset) % buffer->GetTotalDataLength());
+            newestEventNumber = event.mEventNumber;
+            hasEvents         = true;
+        }
+    }
+
+    // Event numbers must keep increasing across restarts.  Events numbered from the current value of the counter on were logged
+    // before the counter was reset, e.g. by a factory reset, so forget about all of them.
+    if (hasEvents && newestEventNumber >= mpEventNumberCounter->GetValue())
+    {
+        ChipLogError(EventLogging, "Dropping recovered events: event number 0x" ChipLogFormatX64 " is ahead of the counter",
+                     ChipLogValueX64(newestEventNumber));
+        for (auto * buffer = GetPriorityBuffer(PriorityLevel::Critical); buffer != nullptr;
+             buffer        = buffer->GetPreviousCircularEventBuffer())
+        {
+            buffer->ResetState(0, 0);
+            buffer->SaveState();
+        }
+    }
 }
 
 CHIP_ERROR EventManagement::CopyToNextBuffer(CircularEventBuffer * apEventBuffer)
@@ -200,6 +287,10 @@ CHIP_ERROR EventManagement::EnsureSpaceInCircularBuffer(size_t aRequiredSpace, P
             eventBuffer->mProcessEvictedElement = EvictEvent;
             eventBuffer->mAppData               = &ctx;
             err                                 = eventBuffer->EvictHead();
+            if (err == CHIP_NO_ERROR)
+            {
+                eventBuffer->SaveState();
+            }
 
             // one of two things happened: either the element was evicted immediately if the head's priority is same as current
             // buffer(final one), or we figured out how much space we need to evict it into the next buffer, the check happens in
@@ -217,8 +308,12 @@ CHIP_ERROR EventManagement::EnsureSpaceInCircularBuffer(size_t aRequiredSpace, P
                     // Since we're calling CopyElement and we've checked
                     // that there is space in the next buffer, we don't expect
                     // this to fail.
-                    err = CopyToNextBuffer(eventBuffer);
+                    CircularEventBuffer * nextBuffer = eventBuffer->GetNextCircularEventBuffer();
+                    const uint8_t * movedEventStart  = nextBuffer->QueueTail();
+                    err                              = CopyToNextBuffer(eventBuffer);
                     SuccessOrExit(err);
+                    nextBuffer->RecordEvent(ctx.mEvictedEventNumber, ctx.mEvictedClusterId, movedEventStart);
+                    nextBuffer->SaveState();
                     // success; evict head unconditionally
                     eventBuffer->mProcessEvictedElement = nullptr;
                     err                                 = eventBuffer->EvictHead();
@@ -228,6 +323,8 @@ CHIP_ERROR EventManagement::EnsureSpaceInCircularBuffer(size_t aRequiredSpace, P
                     // caller know that we could not honor the
                     // request
                     SuccessOrExit(err);
+                    eventBuffer->ForgetEventsUpTo(ctx.mEvictedEventNumber);
+                    eventBuffer->SaveState();
                     continue;
                 }
                 // we cannot copy event outright. We remember the
@@ -353,9 +450,10 @@ void EventManagement::CreateEventManagement(Messaging::ExchangeManager * apExcha
  */
 void EventManagement::DestroyEventManagement()
 {
-    sInstance.mState        = EventManagementStates::Shutdown;
-    sInstance.mpEventBuffer = nullptr;
-    sInstance.mpExchangeMgr = nullptr;
+    sInstance.mState            = EventManagementStates::Shutdown;
+    sInstance.mpEventBuffer     = nullptr;
+    sInstance.mpExchangeMgr     = nullptr;
+    sInstance.mpStorageDelegate = nullptr;
 }
 
 CircularEventBuffer * EventManagement::GetPriorityBuffer(PriorityLevel aPriority) const
@@ -380,14 +478,17 @@ CHIP_ERROR EventManagement::CopyAndAdjustDeltaTime(const TLVReader & aReader, si
         // Does not go on the wire.
         return CHIP_NO_ERROR;
     }
-    if ((aReader.GetTag() == TLV::ContextTag(EventDataIB::Tag::kSystemTimestamp)) && !(ctx->mpContext->mFirst) &&
-        (ctx->mpContext->mCurrentTime.mType == ctx->mpContext->mPreviousTime.mType))
+    // Events recovered from persistent storage may have been logged with a system time from before a restart, so only
+    // encode the timestamp as a delta when it does not go back in time.
+    const bool canUseDeltaTime = !(ctx->mpContext->mFirst) &&
+        (ctx->mpContext->mCurrentTime.mType == ctx->mpContext->mPreviousTime.mType) &&
+        (ctx->mpContext->mCurrentTime.mValue >= ctx->mpContext->mPreviousTime.mValue);
+    if ((aReader.GetTag() == TLV::ContextTag(EventDataIB::Tag::kSystemTimestamp)) && canUseDeltaTime)
     {
         return ctx->mpWriter->Put(TLV::ContextTag(EventDataIB::Tag::kDeltaSystemTimestamp),
                                   ctx->mpContext->mCurrentTime.mValue - ctx->mpContext->mPreviousTime.mValue);
     }
-    if ((aReader.GetTag() == TLV::ContextTag(EventDataIB::Tag::kEpochTimestamp)) && !(ctx->mpContext->mFirst) &&
-        (ctx->mpContext->mCurrentTime.mType == ctx->mpContext->mPreviousTime.mType))
+    if ((aReader.GetTag() == TLV::ContextTag(EventDataIB::Tag::kEpochTimestamp)) && canUseDeltaTime)
     {
         return ctx->mpWriter->Put(TLV::ContextTag(EventDataIB::Tag::kDeltaEpochTimestamp),
                                   ctx->mpContext->mCurrentTime.mValue - ctx->mpContext->mPreviousTime.mValue);
@@ -427,6 +528,7 @@ CHIP_ERROR EventManagement::LogEventPrivate(EventLoggingDelegate * apDelegate, c
     CircularTLVWriter checkpoint = writer;
     EventLoadOutContext ctxt     = EventLoadOutContext(writer, aEventOptions.mPriority, mLastEventNumber);
     EventOptions opts;
+    const uint8_t * eventStart = nullptr;
 
     Timestamp timestamp;
 #if CHIP_DEVICE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
@@ -464,10 +566,17 @@ CHIP_ERROR EventManagement::LogEventPrivate(EventLoggingDelegate * apDelegate, c
     err = EnsureSpaceInCircularBuffer(requestSize, aEventOptions.mPriority);
     SuccessOrExit(err);
 
-    err = ConstructEvent(&ctxt, apDelegate, &opts);
+    eventStart = mpEventBuffer->QueueTail();
+    err        = ConstructEvent(&ctxt, apDelegate, &opts);
     SuccessOrExit(err);
 
     mBytesWritten += writer.GetLengthWritten();
+    mpEventBuffer->RecordEvent(ctxt.mCurrentEventNumber, opts.mPath.mClusterId, eventStart);
+    mpEventBuffer->SaveState();
+    if (mpStorageDelegate != nullptr)
+    {
+        mpStorageDelegate->OnEventStorageChanged();
+    }
 
 exit:
     if (err != CHIP_NO_ERROR)
@@ -648,17 +757,36 @@ CHIP_ERROR EventManagement::FetchEventsSince(TLVWriter & aWriter, const ObjectLi
     TLVReader reader;
     CircularEventBufferWrapper bufWrapper;
     EventLoadOutContext context(aWriter, PriorityLevel::Invalid, aEventMin);
+    uint32_t clusterFilter = 0;
+
+    for (auto * path = apEventPathList; path != nullptr; path = path->mpNext)
+    {
+        clusterFilter |=
+            path->mValue.HasWildcardClusterId() ? UINT32_MAX : CircularEventBuffer::ClusterFilterBit(path->mValue.mClusterId);
+    }
 
     context.mSubjectDescriptor     = aSubjectDescriptor;
     context.mpInterestedEventPaths = apEventPathList;
-    err                            = GetEventReader(reader, PriorityLevel::Critical, &bufWrapper);
-    SuccessOrExit(err);
-
-    err = TLV::Utilities::Iterate(reader, CopyEventsSince, &context, recurse);
+    err                            = SeekEventReader(reader, aEventMin, clusterFilter, &bufWrapper);
+    if (err == CHIP_NO_ERROR)
+    {
+        err = TLV::Utilities::Iterate(reader, CopyEventsSince, &context, recurse);
+    }
     if (err == CHIP_END_OF_TLV)
     {
         err = CHIP_NO_ERROR;
     }
+    SuccessOrExit(err);
+
+    // Every event has been looked at, including the ones the reader skipped: continue after the newest one.
+    for (auto * buffer = mpEventBuffer; buffer != nullptr; buffer = buffer->GetNextCircularEventBuffer())
+    {
+        if (buffer->DataLength() != 0)
+        {
+            context.mCurrentEventNumber = std::max(context.mCurrentEventNumber, buffer->GetLastEventNumber());
+            break;
+        }
+    }
 
 exit:
     if (err == CHIP_ERROR_BUFFER_TOO_SMALL || err == CHIP_ERROR_NO_MEMORY)
@@ -731,6 +859,10 @@ CHIP_ERROR EventManagement::FabricRemoved(FabricIndex aFabricIndex)
     {
         err = CHIP_NO_ERROR;
     }
+    if (mpStorageDelegate != nullptr)
+    {
+        mpStorageDelegate->OnEventStorageChanged();
+    }
     return err;
 }
 
@@ -747,6 +879,66 @@ CHIP_ERROR EventManagement::GetEventReader(TLVReader & aReader, PriorityLevel aP
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR EventManagement::SeekEventReader(TLVReader & aReader, EventNumber aEventMin, uint32_t aClusterFilter,
+                                            CircularEventBufferWrapper * apBufWrapper)
+{
+    CircularEventBuffer * buffer = GetPriorityBuffer(PriorityLevel::Critical);
+    VerifyOrReturnError(buffer != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    // Buffers are read from the most to the least important one, which is also from the oldest to the newest event, so every
+    // buffer before the first one that may hold a requested event can be skipped.
+    while (buffer != nullptr && !buffer->MayContainEvents(aEventMin, aClusterFilter))
+    {
+        buffer = buffer->GetPreviousCircularEventBuffer();
+    }
+    VerifyOrReturnError(buffer != nullptr, CHIP_END_OF_TLV);
+
+    EventNumber indexedNumber    = 0;
+    const uint8_t * readStart    = buffer->FindEventBefore(aEventMin, indexedNumber);
+    apBufWrapper->mpCurrent      = buffer;
+    apBufWrapper->mpReadStart    = readStart;
+    apBufWrapper->mClusterFilter = aClusterFilter;
+
+    CircularEventReader reader;
+    reader.Init(apBufWrapper);
+    aReader.Init(reader);
+
+    if (readStart != nullptr)
+    {
+        // The index is only a hint: make sure it points at the event it was recorded for, and read the whole buffer otherwise.
+        EventEnvelopeContext event;
+        TLVReader peekReader;
+        peekReader.Init(aReader);
+        if (peekReader.Next() != CHIP_NO_ERROR || ReadEventEnvelope(peekReader, event) != CHIP_NO_ERROR ||
+            event.mEventNumber != indexedNumber)
+        {
+            ChipLogError(EventLogging, "Stale event index entry for event 0x" ChipLogFormatX64, ChipLogValueX64(indexedNumber));
+            apBufWrapper->mpCurrent   = buffer;
+            apBufWrapper->mpReadStart = nullptr;
+            reader.Init(apBufWrapper);
+            aReader.Init(reader);
+        }
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR EventManagement::ReadEventEnvelope(const TLVReader & aReader, EventEnvelopeContext & aEvent)
+{
+    TLVReader reader;
+    TLVType containerType;
+    TLVType containerType1;
+
+    reader.Init(aReader);
+    ReturnErrorOnFailure(reader.EnterContainer(containerType));
+    ReturnErrorOnFailure(reader.Next());
+    ReturnErrorOnFailure(reader.EnterContainer(containerType1));
+    CHIP_ERROR err = TLV::Utilities::Iterate(reader, FetchEventParameters, &aEvent, false /*recurse*/);
+    VerifyOrReturnError(err == CHIP_NO_ERROR || err == CHIP_END_OF_TLV, err);
+    VerifyOrReturnError(aEvent.mFieldsToRead == kRequiredEventField, CHIP_ERROR_INVALID_ARGUMENT);
+    return CHIP_NO_ERROR;
+}
+
 CHIP_ERROR EventManagement::FetchEventParameters(const TLVReader & aReader, size_t, void * apContext)
 {
     EventEnvelopeContext * const envelope = static_cast<EventEnvelopeContext *>(apContext);
@@ -827,6 +1019,8 @@ CHIP_ERROR EventManagement::EvictEvent(TLVCircularBuffer & apBuffer, void * apAp
 
     ReclaimEventCtx * const ctx             = static_cast<ReclaimEventCtx *>(apAppData);
     CircularEventBuffer * const eventBuffer = ctx->mpEventBuffer;
+    ctx->mEvictedEventNumber                = context.mEventNumber;
+    ctx->mEvictedClusterId                  = context.mClusterId;
     if (eventBuffer->IsFinalDestinationForPriority(imp))
     {
         ChipLogProgress(EventLogging,
@@ -835,6 +1029,7 @@ CHIP_ERROR EventManagement::EvictEvent(TLVCircularBuffer & apBuffer, void * apAp
                         static_cast<unsigned>(eventBuffer->GetPriority()), ChipLogValueX64(context.mEventNumber),
                         static_cast<unsigned>(imp));
         ctx->mSpaceNeededForMovedEvent = 0;
+        eventBuffer->ForgetEventsUpTo(context.mEventNumber);
         return CHIP_NO_ERROR;
     }
 
@@ -853,9 +1048,105 @@ void CircularEventBuffer::Init(uint8_t * apBuffer, uint32_t aBufferLength, Circu
                                CircularEventBuffer * apNext, PriorityLevel aPriorityLevel)
 {
     TLVCircularBuffer::Init(apBuffer, aBufferLength);
-    mpPrev    = apPrev;
-    mpNext    = apNext;
-    mPriority = aPriorityLevel;
+    mpPrev            = apPrev;
+    mpNext            = apNext;
+    mPriority         = aPriorityLevel;
+    mEventIndexFirst  = 0;
+    mEventIndexCount  = 0;
+    mLastEventNumber  = 0;
+    mClusterFilter    = 0;
+    mpPersistentState = nullptr;
+}
+
+void CircularEventBuffer::SetPersistentState(PersistentEventBufferState * apState)
+{
+    mpPersistentState = apState;
+    VerifyOrReturn(mpPersistentState != nullptr);
+
+    if (mpPersistentState->mMagic == PersistentEventBufferState::kMagic &&
+        mpPersistentState->mBufferSize == GetTotalDataLength() && mpPersistentState->mHeadOffset < GetTotalDataLength() &&
+        mpPersistentState->mDataLength <= GetTotalDataLength())
+    {
+        SetQueueState(mpPersistentState->mHeadOffset, mpPersistentState->mDataLength);
+        return;
+    }
+
+    SaveState();
+}
+
+void CircularEventBuffer::SaveState()
+{
+    VerifyOrReturn(mpPersistentState != nullptr);
+    mpPersistentState->mMagic      = PersistentEventBufferState::kMagic;
+    mpPersistentState->mBufferSize = GetTotalDataLength();
+    mpPersistentState->mHeadOffset = static_cast<uint32_t>(QueueHead() - GetQueue());
+    mpPersistentState->mDataLength = DataLength();
+}
+
+void CircularEventBuffer::ResetState(uint32_t aHeadOffset, uint32_t aDataLength)
+{
+    SetQueueState(aHeadOffset, aDataLength);
+    mEventIndexFirst = 0;
+    mEventIndexCount = 0;
+    mLastEventNumber = 0;
+    mClusterFilter   = 0;
+}
+
+void CircularEventBuffer::RecordEvent(EventNumber aEventNumber, ClusterId aClusterId, const uint8_t * apEventStart)
+{
+    if (apEventStart == QueueHead())
+    {
+        // This is the only event in the buffer, forget about the previous ones.
+        mEventIndexCount = 0;
+        mClusterFilter   = 0;
+    }
+
+    mLastEventNumber = aEventNumber;
+    mClusterFilter |= ClusterFilterBit(aClusterId);
+
+    VerifyOrReturn(kEventIndexSize > 0);
+    if (mEventIndexCount == kEventIndexSize)
+    {
+        mEventIndexFirst = (mEventIndexFirst + 1) % kEventIndexCapacity;
+        mEventIndexCount--;
+    }
+    EventIndexEntry & entry = mEventIndex[(mEventIndexFirst + mEventIndexCount) % kEventIndexCapacity];
+    entry.mEventNumber      = aEventNumber;
+    entry.mOffset           = static_cast<uint32_t>(apEventStart - GetQueue());
+    mEventIndexCount++;
+}
+
+void CircularEventBuffer::ForgetEventsUpTo(EventNumber aEventNumber)
+{
+    while (mEventIndexCount > 0 && GetIndexEntry(0).mEventNumber <= aEventNumber)
+    {
+        mEventIndexFirst = (mEventIndexFirst + 1) % kEventIndexCapacity;
+        mEventIndexCount--;
+    }
+}
+
+const uint8_t * CircularEventBuffer::FindEventBefore(EventNumber aEventMin, EventNumber & aIndexedNumber) const
+{
+    // Binary search for the first entry with an event number of at least aEventMin.
+    uint32_t low  = 0;
+    uint32_t high = mEventIndexCount;
+    while (low < high)
+    {
+        uint32_t mid = low + (high - low) / 2;
+        if (GetIndexEntry(mid).mEventNumber < aEventMin)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    VerifyOrReturnValue(low > 0, nullptr);
+    const EventIndexEntry & entry = GetIndexEntry(low - 1);
+    aIndexedNumber                = entry.mEventNumber;
+    return GetQueue() + entry.mOffset;
 }
 
 bool CircularEventBuffer::IsFinalDestinationForPriority(PriorityLevel aPriority) const
@@ -895,12 +1186,30 @@ void CircularEventReader::Init(CircularEventBufferWrapper * apBufWrapper)
 CHIP_ERROR CircularEventBufferWrapper::GetNextBuffer(TLVReader & aReader, const uint8_t *& aBufStart, uint32_t & aBufLen)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
-    mpCurrent->GetNextBuffer(aReader, aBufStart, aBufLen);
+    if ((aBufStart == nullptr) && (mpReadStart != nullptr))
+    {
+        // Start in the middle of the buffer; the data either runs until the tail or wraps around the end of the storage.
+        const uint8_t * tail = mpCurrent->QueueTail();
+        const uint8_t * end  = mpCurrent->GetQueue() + mpCurrent->GetTotalDataLength();
+        aBufStart            = mpReadStart;
+        aBufLen              = static_cast<uint32_t>(((tail > mpReadStart) ? tail : end) - mpReadStart);
+        mpReadStart          = nullptr;
+    }
+    else
+    {
+        mpCurrent->GetNextBuffer(aReader, aBufStart, aBufLen);
+    }
     SuccessOrExit(err);
 
-    if ((aBufLen == 0) && (mpCurrent->GetPreviousCircularEventBuffer() != nullptr))
+    if (aBufLen == 0)
     {
-        mpCurrent = mpCurrent->GetPreviousCircularEventBuffer();
+        CircularEventBuffer * prev = mpCurrent->GetPreviousCircularEventBuffer();
+        while ((prev != nullptr) && !prev->MayContainEvents(0, mClusterFilter))
+        {
+            prev = prev->GetPreviousCircularEventBuffer();
+        }
+        VerifyOrExit(prev != nullptr, /* no more data */);
+        mpCurrent = prev;
         aBufStart = nullptr;
         err       = GetNextBuffer(aReader, aBufStart, aBufLen);
     }
@@ -76,6 +76,35 @@ inline constexpr size_t kMaxEventSizeReserve            = 512;
 constexpr uint16_t kRequiredEventField =
     (1 << to_underlying(EventDataIB::Tag::kPriority)) | (1 << to_underlying(EventDataIB::Tag::kPath));
 
+/**
+ * @brief
+ *   State of a CircularEventBuffer saved next to its storage.  When both
+ *   outlive the process (e.g. in a memory-mapped file), EventManagement::Init
+ *   uses it to recover the events that were logged before a restart.
+ */
+struct PersistentEventBufferState
+{
+    static constexpr uint32_t kMagic = 0x45564C31; ///< Identifies the layout of this structure
+
+    uint32_t mMagic;
+    uint32_t mBufferSize;
+    uint32_t mHeadOffset;
+    uint32_t mDataLength;
+};
+
+/**
+ * @brief
+ *   Notified whenever the content of the event buffers changes, e.g. to flush
+ *   them when they are kept in persistent storage.
+ */
+class EventStorageDelegate
+{
+public:
+    virtual ~EventStorageDelegate() = default;
+
+    virtual void OnEventStorageChanged() = 0;
+};
+
 /**
  * @brief
  *   Internal event buffer, built around the TLV::TLVCircularBuffer
@@ -128,9 +157,99 @@ public:
     void SetRequiredSpaceforEvicted(size_t aRequiredSpace) { mRequiredSpaceForEvicted = aRequiredSpace; }
     size_t GetRequiredSpaceforEvicted() const { return mRequiredSpaceForEvicted; }
 
+    /**
+     * @brief
+     *   Keep the state of the buffer in apState.  If apState holds a valid
+     *   state for this buffer, the buffer takes it over, otherwise the
+     *   buffer starts empty.  The events of a recovered buffer must be
+     *   recorded with RecordEvent before it is used.
+     */
+    void SetPersistentState(PersistentEventBufferState * apState);
+
+    /**
+     * @brief
+     *   Save the extent of the data in the buffer to its persistent state, if any.
+     */
+    void SaveState();
+
+    /**
+     * @brief
+     *   Set the extent of the data in the buffer and forget about recorded events.
+     */
+    void ResetState(uint32_t aHeadOffset, uint32_t aDataLength);
+
+    /**
+     * @brief
+     *   Record an event that has just been appended to this buffer in the
+     *   buffer's event index.  Must be called for every event stored in the
+     *   buffer, in order.
+     *
+     * @param[in] aEventNumber The event number of the stored event.
+     * @param[in] aClusterId   The cluster of the stored event.
+     * @param[in] apEventStart The location of the first byte of the stored event in the buffer.
+     */
+    void RecordEvent(EventNumber aEventNumber, ClusterId aClusterId, const uint8_t * apEventStart);
+
+    /**
+     * @brief
+     *   Drop index entries for events that are about to be evicted from the
+     *   head of this buffer.
+     */
+    void ForgetEventsUpTo(EventNumber aEventNumber);
+
+    /**
+     * @brief
+     *   Find the location of the last indexed event whose number is lower
+     *   than aEventMin.  Reading from that location skips only events older
+     *   than aEventMin.
+     *
+     * @param[in]  aEventMin       The lowest event number the reader is interested in.
+     * @param[out] aIndexedNumber  The event number of the event at the returned location.
+     *
+     * @return The location of the event, or nullptr if reading needs to start at the head of the buffer.
+     */
+    const uint8_t * FindEventBefore(EventNumber aEventMin, EventNumber & aIndexedNumber) const;
+
+    /**
+     * @brief
+     *   Whether the buffer may contain events with number aEventMin or higher
+     *   from the clusters set in aClusterFilter (see ClusterFilterBit).
+     */
+    bool MayContainEvents(EventNumber aEventMin, uint32_t aClusterFilter) const
+    {
+        return DataLength() != 0 && mLastEventNumber >= aEventMin && (mClusterFilter & aClusterFilter) != 0;
+    }
+
+    EventNumber GetLastEventNumber() const { return mLastEventNumber; }
+
+    /**
+     * @brief
+     *   The bit representing aClusterId in the per-buffer cluster filter.
+     *   Clusters may share bits, so the filter can only tell that a buffer
+     *   does not contain any event of a cluster.
+     */
+    static uint32_t ClusterFilterBit(ClusterId aClusterId)
+    {
+        return static_cast<uint32_t>(1) << ((static_cast<uint32_t>(aClusterId) * 2654435761u) >> 27);
+    }
+
     ~CircularEventBuffer() override = default;
 
 private:
+    struct EventIndexEntry
+    {
+        EventNumber mEventNumber;
+        uint32_t mOffset; ///< Offset of the event from the start of the underlying storage
+    };
+
+    static constexpr uint32_t kEventIndexSize     = CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE;
+    static constexpr uint32_t kEventIndexCapacity = kEventIndexSize > 0 ? kEventIndexSize : 1;
+
+    const EventIndexEntry & GetIndexEntry(uint32_t aIndex) const
+    {
+        return mEventIndex[(mEventIndexFirst + aIndex) % kEventIndexCapacity];
+    }
+
     CircularEventBuffer * mpPrev = nullptr; ///< A pointer CircularEventBuffer storing events less important events
     CircularEventBuffer * mpNext = nullptr; ///< A pointer CircularEventBuffer storing events more important events
 
@@ -139,6 +258,15 @@ private:
 
     size_t mRequiredSpaceForEvicted = 0; ///< Required space for previous buffer to evict event to new buffer
 
+    // Index of the most recently stored events, ordered by event number; the oldest entries are dropped when it is full.
+    EventIndexEntry mEventIndex[kEventIndexCapacity];
+    uint32_t mEventIndexFirst    = 0;
+    uint32_t mEventIndexCount    = 0;
+    EventNumber mLastEventNumber = 0; ///< Number of the newest event in the buffer, valid while the buffer is not empty
+    uint32_t mClusterFilter      = 0; ///< ClusterFilterBit of every cluster with an event in the buffer
+
+    PersistentEventBufferState * mpPersistentState = nullptr;
+
     CHIP_ERROR OnInit(TLV::TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override;
 };
 
@@ -156,6 +284,11 @@ public:
     CircularEventBufferWrapper() : TLVCircularBuffer(nullptr, 0), mpCurrent(nullptr){};
     CircularEventBuffer * mpCurrent;
 
+    // When set, reading starts at this location of mpCurrent instead of its head.
+    const uint8_t * mpReadStart = nullptr;
+    // Previous buffers without any event of these clusters (see CircularEventBuffer::ClusterFilterBit) are skipped.
+    uint32_t mClusterFilter = UINT32_MAX;
+
 private:
     CHIP_ERROR GetNextBuffer(chip::TLV::TLVReader & aReader, const uint8_t *& aBufStart, uint32_t & aBufLen) override;
 };
@@ -187,6 +320,9 @@ struct LogStorageResources
     uint32_t mBufferSize = 0; ///< The size, in bytes, of the `mBuffer`.
     PriorityLevel mPriority =
         PriorityLevel::Invalid; // Log priority level associated with the resources provided in this structure.
+    PersistentEventBufferState * mpPersistentState =
+        nullptr; // Optional.  Where the state of the buffer is kept when mpBuffer outlives the process, so that the events stored
+                 // in mpBuffer can be recovered by EventManagement::Init.
 };
 
 /**
@@ -387,6 +523,12 @@ public:
      */
     void SetScheduledEventInfo(EventNumber & aEventNumber, uint32_t & aInitialWrittenEventBytes) const;
 
+    /**
+     * @brief
+     *   Set the delegate notified when events are added to or removed from the buffers.
+     */
+    void SetStorageDelegate(EventStorageDelegate * apDelegate) { mpStorageDelegate = apDelegate; }
+
 private:
     /**
      * @brief
@@ -500,6 +642,18 @@ private:
      */
     static CHIP_ERROR FetchEventParameters(const TLV::TLVReader & aReader, size_t aDepth, void * apContext);
 
+    /**
+     * @brief Read the envelope of the event aReader is positioned on, without moving aReader.
+     */
+    static CHIP_ERROR ReadEventEnvelope(const TLV::TLVReader & aReader, EventEnvelopeContext & aEvent);
+
+    /**
+     * @brief
+     *   Rebuild the state of buffers recovered from persistent storage: drop
+     *   incomplete or duplicated events, and record the remaining ones.
+     */
+    void RestoreEvents();
+
     /**
      * @brief Internal iterator function used to scan and filter though event logs
      * First event gets a timestamp, subsequent ones get a delta T
@@ -545,6 +699,17 @@ private:
      */
     CircularEventBuffer * GetPriorityBuffer(PriorityLevel aPriority) const;
 
+    /**
+     * @brief
+     *   Like GetEventReader from the critical buffer, but the reader skips
+     *   buffers and indexed events that cannot contain events with number
+     *   aEventMin or higher from the clusters in aClusterFilter.
+     *
+     * @return CHIP_END_OF_TLV if no buffer may contain such events.
+     */
+    CHIP_ERROR SeekEventReader(TLV::TLVReader & aReader, EventNumber aEventMin, uint32_t aClusterFilter,
+                               CircularEventBufferWrapper * apBufWrapper);
+
     // EventBuffer for debug level,
     CircularEventBuffer * mpEventBuffer        = nullptr;
     Messaging::ExchangeManager * mpExchangeMgr = nullptr;
@@ -558,6 +723,8 @@ private:
     Timestamp mLastEventTimestamp;    ///< The timestamp of the last event in this buffer
 
     System::Clock::Milliseconds64 mMonotonicStartupTime;
+
+    EventStorageDelegate * mpStorageDelegate = nullptr;
 };
 } // namespace app
 } // namespace chip
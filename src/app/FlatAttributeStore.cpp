@@ -0,0 +1,381 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/FlatAttributeStore.h>
+
+#include <lib/core/TLVWriter.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/SafeInt.h>
+
+#include <algorithm>
+#include <string.h>
+
+namespace chip {
+namespace app {
+
+namespace {
+
+constexpr size_t kMinIndexSize   = 16;
+constexpr size_t kArenaChunkSize = 4096;
+
+size_t Mix(uint64_t value)
+{
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return static_cast<size_t>(value);
+}
+
+size_t HashAttribute(EndpointId aEndpointId, ClusterId aClusterId, AttributeId aAttributeId)
+{
+    // Cluster ids rarely have a vendor prefix, so the endpoint id mostly lands on zero bits.
+    return Mix(((static_cast<uint64_t>(aClusterId) << 32) | aAttributeId) ^ (static_cast<uint64_t>(aEndpointId) << 48));
+}
+
+size_t HashCluster(EndpointId aEndpointId, ClusterId aClusterId)
+{
+    return Mix((static_cast<uint64_t>(aEndpointId) << 32) | aClusterId);
+}
+
+} // namespace
+
+StatusIB FlatAttributeStore::Attribute::GetStatus() const
+{
+    StatusIB status(mStatus);
+    if (mHasClusterStatus)
+    {
+        status.mClusterStatus.SetValue(mClusterStatus);
+    }
+    return status;
+}
+
+FlatAttributeStore::~FlatAttributeStore()
+{
+    FreeChunks(mArena);
+}
+
+template <typename Matches>
+uint32_t FlatAttributeStore::FindInIndex(const std::vector<uint32_t> & aIndex, size_t aHash, Matches && aMatches)
+{
+    VerifyOrReturnValue(!aIndex.empty(), kNoEntry);
+
+    size_t mask = aIndex.size() - 1;
+    for (size_t slot = aHash & mask;; slot = (slot + 1) & mask)
+    {
+        uint32_t entry = aIndex[slot];
+        if (entry == kNoEntry || aMatches(entry))
+        {
+            return entry;
+        }
+    }
+}
+
+template <typename Hash>
+void FlatAttributeStore::AddToIndex(std::vector<uint32_t> & aIndex, uint32_t aEntry, Hash && aHash)
+{
+    size_t count = static_cast<size_t>(aEntry) + 1;
+    if (count * 2 <= aIndex.size())
+    {
+        PlaceInIndex(aIndex, aEntry, aHash(aEntry));
+        return;
+    }
+
+    aIndex.assign(std::max(kMinIndexSize, aIndex.size() * 2), kNoEntry);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        PlaceInIndex(aIndex, i, aHash(i));
+    }
+}
+
+void FlatAttributeStore::PlaceInIndex(std::vector<uint32_t> & aIndex, uint32_t aEntry, size_t aHash)
+{
+    size_t mask = aIndex.size() - 1;
+    size_t slot = aHash & mask;
+    while (aIndex[slot] != kNoEntry)
+    {
+        slot = (slot + 1) & mask;
+    }
+    aIndex[slot] = aEntry;
+}
+
+uint32_t FlatAttributeStore::FindClusterIndex(EndpointId aEndpointId, ClusterId aClusterId) const
+{
+    return FindInIndex(mClusterIndex, HashCluster(aEndpointId, aClusterId), [&](uint32_t i) {
+        return mClusters[i].mEndpointId == aEndpointId && mClusters[i].mClusterId == aClusterId;
+    });
+}
+
+uint32_t FlatAttributeStore::AddCluster(EndpointId aEndpointId, ClusterId aClusterId)
+{
+    uint32_t index = static_cast<uint32_t>(mClusters.size());
+
+    Cluster cluster;
+    cluster.mEndpointId     = aEndpointId;
+    cluster.mClusterId      = aClusterId;
+    cluster.mFirstAttribute = kNoEntry;
+    mClusters.push_back(cluster);
+    AddToIndex(mClusterIndex, index,
+               [this](uint32_t i) { return HashCluster(mClusters[i].mEndpointId, mClusters[i].mClusterId); });
+
+    auto endpoint = std::lower_bound(mEndpoints.begin(), mEndpoints.end(), aEndpointId);
+    if (endpoint == mEndpoints.end() || *endpoint != aEndpointId)
+    {
+        mEndpoints.insert(endpoint, aEndpointId);
+    }
+    return index;
+}
+
+CHIP_ERROR FlatAttributeStore::FindOrAddAttribute(const ConcreteAttributePath & aPath, Attribute *& aAttribute)
+{
+    size_t hash    = HashAttribute(aPath.mEndpointId, aPath.mClusterId, aPath.mAttributeId);
+    uint32_t index = FindInIndex(mAttributeIndex, hash, [&](uint32_t i) {
+        return mAttributes[i].mEndpointId == aPath.mEndpointId && mAttributes[i].mClusterId == aPath.mClusterId &&
+            mAttributes[i].mAttributeId == aPath.mAttributeId;
+    });
+    if (index != kNoEntry)
+    {
+        aAttribute = &mAttributes[index];
+        return CHIP_NO_ERROR;
+    }
+
+    VerifyOrReturnError(mAttributes.size() < kNoEntry, CHIP_ERROR_NO_MEMORY);
+    index = static_cast<uint32_t>(mAttributes.size());
+
+    uint32_t cluster = FindClusterIndex(aPath.mEndpointId, aPath.mClusterId);
+    if (cluster == kNoEntry)
+    {
+        VerifyOrReturnError(mClusters.size() < kNoEntry, CHIP_ERROR_NO_MEMORY);
+        cluster = AddCluster(aPath.mEndpointId, aPath.mClusterId);
+    }
+
+    Attribute attribute;
+    attribute.mEndpointId       = aPath.mEndpointId;
+    attribute.mType             = Attribute::Type::kSize;
+    attribute.mStatus           = Protocols::InteractionModel::Status::Success;
+    attribute.mClusterStatus    = 0;
+    attribute.mHasClusterStatus = false;
+    attribute.mClusterId        = aPath.mClusterId;
+    attribute.mAttributeId      = aPath.mAttributeId;
+    attribute.mNextInCluster    = mClusters[cluster].mFirstAttribute;
+    attribute.mSize             = 0;
+    attribute.mData             = nullptr;
+    mAttributes.push_back(attribute);
+    mClusters[cluster].mFirstAttribute = index;
+    AddToIndex(mAttributeIndex, index, [this](uint32_t i) {
+        return HashAttribute(mAttributes[i].mEndpointId, mAttributes[i].mClusterId, mAttributes[i].mAttributeId);
+    });
+
+    aAttribute = &mAttributes[index];
+    return CHIP_NO_ERROR;
+}
+
+void FlatAttributeStore::ReleaseData(Attribute & aAttribute)
+{
+    if (aAttribute.IsData())
+    {
+        mLiveDataSize -= aAttribute.mSize;
+        mGarbageSize += aAttribute.mSize;
+    }
+    aAttribute.mData = nullptr;
+}
+
+CHIP_ERROR FlatAttributeStore::SetData(const ConcreteAttributePath & aPath, TLV::TLVReader & aData, size_t aElementSize)
+{
+    VerifyOrReturnError(CanCastTo<uint32_t>(aElementSize), CHIP_ERROR_INVALID_ARGUMENT);
+
+    uint8_t * data = AllocateArenaSpace(aElementSize);
+    VerifyOrReturnError(data != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    TLV::TLVWriter writer;
+    writer.Init(data, aElementSize);
+    CHIP_ERROR err = writer.CopyElement(TLV::AnonymousTag(), aData);
+    if (err == CHIP_NO_ERROR)
+    {
+        err = writer.Finalize();
+    }
+
+    Attribute * attribute = nullptr;
+    if (err == CHIP_NO_ERROR)
+    {
+        err = FindOrAddAttribute(aPath, attribute);
+    }
+    if (err != CHIP_NO_ERROR)
+    {
+        mGarbageSize += aElementSize;
+        return err;
+    }
+
+    ReleaseData(*attribute);
+    attribute->mType = Attribute::Type::kData;
+    attribute->mSize = static_cast<uint32_t>(aElementSize);
+    attribute->mData = data;
+    mLiveDataSize += aElementSize;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR FlatAttributeStore::SetSize(const ConcreteAttributePath & aPath, size_t aSize)
+{
+    VerifyOrReturnError(CanCastTo<uint32_t>(aSize), CHIP_ERROR_INVALID_ARGUMENT);
+
+    Attribute * attribute = nullptr;
+    ReturnErrorOnFailure(FindOrAddAttribute(aPath, attribute));
+
+    ReleaseData(*attribute);
+    attribute->mType = Attribute::Type::kSize;
+    attribute->mSize = static_cast<uint32_t>(aSize);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR FlatAttributeStore::SetStatus(const ConcreteAttributePath & aPath, const StatusIB & aStatus)
+{
+    Attribute * attribute = nullptr;
+    ReturnErrorOnFailure(FindOrAddAttribute(aPath, attribute));
+
+    ReleaseData(*attribute);
+    attribute->mType             = Attribute::Type::kStatus;
+    attribute->mStatus           = aStatus.mStatus;
+    attribute->mHasClusterStatus = aStatus.mClusterStatus.HasValue();
+    attribute->mClusterStatus    = aStatus.mClusterStatus.ValueOr(0);
+    attribute->mSize             = 0;
+    return CHIP_NO_ERROR;
+}
+
+const FlatAttributeStore::Attribute * FlatAttributeStore::FindAttribute(const ConcreteAttributePath & aPath) const
+{
+    uint32_t index = FindInIndex(mAttributeIndex, HashAttribute(aPath.mEndpointId, aPath.mClusterId, aPath.mAttributeId),
+                                 [&](uint32_t i) {
+                                     return mAttributes[i].mEndpointId == aPath.mEndpointId &&
+                                         mAttributes[i].mClusterId == aPath.mClusterId &&
+                                         mAttributes[i].mAttributeId == aPath.mAttributeId;
+                                 });
+    return (index != kNoEntry) ? &mAttributes[index] : nullptr;
+}
+
+FlatAttributeStore::ClusterVersions * FlatAttributeStore::FindCluster(EndpointId aEndpointId, ClusterId aClusterId)
+{
+    uint32_t index = FindClusterIndex(aEndpointId, aClusterId);
+    return (index != kNoEntry) ? &mClusters[index].mVersions : nullptr;
+}
+
+const FlatAttributeStore::ClusterVersions * FlatAttributeStore::FindCluster(EndpointId aEndpointId, ClusterId aClusterId) const
+{
+    uint32_t index = FindClusterIndex(aEndpointId, aClusterId);
+    return (index != kNoEntry) ? &mClusters[index].mVersions : nullptr;
+}
+
+bool FlatAttributeStore::HasEndpoint(EndpointId aEndpointId) const
+{
+    return std::binary_search(mEndpoints.begin(), mEndpoints.end(), aEndpointId);
+}
+
+FlatAttributeStore::ArenaChunk * FlatAttributeStore::AllocateChunk(size_t aCapacity)
+{
+    VerifyOrReturnValue(aCapacity <= SIZE_MAX - sizeof(ArenaChunk), nullptr);
+
+    auto * chunk = static_cast<ArenaChunk *>(Platform::MemoryAlloc(sizeof(ArenaChunk) + aCapacity));
+    VerifyOrReturnValue(chunk != nullptr, nullptr);
+
+    chunk->mNext     = nullptr;
+    chunk->mCapacity = aCapacity;
+    chunk->mUsed     = 0;
+    return chunk;
+}
+
+void FlatAttributeStore::FreeChunks(ArenaChunk * aChunk)
+{
+    while (aChunk != nullptr)
+    {
+        ArenaChunk * next = aChunk->mNext;
+        Platform::MemoryFree(aChunk);
+        aChunk = next;
+    }
+}
+
+uint8_t * FlatAttributeStore::AllocateArenaSpace(size_t aSize)
+{
+    if (mArena != nullptr && mArena->mCapacity - mArena->mUsed >= aSize)
+    {
+        uint8_t * data = mArena->Data() + mArena->mUsed;
+        mArena->mUsed += aSize;
+        return data;
+    }
+
+    // A large value gets a chunk of its own, behind the current one, so that the room left in the latter is not lost.
+    bool ownChunk      = (mArena != nullptr && aSize > kArenaChunkSize / 4);
+    ArenaChunk * chunk = AllocateChunk(ownChunk ? aSize : std::max(aSize, kArenaChunkSize));
+    VerifyOrReturnValue(chunk != nullptr, nullptr);
+
+    chunk->mUsed = aSize;
+    mArenaSize += sizeof(ArenaChunk) + chunk->mCapacity;
+    if (ownChunk)
+    {
+        chunk->mNext  = mArena->mNext;
+        mArena->mNext = chunk;
+    }
+    else
+    {
+        if (mArena != nullptr)
+        {
+            mGarbageSize += mArena->mCapacity - mArena->mUsed;
+        }
+        chunk->mNext = mArena;
+        mArena       = chunk;
+    }
+    return chunk->Data();
+}
+
+void FlatAttributeStore::Compact()
+{
+    VerifyOrReturn(mGarbageSize > mLiveDataSize && mGarbageSize >= kArenaChunkSize);
+
+    ArenaChunk * arena = nullptr;
+    if (mLiveDataSize > 0)
+    {
+        // Keep the values where they are if there is no memory to move them.
+        arena = AllocateChunk(std::max(mLiveDataSize, kArenaChunkSize));
+        VerifyOrReturn(arena != nullptr);
+
+        for (auto & attribute : mAttributes)
+        {
+            if (attribute.IsData())
+            {
+                uint8_t * data = arena->Data() + arena->mUsed;
+                memcpy(data, attribute.mData, attribute.mSize);
+                attribute.mData = data;
+                arena->mUsed += attribute.mSize;
+            }
+        }
+    }
+
+    FreeChunks(mArena);
+    mArena       = arena;
+    mArenaSize   = (arena != nullptr) ? sizeof(ArenaChunk) + arena->mCapacity : 0;
+    mGarbageSize = 0;
+}
+
+size_t FlatAttributeStore::GetMemoryUsage() const
+{
+    return mAttributes.capacity() * sizeof(Attribute) + mAttributeIndex.capacity() * sizeof(uint32_t) +
+        mClusters.capacity() * sizeof(Cluster) + mClusterIndex.capacity() * sizeof(uint32_t) +
+        mEndpoints.capacity() * sizeof(EndpointId) + mArenaSize;
+}
+
+} // namespace app
+} // namespace chip
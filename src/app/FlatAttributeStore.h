@@ -0,0 +1,234 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the attribute storage used by ClusterStateCache in its flat storage mode.
+ */
+
+#pragma once
+
+#include <app/ConcreteAttributePath.h>
+#include <app/MessageDef/StatusIB.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/core/Optional.h>
+#include <lib/core/TLVReader.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/Span.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace chip {
+namespace app {
+
+/**
+ * Attribute states of a node, with few allocations per attribute.
+ *
+ * Attributes and clusters are kept in two dense arrays, each indexed by an open-addressing hash table keyed by the
+ * packed (endpoint, cluster, attribute), respectively (endpoint, cluster), ids.  The attributes of a cluster are
+ * linked together, so iterating over them does not scan the table.  Attributes are never removed.
+ *
+ * Attribute values are copied into a chunked arena instead of being allocated one by one.  A value stays at the
+ * same address until Compact() is called, even if the attribute is updated in the meantime: the space of a replaced
+ * value is only reclaimed by compaction.
+ */
+class FlatAttributeStore
+{
+public:
+    struct ClusterVersions
+    {
+        Optional<DataVersion> mPendingDataVersion;
+        Optional<DataVersion> mCommittedDataVersion;
+    };
+
+    class Attribute
+    {
+    public:
+        bool IsStatus() const { return mType == Type::kStatus; }
+        bool IsData() const { return mType == Type::kData; }
+
+        /**
+         * The status of an attribute stored with SetStatus().
+         */
+        StatusIB GetStatus() const;
+
+        /**
+         * The TLV element of an attribute stored with SetData().
+         */
+        ByteSpan GetData() const { return ByteSpan(mData, mSize); }
+
+        /**
+         * The size of the TLV element of an attribute stored with SetData() or SetSize().
+         */
+        size_t GetSize() const { return mSize; }
+
+    private:
+        friend class FlatAttributeStore;
+
+        enum class Type : uint8_t
+        {
+            kStatus,
+            kData,
+            kSize,
+        };
+
+        EndpointId mEndpointId;
+        Type mType;
+        Protocols::InteractionModel::Status mStatus;
+        ClusterStatus mClusterStatus;
+        bool mHasClusterStatus;
+        ClusterId mClusterId;
+        AttributeId mAttributeId;
+        uint32_t mNextInCluster;
+        uint32_t mSize;
+        const uint8_t * mData;
+    };
+
+    FlatAttributeStore() = default;
+    ~FlatAttributeStore();
+
+    FlatAttributeStore(const FlatAttributeStore &)             = delete;
+    FlatAttributeStore & operator=(const FlatAttributeStore &) = delete;
+
+    /**
+     * Store a copy of the TLV element aData is positioned on, of size aElementSize, as the state of aPath.
+     */
+    CHIP_ERROR SetData(const ConcreteAttributePath & aPath, TLV::TLVReader & aData, size_t aElementSize);
+
+    /**
+     * Store only the size of a TLV element as the state of aPath.
+     */
+    CHIP_ERROR SetSize(const ConcreteAttributePath & aPath, size_t aSize);
+
+    CHIP_ERROR SetStatus(const ConcreteAttributePath & aPath, const StatusIB & aStatus);
+
+    /**
+     * The returned pointer is only valid until the next call to one of the setters.
+     */
+    const Attribute * FindAttribute(const ConcreteAttributePath & aPath) const;
+
+    /**
+     * A cluster exists once any of its attributes has been stored.  The returned pointer is only valid until the
+     * next call to one of the setters.
+     */
+    ClusterVersions * FindCluster(EndpointId aEndpointId, ClusterId aClusterId);
+    const ClusterVersions * FindCluster(EndpointId aEndpointId, ClusterId aClusterId) const;
+
+    bool HasEndpoint(EndpointId aEndpointId) const;
+
+    /**
+     * Call func with the id of each attribute of a cluster, in no particular order.  Stops at, and returns, the first
+     * error func returns.
+     *
+     * @retval #CHIP_ERROR_KEY_NOT_FOUND if the cluster does not exist.
+     */
+    template <typename Func>
+    CHIP_ERROR ForEachAttribute(EndpointId aEndpointId, ClusterId aClusterId, Func func) const
+    {
+        uint32_t cluster = FindClusterIndex(aEndpointId, aClusterId);
+        VerifyOrReturnError(cluster != kNoEntry, CHIP_ERROR_KEY_NOT_FOUND);
+
+        for (uint32_t i = mClusters[cluster].mFirstAttribute; i != kNoEntry; i = mAttributes[i].mNextInCluster)
+        {
+            ReturnErrorOnFailure(func(mAttributes[i].mAttributeId, mAttributes[i]));
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    /**
+     * Call func with the endpoint id, cluster id and data versions of each cluster, in the order they were added.
+     * Stops at, and returns, the first error func returns.
+     */
+    template <typename Func>
+    CHIP_ERROR ForEachCluster(Func func) const
+    {
+        for (const auto & cluster : mClusters)
+        {
+            ReturnErrorOnFailure(func(cluster.mEndpointId, cluster.mClusterId, cluster.mVersions));
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    /**
+     * Reclaim the space of the values that were replaced, if it has grown larger than the space of the live values.
+     * This moves every value, so nothing obtained from the store must be in use.
+     */
+    void Compact();
+
+    /**
+     * Number of bytes allocated by the store.
+     */
+    size_t GetMemoryUsage() const;
+
+private:
+    static constexpr uint32_t kNoEntry = UINT32_MAX;
+
+    struct Cluster
+    {
+        EndpointId mEndpointId;
+        ClusterId mClusterId;
+        uint32_t mFirstAttribute;
+        ClusterVersions mVersions;
+    };
+
+    struct ArenaChunk
+    {
+        ArenaChunk * mNext;
+        size_t mCapacity;
+        size_t mUsed;
+
+        uint8_t * Data() { return reinterpret_cast<uint8_t *>(this + 1); }
+    };
+
+    uint32_t FindClusterIndex(EndpointId aEndpointId, ClusterId aClusterId) const;
+    // Find the attribute, adding it if needed.  A new attribute has an empty size state.
+    CHIP_ERROR FindOrAddAttribute(const ConcreteAttributePath & aPath, Attribute *& aAttribute);
+    uint32_t AddCluster(EndpointId aEndpointId, ClusterId aClusterId);
+    // Drop the value of the attribute, before it gets a new state.
+    void ReleaseData(Attribute & aAttribute);
+
+    uint8_t * AllocateArenaSpace(size_t aSize);
+    static ArenaChunk * AllocateChunk(size_t aCapacity);
+    static void FreeChunks(ArenaChunk * aChunk);
+
+    // Hash table helpers: an index holds the positions of entries in their dense array, at a load factor of at most 1/2.
+    template <typename Matches>
+    static uint32_t FindInIndex(const std::vector<uint32_t> & aIndex, size_t aHash, Matches && aMatches);
+    // aHash(i) is the hash of the i-th entry.  aEntry must be the last one.
+    template <typename Hash>
+    static void AddToIndex(std::vector<uint32_t> & aIndex, uint32_t aEntry, Hash && aHash);
+    static void PlaceInIndex(std::vector<uint32_t> & aIndex, uint32_t aEntry, size_t aHash);
+
+    std::vector<Attribute> mAttributes;
+    std::vector<uint32_t> mAttributeIndex;
+    std::vector<Cluster> mClusters;
+    std::vector<uint32_t> mClusterIndex;
+    std::vector<EndpointId> mEndpoints; // sorted
+
+    // Values are appended to the first chunk.
+    ArenaChunk * mArena  = nullptr;
+    size_t mArenaSize    = 0; // including chunk headers
+    size_t mLiveDataSize = 0;
+    size_t mGarbageSize  = 0; // replaced values, and room that was left unused at the end of chunks
+};
+
+} // namespace app
+} // namespace chip
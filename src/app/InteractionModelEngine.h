@@ -593,7 +593,7 @@ private:
 
     CommandHandlerInterface * mCommandHandlerList = nullptr;
 
-    ObjectPool<CommandHandler, CHIP_IM_MAX_NUM_COMMAND_HANDLER> mCommandHandlerObjs;
+    ObjectPool<CommandHandler, CHIP_IM_MAX_NUM_COMMAND_HANDLER, ObjectPoolMem::kDefaultIterable> mCommandHandlerObjs;
     ObjectPool<TimedHandler, CHIP_IM_MAX_NUM_TIMED_HANDLER> mTimedHandlers;
     WriteHandler mWriteHandlers[CHIP_IM_MAX_NUM_WRITE_HANDLER];
     reporting::Engine mReportingEngine;
@@ -625,7 +625,7 @@ private:
                CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_READS + CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_SUBSCRIPTIONS>
         mDataVersionFilterPool;
 
-    ObjectPool<ReadHandler, CHIP_IM_MAX_NUM_READS + CHIP_IM_MAX_NUM_SUBSCRIPTIONS> mReadHandlers;
+    ObjectPool<ReadHandler, CHIP_IM_MAX_NUM_READS + CHIP_IM_MAX_NUM_SUBSCRIPTIONS, ObjectPoolMem::kDefaultIterable> mReadHandlers;
 
 #if CHIP_CONFIG_ENABLE_READ_CLIENT
     ReadClient * mpActiveReadClientList = nullptr;
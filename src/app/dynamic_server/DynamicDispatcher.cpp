@@ -282,6 +282,12 @@ uint16_t emberAfEndpointCount(void)
     return 1;
 }
 
+unsigned emberAfMetadataStructureGeneration(void)
+{
+    // Our single endpoint never changes.
+    return 0;
+}
+
 uint16_t emberAfIndexFromEndpoint(EndpointId endpoint)
 {
     if (endpoint == kSupportedEndpoint)
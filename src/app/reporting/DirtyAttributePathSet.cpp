@@ -0,0 +1,315 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/reporting/DirtyAttributePathSet.h>
+
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <algorithm>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+namespace {
+
+bool KeyLess(const AttributePathParams & aPath, EndpointId aEndpointId, ClusterId aClusterId, AttributeId aAttributeId)
+{
+    if (aPath.mEndpointId != aEndpointId)
+    {
+        return aPath.mEndpointId < aEndpointId;
+    }
+    if (aPath.mClusterId != aClusterId)
+    {
+        return aPath.mClusterId < aClusterId;
+    }
+    return aPath.mAttributeId < aAttributeId;
+}
+
+bool KeyLess(const AttributePathParams & a, const AttributePathParams & b)
+{
+    return KeyLess(a, b.mEndpointId, b.mClusterId, b.mAttributeId);
+}
+
+} // namespace
+
+DirtyAttributePathSetBase::~DirtyAttributePathSetBase()
+{
+    if (mCanGrow)
+    {
+        Platform::MemoryFree(mEntries);
+    }
+}
+
+size_t DirtyAttributePathSetBase::LowerBound(EndpointId aEndpointId, ClusterId aClusterId, AttributeId aAttributeId) const
+{
+    size_t low  = 0;
+    size_t high = mSize;
+    while (low < high)
+    {
+        size_t middle = low + (high - low) / 2;
+        if (KeyLess(mEntries[middle], aEndpointId, aClusterId, aAttributeId))
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+AttributePathParamsWithGeneration * DirtyAttributePathSetBase::Find(EndpointId aEndpointId, ClusterId aClusterId,
+                                                                    AttributeId aAttributeId) const
+{
+    size_t index = LowerBound(aEndpointId, aClusterId, aAttributeId);
+    VerifyOrReturnValue(index < mSize, nullptr);
+
+    AttributePathParamsWithGeneration & entry = mEntries[index];
+    VerifyOrReturnValue(entry.mEndpointId == aEndpointId && entry.mClusterId == aClusterId && entry.mAttributeId == aAttributeId,
+                        nullptr);
+    return &entry;
+}
+
+AttributePathParamsWithGeneration * DirtyAttributePathSetBase::FindSupersetOf(const AttributePathParams & aPath,
+                                                                              uint64_t aGeneration) const
+{
+    // The only paths that can be supersets of aPath are aPath itself with any of its concrete ids replaced by a wildcard.  A
+    // wildcard id of aPath has no other candidate, so skip the second iteration for it.
+    const EndpointId endpoints[]   = { aPath.mEndpointId, kInvalidEndpointId };
+    const ClusterId clusters[]     = { aPath.mClusterId, kInvalidClusterId };
+    const AttributeId attributes[] = { aPath.mAttributeId, kInvalidAttributeId };
+
+    for (size_t e = aPath.HasWildcardEndpointId() ? 1 : 0; e < 2; e++)
+    {
+        for (size_t c = aPath.HasWildcardClusterId() ? 1 : 0; c < 2; c++)
+        {
+            for (size_t a = aPath.HasWildcardAttributeId() ? 1 : 0; a < 2; a++)
+            {
+                AttributePathParamsWithGeneration * entry = Find(endpoints[e], clusters[c], attributes[a]);
+                if (entry != nullptr && entry->mGeneration > aGeneration)
+                {
+                    return entry;
+                }
+            }
+        }
+    }
+    return nullptr;
+}
+
+size_t DirtyAttributePathSetBase::RemoveSubsetsOf(const AttributePathParams & aPath)
+{
+    // With a concrete endpoint (and cluster), the subsets of aPath are all in the range of paths sharing that endpoint (and
+    // cluster); otherwise they can be anywhere.
+    size_t read = 0;
+    if (!aPath.HasWildcardEndpointId())
+    {
+        read = LowerBound(aPath.mEndpointId, aPath.HasWildcardClusterId() ? 0 : aPath.mClusterId, 0);
+    }
+
+    size_t write = read;
+    for (; read < mSize; read++)
+    {
+        const AttributePathParamsWithGeneration & entry = mEntries[read];
+        if ((!aPath.HasWildcardEndpointId() && entry.mEndpointId != aPath.mEndpointId) ||
+            (!aPath.HasWildcardEndpointId() && !aPath.HasWildcardClusterId() && entry.mClusterId != aPath.mClusterId))
+        {
+            break;
+        }
+        if (!aPath.IsAttributePathSupersetOf(entry))
+        {
+            mEntries[write++] = entry;
+        }
+    }
+
+    size_t removed = read - write;
+    while (read < mSize)
+    {
+        mEntries[write++] = mEntries[read++];
+    }
+    mSize = write;
+    return removed;
+}
+
+void DirtyAttributePathSetBase::InsertSorted(const AttributePathParams & aPath, uint64_t aGeneration)
+{
+    size_t index = LowerBound(aPath.mEndpointId, aPath.mClusterId, aPath.mAttributeId);
+    for (size_t i = mSize; i > index; i--)
+    {
+        mEntries[i] = mEntries[i - 1];
+    }
+    mEntries[index]             = AttributePathParams(aPath.mEndpointId, aPath.mClusterId, aPath.mAttributeId);
+    mEntries[index].mGeneration = aGeneration;
+    mSize++;
+    mLatestGeneration = aGeneration;
+}
+
+bool DirtyAttributePathSetBase::Grow()
+{
+    VerifyOrReturnValue(mCanGrow, false);
+
+    size_t capacity = mCapacity == 0 ? mInitialCapacity : mCapacity * 2;
+    VerifyOrReturnValue(capacity > mCapacity && capacity <= SIZE_MAX / sizeof(AttributePathParamsWithGeneration), false);
+
+    auto * entries = static_cast<AttributePathParamsWithGeneration *>(
+        Platform::MemoryRealloc(mEntries, capacity * sizeof(AttributePathParamsWithGeneration)));
+    VerifyOrReturnValue(entries != nullptr, false);
+
+    mEntries  = entries;
+    mCapacity = capacity;
+    return true;
+}
+
+template <typename Widen>
+bool DirtyAttributePathSetBase::Coalesce(Widen && aWiden)
+{
+    bool released = false;
+    AttributePathParams widened;
+
+    for (size_t i = 0; i < mSize; i++)
+    {
+        if (!aWiden(mEntries[i], widened))
+        {
+            continue;
+        }
+
+        // Fold every other path covered by the widened one into it, wherever it is: a widened path with a wildcard endpoint can
+        // cover paths outside of its own group.
+        uint64_t generation = mEntries[i].mGeneration;
+        size_t write        = 0;
+        size_t outer        = 0;
+        for (size_t j = 0; j < mSize; j++)
+        {
+            if (j != i && widened.IsAttributePathSupersetOf(mEntries[j]))
+            {
+                generation = std::max(generation, mEntries[j].mGeneration);
+                continue;
+            }
+            if (j == i)
+            {
+                outer = write;
+            }
+            mEntries[write++] = mEntries[j];
+        }
+
+        if (write == mSize)
+        {
+            continue;
+        }
+
+        mEntries[outer]             = widened;
+        mEntries[outer].mGeneration = generation;
+        mSize                       = write;
+        released                    = true;
+        // The paths now after the widened one were all after it before, so none of them has been visited yet.
+        i = outer;
+    }
+
+    VerifyOrReturnValue(released, false);
+
+    // Widening changed the keys, restore the order.  This only happens when the storage is full, and is cheap for the small
+    // fixed sizes that can fill up.
+    for (size_t i = 1; i < mSize; i++)
+    {
+        AttributePathParamsWithGeneration entry = mEntries[i];
+        size_t j                                = i;
+        for (; j > 0 && KeyLess(entry, mEntries[j - 1]); j--)
+        {
+            mEntries[j] = mEntries[j - 1];
+        }
+        mEntries[j] = entry;
+    }
+    return true;
+}
+
+bool DirtyAttributePathSetBase::MergeOverlapped(const AttributePathParams & aPath, uint64_t aGeneration)
+{
+    AttributePathParamsWithGeneration * superset = FindSupersetOf(aPath, 0);
+    if (superset != nullptr)
+    {
+        superset->mGeneration = aGeneration;
+        mLatestGeneration     = aGeneration;
+        return true;
+    }
+
+    // Only a wildcard path can cover other paths.  Replace all of them, not just the first one, so that the set never holds a
+    // path and its superset.
+    VerifyOrReturnValue(aPath.IsWildcardPath(), false);
+    VerifyOrReturnValue(RemoveSubsetsOf(aPath) > 0, false);
+    InsertSorted(aPath, aGeneration);
+    return true;
+}
+
+CHIP_ERROR DirtyAttributePathSetBase::Insert(const AttributePathParams & aPath, uint64_t aGeneration)
+{
+    const AttributePathParams path(aPath.mEndpointId, aPath.mClusterId, aPath.mAttributeId);
+
+    VerifyOrReturnError(!MergeOverlapped(path, aGeneration), CHIP_NO_ERROR);
+
+    if (mSize == mCapacity && !Grow())
+    {
+        // Nothing to merge into when heap storage could not be allocated at all.
+        VerifyOrReturnError(mCapacity > 0, CHIP_ERROR_NO_MEMORY);
+
+        bool released = Coalesce([](const AttributePathParams & entry, AttributePathParams & widened) {
+            VerifyOrReturnValue(!entry.HasWildcardClusterId(), false);
+            widened = AttributePathParams(entry.mEndpointId, entry.mClusterId);
+            return true;
+        });
+        released = released || Coalesce([](const AttributePathParams & entry, AttributePathParams & widened) {
+                       VerifyOrReturnValue(!entry.HasWildcardEndpointId(), false);
+                       widened = AttributePathParams(entry.mEndpointId, kInvalidClusterId);
+                       return true;
+                   });
+        released = released || Coalesce([](const AttributePathParams & entry, AttributePathParams & widened) {
+                       VerifyOrReturnValue(!entry.HasWildcardClusterId(), false);
+                       widened = AttributePathParams(kInvalidEndpointId, entry.mClusterId);
+                       return true;
+                   });
+
+        if (!released)
+        {
+            ChipLogDetail(DataManagement, "Dirty set exhausted, merge all paths.");
+            mEntries[0]             = AttributePathParams();
+            mEntries[0].mGeneration = aGeneration;
+            mSize                   = 1;
+            mLatestGeneration       = aGeneration;
+            return CHIP_NO_ERROR;
+        }
+
+        // Coalescing may have produced a superset of the new path.
+        VerifyOrReturnError(!MergeOverlapped(path, aGeneration), CHIP_NO_ERROR);
+    }
+
+    InsertSorted(path, aGeneration);
+    return CHIP_NO_ERROR;
+}
+
+bool DirtyAttributePathSetBase::IsDirtySince(const ConcreteAttributePath & aPath, uint64_t aGeneration) const
+{
+    VerifyOrReturnValue(mLatestGeneration > aGeneration, false);
+
+    return FindSupersetOf(AttributePathParams(aPath.mEndpointId, aPath.mClusterId, aPath.mAttributeId), aGeneration) != nullptr;
+}
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
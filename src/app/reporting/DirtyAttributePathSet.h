@@ -0,0 +1,181 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the set of attribute paths that the reporting engine
+ *      considers dirty, together with the generation at which each path last
+ *      changed.
+ */
+
+#pragma once
+
+#include <app/AttributePathParams.h>
+#include <app/ConcreteAttributePath.h>
+#include <lib/core/CHIPError.h>
+#include <lib/support/Pool.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+struct AttributePathParamsWithGeneration : public AttributePathParams
+{
+    AttributePathParamsWithGeneration() {}
+    AttributePathParamsWithGeneration(const AttributePathParams aPath) : AttributePathParams(aPath) {}
+    uint64_t mGeneration = 0;
+};
+
+/**
+ * Dirty attribute paths, kept sorted by endpoint, then cluster, then attribute.  Wildcard ids sort after
+ * every concrete id, so all the paths under one endpoint, or under one endpoint and cluster, are adjacent.
+ *
+ * The set maintains the invariant that no path is a superset of another one, so that the paths that can
+ * cover a given path are exactly those obtained by replacing some of its ids by wildcards; each of them is
+ * found with a binary search.  List indices are not tracked: a path is always recorded for the whole
+ * attribute.
+ *
+ * When the storage is full, paths under the same cluster are merged first, then paths under the same
+ * endpoint, then paths of the same cluster across endpoints.  Only when none of these frees any room is the
+ * whole set replaced by a single wildcard path.
+ */
+class DirtyAttributePathSetBase
+{
+public:
+    DirtyAttributePathSetBase(const DirtyAttributePathSetBase &)             = delete;
+    DirtyAttributePathSetBase & operator=(const DirtyAttributePathSetBase &) = delete;
+
+    /**
+     * Record that aPath changed at aGeneration, merging it with the overlapping paths.
+     *
+     * @retval #CHIP_ERROR_NO_MEMORY if heap storage could not be allocated for the first path.
+     */
+    CHIP_ERROR Insert(const AttributePathParams & aPath, uint64_t aGeneration);
+
+    /**
+     * If one of the paths is a superset of aPath, move it to aGeneration.  Otherwise, if aPath is a superset
+     * of some of the paths, replace them with aPath at aGeneration.
+     *
+     * Returns whether the set now has a path that is a superset of aPath.
+     */
+    bool MergeOverlapped(const AttributePathParams & aPath, uint64_t aGeneration);
+
+    /**
+     * Returns whether aPath is covered by a path that changed after aGeneration.
+     */
+    bool IsDirtySince(const ConcreteAttributePath & aPath, uint64_t aGeneration) const;
+
+    /**
+     * The most recent generation of any path, or 0 if the set is empty.
+     */
+    uint64_t GetLatestGeneration() const { return mLatestGeneration; }
+
+    size_t Size() const { return mSize; }
+    bool IsEmpty() const { return mSize == 0; }
+
+    void Clear()
+    {
+        mSize             = 0;
+        mLatestGeneration = 0;
+    }
+
+    /**
+     * Call function with a pointer to each path, in sorted order.  The function must not modify the set, and
+     * returns Loop::Continue or Loop::Break.
+     */
+    template <typename Function>
+    Loop ForEachPath(Function && function) const
+    {
+        for (size_t i = 0; i < mSize; i++)
+        {
+            if (function(static_cast<const AttributePathParamsWithGeneration *>(&mEntries[i])) == Loop::Break)
+            {
+                return Loop::Break;
+            }
+        }
+        return Loop::Finish;
+    }
+
+protected:
+    DirtyAttributePathSetBase(AttributePathParamsWithGeneration * apStorage, size_t aCapacity) :
+        mEntries(apStorage), mCapacity(apStorage != nullptr ? aCapacity : 0), mInitialCapacity(aCapacity),
+        mCanGrow(apStorage == nullptr)
+    {}
+    ~DirtyAttributePathSetBase();
+
+private:
+    size_t LowerBound(EndpointId aEndpointId, ClusterId aClusterId, AttributeId aAttributeId) const;
+    AttributePathParamsWithGeneration * Find(EndpointId aEndpointId, ClusterId aClusterId, AttributeId aAttributeId) const;
+    // The first path covering aPath that changed after aGeneration.
+    AttributePathParamsWithGeneration * FindSupersetOf(const AttributePathParams & aPath, uint64_t aGeneration) const;
+    size_t RemoveSubsetsOf(const AttributePathParams & aPath);
+    void InsertSorted(const AttributePathParams & aPath, uint64_t aGeneration);
+    bool Grow();
+
+    /**
+     * For each path that aWiden applies to, if its widened form covers any other path, replace all of them by
+     * the widened path, at their latest generation.
+     *
+     * Returns whether any path was released.
+     */
+    template <typename Widen>
+    bool Coalesce(Widen && aWiden);
+
+    AttributePathParamsWithGeneration * mEntries;
+    size_t mSize      = 0;
+    size_t mCapacity;
+    size_t mInitialCapacity;
+    bool mCanGrow;
+    uint64_t mLatestGeneration = 0;
+};
+
+template <size_t N, ObjectPoolMem P = ObjectPoolMem::kDefault>
+class DirtyAttributePathSet;
+
+/**
+ * Fixed storage for N paths; paths are coalesced once it is full.
+ */
+template <size_t N>
+class DirtyAttributePathSet<N, ObjectPoolMem::kInline> : public DirtyAttributePathSetBase
+{
+public:
+    DirtyAttributePathSet() : DirtyAttributePathSetBase(mStorage, N) {}
+
+private:
+    AttributePathParamsWithGeneration mStorage[N];
+};
+
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+/**
+ * Heap storage, starting with room for N paths and growing on demand.  Paths are only coalesced if
+ * growing fails.
+ */
+template <size_t N>
+class DirtyAttributePathSet<N, ObjectPoolMem::kHeap> : public DirtyAttributePathSetBase
+{
+public:
+    DirtyAttributePathSet() : DirtyAttributePathSetBase(nullptr, N) {}
+};
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
@@ -52,7 +52,7 @@ void Engine::Shutdown()
 
     mNumReportsInFlight = 0;
     mCurReadHandlerIdx  = 0;
-    mGlobalDirtySet.ReleaseAll();
+    mGlobalDirtySet.Clear();
 }
 
 bool Engine::IsClusterDataVersionMatch(const ObjectList<DataVersionFilter> * aDataVersionFilterList,
@@ -145,23 +145,10 @@ CHIP_ERROR Engine::BuildSingleReportDataAttributeReportIBs(ReportDataMessage::Bu
         {
             if (!apReadHandler->IsPriming())
             {
-                bool concretePathDirty = false;
                 // TODO: Optimize this implementation by making the iterator only emit intersected paths.
-                mGlobalDirtySet.ForEachActiveObject([&](auto * dirtyPath) {
-                    if (dirtyPath->IsAttributePathSupersetOf(readPath))
-                    {
-                        // We don't need to worry about paths that were already marked dirty before the last time this read handler
-                        // started a report that it completed: those paths already got reported.
-                        if (dirtyPath->mGeneration > apReadHandler->mPreviousReportsBeginGeneration)
-                        {
-                            concretePathDirty = true;
-                            return Loop::Break;
-                        }
-                    }
-                    return Loop::Continue;
-                });
-
-                if (!concretePathDirty)
+                // We don't need to worry about paths that were already marked dirty before the last time this read handler
+                // started a report that it completed: those paths already got reported.
+                if (!mGlobalDirtySet.IsDirtySince(readPath, apReadHandler->mPreviousReportsBeginGeneration))
                 {
                     // This attribute is not dirty, we just skip this one.
                     continue;
@@ -695,143 +682,18 @@ void Engine::Run()
     {
         ChipLogDetail(DataManagement, "All ReadHandler-s are clean, clear GlobalDirtySet");
 
-        mGlobalDirtySet.ReleaseAll();
+        mGlobalDirtySet.Clear();
     }
 }
 
-bool Engine::MergeOverlappedAttributePath(const AttributePathParams & aAttributePath)
-{
-    return Loop::Break == mGlobalDirtySet.ForEachActiveObject([&](auto * path) {
-        if (path->IsAttributePathSupersetOf(aAttributePath))
-        {
-            path->mGeneration = GetDirtySetGeneration();
-            return Loop::Break;
-        }
-        if (aAttributePath.IsAttributePathSupersetOf(*path))
-        {
-            // TODO: the wildcard input path may be superset of next paths in globalDirtySet, it is fine at this moment, since
-            // when building report, it would use the first path of globalDirtySet to compare against interested paths read clients
-            // want.
-            // It is better to eliminate the duplicate wildcard paths in follow-up
-            path->mGeneration  = GetDirtySetGeneration();
-            path->mEndpointId  = aAttributePath.mEndpointId;
-            path->mClusterId   = aAttributePath.mClusterId;
-            path->mListIndex   = aAttributePath.mListIndex;
-            path->mAttributeId = aAttributePath.mAttributeId;
-            return Loop::Break;
-        }
-        return Loop::Continue;
-    });
-}
-
-bool Engine::ClearTombPaths()
-{
-    bool pathReleased = false;
-    mGlobalDirtySet.ForEachActiveObject([&](auto * path) {
-        if (path->mGeneration == 0)
-        {
-            mGlobalDirtySet.ReleaseObject(path);
-            pathReleased = true;
-        }
-        return Loop::Continue;
-    });
-    return pathReleased;
-}
-
-bool Engine::MergeDirtyPathsUnderSameCluster()
-{
-    mGlobalDirtySet.ForEachActiveObject([&](auto * outerPath) {
-        if (outerPath->HasWildcardClusterId() || outerPath->mGeneration == 0)
-        {
-            return Loop::Continue;
-        }
-        mGlobalDirtySet.ForEachActiveObject([&](auto * innerPath) {
-            if (innerPath == outerPath)
-            {
-                return Loop::Continue;
-            }
-            // We don't support paths with a wildcard endpoint + a concrete cluster in global dirty set, so we do a simple == check
-            // here.
-            if (innerPath->mEndpointId != outerPath->mEndpointId || innerPath->mClusterId != outerPath->mClusterId)
-            {
-                return Loop::Continue;
-            }
-            if (innerPath->mGeneration > outerPath->mGeneration)
-            {
-                outerPath->mGeneration = innerPath->mGeneration;
-            }
-            outerPath->SetWildcardAttributeId();
-
-            // The object pool does not allow us to release objects in a nested iteration, mark the path as a tomb by setting its
-            // generation to 0 and then clear it later.
-            innerPath->mGeneration = 0;
-            return Loop::Continue;
-        });
-        return Loop::Continue;
-    });
-
-    return ClearTombPaths();
-}
-
-bool Engine::MergeDirtyPathsUnderSameEndpoint()
-{
-    mGlobalDirtySet.ForEachActiveObject([&](auto * outerPath) {
-        if (outerPath->HasWildcardEndpointId() || outerPath->mGeneration == 0)
-        {
-            return Loop::Continue;
-        }
-        mGlobalDirtySet.ForEachActiveObject([&](auto * innerPath) {
-            if (innerPath == outerPath)
-            {
-                return Loop::Continue;
-            }
-            if (innerPath->mEndpointId != outerPath->mEndpointId)
-            {
-                return Loop::Continue;
-            }
-            if (innerPath->mGeneration > outerPath->mGeneration)
-            {
-                outerPath->mGeneration = innerPath->mGeneration;
-            }
-            outerPath->SetWildcardClusterId();
-            outerPath->SetWildcardAttributeId();
-
-            // The object pool does not allow us to release objects in a nested iteration, mark the path as a tomb by setting its
-            // generation to 0 and then clear it later.
-            innerPath->mGeneration = 0;
-            return Loop::Continue;
-        });
-        return Loop::Continue;
-    });
-    return ClearTombPaths();
-}
-
 CHIP_ERROR Engine::InsertPathIntoDirtySet(const AttributePathParams & aAttributePath)
 {
-    ReturnErrorCodeIf(MergeOverlappedAttributePath(aAttributePath), CHIP_NO_ERROR);
-
-    if (mGlobalDirtySet.Exhausted() && !MergeDirtyPathsUnderSameCluster() && !MergeDirtyPathsUnderSameEndpoint())
-    {
-        ChipLogDetail(DataManagement, "Global dirty set pool exhausted, merge all paths.");
-        mGlobalDirtySet.ReleaseAll();
-        auto object         = mGlobalDirtySet.CreateObject();
-        object->mGeneration = GetDirtySetGeneration();
-    }
-
-    ReturnErrorCodeIf(MergeOverlappedAttributePath(aAttributePath), CHIP_NO_ERROR);
-    ChipLogDetail(DataManagement, "Cannot merge the new path into any existing path, create one.");
-
-    auto object = mGlobalDirtySet.CreateObject();
-    if (object == nullptr)
+    CHIP_ERROR err = mGlobalDirtySet.Insert(aAttributePath, GetDirtySetGeneration());
+    if (err != CHIP_NO_ERROR)
     {
-        // This should not happen, this path should be merged into the wildcard endpoint at least.
-        ChipLogError(DataManagement, "mGlobalDirtySet pool full, cannot handle more entries!");
-        return CHIP_ERROR_NO_MEMORY;
+        ChipLogError(DataManagement, "Cannot record dirty path: %" CHIP_ERROR_FORMAT, err.Format());
     }
-    *object             = aAttributePath;
-    object->mGeneration = GetDirtySetGeneration();
-
-    return CHIP_NO_ERROR;
+    return err;
 }
 
 CHIP_ERROR Engine::SetDirty(AttributePathParams & aAttributePath)
@@ -27,6 +27,7 @@
 #include <access/AccessControl.h>
 #include <app/MessageDef/ReportDataMessage.h>
 #include <app/ReadHandler.h>
+#include <app/reporting/DirtyAttributePathSet.h>
 #include <app/util/basic-types.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/support/CodeUtils.h>
@@ -131,7 +132,7 @@ public:
     void ScheduleUrgentEventDeliverySync(Optional<FabricIndex> fabricIndex = NullOptional);
 
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
-    size_t GetGlobalDirtySetSize() { return mGlobalDirtySet.Allocated(); }
+    size_t GetGlobalDirtySetSize() { return mGlobalDirtySet.Size(); }
 #endif
 
 private:
@@ -145,13 +146,6 @@ private:
 
     bool IsRunScheduled() const { return mRunScheduled; }
 
-    struct AttributePathParamsWithGeneration : public AttributePathParams
-    {
-        AttributePathParamsWithGeneration() {}
-        AttributePathParamsWithGeneration(const AttributePathParams aPath) : AttributePathParams(aPath) {}
-        uint64_t mGeneration = 0;
-    };
-
     /**
      * Build Single Report Data including attribute changes and event data stream, and send out
      *
@@ -191,37 +185,6 @@ private:
     CHIP_ERROR ScheduleBufferPressureEventDelivery(uint32_t aBytesWritten);
     void GetMinEventLogPosition(uint32_t & aMinLogPosition);
 
-    /**
-     * If the provided path is a superset of our of our existing paths, update that existing path to match the
-     * provided path.
-     *
-     * Return whether one of our paths is now a superset of the provided path.
-     */
-    bool MergeOverlappedAttributePath(const AttributePathParams & aAttributePath);
-
-    /**
-     * If we are running out of ObjectPool for the global dirty set, we will try to merge the existing items by clusters.
-     *
-     * Returns whether we have released any paths.
-     */
-    bool MergeDirtyPathsUnderSameCluster();
-
-    /**
-     * If we are running out of ObjectPool for the global dirty set and we cannot find a slot after merging the existing items by
-     * clusters, we will try to merge the existing items by endpoints.
-     *
-     * Returns whether we have released any paths.
-     */
-    bool MergeDirtyPathsUnderSameEndpoint();
-
-    /**
-     * During the iterating of the paths, releasing the object in the inner loop will cause undefined behavior of the ObjectPool, so
-     * we replace the items to be cleared by a tomb first, then clear all the tombs after the iteration.
-     *
-     * Returns whether we have released any paths.
-     */
-    bool ClearTombPaths();
-
     CHIP_ERROR InsertPathIntoDirtySet(const AttributePathParams & aAttributePath);
 
     inline void BumpDirtySetGeneration() { mDirtyGeneration++; }
@@ -256,9 +219,9 @@ private:
      */
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
     // For unit tests, always use inline allocation for code coverage.
-    ObjectPool<AttributePathParamsWithGeneration, CHIP_IM_SERVER_MAX_NUM_DIRTY_SET, ObjectPoolMem::kInline> mGlobalDirtySet;
+    DirtyAttributePathSet<CHIP_IM_SERVER_MAX_NUM_DIRTY_SET, ObjectPoolMem::kInline> mGlobalDirtySet;
 #else
-    ObjectPool<AttributePathParamsWithGeneration, CHIP_IM_SERVER_MAX_NUM_DIRTY_SET> mGlobalDirtySet;
+    DirtyAttributePathSet<CHIP_IM_SERVER_MAX_NUM_DIRTY_SET> mGlobalDirtySet;
 #endif
 
     /**
@@ -0,0 +1,159 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/server/PersistentEventLogStorage.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <platform/CHIPDeviceLayer.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace chip {
+namespace app {
+
+namespace {
+
+// Keeps the persistent state of every buffer aligned.
+constexpr size_t kSegmentAlignment = 8;
+
+constexpr size_t AlignSegment(size_t aSize)
+{
+    return (aSize + kSegmentAlignment - 1) & ~(kSegmentAlignment - 1);
+}
+
+} // namespace
+
+CHIP_ERROR PersistentEventLogStorage::Init(const char * apPath, LogStorageResources * apResources, size_t aCount,
+                                           System::Clock::Milliseconds32 aSyncInterval)
+{
+    VerifyOrReturnError(mpMapping == nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(apPath != nullptr && apResources != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(aCount > 0 && aCount <= kMaxBuffers, CHIP_ERROR_INVALID_ARGUMENT);
+
+    FileHeader header;
+    memset(&header, 0, sizeof(header));
+    header.mMagic       = kFileMagic;
+    header.mBufferCount = static_cast<uint32_t>(aCount);
+
+    size_t size = AlignSegment(sizeof(FileHeader));
+    for (size_t i = 0; i < aCount; i++)
+    {
+        header.mBufferSizes[i] = apResources[i].mBufferSize;
+        size += AlignSegment(sizeof(PersistentEventBufferState) + apResources[i].mBufferSize);
+    }
+
+    int fd = open(apPath, O_RDWR | O_CREAT | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (fd < 0)
+    {
+        ChipLogError(EventLogging, "Failed to open event log file (%s), %s (%d)", apPath, strerror(errno), errno);
+        return CHIP_ERROR_POSIX(errno);
+    }
+
+    struct stat fileStat;
+    void * mapping = MAP_FAILED;
+    if (fstat(fd, &fileStat) == 0 &&
+        (static_cast<size_t>(fileStat.st_size) == size || ftruncate(fd, static_cast<off_t>(size)) == 0))
+    {
+        mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    const int mapErrno = errno;
+    // The mapping keeps the file open.
+    close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        ChipLogError(EventLogging, "Failed to map event log file (%s), %s (%d)", apPath, strerror(mapErrno), mapErrno);
+        return CHIP_ERROR_POSIX(mapErrno);
+    }
+
+    mpMapping     = static_cast<uint8_t *>(mapping);
+    mMappingSize  = size;
+    mSyncInterval = aSyncInterval;
+    mSyncPending  = false;
+
+    if (memcmp(mpMapping, &header, sizeof(header)) != 0)
+    {
+        ChipLogProgress(EventLogging, "Resetting event log file (%s)", apPath);
+        memset(mpMapping, 0, mMappingSize);
+        memcpy(mpMapping, &header, sizeof(header));
+    }
+
+    uint8_t * segment = mpMapping + AlignSegment(sizeof(FileHeader));
+    for (size_t i = 0; i < aCount; i++)
+    {
+        apResources[i].mpPersistentState = reinterpret_cast<PersistentEventBufferState *>(segment);
+        apResources[i].mpBuffer          = segment + sizeof(PersistentEventBufferState);
+        segment += AlignSegment(sizeof(PersistentEventBufferState) + apResources[i].mBufferSize);
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+void PersistentEventLogStorage::Shutdown()
+{
+    VerifyOrReturn(mpMapping != nullptr);
+
+    if (mSyncPending)
+    {
+        DeviceLayer::SystemLayer().CancelTimer(SyncTimerExpired, this);
+        mSyncPending = false;
+    }
+    Sync();
+
+    munmap(mpMapping, mMappingSize);
+    mpMapping    = nullptr;
+    mMappingSize = 0;
+}
+
+CHIP_ERROR PersistentEventLogStorage::Sync()
+{
+    VerifyOrReturnError(mpMapping != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    if (msync(mpMapping, mMappingSize, MS_SYNC) != 0)
+    {
+        ChipLogError(EventLogging, "Failed to sync event log file, %s (%d)", strerror(errno), errno);
+        return CHIP_ERROR_POSIX(errno);
+    }
+    return CHIP_NO_ERROR;
+}
+
+void PersistentEventLogStorage::OnEventStorageChanged()
+{
+    VerifyOrReturn(mpMapping != nullptr && !mSyncPending);
+
+    if (mSyncInterval.count() != 0 && DeviceLayer::SystemLayer().StartTimer(mSyncInterval, SyncTimerExpired, this) == CHIP_NO_ERROR)
+    {
+        mSyncPending = true;
+        return;
+    }
+    Sync();
+}
+
+void PersistentEventLogStorage::SyncTimerExpired(System::Layer * apSystemLayer, void * apAppState)
+{
+    PersistentEventLogStorage * storage = static_cast<PersistentEventLogStorage *>(apAppState);
+    storage->mSyncPending               = false;
+    storage->Sync();
+}
+
+} // namespace app
+} // namespace chip
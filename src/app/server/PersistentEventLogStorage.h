@@ -0,0 +1,105 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *          Keeps the event logging buffers in a memory-mapped file, so that the events
+ *          logged before a restart can still be read afterwards.
+ *
+ *          The file holds one segment per priority buffer, each made of the
+ *          PersistentEventBufferState of the buffer followed by its storage.  Logging
+ *          an event only writes the event and the few bytes of state of the buffers it
+ *          touched; msync() is batched and issued once the sync interval has elapsed
+ *          after a change, and on Shutdown().  EventManagement::Init drops whatever a
+ *          crash left incomplete.
+ *
+ *          A file that does not match the layout of the buffers is reset.
+ *
+ *          Restored events keep the timestamps they were logged with.  System timestamps
+ *          count from the boot they were logged in, so those of events logged before the
+ *          restart do not compare with the current system time.
+ *
+ *          Shutdown() must be called before the object is destroyed: the destructor does
+ *          not cancel the sync timer nor unmap the file.
+ */
+
+#pragma once
+
+#include <app/EventManagement.h>
+#include <lib/core/CHIPError.h>
+#include <system/SystemClock.h>
+#include <system/SystemLayer.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace app {
+
+class PersistentEventLogStorage : public EventStorageDelegate
+{
+public:
+    static constexpr size_t kMaxBuffers = 4;
+
+    PersistentEventLogStorage() = default;
+
+    PersistentEventLogStorage(const PersistentEventLogStorage &)             = delete;
+    PersistentEventLogStorage & operator=(const PersistentEventLogStorage &) = delete;
+
+    /**
+     * Map the file at apPath and point the buffer and persistent state of each of the aCount
+     * apResources into it.  The buffer sizes of apResources define the layout of the file.
+     * apResources is left untouched on failure.
+     *
+     * Must be called before EventManagement::Init, with the resources then given to it.
+     */
+    CHIP_ERROR Init(const char * apPath, LogStorageResources * apResources, size_t aCount,
+                    System::Clock::Milliseconds32 aSyncInterval);
+
+    /**
+     * Flush the events to the file, cancel the pending sync and unmap the file.  EventManagement
+     * must not use the buffers anymore.  Must be called on the Matter thread.
+     */
+    void Shutdown();
+
+    /**
+     * Flush the events to the file.
+     */
+    CHIP_ERROR Sync();
+
+    void OnEventStorageChanged() override;
+
+private:
+    struct FileHeader
+    {
+        uint32_t mMagic;
+        uint32_t mBufferCount;
+        uint32_t mBufferSizes[kMaxBuffers];
+    };
+
+    static constexpr uint32_t kFileMagic = 0x43484556; // "CHEV"
+
+    static void SyncTimerExpired(System::Layer * apSystemLayer, void * apAppState);
+
+    uint8_t * mpMapping = nullptr;
+    size_t mMappingSize = 0;
+    System::Clock::Milliseconds32 mSyncInterval;
+    bool mSyncPending = false;
+};
+
+} // namespace app
+} // namespace chip
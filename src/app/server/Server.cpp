@@ -59,6 +59,10 @@
 #include <lib/support/PersistentStorageAudit.h>
 #endif // defined(CHIP_SUPPORT_ENABLE_STORAGE_API_AUDIT) || defined(CHIP_SUPPORT_ENABLE_STORAGE_LOAD_TEST_AUDIT)
 
+#if CHIP_DEVICE_LAYER_TARGET_LINUX && CHIP_DEVICE_CONFIG_LINUX_PERSISTENT_EVENT_LOG
+#include <app/server/PersistentEventLogStorage.h>
+#endif // CHIP_DEVICE_LAYER_TARGET_LINUX && CHIP_DEVICE_CONFIG_LINUX_PERSISTENT_EVENT_LOG
+
 using namespace chip::DeviceLayer;
 
 using chip::kMinValidFabricIndex;
@@ -95,6 +99,9 @@ static uint8_t sDebugEventBuffer[CHIP_DEVICE_CONFIG_EVENT_LOGGING_DEBUG_BUFFER_S
 static uint8_t sCritEventBuffer[CHIP_DEVICE_CONFIG_EVENT_LOGGING_CRIT_BUFFER_SIZE];
 static ::chip::PersistedCounter<chip::EventNumber> sGlobalEventIdCounter;
 static ::chip::app::CircularEventBuffer sLoggingBuffer[CHIP_NUM_EVENT_LOGGING_BUFFERS];
+#if CHIP_DEVICE_LAYER_TARGET_LINUX && CHIP_DEVICE_CONFIG_LINUX_PERSISTENT_EVENT_LOG
+static ::chip::app::PersistentEventLogStorage sEventLogStorage;
+#endif // CHIP_DEVICE_LAYER_TARGET_LINUX && CHIP_DEVICE_CONFIG_LINUX_PERSISTENT_EVENT_LOG
 #endif // CHIP_CONFIG_ENABLE_SERVER_IM_EVENT
 
 CHIP_ERROR Server::Init(const ServerInitParams & initParams)
@@ -250,9 +257,22 @@ CHIP_ERROR Server::Init(const ServerInitParams & initParams)
             { &sCritEventBuffer[0], sizeof(sCritEventBuffer), ::chip::app::PriorityLevel::Critical }
         };
 
+#if CHIP_DEVICE_LAYER_TARGET_LINUX && CHIP_DEVICE_CONFIG_LINUX_PERSISTENT_EVENT_LOG
+        if (sEventLogStorage.Init(CHIP_DEVICE_CONFIG_LINUX_PERSISTENT_EVENT_LOG_PATH, &logStorageResources[0],
+                                  ArraySize(logStorageResources),
+                                  System::Clock::Milliseconds32(CHIP_DEVICE_CONFIG_LINUX_PERSISTENT_EVENT_LOG_SYNC_INTERVAL_MS)) !=
+            CHIP_NO_ERROR)
+        {
+            ChipLogError(AppServer, "Failed to open the persistent event log, events will not survive a restart");
+        }
+#endif // CHIP_DEVICE_LAYER_TARGET_LINUX && CHIP_DEVICE_CONFIG_LINUX_PERSISTENT_EVENT_LOG
+
         chip::app::EventManagement::GetInstance().Init(&mExchangeMgr, CHIP_NUM_EVENT_LOGGING_BUFFERS, &sLoggingBuffer[0],
                                                        &logStorageResources[0], &sGlobalEventIdCounter,
                                                        std::chrono::duration_cast<System::Clock::Milliseconds64>(mInitTimestamp));
+#if CHIP_DEVICE_LAYER_TARGET_LINUX && CHIP_DEVICE_CONFIG_LINUX_PERSISTENT_EVENT_LOG
+        chip::app::EventManagement::GetInstance().SetStorageDelegate(&sEventLogStorage);
+#endif // CHIP_DEVICE_LAYER_TARGET_LINUX && CHIP_DEVICE_CONFIG_LINUX_PERSISTENT_EVENT_LOG
     }
 #endif // CHIP_CONFIG_ENABLE_SERVER_IM_EVENT
 
@@ -547,6 +567,11 @@ void Server::Shutdown()
 
     chip::Dnssd::Resolver::Instance().Shutdown();
     chip::app::InteractionModelEngine::GetInstance()->Shutdown();
+#if CHIP_CONFIG_ENABLE_SERVER_IM_EVENT && CHIP_DEVICE_LAYER_TARGET_LINUX && CHIP_DEVICE_CONFIG_LINUX_PERSISTENT_EVENT_LOG
+    // The event buffers live in the mapping of the event log file.
+    chip::app::EventManagement::DestroyEventManagement();
+    sEventLogStorage.Shutdown();
+#endif // CHIP_CONFIG_ENABLE_SERVER_IM_EVENT && CHIP_DEVICE_LAYER_TARGET_LINUX && CHIP_DEVICE_CONFIG_LINUX_PERSISTENT_EVENT_LOG
     mCommissioningWindowManager.Shutdown();
     mMessageCounterManager.Shutdown();
     mExchangeMgr.Shutdown();
@@ -20,8 +20,11 @@
 #include <app/AttributePathExpandIterator.h>
 #include <app/ConcreteAttributePath.h>
 #include <app/EventManagement.h>
+#include <app/GlobalAttributes.h>
 #include <app/ObjectList.h>
 #include <app/util/mock/Constants.h>
+#include <app/util/mock/Functions.h>
+#include <app/util/mock/MockNodeConfig.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/core/TLVDebug.h>
 #include <lib/support/CodeUtils.h>
@@ -417,6 +420,81 @@ void TestMultipleClusInfo(nlTestSuite * apSuite, void * apContext)
     NL_TEST_ASSERT(apSuite, index == ArraySize(paths));
 }
 
+void TestMetadataChange(nlTestSuite * apSuite, void * apContext)
+{
+    // clang-format off
+    static const MockNodeConfig config1({
+        MockEndpointConfig(kMockEndpoint1, {
+            MockClusterConfig(MockClusterId(1), { MockAttributeId(1), MockAttributeId(2), MockAttributeId(3) }),
+            MockClusterConfig(MockClusterId(2), { MockAttributeId(1) }),
+        }),
+        MockEndpointConfig(kMockEndpoint2, {
+            MockClusterConfig(MockClusterId(1), { MockAttributeId(1) }),
+        }),
+    });
+    // An attribute is added in front of the one we are at.
+    static const MockNodeConfig config2({
+        MockEndpointConfig(kMockEndpoint1, {
+            MockClusterConfig(MockClusterId(1), {
+                MockAttributeId(4), MockAttributeId(1), MockAttributeId(2), MockAttributeId(3),
+            }),
+            MockClusterConfig(MockClusterId(2), { MockAttributeId(1) }),
+        }),
+        MockEndpointConfig(kMockEndpoint2, {
+            MockClusterConfig(MockClusterId(1), { MockAttributeId(1) }),
+        }),
+    });
+    // The cluster we are in is removed.
+    static const MockNodeConfig config3({
+        MockEndpointConfig(kMockEndpoint1, {
+            MockClusterConfig(MockClusterId(2), { MockAttributeId(1) }),
+        }),
+        MockEndpointConfig(kMockEndpoint2, {
+            MockClusterConfig(MockClusterId(1), { MockAttributeId(1) }),
+        }),
+    });
+    // The endpoint we are in is removed.
+    static const MockNodeConfig config4({
+        MockEndpointConfig(kMockEndpoint2, {
+            MockClusterConfig(MockClusterId(1), { MockAttributeId(1) }),
+        }),
+    });
+    // clang-format on
+
+    SetMockNodeConfig(config1);
+
+    app::ObjectList<app::AttributePathParams> clusInfo;
+    app::AttributePathExpandIterator iter(&clusInfo);
+    app::ConcreteAttributePath path;
+
+    NL_TEST_ASSERT(apSuite, iter.Get(path) && path == P(kMockEndpoint1, MockClusterId(1), MockAttributeId(1)));
+    iter.Next();
+    NL_TEST_ASSERT(apSuite, iter.Get(path) && path == P(kMockEndpoint1, MockClusterId(1), MockAttributeId(2)));
+
+    SetMockNodeConfig(config2);
+    iter.Next();
+    NL_TEST_ASSERT(apSuite, iter.Get(path) && path == P(kMockEndpoint1, MockClusterId(1), MockAttributeId(3)));
+
+    SetMockNodeConfig(config3);
+    iter.Next();
+    NL_TEST_ASSERT(apSuite, iter.Get(path) && path == P(kMockEndpoint1, MockClusterId(2), MockAttributeId(1)));
+
+    SetMockNodeConfig(config4);
+    iter.Next();
+    NL_TEST_ASSERT(apSuite, iter.Get(path) && path == P(kMockEndpoint2, MockClusterId(1), MockAttributeId(1)));
+
+    // The rest are the global attributes of that cluster.
+    size_t remaining = 0;
+    for (iter.Next(); iter.Get(path); iter.Next())
+    {
+        NL_TEST_ASSERT(apSuite, path.mEndpointId == kMockEndpoint2 && path.mClusterId == MockClusterId(1));
+        remaining++;
+    }
+    NL_TEST_ASSERT(apSuite, remaining == ArraySize(GlobalAttributesNotInMetadata));
+
+    ResetMockNodeConfig();
+}
+
 static int TestSetup(void * inContext)
 {
     return SUCCESS;
@@ -445,6 +523,7 @@ const nlTest sTests[] =
         NL_TEST_DEF("TestWildcardAttribute", TestWildcardAttribute),
         NL_TEST_DEF("TestNoWildcard", TestNoWildcard),
         NL_TEST_DEF("TestMultipleClusInfo", TestMultipleClusInfo),
+        NL_TEST_DEF("TestMetadataChange", TestMetadataChange),
         NL_TEST_SENTINEL()
 };
 // clang-format on
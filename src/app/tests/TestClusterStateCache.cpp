@@ -538,11 +538,11 @@ CacheValidator::CacheValidator(AttributeInstructionListType & instructionList,
     }
 }
 
-void RunAndValidateSequence(AttributeInstructionListType list)
+void RunAndValidateSequence(AttributeInstructionListType list, ClusterStateCache::StorageMode storageMode)
 {
     ForwardedDataCallbackValidator dataCallbackValidator;
     CacheValidator client(list, dataCallbackValidator);
-    ClusterStateCache cache(client);
+    ClusterStateCache cache(client, Optional<EventNumber>::Missing(), true, storageMode);
 
     // In order for the cache to track our data versions, we need to claim to it
     // that we are dealing with a wildcard path.  And we need to do that before
@@ -614,6 +614,12 @@ void RunAndValidateSequence(AttributeInstructionListType list)
     } while (true);
 }
 
+void RunAndValidateSequence(AttributeInstructionListType list)
+{
+    RunAndValidateSequence(list, ClusterStateCache::StorageMode::kNested);
+    RunAndValidateSequence(list, ClusterStateCache::StorageMode::kFlat);
+}
+
 /*
  * This validates the cache by issuing different sequences of attribute combinations
  * and ensuring that the latest view in the cache matches up with expectations.
@@ -50,6 +50,8 @@
 namespace {
 
 static const chip::ClusterId kLivenessClusterId   = 0x00000022;
+static const chip::ClusterId kOtherClusterId      = 0x0000002F;
+static const chip::ClusterId kUnusedClusterId     = 0x00000030;
 static const uint32_t kLivenessChangeEvent        = 1;
 static const chip::EndpointId kTestEndpointId1    = 2;
 static const chip::EndpointId kTestEndpointId2    = 3;
@@ -311,9 +313,153 @@ static void CheckLogEventWithDiscardLowEvent(nlTestSuite * apSuite, void * apCon
     CheckLogState(apSuite, logMgmt, 3, chip::app::PriorityLevel::Debug);
 }
 
+static size_t FetchEventCount(chip::app::EventManagement & aLogMgmt, chip::EventNumber & aEventMin,
+                              chip::app::ObjectList<chip::app::EventPathParams> * apPaths)
+{
+    chip::TLV::TLVWriter writer;
+    size_t eventCount = 0;
+    uint8_t backingStore[1024];
+
+    writer.Init(backingStore, sizeof(backingStore));
+    CHIP_ERROR err = aLogMgmt.FetchEventsSince(writer, apPaths, aEventMin, eventCount, chip::Access::SubjectDescriptor{});
+    VerifyOrReturnValue(err == CHIP_NO_ERROR || err == CHIP_END_OF_TLV, SIZE_MAX);
+    return eventCount;
+}
+
+static void CheckFetchEventsSinceSkipsOlderEvents(nlTestSuite * apSuite, void * apContext)
+{
+    chip::app::EventManagement & logMgmt = chip::app::EventManagement::GetInstance();
+    chip::EventNumber eids[6];
+    chip::EventNumber eventMin;
+    chip::app::EventOptions options;
+    TestEventGenerator testEventGenerator;
+
+    // Alternate between two clusters; the events end up spread over the debug and info buffers.
+    options.mPriority = chip::app::PriorityLevel::Info;
+    for (size_t i = 0; i < ArraySize(eids); i++)
+    {
+        options.mPath = { kTestEndpointId1, (i % 2 == 0) ? kLivenessClusterId : kOtherClusterId, kLivenessChangeEvent };
+        testEventGenerator.SetStatus(static_cast<int32_t>(i));
+        NL_TEST_ASSERT(apSuite, logMgmt.LogEvent(&testEventGenerator, options, eids[i]) == CHIP_NO_ERROR);
+    }
+    CheckLogState(apSuite, logMgmt, 6, chip::app::PriorityLevel::Info);
+
+    chip::app::ObjectList<chip::app::EventPathParams> wildcardPath;
+    for (size_t i = 0; i < ArraySize(eids); i++)
+    {
+        eventMin = eids[i];
+        NL_TEST_ASSERT(apSuite, FetchEventCount(logMgmt, eventMin, &wildcardPath) == ArraySize(eids) - i);
+        NL_TEST_ASSERT(apSuite, eventMin == eids[5] + 1);
+    }
+
+    chip::app::ObjectList<chip::app::EventPathParams> otherClusterPath;
+    otherClusterPath.mValue.mClusterId = kOtherClusterId;
+    eventMin                           = 0;
+    NL_TEST_ASSERT(apSuite, FetchEventCount(logMgmt, eventMin, &otherClusterPath) == 3);
+    NL_TEST_ASSERT(apSuite, eventMin == eids[5] + 1);
+    eventMin = eids[4];
+    NL_TEST_ASSERT(apSuite, FetchEventCount(logMgmt, eventMin, &otherClusterPath) == 1);
+
+    // No event of this cluster was logged: nothing is fetched, but the next read still starts after the newest event.
+    chip::app::ObjectList<chip::app::EventPathParams> unusedClusterPath;
+    unusedClusterPath.mValue.mClusterId = kUnusedClusterId;
+    eventMin                            = 0;
+    NL_TEST_ASSERT(apSuite, FetchEventCount(logMgmt, eventMin, &unusedClusterPath) == 0);
+    NL_TEST_ASSERT(apSuite, eventMin == eids[5] + 1);
+
+    // Nothing newer than the newest event.
+    eventMin = eids[5] + 1;
+    NL_TEST_ASSERT(apSuite, FetchEventCount(logMgmt, eventMin, &wildcardPath) == 0);
+}
+
+static void CheckEventsRestoredFromPersistentState(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx                    = *static_cast<TestContext *>(apContext);
+    chip::app::EventManagement & logMgmt = chip::app::EventManagement::GetInstance();
+    chip::app::PersistentEventBufferState states[3];
+    chip::app::LogStorageResources logStorageResources[] = {
+        { &gDebugEventBuffer[0], sizeof(gDebugEventBuffer), chip::app::PriorityLevel::Debug, &states[0] },
+        { &gInfoEventBuffer[0], sizeof(gInfoEventBuffer), chip::app::PriorityLevel::Info, &states[1] },
+        { &gCritEventBuffer[0], sizeof(gCritEventBuffer), chip::app::PriorityLevel::Critical, &states[2] },
+    };
+    chip::MonotonicallyIncreasingCounter<chip::EventNumber> eventCounter;
+    chip::EventNumber eids[5];
+    chip::EventNumber eventMin;
+    chip::app::EventOptions options;
+    TestEventGenerator testEventGenerator;
+    chip::app::ObjectList<chip::app::EventPathParams> wildcardPath;
+
+    // Without a valid saved state, the buffers start empty.
+    memset(states, 0, sizeof(states));
+    chip::app::EventManagement::DestroyEventManagement();
+    NL_TEST_ASSERT(apSuite, eventCounter.Init(100) == CHIP_NO_ERROR);
+    chip::app::EventManagement::CreateEventManagement(&ctx.GetExchangeManager(), ArraySize(logStorageResources),
+                                                      gCircularEventBuffer, logStorageResources, &eventCounter);
+    eventMin = 0;
+    NL_TEST_ASSERT(apSuite, FetchEventCount(logMgmt, eventMin, &wildcardPath) == 0);
+
+    options.mPath     = { kTestEndpointId1, kLivenessClusterId, kLivenessChangeEvent };
+    options.mPriority = chip::app::PriorityLevel::Info;
+    for (size_t i = 0; i < ArraySize(eids); i++)
+    {
+        testEventGenerator.SetStatus(static_cast<int32_t>(i));
+        NL_TEST_ASSERT(apSuite, logMgmt.LogEvent(&testEventGenerator, options, eids[i]) == CHIP_NO_ERROR);
+    }
+
+    // Restart with the same storage and a counter that was persisted ahead of the logged events.
+    chip::app::EventManagement::DestroyEventManagement();
+    NL_TEST_ASSERT(apSuite, eventCounter.Init(eids[4] + 10) == CHIP_NO_ERROR);
+    chip::app::EventManagement::CreateEventManagement(&ctx.GetExchangeManager(), ArraySize(logStorageResources),
+                                                      gCircularEventBuffer, logStorageResources, &eventCounter);
+    eventMin = 0;
+    NL_TEST_ASSERT(apSuite, FetchEventCount(logMgmt, eventMin, &wildcardPath) == ArraySize(eids));
+    NL_TEST_ASSERT(apSuite, eventMin == eids[4] + 1);
+    eventMin = eids[2];
+    NL_TEST_ASSERT(apSuite, FetchEventCount(logMgmt, eventMin, &wildcardPath) == 3);
+
+    // A crash while moving the oldest debug event to the info buffer leaves it in both buffers.
+    chip::app::EventManagement::DestroyEventManagement();
+    chip::TLV::CircularTLVReader reader;
+    chip::TLV::CircularTLVWriter writer;
+    const uint32_t availableInfoLength = gCircularEventBuffer[1].AvailableDataLength();
+    reader.Init(gCircularEventBuffer[0]);
+    writer.Init(gCircularEventBuffer[1]);
+    NL_TEST_ASSERT(apSuite, reader.Next() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, writer.CopyElement(reader) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, writer.Finalize() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, writer.GetLengthWritten() <= availableInfoLength);
+    gCircularEventBuffer[1].SaveState();
+
+    // ... and a crash while logging an event leaves it incomplete.
+    states[0].mDataLength--;
+
+    chip::app::EventManagement::CreateEventManagement(&ctx.GetExchangeManager(), ArraySize(logStorageResources),
+                                                      gCircularEventBuffer, logStorageResources, &eventCounter);
+    eventMin = 0;
+    NL_TEST_ASSERT(apSuite, FetchEventCount(logMgmt, eventMin, &wildcardPath) == ArraySize(eids) - 1);
+    NL_TEST_ASSERT(apSuite, eventMin == eids[3] + 1);
+
+    // New events are numbered after the restored ones.
+    chip::EventNumber eid;
+    NL_TEST_ASSERT(apSuite, logMgmt.LogEvent(&testEventGenerator, options, eid) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, eid == eids[4] + 10);
+    eventMin = eids[3] + 1;
+    NL_TEST_ASSERT(apSuite, FetchEventCount(logMgmt, eventMin, &wildcardPath) == 1);
+
+    // Events numbered ahead of the counter were logged before it was reset, and are dropped.
+    chip::app::EventManagement::DestroyEventManagement();
+    NL_TEST_ASSERT(apSuite, eventCounter.Init(0) == CHIP_NO_ERROR);
+    chip::app::EventManagement::CreateEventManagement(&ctx.GetExchangeManager(), ArraySize(logStorageResources),
+                                                      gCircularEventBuffer, logStorageResources, &eventCounter);
+    eventMin = 0;
+    NL_TEST_ASSERT(apSuite, FetchEventCount(logMgmt, eventMin, &wildcardPath) == 0);
+}
+
 const nlTest sTests[] = {
     NL_TEST_DEF("CheckLogEventWithEvictToNextBuffer", CheckLogEventWithEvictToNextBuffer),
     NL_TEST_DEF("CheckLogEventWithDiscardLowEvent", CheckLogEventWithDiscardLowEvent),
+    NL_TEST_DEF("CheckFetchEventsSinceSkipsOlderEvents", CheckFetchEventsSinceSkipsOlderEvents),
+    NL_TEST_DEF("CheckEventsRestoredFromPersistentState", CheckEventsRestoredFromPersistentState),
     NL_TEST_SENTINEL(),
 };
 
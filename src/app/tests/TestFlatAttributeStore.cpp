@@ -0,0 +1,234 @@
+/*
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/FlatAttributeStore.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/TLVReader.h>
+#include <lib/core/TLVWriter.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/UnitTestRegistration.h>
+
+#include <nlunit-test.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::app;
+
+constexpr EndpointId kEndpointCount   = 4;
+constexpr ClusterId kClusterCount     = 16;
+constexpr AttributeId kAttributeCount = 24;
+
+// Encodes aValue as an anonymous uint32 and stores it with SetData.
+CHIP_ERROR StoreValue(FlatAttributeStore & store, const ConcreteAttributePath & path, uint32_t aValue)
+{
+    uint8_t buffer[16];
+    TLV::TLVWriter writer;
+    writer.Init(buffer);
+    ReturnErrorOnFailure(writer.Put(TLV::AnonymousTag(), aValue));
+    ReturnErrorOnFailure(writer.Finalize());
+
+    TLV::TLVReader reader;
+    reader.Init(buffer, writer.GetLengthWritten());
+    ReturnErrorOnFailure(reader.Next());
+    return store.SetData(path, reader, writer.GetLengthWritten());
+}
+
+bool HasValue(const FlatAttributeStore & store, const ConcreteAttributePath & path, uint32_t aValue)
+{
+    const FlatAttributeStore::Attribute * attribute = store.FindAttribute(path);
+    VerifyOrReturnValue(attribute != nullptr && attribute->IsData(), false);
+
+    TLV::TLVReader reader;
+    reader.Init(attribute->GetData());
+    uint32_t value = 0;
+    VerifyOrReturnValue(reader.Next() == CHIP_NO_ERROR && reader.Get(value) == CHIP_NO_ERROR, false);
+    return value == aValue;
+}
+
+uint32_t ValueFor(EndpointId endpoint, ClusterId cluster, AttributeId attribute, uint32_t generation)
+{
+    return (static_cast<uint32_t>(endpoint) << 24) ^ (cluster << 16) ^ (attribute << 8) ^ generation;
+}
+
+void TestLookup(nlTestSuite * inSuite, void * inContext)
+{
+    FlatAttributeStore store;
+
+    NL_TEST_ASSERT(inSuite, store.FindAttribute(ConcreteAttributePath(0, 0, 0)) == nullptr);
+    NL_TEST_ASSERT(inSuite, store.FindCluster(0, 0) == nullptr);
+    NL_TEST_ASSERT(inSuite, !store.HasEndpoint(0));
+
+    // Enough attributes for the tables to be resized several times.
+    for (EndpointId e = 0; e < kEndpointCount; e++)
+    {
+        for (ClusterId c = 0; c < kClusterCount; c++)
+        {
+            for (AttributeId a = 0; a < kAttributeCount; a++)
+            {
+                NL_TEST_ASSERT(inSuite, StoreValue(store, ConcreteAttributePath(e, c, a), ValueFor(e, c, a, 0)) == CHIP_NO_ERROR);
+            }
+        }
+    }
+
+    for (EndpointId e = 0; e < kEndpointCount; e++)
+    {
+        NL_TEST_ASSERT(inSuite, store.HasEndpoint(e));
+        for (ClusterId c = 0; c < kClusterCount; c++)
+        {
+            NL_TEST_ASSERT(inSuite, store.FindCluster(e, c) != nullptr);
+
+            uint32_t seen = 0;
+            NL_TEST_ASSERT(inSuite,
+                           store.ForEachAttribute(e, c, [&](AttributeId a, const FlatAttributeStore::Attribute & attribute) {
+                               NL_TEST_ASSERT(inSuite, a < kAttributeCount);
+                               NL_TEST_ASSERT(inSuite, attribute.IsData());
+                               seen |= (1u << a);
+                               return CHIP_NO_ERROR;
+                           }) == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(inSuite, seen == (1u << kAttributeCount) - 1);
+
+            for (AttributeId a = 0; a < kAttributeCount; a++)
+            {
+                NL_TEST_ASSERT(inSuite, HasValue(store, ConcreteAttributePath(e, c, a), ValueFor(e, c, a, 0)));
+            }
+        }
+    }
+
+    NL_TEST_ASSERT(inSuite, !store.HasEndpoint(kEndpointCount));
+    NL_TEST_ASSERT(inSuite, store.FindCluster(0, kClusterCount) == nullptr);
+    NL_TEST_ASSERT(inSuite, store.FindAttribute(ConcreteAttributePath(0, 0, kAttributeCount)) == nullptr);
+    NL_TEST_ASSERT(inSuite, store.ForEachAttribute(0, kClusterCount, [](AttributeId, const FlatAttributeStore::Attribute &) {
+        return CHIP_NO_ERROR;
+    }) == CHIP_ERROR_KEY_NOT_FOUND);
+
+    size_t clusters = 0;
+    NL_TEST_ASSERT(inSuite, store.ForEachCluster([&](EndpointId, ClusterId, const FlatAttributeStore::ClusterVersions &) {
+        clusters++;
+        return CHIP_NO_ERROR;
+    }) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, clusters == kEndpointCount * kClusterCount);
+}
+
+void TestStates(nlTestSuite * inSuite, void * inContext)
+{
+    FlatAttributeStore store;
+    const ConcreteAttributePath path(1, 6, 0);
+
+    NL_TEST_ASSERT(inSuite, StoreValue(store, path, 42) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, HasValue(store, path, 42));
+
+    StatusIB status(Protocols::InteractionModel::Status::Failure, 7);
+    NL_TEST_ASSERT(inSuite, store.SetStatus(path, status) == CHIP_NO_ERROR);
+    const FlatAttributeStore::Attribute * attribute = store.FindAttribute(path);
+    NL_TEST_ASSERT(inSuite, attribute != nullptr && attribute->IsStatus() && !attribute->IsData());
+    NL_TEST_ASSERT(inSuite, attribute != nullptr && attribute->GetStatus().mStatus == status.mStatus);
+    NL_TEST_ASSERT(inSuite, attribute != nullptr && attribute->GetStatus().mClusterStatus.ValueOr(0) == 7);
+
+    NL_TEST_ASSERT(inSuite, store.SetSize(path, 123) == CHIP_NO_ERROR);
+    attribute = store.FindAttribute(path);
+    NL_TEST_ASSERT(inSuite, attribute != nullptr && !attribute->IsStatus() && !attribute->IsData());
+    NL_TEST_ASSERT(inSuite, attribute != nullptr && attribute->GetSize() == 123);
+
+    FlatAttributeStore::ClusterVersions * versions = store.FindCluster(1, 6);
+    NL_TEST_ASSERT(inSuite, versions != nullptr);
+    if (versions != nullptr)
+    {
+        versions->mCommittedDataVersion.SetValue(5);
+    }
+    NL_TEST_ASSERT(inSuite, StoreValue(store, path, 43) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, HasValue(store, path, 43));
+    versions = store.FindCluster(1, 6);
+    NL_TEST_ASSERT(inSuite, versions != nullptr && versions->mCommittedDataVersion.ValueOr(0) == 5);
+}
+
+void TestCompact(nlTestSuite * inSuite, void * inContext)
+{
+    FlatAttributeStore store;
+
+    for (AttributeId a = 0; a < kAttributeCount; a++)
+    {
+        NL_TEST_ASSERT(inSuite, StoreValue(store, ConcreteAttributePath(0, 0, a), ValueFor(0, 0, a, 0)) == CHIP_NO_ERROR);
+    }
+
+    // Nothing to reclaim yet.
+    ByteSpan before = store.FindAttribute(ConcreteAttributePath(0, 0, 0))->GetData();
+    store.Compact();
+    NL_TEST_ASSERT(inSuite, store.FindAttribute(ConcreteAttributePath(0, 0, 0))->GetData().data() == before.data());
+
+    // Replaced values stay where they are until compaction.
+    uint32_t generation = 1;
+    for (; generation < 5000; generation++)
+    {
+        NL_TEST_ASSERT(inSuite, StoreValue(store, ConcreteAttributePath(0, 0, 1), ValueFor(0, 0, 1, generation)) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, store.FindAttribute(ConcreteAttributePath(0, 0, 0))->GetData().data() == before.data());
+
+    size_t usageBefore = store.GetMemoryUsage();
+    store.Compact();
+    NL_TEST_ASSERT(inSuite, store.GetMemoryUsage() < usageBefore);
+
+    NL_TEST_ASSERT(inSuite, HasValue(store, ConcreteAttributePath(0, 0, 1), ValueFor(0, 0, 1, generation - 1)));
+    for (AttributeId a = 0; a < kAttributeCount; a++)
+    {
+        if (a != 1)
+        {
+            NL_TEST_ASSERT(inSuite, HasValue(store, ConcreteAttributePath(0, 0, a), ValueFor(0, 0, a, 0)));
+        }
+    }
+}
+
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("TestLookup", TestLookup),
+    NL_TEST_DEF("TestStates", TestStates),
+    NL_TEST_DEF("TestCompact", TestCompact),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int TestSetup(void * inContext)
+{
+    return Platform::MemoryInit() == CHIP_NO_ERROR ? SUCCESS : FAILURE;
+}
+
+int TestTeardown(void * inContext)
+{
+    Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+} // namespace
+
+int TestFlatAttributeStore()
+{
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "FlatAttributeStore",
+        &sTests[0],
+        TestSetup,
+        TestTeardown,
+    };
+    // clang-format on
+
+    nlTestRunner(&theSuite, nullptr);
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestFlatAttributeStore)
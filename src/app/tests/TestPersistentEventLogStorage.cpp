@@ -0,0 +1,322 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a test for the memory-mapped event log file of the server.
+ *
+ */
+
+#include <access/SubjectDescriptor.h>
+#include <app/EventLoggingDelegate.h>
+#include <app/EventManagement.h>
+#include <app/server/PersistentEventLogStorage.h>
+#include <app/tests/AppTestContext.h>
+#include <lib/support/CHIPCounter.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/UnitTestContext.h>
+#include <lib/support/UnitTestRegistration.h>
+
+#include <nlunit-test.h>
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+using chip::app::LogStorageResources;
+using chip::app::PersistentEventBufferState;
+using chip::app::PersistentEventLogStorage;
+using chip::app::PriorityLevel;
+using TestContext = chip::Test::AppContext;
+
+static const chip::ClusterId kLivenessClusterId   = 0x00000022;
+static const uint32_t kLivenessChangeEvent        = 1;
+static const chip::EndpointId kTestEndpointId     = 2;
+static const chip::TLV::Tag kLivenessDeviceStatus = chip::TLV::ContextTag(1);
+
+static constexpr size_t kBufferCount                 = 3;
+static constexpr uint32_t kBufferSizes[kBufferCount] = { 128, 128, 128 };
+static constexpr chip::System::Clock::Milliseconds32 kNoDelay{ 0 };
+static chip::app::CircularEventBuffer gCircularEventBuffer[kBufferCount];
+
+class TempFile
+{
+public:
+    TempFile()
+    {
+        strcpy(mPath, "/tmp/chip-event-log-test-XXXXXX");
+        int fd = mkstemp(mPath);
+        VerifyOrDie(fd >= 0);
+        close(fd);
+        // Start from a missing file, as a device that never logged an event.
+        unlink(mPath);
+    }
+    ~TempFile() { unlink(mPath); }
+
+    const char * Path() const { return mPath; }
+
+    size_t Size() const
+    {
+        struct stat st;
+        return (stat(mPath, &st) == 0) ? static_cast<size_t>(st.st_size) : 0;
+    }
+
+private:
+    char mPath[64];
+};
+
+class TestEventGenerator : public chip::app::EventLoggingDelegate
+{
+public:
+    CHIP_ERROR WriteEvent(chip::TLV::TLVWriter & aWriter)
+    {
+        chip::TLV::TLVType dataContainerType;
+        ReturnErrorOnFailure(aWriter.StartContainer(chip::TLV::ContextTag(chip::to_underlying(chip::app::EventDataIB::Tag::kData)),
+                                                    chip::TLV::kTLVType_Structure, dataContainerType));
+        ReturnErrorOnFailure(aWriter.Put(kLivenessDeviceStatus, mStatus));
+        return aWriter.EndContainer(dataContainerType);
+    }
+
+    void SetStatus(int32_t aStatus) { mStatus = aStatus; }
+
+private:
+    int32_t mStatus;
+};
+
+// The buffers and their persistent state are pointed into the file by PersistentEventLogStorage::Init.
+static void MakeResources(LogStorageResources (&aResources)[kBufferCount], const uint32_t (&aSizes)[kBufferCount])
+{
+    const PriorityLevel priorities[] = { PriorityLevel::Debug, PriorityLevel::Info, PriorityLevel::Critical };
+    for (size_t i = 0; i < ArraySize(aResources); i++)
+    {
+        aResources[i]             = LogStorageResources();
+        aResources[i].mBufferSize = aSizes[i];
+        aResources[i].mPriority   = priorities[i];
+    }
+}
+
+static size_t AlignSegment(size_t aSize)
+{
+    return (aSize + 7) & ~static_cast<size_t>(7);
+}
+
+static size_t FetchEventCount(chip::EventNumber & aEventMin)
+{
+    chip::app::ObjectList<chip::app::EventPathParams> wildcardPath;
+    chip::TLV::TLVWriter writer;
+    size_t eventCount = 0;
+    uint8_t backingStore[1024];
+
+    writer.Init(backingStore, sizeof(backingStore));
+    CHIP_ERROR err = chip::app::EventManagement::GetInstance().FetchEventsSince(writer, &wildcardPath, aEventMin, eventCount,
+                                                                               chip::Access::SubjectDescriptor{});
+    VerifyOrReturnValue(err == CHIP_NO_ERROR || err == CHIP_END_OF_TLV, SIZE_MAX);
+    return eventCount;
+}
+
+static void LogEvents(nlTestSuite * apSuite, chip::EventNumber * apEventNumbers, size_t aCount)
+{
+    chip::app::EventOptions options;
+    TestEventGenerator testEventGenerator;
+
+    options.mPath     = { kTestEndpointId, kLivenessClusterId, kLivenessChangeEvent };
+    options.mPriority = PriorityLevel::Info;
+    for (size_t i = 0; i < aCount; i++)
+    {
+        testEventGenerator.SetStatus(static_cast<int32_t>(i));
+        NL_TEST_ASSERT(apSuite,
+                       chip::app::EventManagement::GetInstance().LogEvent(&testEventGenerator, options, apEventNumbers[i]) ==
+                           CHIP_NO_ERROR);
+    }
+}
+
+static void CheckFileLayout(nlTestSuite * apSuite, void * apContext)
+{
+    TempFile file;
+    PersistentEventLogStorage storage;
+    LogStorageResources resources[kBufferCount];
+
+    MakeResources(resources, kBufferSizes);
+    NL_TEST_ASSERT(apSuite, storage.Init(file.Path(), resources, 0, kNoDelay) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(apSuite,
+                   storage.Init(file.Path(), resources, PersistentEventLogStorage::kMaxBuffers + 1, kNoDelay) ==
+                       CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(apSuite, storage.Init("/nonexistent/chip-event-log", resources, kBufferCount, kNoDelay) != CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, resources[0].mpBuffer == nullptr && resources[0].mpPersistentState == nullptr);
+
+    NL_TEST_ASSERT(apSuite, storage.Init(file.Path(), resources, kBufferCount, kNoDelay) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, storage.Init(file.Path(), resources, kBufferCount, kNoDelay) == CHIP_ERROR_INCORRECT_STATE);
+
+    // The file header is followed by one segment per buffer: its aligned persistent state, then its storage.
+    // The mapping starts on a page boundary, so the offset of the first segment is that of its address in the page.
+    const size_t headerSize = reinterpret_cast<uintptr_t>(resources[0].mpPersistentState) % static_cast<size_t>(getpagesize());
+    size_t expectedSize     = headerSize;
+    NL_TEST_ASSERT(apSuite, headerSize > 0 && headerSize == AlignSegment(headerSize));
+    for (size_t i = 0; i < kBufferCount; i++)
+    {
+        uint8_t * segment = reinterpret_cast<uint8_t *>(resources[i].mpPersistentState);
+        NL_TEST_ASSERT(apSuite, reinterpret_cast<uintptr_t>(segment) % alignof(PersistentEventBufferState) == 0);
+        NL_TEST_ASSERT(apSuite, resources[i].mpBuffer == segment + sizeof(PersistentEventBufferState));
+        if (i > 0)
+        {
+            NL_TEST_ASSERT(apSuite,
+                           segment ==
+                               reinterpret_cast<uint8_t *>(resources[i - 1].mpPersistentState) +
+                                   AlignSegment(sizeof(PersistentEventBufferState) + kBufferSizes[i - 1]));
+        }
+        expectedSize += AlignSegment(sizeof(PersistentEventBufferState) + kBufferSizes[i]);
+    }
+    NL_TEST_ASSERT(apSuite, file.Size() == expectedSize);
+
+    // The buffers of a new file hold no state.
+    for (auto & resource : resources)
+    {
+        PersistentEventBufferState zero;
+        memset(&zero, 0, sizeof(zero));
+        NL_TEST_ASSERT(apSuite, memcmp(resource.mpPersistentState, &zero, sizeof(zero)) == 0);
+    }
+
+    storage.Shutdown();
+    NL_TEST_ASSERT(apSuite, storage.Sync() == CHIP_ERROR_INCORRECT_STATE);
+}
+
+static void CheckEventsSurviveReInit(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    TempFile file;
+    PersistentEventLogStorage storage;
+    LogStorageResources resources[kBufferCount];
+    chip::MonotonicallyIncreasingCounter<chip::EventNumber> eventCounter;
+    chip::EventNumber eids[3];
+    chip::EventNumber eventMin;
+
+    MakeResources(resources, kBufferSizes);
+    NL_TEST_ASSERT(apSuite, storage.Init(file.Path(), resources, kBufferCount, kNoDelay) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, eventCounter.Init(100) == CHIP_NO_ERROR);
+    chip::app::EventManagement::CreateEventManagement(&ctx.GetExchangeManager(), kBufferCount, gCircularEventBuffer,
+                                                      resources, &eventCounter);
+    chip::app::EventManagement::GetInstance().SetStorageDelegate(&storage);
+    LogEvents(apSuite, eids, ArraySize(eids));
+    chip::app::EventManagement::DestroyEventManagement();
+    storage.Shutdown();
+
+    // A restart maps the same file, with resources that point into a new mapping.
+    MakeResources(resources, kBufferSizes);
+    NL_TEST_ASSERT(apSuite, storage.Init(file.Path(), resources, kBufferCount, kNoDelay) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, eventCounter.Init(eids[2] + 10) == CHIP_NO_ERROR);
+    chip::app::EventManagement::CreateEventManagement(&ctx.GetExchangeManager(), kBufferCount, gCircularEventBuffer,
+                                                      resources, &eventCounter);
+    chip::app::EventManagement::GetInstance().SetStorageDelegate(&storage);
+    eventMin = 0;
+    NL_TEST_ASSERT(apSuite, FetchEventCount(eventMin) == ArraySize(eids));
+    NL_TEST_ASSERT(apSuite, eventMin == eids[2] + 1);
+    chip::app::EventManagement::DestroyEventManagement();
+    storage.Shutdown();
+}
+
+static void CheckMismatchedFileIsReset(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    TempFile file;
+    PersistentEventLogStorage storage;
+    LogStorageResources resources[kBufferCount];
+    chip::MonotonicallyIncreasingCounter<chip::EventNumber> eventCounter;
+    chip::EventNumber eids[3];
+    chip::EventNumber eventMin;
+    const uint32_t resizedBufferSizes[] = { kBufferSizes[0], 2 * kBufferSizes[1], kBufferSizes[2] };
+
+    MakeResources(resources, kBufferSizes);
+    NL_TEST_ASSERT(apSuite, storage.Init(file.Path(), resources, kBufferCount, kNoDelay) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, eventCounter.Init(100) == CHIP_NO_ERROR);
+    chip::app::EventManagement::CreateEventManagement(&ctx.GetExchangeManager(), kBufferCount, gCircularEventBuffer,
+                                                      resources, &eventCounter);
+    chip::app::EventManagement::GetInstance().SetStorageDelegate(&storage);
+    LogEvents(apSuite, eids, ArraySize(eids));
+    chip::app::EventManagement::DestroyEventManagement();
+    storage.Shutdown();
+    const size_t originalSize = file.Size();
+
+    // A build with a larger info buffer resizes the file and drops the events laid out for the old buffers.
+    MakeResources(resources, resizedBufferSizes);
+    NL_TEST_ASSERT(apSuite, storage.Init(file.Path(), resources, kBufferCount, kNoDelay) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, file.Size() == originalSize + kBufferSizes[1]);
+    NL_TEST_ASSERT(apSuite, eventCounter.Init(eids[2] + 10) == CHIP_NO_ERROR);
+    chip::app::EventManagement::CreateEventManagement(&ctx.GetExchangeManager(), kBufferCount, gCircularEventBuffer,
+                                                      resources, &eventCounter);
+    eventMin = 0;
+    NL_TEST_ASSERT(apSuite, FetchEventCount(eventMin) == 0);
+    chip::app::EventManagement::DestroyEventManagement();
+    storage.Shutdown();
+
+    // So does a corrupted file header, even with the right size.
+    MakeResources(resources, kBufferSizes);
+    NL_TEST_ASSERT(apSuite, storage.Init(file.Path(), resources, kBufferCount, kNoDelay) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, file.Size() == originalSize);
+    chip::app::EventManagement::CreateEventManagement(&ctx.GetExchangeManager(), kBufferCount, gCircularEventBuffer,
+                                                      resources, &eventCounter);
+    chip::app::EventManagement::GetInstance().SetStorageDelegate(&storage);
+    LogEvents(apSuite, eids, ArraySize(eids));
+    chip::app::EventManagement::DestroyEventManagement();
+    storage.Shutdown();
+
+    int fd = open(file.Path(), O_WRONLY);
+    NL_TEST_ASSERT(apSuite, fd >= 0);
+    const uint8_t badMagic = 0;
+    NL_TEST_ASSERT(apSuite, pwrite(fd, &badMagic, sizeof(badMagic), 0) == static_cast<ssize_t>(sizeof(badMagic)));
+    close(fd);
+
+    MakeResources(resources, kBufferSizes);
+    NL_TEST_ASSERT(apSuite, storage.Init(file.Path(), resources, kBufferCount, kNoDelay) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, file.Size() == originalSize);
+    NL_TEST_ASSERT(apSuite, eventCounter.Init(eids[2] + 10) == CHIP_NO_ERROR);
+    chip::app::EventManagement::CreateEventManagement(&ctx.GetExchangeManager(), kBufferCount, gCircularEventBuffer,
+                                                      resources, &eventCounter);
+    eventMin = 0;
+    NL_TEST_ASSERT(apSuite, FetchEventCount(eventMin) == 0);
+    chip::app::EventManagement::DestroyEventManagement();
+    storage.Shutdown();
+}
+
+const nlTest sTests[] = {
+    NL_TEST_DEF("CheckFileLayout", CheckFileLayout),
+    NL_TEST_DEF("CheckEventsSurviveReInit", CheckEventsSurviveReInit),
+    NL_TEST_DEF("CheckMismatchedFileIsReset", CheckMismatchedFileIsReset),
+    NL_TEST_SENTINEL(),
+};
+
+nlTestSuite sSuite = {
+    "PersistentEventLogStorage",
+    &sTests[0],
+    TestContext::nlTestSetUpTestSuite,
+    TestContext::nlTestTearDownTestSuite,
+    TestContext::nlTestSetUp,
+    TestContext::nlTestTearDown,
+};
+
+} // namespace
+
+int TestPersistentEventLogStorage()
+{
+    return chip::ExecuteTestsWithContext<TestContext>(&sSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestPersistentEventLogStorage)
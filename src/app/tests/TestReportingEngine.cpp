@@ -57,6 +57,7 @@ public:
     static void TestBuildAndSendSingleReportData(nlTestSuite * apSuite, void * apContext);
     static void TestMergeOverlappedAttributePath(nlTestSuite * apSuite, void * apContext);
     static void TestMergeAttributePathWhenDirtySetPoolExhausted(nlTestSuite * apSuite, void * apContext);
+    static void TestDirtySetGenerations(nlTestSuite * apSuite, void * apContext);
 
 private:
     static bool InsertToDirtySet(const AttributePathParams & aPath);
@@ -73,7 +74,7 @@ private:
         const int size                        = sizeof...(args);
         ExpectedDirtySetContent content[size] = { ExpectedDirtySetContent(args)... };
 
-        if (InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.ForEachActiveObject([&](auto * path) {
+        if (InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.ForEachPath([&](auto * path) {
                 for (int i = 0; i < size; i++)
                 {
                     if (static_cast<AttributePathParams>(content[i]) == static_cast<AttributePathParams>(*path))
@@ -176,18 +177,17 @@ void TestReportingEngine::TestMergeOverlappedAttributePath(nlTestSuite * apSuite
                                                                     app::reporting::GetDefaultReportScheduler());
     NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
 
-    AttributePathParams * clusterInfo = InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.CreateObject();
-    clusterInfo->mEndpointId          = 1;
-    clusterInfo->mClusterId           = 1;
-    clusterInfo->mAttributeId         = 1;
+    Engine & engine = InteractionModelEngine::GetInstance()->GetReportingEngine();
+    engine.mGlobalDirtySet.Clear();
+    NL_TEST_ASSERT(apSuite, InsertToDirtySet(AttributePathParams(1, 1, 1)));
+    const uint64_t generation = engine.GetDirtySetGeneration();
 
     {
         AttributePathParams testClusterInfo;
         testClusterInfo.mEndpointId  = 1;
         testClusterInfo.mClusterId   = 1;
         testClusterInfo.mAttributeId = 3;
-        NL_TEST_ASSERT(apSuite,
-                       !InteractionModelEngine::GetInstance()->GetReportingEngine().MergeOverlappedAttributePath(testClusterInfo));
+        NL_TEST_ASSERT(apSuite, !engine.mGlobalDirtySet.MergeOverlapped(testClusterInfo, generation));
     }
     {
         AttributePathParams testClusterInfo;
@@ -195,8 +195,7 @@ void TestReportingEngine::TestMergeOverlappedAttributePath(nlTestSuite * apSuite
         testClusterInfo.mClusterId   = 1;
         testClusterInfo.mAttributeId = 1;
         testClusterInfo.mListIndex   = 2;
-        NL_TEST_ASSERT(apSuite,
-                       InteractionModelEngine::GetInstance()->GetReportingEngine().MergeOverlappedAttributePath(testClusterInfo));
+        NL_TEST_ASSERT(apSuite, engine.mGlobalDirtySet.MergeOverlapped(testClusterInfo, generation));
     }
 
     {
@@ -204,17 +203,17 @@ void TestReportingEngine::TestMergeOverlappedAttributePath(nlTestSuite * apSuite
         testClusterInfo.mEndpointId  = 1;
         testClusterInfo.mClusterId   = 1;
         testClusterInfo.mAttributeId = kInvalidAttributeId;
-        NL_TEST_ASSERT(apSuite,
-                       InteractionModelEngine::GetInstance()->GetReportingEngine().MergeOverlappedAttributePath(testClusterInfo));
+        NL_TEST_ASSERT(apSuite, engine.mGlobalDirtySet.MergeOverlapped(testClusterInfo, generation));
+        NL_TEST_ASSERT(apSuite, VerifyDirtySetContent(AttributePathParams(EndpointId(1), ClusterId(1))));
     }
 
     {
         AttributePathParams testClusterInfo;
+        testClusterInfo.mEndpointId  = 1;
         testClusterInfo.mClusterId   = kInvalidClusterId;
         testClusterInfo.mAttributeId = kInvalidAttributeId;
-        NL_TEST_ASSERT(apSuite,
-                       InteractionModelEngine::GetInstance()->GetReportingEngine().MergeOverlappedAttributePath(testClusterInfo));
-        NL_TEST_ASSERT(apSuite, clusterInfo->mClusterId == kInvalidClusterId && clusterInfo->mAttributeId == kInvalidAttributeId);
+        NL_TEST_ASSERT(apSuite, engine.mGlobalDirtySet.MergeOverlapped(testClusterInfo, generation));
+        NL_TEST_ASSERT(apSuite, VerifyDirtySetContent(AttributePathParams(EndpointId(1), kInvalidClusterId)));
     }
 
     {
@@ -222,22 +221,26 @@ void TestReportingEngine::TestMergeOverlappedAttributePath(nlTestSuite * apSuite
         testClusterInfo.mEndpointId  = kInvalidEndpointId;
         testClusterInfo.mClusterId   = kInvalidClusterId;
         testClusterInfo.mAttributeId = kInvalidAttributeId;
-        NL_TEST_ASSERT(apSuite,
-                       InteractionModelEngine::GetInstance()->GetReportingEngine().MergeOverlappedAttributePath(testClusterInfo));
-        NL_TEST_ASSERT(apSuite,
-                       clusterInfo->mEndpointId == kInvalidEndpointId && clusterInfo->mClusterId == kInvalidClusterId &&
-                           clusterInfo->mAttributeId == kInvalidAttributeId);
+        NL_TEST_ASSERT(apSuite, engine.mGlobalDirtySet.MergeOverlapped(testClusterInfo, generation));
+        NL_TEST_ASSERT(apSuite, VerifyDirtySetContent(AttributePathParams()));
     }
+
+    // A wildcard path replaces every path it covers, not just the first one.
+    engine.mGlobalDirtySet.Clear();
+    NL_TEST_ASSERT(apSuite, InsertToDirtySet(AttributePathParams(1, 1, 1)));
+    NL_TEST_ASSERT(apSuite, InsertToDirtySet(AttributePathParams(1, 2, 1)));
+    NL_TEST_ASSERT(apSuite, InsertToDirtySet(AttributePathParams(2, 1, 1)));
+    NL_TEST_ASSERT(apSuite, engine.mGlobalDirtySet.MergeOverlapped(AttributePathParams(kInvalidEndpointId, 1, 1), generation));
+    NL_TEST_ASSERT(apSuite, VerifyDirtySetContent(AttributePathParams(kInvalidEndpointId, 1, 1), AttributePathParams(1, 2, 1)));
+
     InteractionModelEngine::GetInstance()->GetReportingEngine().Shutdown();
 }
 
 bool TestReportingEngine::InsertToDirtySet(const AttributePathParams & aPath)
 {
-    auto path = InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.CreateObject();
-    VerifyOrReturnError(path != nullptr, false);
-    *path             = aPath;
-    path->mGeneration = InteractionModelEngine::GetInstance()->GetReportingEngine().GetDirtySetGeneration();
-    return true;
+    Engine & engine = InteractionModelEngine::GetInstance()->GetReportingEngine();
+    VerifyOrReturnError(engine.mGlobalDirtySet.Size() < CHIP_IM_SERVER_MAX_NUM_DIRTY_SET, false);
+    return engine.mGlobalDirtySet.Insert(aPath, engine.GetDirtySetGeneration()) == CHIP_NO_ERROR;
 }
 
 void TestReportingEngine::TestMergeAttributePathWhenDirtySetPoolExhausted(nlTestSuite * apSuite, void * apContext)
@@ -248,7 +251,7 @@ void TestReportingEngine::TestMergeAttributePathWhenDirtySetPoolExhausted(nlTest
                                                                     app::reporting::GetDefaultReportScheduler());
     NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
 
-    InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.ReleaseAll();
+    InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.Clear();
     InteractionModelEngine::GetInstance()->GetReportingEngine().BumpDirtySetGeneration();
 
     // Case 1: All dirty paths including the new one are under the same cluster.
@@ -263,7 +266,7 @@ void TestReportingEngine::TestMergeAttributePathWhenDirtySetPoolExhausted(nlTest
                            AttributePathParams(kTestEndpointId, kTestClusterId, CHIP_IM_SERVER_MAX_NUM_DIRTY_SET + 1)));
     NL_TEST_ASSERT(apSuite, VerifyDirtySetContent(AttributePathParams(kTestEndpointId, kTestClusterId)));
 
-    InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.ReleaseAll();
+    InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.Clear();
 
     // Case 2: All dirty paths including the new one are under the same endpoint.
     // -> Expected behavior: The dirty set is replaced by a wildcard cluster path under the same endpoint.
@@ -277,7 +280,7 @@ void TestReportingEngine::TestMergeAttributePathWhenDirtySetPoolExhausted(nlTest
                            AttributePathParams(kTestEndpointId, ClusterId(CHIP_IM_SERVER_MAX_NUM_DIRTY_SET + 1), 1)));
     NL_TEST_ASSERT(apSuite, VerifyDirtySetContent(AttributePathParams(kTestEndpointId, kInvalidClusterId)));
 
-    InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.ReleaseAll();
+    InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.Clear();
 
     // Case 3: All dirty paths including the new one are under the different endpoints.
     // -> Expected behavior: The dirty set is replaced by a wildcard endpoint.
@@ -291,7 +294,7 @@ void TestReportingEngine::TestMergeAttributePathWhenDirtySetPoolExhausted(nlTest
                            AttributePathParams(EndpointId(CHIP_IM_SERVER_MAX_NUM_DIRTY_SET + 1), 1, 1)));
     NL_TEST_ASSERT(apSuite, VerifyDirtySetContent(AttributePathParams()));
 
-    InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.ReleaseAll();
+    InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.Clear();
 
     // Case 4: All existing dirty paths are under the same cluster, the new path comes from another cluster.
     // -> Expected behavior: The existing paths are merged into one single wildcard attribute path. New path is inserted as-is.
@@ -307,7 +310,7 @@ void TestReportingEngine::TestMergeAttributePathWhenDirtySetPoolExhausted(nlTest
                    VerifyDirtySetContent(AttributePathParams(kTestEndpointId, kTestClusterId),
                                          AttributePathParams(kTestEndpointId + 1, kTestClusterId + 1, 1)));
 
-    InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.ReleaseAll();
+    InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.Clear();
 
     // Case 5: All existing dirty paths are under the same endpoint, the new path comes from another endpoint.
     // -> Expected behavior: The existing paths are merged into one single wildcard cluster path. New path is inserted as-is.
@@ -323,6 +326,61 @@ void TestReportingEngine::TestMergeAttributePathWhenDirtySetPoolExhausted(nlTest
                    VerifyDirtySetContent(AttributePathParams(kTestEndpointId, kInvalidClusterId),
                                          AttributePathParams(kTestEndpointId + 1, kTestClusterId + 1, 1)));
 
+    InteractionModelEngine::GetInstance()->GetReportingEngine().mGlobalDirtySet.Clear();
+
+    // Case 6: Every dirty path is on its own endpoint, but they are all in the same cluster.
+    // -> Expected behavior: The dirty set is replaced by a wildcard endpoint path for that cluster.
+    for (EndpointId i = 1; i <= CHIP_IM_SERVER_MAX_NUM_DIRTY_SET; i++)
+    {
+        NL_TEST_ASSERT(apSuite, InsertToDirtySet(AttributePathParams(i, kTestClusterId, i)));
+    }
+    NL_TEST_ASSERT(apSuite,
+                   CHIP_NO_ERROR ==
+                       InteractionModelEngine::GetInstance()->GetReportingEngine().InsertPathIntoDirtySet(
+                           AttributePathParams(EndpointId(CHIP_IM_SERVER_MAX_NUM_DIRTY_SET + 1), kTestClusterId, 1)));
+    NL_TEST_ASSERT(apSuite, VerifyDirtySetContent(AttributePathParams(kInvalidEndpointId, kTestClusterId)));
+
+    InteractionModelEngine::GetInstance()->GetReportingEngine().Shutdown();
+}
+
+void TestReportingEngine::TestDirtySetGenerations(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    CHIP_ERROR err    = CHIP_NO_ERROR;
+    err               = InteractionModelEngine::GetInstance()->Init(&ctx.GetExchangeManager(), &ctx.GetFabricTable(),
+                                                                    app::reporting::GetDefaultReportScheduler());
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    Engine & engine = InteractionModelEngine::GetInstance()->GetReportingEngine();
+    engine.mGlobalDirtySet.Clear();
+
+    engine.BumpDirtySetGeneration();
+    const uint64_t first = engine.GetDirtySetGeneration();
+    NL_TEST_ASSERT(apSuite, InsertToDirtySet(AttributePathParams(kTestEndpointId, kTestClusterId, kTestFieldId1)));
+
+    engine.BumpDirtySetGeneration();
+    const uint64_t second = engine.GetDirtySetGeneration();
+    NL_TEST_ASSERT(apSuite, InsertToDirtySet(AttributePathParams(kInvalidEndpointId, kTestClusterId, kTestFieldId2)));
+
+    const ConcreteAttributePath field1(kTestEndpointId, kTestClusterId, kTestFieldId1);
+    const ConcreteAttributePath field2(kTestEndpointId + 1, kTestClusterId, kTestFieldId2);
+    const ConcreteAttributePath otherCluster(kTestEndpointId, kTestClusterId + 1, kTestFieldId1);
+
+    NL_TEST_ASSERT(apSuite, engine.mGlobalDirtySet.IsDirtySince(field1, first - 1));
+    NL_TEST_ASSERT(apSuite, !engine.mGlobalDirtySet.IsDirtySince(field1, first));
+    NL_TEST_ASSERT(apSuite, engine.mGlobalDirtySet.IsDirtySince(field2, first));
+    NL_TEST_ASSERT(apSuite, !engine.mGlobalDirtySet.IsDirtySince(field2, second));
+    NL_TEST_ASSERT(apSuite, !engine.mGlobalDirtySet.IsDirtySince(otherCluster, 0));
+
+    // Marking field1 dirty on every endpoint replaces the concrete path, at the new generation.
+    engine.BumpDirtySetGeneration();
+    NL_TEST_ASSERT(apSuite, InsertToDirtySet(AttributePathParams(kInvalidEndpointId, kTestClusterId, kTestFieldId1)));
+    NL_TEST_ASSERT(apSuite,
+                   VerifyDirtySetContent(AttributePathParams(kInvalidEndpointId, kTestClusterId, kTestFieldId1),
+                                         AttributePathParams(kInvalidEndpointId, kTestClusterId, kTestFieldId2)));
+    NL_TEST_ASSERT(apSuite, engine.mGlobalDirtySet.IsDirtySince(field1, second));
+    NL_TEST_ASSERT(apSuite, engine.mGlobalDirtySet.GetLatestGeneration() == engine.GetDirtySetGeneration());
+
     InteractionModelEngine::GetInstance()->GetReportingEngine().Shutdown();
 }
 
@@ -337,6 +395,7 @@ const nlTest sTests[] =
     NL_TEST_DEF("CheckBuildAndSendSingleReportData", chip::app::reporting::TestReportingEngine::TestBuildAndSendSingleReportData),
     NL_TEST_DEF("TestMergeOverlappedAttributePath", chip::app::reporting::TestReportingEngine::TestMergeOverlappedAttributePath),
     NL_TEST_DEF("TestMergeAttributePathWhenDirtySetPoolExhausted", chip::app::reporting::TestReportingEngine::TestMergeAttributePathWhenDirtySetPoolExhausted),
+    NL_TEST_DEF("TestDirtySetGenerations", chip::app::reporting::TestReportingEngine::TestDirtySetGenerations),
     NL_TEST_SENTINEL()
 };
 // clang-format on
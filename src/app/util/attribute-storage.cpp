@@ -88,6 +88,130 @@ uint8_t singletonAttributeData[ACTUAL_SINGLETONS_SIZE];
 
 uint16_t emberEndpointCount = 0;
 
+// Lookup structures over emAfEndpoints.  They only depend on the endpoint ids and endpoint types, so they are dropped
+// whenever one of those, or the endpoint count, changes (see InvalidateEndpointLookups) and rebuilt on next use.
+// Enabling or disabling an endpoint does not invalidate them: the enabled bit is checked on every lookup.
+
+constexpr size_t EndpointIndexTableSize(size_t minimum)
+{
+    size_t size = 1;
+    while (size < minimum)
+    {
+        size *= 2;
+    }
+    return size;
+}
+
+// Open-addressed table from endpoint id to endpoint index, at most half full so that probe sequences stay short.
+constexpr size_t kEndpointIndexTableSize = EndpointIndexTableSize(2 * MAX_ENDPOINT_COUNT);
+constexpr size_t kEndpointIndexTableMask = kEndpointIndexTableSize - 1;
+uint16_t endpointIndexTable[kEndpointIndexTableSize];
+bool endpointIndexTableValid = false;
+// The same endpoint id can be used by a fixed and a dynamic endpoint.  Lookups then need the first enabled match, so fall
+// back to scanning emAfEndpoints.
+bool endpointIndexTableHasDuplicates = false;
+
+// Small direct-mapped caches for the (endpoint, cluster) -> server cluster and (cluster, attribute) -> metadata lookups done
+// on every attribute access.  Misses are cached as well.
+constexpr size_t kLookupCacheSize = 16;
+
+struct ServerClusterCacheEntry
+{
+    uint16_t endpointIndex = kEmberInvalidEndpointIndex;
+    ClusterId clusterId    = kInvalidClusterId;
+    const EmberAfCluster * cluster;
+};
+ServerClusterCacheEntry serverClusterCache[kLookupCacheSize];
+
+struct AttributeMetadataCacheEntry
+{
+    const EmberAfCluster * cluster = nullptr;
+    AttributeId attributeId        = kInvalidAttributeId;
+    const EmberAfAttributeMetadata * metadata;
+};
+AttributeMetadataCacheEntry attributeMetadataCache[kLookupCacheSize];
+
+// Bumped together with the lookups being dropped; see emberAfMetadataStructureGeneration.
+unsigned metadataStructureGeneration = 0;
+
+void InvalidateEndpointLookups()
+{
+    metadataStructureGeneration++;
+    endpointIndexTableValid = false;
+    for (auto & entry : serverClusterCache)
+    {
+        entry = ServerClusterCacheEntry();
+    }
+    for (auto & entry : attributeMetadataCache)
+    {
+        entry = AttributeMetadataCacheEntry();
+    }
+}
+
+void BuildEndpointIndexTable()
+{
+    for (auto & slot : endpointIndexTable)
+    {
+        slot = kEmberInvalidEndpointIndex;
+    }
+    endpointIndexTableHasDuplicates = false;
+
+    for (uint16_t index = 0; index < emberEndpointCount; index++)
+    {
+        EndpointId endpoint = emAfEndpoints[index].endpoint;
+        if (endpoint == kInvalidEndpointId)
+        {
+            continue;
+        }
+
+        size_t slot = endpoint & kEndpointIndexTableMask;
+        while (endpointIndexTable[slot] != kEmberInvalidEndpointIndex)
+        {
+            if (emAfEndpoints[endpointIndexTable[slot]].endpoint == endpoint)
+            {
+                endpointIndexTableHasDuplicates = true;
+            }
+            slot = (slot + 1) & kEndpointIndexTableMask;
+        }
+        endpointIndexTable[slot] = index;
+    }
+
+    endpointIndexTableValid = true;
+}
+
+const EmberAfCluster * FindServerClusterByIndex(uint16_t endpointIndex, ClusterId clusterId)
+{
+    ServerClusterCacheEntry & entry = serverClusterCache[(clusterId + endpointIndex * 7u) % kLookupCacheSize];
+    if (entry.endpointIndex != endpointIndex || entry.clusterId != clusterId)
+    {
+        entry.endpointIndex = endpointIndex;
+        entry.clusterId     = clusterId;
+        entry.cluster       = emberAfFindClusterInType(emAfEndpoints[endpointIndex].endpointType, clusterId, CLUSTER_MASK_SERVER);
+    }
+    return entry.cluster;
+}
+
+const EmberAfAttributeMetadata * FindAttributeMetadataInCluster(const EmberAfCluster * cluster, AttributeId attributeId)
+{
+    size_t hash                         = reinterpret_cast<uintptr_t>(cluster) / sizeof(EmberAfCluster) + attributeId;
+    AttributeMetadataCacheEntry & entry = attributeMetadataCache[hash % kLookupCacheSize];
+    if (entry.cluster != cluster || entry.attributeId != attributeId)
+    {
+        entry.cluster     = cluster;
+        entry.attributeId = attributeId;
+        entry.metadata    = nullptr;
+        for (uint16_t i = 0; i < cluster->attributeCount; i++)
+        {
+            if (cluster->attributes[i].attributeId == attributeId)
+            {
+                entry.metadata = &cluster->attributes[i];
+                break;
+            }
+        }
+    }
+    return entry.metadata;
+}
+
 // If we have attributes that are more than 4 bytes, then
 // we need this data block for the defaults
 #if (defined(GENERATED_DEFAULTS) && GENERATED_DEFAULTS_COUNT)
@@ -235,11 +359,14 @@ void emberAfEndpointConfigure()
         }
     }
 #endif
+
+    InvalidateEndpointLookups();
 }
 
 void emberAfSetDynamicEndpointCount(uint16_t dynamicEndpointCount)
 {
     emberEndpointCount = static_cast<uint16_t>(FIXED_ENDPOINT_COUNT + dynamicEndpointCount);
+    InvalidateEndpointLookups();
 }
 
 uint16_t emberAfGetDynamicIndexFromEndpoint(EndpointId id)
@@ -297,6 +424,7 @@ EmberAfStatus emberAfSetDynamicEndpoint(uint16_t index, EndpointId id, const Emb
     // Start the endpoint off as disabled.
     emAfEndpoints[index].bitmask.Clear(EmberAfEndpointOptions::isEnabled);
     emAfEndpoints[index].parentEndpointId = parentEndpointId;
+    InvalidateEndpointLookups();
 
     emberAfSetDynamicEndpointCount(MAX_ENDPOINT_COUNT - FIXED_ENDPOINT_COUNT);
 
@@ -329,6 +457,7 @@ EndpointId emberAfClearDynamicEndpoint(uint16_t index)
         ep = emAfEndpoints[index].endpoint;
         emberAfEndpointEnableDisable(ep, false);
         emAfEndpoints[index].endpoint = kInvalidEndpointId;
+        InvalidateEndpointLookups();
     }
 
     return ep;
@@ -344,6 +473,11 @@ uint16_t emberAfEndpointCount()
     return emberEndpointCount;
 }
 
+unsigned emberAfMetadataStructureGeneration()
+{
+    return metadataStructureGeneration;
+}
+
 bool emberAfEndpointIndexIsEnabled(uint16_t index)
 {
     return (emAfEndpoints[index].bitmask.Has(EmberAfEndpointOptions::isEnabled));
@@ -462,16 +596,22 @@ void emAfCallInits()
 // Returns the pointer to metadata, or null if it is not found
 const EmberAfAttributeMetadata * emberAfLocateAttributeMetadata(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId)
 {
-    const EmberAfAttributeMetadata * metadata = nullptr;
-    EmberAfAttributeSearchRecord record;
-    record.endpoint    = endpoint;
-    record.clusterId   = clusterId;
-    record.attributeId = attributeId;
-    emAfReadOrWriteAttribute(&record, &metadata,
-                             nullptr, // buffer
-                             0,       // buffer size
-                             false);  // write?
-    return metadata;
+    // The lookups below read and fill the shared endpoint, cluster and attribute caches.
+    assertChipStackLockedByCurrentThread();
+
+    uint16_t ep = emberAfIndexFromEndpoint(endpoint);
+    if (ep == kEmberInvalidEndpointIndex)
+    {
+        return nullptr;
+    }
+
+    const EmberAfCluster * cluster = FindServerClusterByIndex(ep, clusterId);
+    if (cluster == nullptr)
+    {
+        return nullptr;
+    }
+
+    return FindAttributeMetadataInCluster(cluster, attributeId);
 }
 
 static uint8_t * singletonAttributeLocation(const EmberAfAttributeMetadata * am)
@@ -747,6 +887,8 @@ const EmberAfCluster * emberAfFindClusterInType(const EmberAfEndpointType * endp
 
 uint8_t emberAfClusterIndex(EndpointId endpoint, ClusterId clusterId, EmberAfClusterMask mask)
 {
+    // Not served from the endpoint index: while dynamic endpoints are being added and removed, several entries may carry the
+    // same endpoint id, and the first one that has the cluster wins.
     for (uint16_t ep = 0; ep < emberAfEndpointCount(); ep++)
     {
         // Check the endpoint id first, because that way we avoid examining the
@@ -835,7 +977,7 @@ const EmberAfCluster * emberAfFindServerCluster(EndpointId endpoint, ClusterId c
         return nullptr;
     }
 
-    return emberAfFindClusterInType(emAfEndpoints[ep].endpointType, clusterId, CLUSTER_MASK_SERVER);
+    return FindServerClusterByIndex(ep, clusterId);
 }
 
 // Returns cluster within the endpoint; Does not ignore disabled endpoints
@@ -857,6 +999,30 @@ static uint16_t findIndexFromEndpoint(EndpointId endpoint, bool ignoreDisabledEn
         return kEmberInvalidEndpointIndex;
     }
 
+    if (!endpointIndexTableValid)
+    {
+        BuildEndpointIndexTable();
+    }
+
+    if (!endpointIndexTableHasDuplicates)
+    {
+        size_t slot = endpoint & kEndpointIndexTableMask;
+        while (endpointIndexTable[slot] != kEmberInvalidEndpointIndex)
+        {
+            uint16_t epi = endpointIndexTable[slot];
+            if (emAfEndpoints[epi].endpoint == endpoint)
+            {
+                if (ignoreDisabledEndpoints && !emAfEndpoints[epi].bitmask.Has(EmberAfEndpointOptions::isEnabled))
+                {
+                    return kEmberInvalidEndpointIndex;
+                }
+                return epi;
+            }
+            slot = (slot + 1) & kEndpointIndexTableMask;
+        }
+        return kEmberInvalidEndpointIndex;
+    }
+
     uint16_t epi;
     for (epi = 0; epi < emberAfEndpointCount(); epi++)
     {
@@ -32,6 +32,16 @@
  */
 uint16_t emberAfEndpointCount(void);
 
+/**
+ * Returns a counter that changes whenever the set of endpoints, or the
+ * endpoint type of one of them, changes (e.g. when a dynamic endpoint is
+ * added or removed).  Enabling or disabling an endpoint does not change it.
+ *
+ * Endpoint, cluster and attribute indices obtained from the functions in this
+ * file can only be reused while this counter does not change.
+ */
+unsigned emberAfMetadataStructureGeneration(void);
+
 /**
  * @brief Enable/disable endpoints
  */
@@ -61,8 +61,9 @@ using namespace Clusters::Globals::Attributes;
 
 namespace {
 
-DataVersion dataVersion           = 0;
-const MockNodeConfig * mockConfig = nullptr;
+DataVersion dataVersion              = 0;
+const MockNodeConfig * mockConfig    = nullptr;
+unsigned metadataStructureGeneration = 0;
 
 const MockNodeConfig & DefaultMockNodeConfig()
 {
@@ -136,6 +137,11 @@ uint16_t emberAfEndpointCount()
     return static_cast<uint16_t>(GetMockNodeConfig().endpoints.size());
 }
 
+unsigned emberAfMetadataStructureGeneration()
+{
+    return metadataStructureGeneration;
+}
+
 uint16_t emberAfIndexFromEndpoint(EndpointId endpointId)
 {
     ptrdiff_t index;
@@ -334,6 +340,18 @@ DataVersion GetVersion()
     return dataVersion;
 }
 
+void SetMockNodeConfig(const MockNodeConfig & config)
+{
+    mockConfig = &config;
+    metadataStructureGeneration++;
+}
+
+void ResetMockNodeConfig()
+{
+    mockConfig = nullptr;
+    metadataStructureGeneration++;
+}
+
 CHIP_ERROR ReadSingleMockClusterData(FabricIndex aAccessingFabricIndex, const ConcreteAttributePath & aPath,
                                      AttributeReportIBs::Builder & aAttributeReports,
                                      AttributeValueEncoder::AttributeEncodeState * apEncoderState)
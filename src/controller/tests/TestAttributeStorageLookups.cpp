@@ -0,0 +1,200 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "app-common/zap-generated/ids/Attributes.h"
+#include "app-common/zap-generated/ids/Clusters.h"
+#include <app/tests/AppTestContext.h>
+#include <app/util/af.h>
+#include <app/util/attribute-storage.h>
+#include <app/util/endpoint-config-api.h>
+#include <lib/support/UnitTestContext.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <nlunit-test.h>
+
+using TestContext = chip::Test::AppContext;
+using namespace chip;
+using namespace chip::app;
+using namespace chip::app::Clusters;
+
+namespace {
+
+//
+// The generated endpoint_config for the controller app has Endpoint 1
+// already used in the fixed endpoint set of size 1. Consequently, let's use the next
+// number higher than that for our dynamic test endpoints.
+//
+constexpr EndpointId kTestEndpointId      = 2;
+constexpr EndpointId kOtherTestEndpointId = 3;
+constexpr EndpointId kUnusedEndpointId    = 4;
+
+constexpr AttributeId kFirstAttribute    = 1;
+constexpr AttributeId kSecondAttribute   = 2;
+constexpr AttributeId kReplacedAttribute = 3;
+constexpr AttributeId kMissingAttribute  = 0x10;
+
+//clang-format off
+DECLARE_DYNAMIC_ATTRIBUTE_LIST_BEGIN(testClusterAttrs)
+DECLARE_DYNAMIC_ATTRIBUTE(kFirstAttribute, INT8U, 1, 0), DECLARE_DYNAMIC_ATTRIBUTE(kSecondAttribute, INT8U, 1, 0),
+    DECLARE_DYNAMIC_ATTRIBUTE_LIST_END();
+
+DECLARE_DYNAMIC_CLUSTER_LIST_BEGIN(testEndpointClusters)
+DECLARE_DYNAMIC_CLUSTER(Clusters::UnitTesting::Id, testClusterAttrs, ZAP_CLUSTER_MASK(SERVER), nullptr, nullptr),
+    DECLARE_DYNAMIC_CLUSTER_LIST_END;
+
+DECLARE_DYNAMIC_ENDPOINT(testEndpoint, testEndpointClusters);
+
+// Same cluster, other attributes, to replace the first endpoint type under the same endpoint id.
+DECLARE_DYNAMIC_ATTRIBUTE_LIST_BEGIN(replacementClusterAttrs)
+DECLARE_DYNAMIC_ATTRIBUTE(kReplacedAttribute, INT8U, 1, 0), DECLARE_DYNAMIC_ATTRIBUTE_LIST_END();
+
+DECLARE_DYNAMIC_CLUSTER_LIST_BEGIN(replacementEndpointClusters)
+DECLARE_DYNAMIC_CLUSTER(Clusters::UnitTesting::Id, replacementClusterAttrs, ZAP_CLUSTER_MASK(SERVER), nullptr, nullptr),
+    DECLARE_DYNAMIC_CLUSTER_LIST_END;
+
+DECLARE_DYNAMIC_ENDPOINT(replacementEndpoint, replacementEndpointClusters);
+//clang-format on
+
+DataVersion dataVersionStorage[ArraySize(testEndpointClusters)];
+DataVersion otherDataVersionStorage[ArraySize(replacementEndpointClusters)];
+
+bool IsAttribute(const EmberAfAttributeMetadata * metadata, AttributeId attributeId)
+{
+    return (metadata != nullptr) && (metadata->attributeId == attributeId);
+}
+
+void TestLookupHits(nlTestSuite * apSuite, void * apContext)
+{
+    NL_TEST_ASSERT(apSuite,
+                   emberAfSetDynamicEndpoint(0, kTestEndpointId, &testEndpoint, Span<DataVersion>(dataVersionStorage)) ==
+                       EMBER_ZCL_STATUS_SUCCESS);
+
+    const EmberAfAttributeMetadata * first = emberAfLocateAttributeMetadata(kTestEndpointId, UnitTesting::Id, kFirstAttribute);
+    NL_TEST_ASSERT(apSuite, IsAttribute(first, kFirstAttribute));
+    NL_TEST_ASSERT(apSuite, first == &testClusterAttrs[0]);
+
+    const EmberAfAttributeMetadata * second = emberAfLocateAttributeMetadata(kTestEndpointId, UnitTesting::Id, kSecondAttribute);
+    NL_TEST_ASSERT(apSuite, IsAttribute(second, kSecondAttribute));
+
+    // Repeated lookups, now answered from the caches, give the same results.
+    for (int i = 0; i < 3; i++)
+    {
+        NL_TEST_ASSERT(apSuite, emberAfLocateAttributeMetadata(kTestEndpointId, UnitTesting::Id, kFirstAttribute) == first);
+        NL_TEST_ASSERT(apSuite, emberAfLocateAttributeMetadata(kTestEndpointId, UnitTesting::Id, kSecondAttribute) == second);
+        NL_TEST_ASSERT(apSuite, emberAfFindServerCluster(kTestEndpointId, UnitTesting::Id) == &testEndpointClusters[0]);
+        NL_TEST_ASSERT(apSuite, emberAfIndexFromEndpoint(kTestEndpointId) == FIXED_ENDPOINT_COUNT);
+    }
+
+    emberAfClearDynamicEndpoint(0);
+}
+
+void TestLookupMisses(nlTestSuite * apSuite, void * apContext)
+{
+    NL_TEST_ASSERT(apSuite,
+                   emberAfSetDynamicEndpoint(0, kTestEndpointId, &testEndpoint, Span<DataVersion>(dataVersionStorage)) ==
+                       EMBER_ZCL_STATUS_SUCCESS);
+
+    // Misses are cached as well, and must stay misses.
+    for (int i = 0; i < 2; i++)
+    {
+        NL_TEST_ASSERT(apSuite, emberAfLocateAttributeMetadata(kTestEndpointId, UnitTesting::Id, kMissingAttribute) == nullptr);
+        NL_TEST_ASSERT(apSuite, emberAfLocateAttributeMetadata(kTestEndpointId, OnOff::Id, kFirstAttribute) == nullptr);
+        NL_TEST_ASSERT(apSuite, emberAfLocateAttributeMetadata(kUnusedEndpointId, UnitTesting::Id, kFirstAttribute) == nullptr);
+        NL_TEST_ASSERT(apSuite, emberAfFindServerCluster(kTestEndpointId, OnOff::Id) == nullptr);
+        NL_TEST_ASSERT(apSuite, emberAfIndexFromEndpoint(kUnusedEndpointId) == kEmberInvalidEndpointIndex);
+    }
+
+    // A miss does not hide the attributes that are there.
+    NL_TEST_ASSERT(apSuite,
+                   IsAttribute(emberAfLocateAttributeMetadata(kTestEndpointId, UnitTesting::Id, kFirstAttribute), kFirstAttribute));
+
+    emberAfClearDynamicEndpoint(0);
+}
+
+void TestLookupInvalidation(nlTestSuite * apSuite, void * apContext)
+{
+    NL_TEST_ASSERT(apSuite,
+                   emberAfSetDynamicEndpoint(0, kTestEndpointId, &testEndpoint, Span<DataVersion>(dataVersionStorage)) ==
+                       EMBER_ZCL_STATUS_SUCCESS);
+    NL_TEST_ASSERT(apSuite,
+                   IsAttribute(emberAfLocateAttributeMetadata(kTestEndpointId, UnitTesting::Id, kFirstAttribute), kFirstAttribute));
+    NL_TEST_ASSERT(apSuite, emberAfLocateAttributeMetadata(kTestEndpointId, UnitTesting::Id, kReplacedAttribute) == nullptr);
+
+    // Disabled endpoints are not found, without any cache being dropped.
+    NL_TEST_ASSERT(apSuite, emberAfEndpointEnableDisable(kTestEndpointId, false));
+    NL_TEST_ASSERT(apSuite, emberAfLocateAttributeMetadata(kTestEndpointId, UnitTesting::Id, kFirstAttribute) == nullptr);
+    NL_TEST_ASSERT(apSuite, emberAfIndexFromEndpoint(kTestEndpointId) == kEmberInvalidEndpointIndex);
+    NL_TEST_ASSERT(apSuite, emberAfIndexFromEndpointIncludingDisabledEndpoints(kTestEndpointId) != kEmberInvalidEndpointIndex);
+    NL_TEST_ASSERT(apSuite, emberAfEndpointEnableDisable(kTestEndpointId, true));
+    NL_TEST_ASSERT(apSuite,
+                   IsAttribute(emberAfLocateAttributeMetadata(kTestEndpointId, UnitTesting::Id, kFirstAttribute), kFirstAttribute));
+
+    // Cleared endpoints are not found anymore.
+    emberAfClearDynamicEndpoint(0);
+    NL_TEST_ASSERT(apSuite, emberAfLocateAttributeMetadata(kTestEndpointId, UnitTesting::Id, kFirstAttribute) == nullptr);
+    NL_TEST_ASSERT(apSuite, emberAfFindServerCluster(kTestEndpointId, UnitTesting::Id) == nullptr);
+    NL_TEST_ASSERT(apSuite, emberAfIndexFromEndpointIncludingDisabledEndpoints(kTestEndpointId) == kEmberInvalidEndpointIndex);
+
+    // The same endpoint id, with another endpoint type, finds the new metadata only.
+    EmberAfStatus status =
+        emberAfSetDynamicEndpoint(0, kTestEndpointId, &replacementEndpoint, Span<DataVersion>(otherDataVersionStorage));
+    NL_TEST_ASSERT(apSuite, status == EMBER_ZCL_STATUS_SUCCESS);
+    const EmberAfAttributeMetadata * replaced =
+        emberAfLocateAttributeMetadata(kTestEndpointId, UnitTesting::Id, kReplacedAttribute);
+    NL_TEST_ASSERT(apSuite, replaced == &replacementClusterAttrs[0]);
+    NL_TEST_ASSERT(apSuite, emberAfLocateAttributeMetadata(kTestEndpointId, UnitTesting::Id, kFirstAttribute) == nullptr);
+    NL_TEST_ASSERT(apSuite, emberAfFindServerCluster(kTestEndpointId, UnitTesting::Id) == &replacementEndpointClusters[0]);
+
+    // The first endpoint type, now under another endpoint id in another slot, is found there.
+    status = emberAfSetDynamicEndpoint(1, kOtherTestEndpointId, &testEndpoint, Span<DataVersion>(dataVersionStorage));
+    NL_TEST_ASSERT(apSuite, status == EMBER_ZCL_STATUS_SUCCESS);
+    const EmberAfAttributeMetadata * first = emberAfLocateAttributeMetadata(kOtherTestEndpointId, UnitTesting::Id, kFirstAttribute);
+    NL_TEST_ASSERT(apSuite, first == &testClusterAttrs[0]);
+    NL_TEST_ASSERT(apSuite, emberAfLocateAttributeMetadata(kTestEndpointId, UnitTesting::Id, kFirstAttribute) == nullptr);
+    NL_TEST_ASSERT(apSuite, emberAfIndexFromEndpoint(kOtherTestEndpointId) == FIXED_ENDPOINT_COUNT + 1);
+
+    emberAfClearDynamicEndpoint(1);
+    emberAfClearDynamicEndpoint(0);
+}
+
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("TestLookupHits", TestLookupHits),
+    NL_TEST_DEF("TestLookupMisses", TestLookupMisses),
+    NL_TEST_DEF("TestLookupInvalidation", TestLookupInvalidation),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+nlTestSuite sSuite = {
+    "TestAttributeStorageLookups",
+    &sTests[0],
+    TestContext::nlTestSetUpTestSuite,
+    TestContext::nlTestTearDownTestSuite,
+    TestContext::nlTestSetUp,
+    TestContext::nlTestTearDown,
+};
+
+} // namespace
+
+int TestAttributeStorageLookups()
+{
+    return chip::ExecuteTestsWithContext<TestContext>(&sSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestAttributeStorageLookups)
@@ -415,8 +415,16 @@ CHIP_ERROR ChipCertificateSet::ValidateCert(const ChipCertificateData * cert, Va
 
     // Verify signature of the current certificate against public key of the CA certificate. If signature verification
     // succeeds, the current certificate is valid.
+    if (context.mSignatureCache != nullptr && context.mSignatureCache->Contains(*cert, *caCert))
+    {
+        ExitNow(err = CHIP_NO_ERROR);
+    }
     err = VerifyCertSignature(*cert, *caCert);
     SuccessOrExit(err);
+    if (context.mSignatureCache != nullptr)
+    {
+        context.mSignatureCache->Add(*cert, *caCert);
+    }
 
 exit:
     return err;
@@ -506,6 +514,7 @@ void ValidationContext::Reset()
     mEffectiveTime  = EffectiveTime{};
     mTrustAnchor    = nullptr;
     mValidityPolicy = nullptr;
+    mSignatureCache = nullptr;
     mRequiredKeyUsages.ClearAll();
     mRequiredKeyPurposes.ClearAll();
     mRequiredCertType = CertType::kNotSpecified;
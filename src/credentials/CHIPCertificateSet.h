@@ -31,6 +31,7 @@
 #include <string.h>
 
 #include "CHIPCert.h"
+#include "CertificateSignatureCache.h"
 #include "CertificateValidityPolicy.h"
 #include <lib/support/Variant.h>
 
@@ -74,6 +75,8 @@ struct ValidationContext
 
     CertificateValidityPolicy * mValidityPolicy =
         nullptr; /**< Optional application policy to apply for certificate validity period evaluation. */
+    CertificateSignatureCache * mSignatureCache =
+        nullptr; /**< Optional cache of verified signatures, consulted before verifying a certificate's signature. */
 
     void Reset();
 
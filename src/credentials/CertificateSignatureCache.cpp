@@ -0,0 +1,134 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <credentials/CertificateSignatureCache.h>
+
+#include <credentials/CHIPCert.h>
+#include <lib/support/CodeUtils.h>
+
+#include <string.h>
+
+namespace chip {
+namespace Credentials {
+
+using namespace chip::Crypto;
+
+CHIP_ERROR CertificateSignatureCache::Init()
+{
+    VerifyOrReturnError(!mInitialized, CHIP_NO_ERROR);
+    ReturnErrorOnFailure(System::Mutex::Init(mLock));
+    mCount       = 0;
+    mInitialized = true;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CertificateSignatureCache::ComputeDigest(const ChipCertificateData & cert, const ChipCertificateData & signer,
+                                                    Entry & outEntry)
+{
+    Hash_SHA256_stream hash;
+    MutableByteSpan digest(outEntry.mDigest);
+
+    ReturnErrorOnFailure(hash.Begin());
+    ReturnErrorOnFailure(hash.AddData(ByteSpan(cert.mTBSHash)));
+    ReturnErrorOnFailure(hash.AddData(cert.mSignature));
+    ReturnErrorOnFailure(hash.AddData(signer.mPublicKey));
+    return hash.Finish(digest);
+}
+
+size_t CertificateSignatureCache::Find(const Entry & entry) const
+{
+    for (size_t i = 0; i < mCount; i++)
+    {
+        if (memcmp(mEntries[i].mDigest, entry.mDigest, sizeof(entry.mDigest)) == 0)
+        {
+            return i;
+        }
+    }
+    return mCount;
+}
+
+void CertificateSignatureCache::MoveToFront(size_t index, const Entry & entry)
+{
+    memmove(&mEntries[1], &mEntries[0], index * sizeof(Entry));
+    mEntries[0] = entry;
+}
+
+bool CertificateSignatureCache::Contains(const ChipCertificateData & cert, const ChipCertificateData & signer)
+{
+    VerifyOrReturnValue(kCapacity > 0 && mInitialized, false);
+    VerifyOrReturnValue(cert.mCertFlags.Has(CertFlags::kTBSHashPresent), false);
+
+    Entry entry;
+    VerifyOrReturnValue(ComputeDigest(cert, signer, entry) == CHIP_NO_ERROR, false);
+
+    mLock.Lock();
+    size_t index = Find(entry);
+    bool found   = (index < mCount);
+    if (found)
+    {
+        MoveToFront(index, entry);
+    }
+    mLock.Unlock();
+
+    return found;
+}
+
+void CertificateSignatureCache::Add(const ChipCertificateData & cert, const ChipCertificateData & signer)
+{
+    VerifyOrReturn(kCapacity > 0 && mInitialized);
+    VerifyOrReturn(cert.mCertFlags.Has(CertFlags::kTBSHashPresent));
+
+    Entry entry;
+    VerifyOrReturn(ComputeDigest(cert, signer, entry) == CHIP_NO_ERROR);
+
+    mLock.Lock();
+    size_t index = Find(entry);
+    if (index == mCount)
+    {
+        // Not present: evict the least recently used entry if full.
+        if (mCount < kCapacity)
+        {
+            mCount++;
+        }
+        index = mCount - 1;
+    }
+    MoveToFront(index, entry);
+    mLock.Unlock();
+}
+
+void CertificateSignatureCache::Clear()
+{
+    VerifyOrReturn(mInitialized);
+
+    mLock.Lock();
+    mCount = 0;
+    mLock.Unlock();
+}
+
+size_t CertificateSignatureCache::Count() const
+{
+    VerifyOrReturnValue(mInitialized, 0);
+
+    mLock.Lock();
+    size_t count = mCount;
+    mLock.Unlock();
+
+    return count;
+}
+
+} // namespace Credentials
+} // namespace chip
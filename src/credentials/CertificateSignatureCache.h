@@ -0,0 +1,87 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <crypto/CHIPCryptoPAL.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/CHIPError.h>
+#include <system/SystemMutex.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace Credentials {
+
+struct ChipCertificateData;
+
+/**
+ * Remembers certificate signatures that were successfully verified, so that validating the same
+ * certificate chain again (e.g. on every CASE handshake with a peer) does not repeat the ECDSA
+ * verifications.
+ *
+ * Entries are keyed by a digest of the certificate's TBS hash, its signature and the public key of
+ * the signing certificate.  Only the signature check is skipped on a hit: the validity period,
+ * CertificateValidityPolicy and chaining up to a trust anchor are still evaluated on every
+ * validation.  The least recently used entry is evicted when the cache is full.
+ *
+ * Once Init() has returned, the cache may be used from any thread.
+ */
+class CertificateSignatureCache
+{
+public:
+    static constexpr size_t kCapacity = CHIP_CONFIG_CERT_SIGNATURE_CACHE_SIZE;
+
+    CHIP_ERROR Init();
+
+    /**
+     * Returns true if the signature of cert by signer was previously recorded with Add().
+     */
+    bool Contains(const ChipCertificateData & cert, const ChipCertificateData & signer);
+
+    /**
+     * Records that the signature of cert was verified with the public key of signer.
+     */
+    void Add(const ChipCertificateData & cert, const ChipCertificateData & signer);
+
+    void Clear();
+
+    size_t Count() const;
+
+private:
+    struct Entry
+    {
+        uint8_t mDigest[Crypto::kSHA256_Hash_Length];
+    };
+
+    static CHIP_ERROR ComputeDigest(const ChipCertificateData & cert, const ChipCertificateData & signer, Entry & outEntry);
+
+    // Returns the index of the entry, or mCount if not present.  Must be called with mLock held.
+    size_t Find(const Entry & entry) const;
+
+    // Moves the entry at index to the front, shifting the more recently used ones back by one.
+    void MoveToFront(size_t index, const Entry & entry);
+
+    // Ordered from most to least recently used; only the first mCount are valid.
+    Entry mEntries[kCapacity > 0 ? kCapacity : 1];
+    size_t mCount     = 0;
+    bool mInitialized = false;
+    mutable System::Mutex mLock;
+};
+
+} // namespace Credentials
+} // namespace chip
@@ -1079,6 +1079,8 @@ CHIP_ERROR FabricTable::Init(const FabricTable::InitParams & initParams)
     // this condition and can act appropriately.
     mLastKnownGoodTime.Init(mStorage);
 
+    ReturnErrorOnFailure(mCertificateSignatureCache.Init());
+
     uint8_t buf[IndexInfoTLVMaxSize()];
     uint16_t size  = sizeof(buf);
     CHIP_ERROR err = mStorage->SyncGetKeyValue(DefaultStorageKeyAllocator::FabricIndexInfo().KeyName(), buf, size);
@@ -1892,6 +1894,17 @@ CHIP_ERROR FabricTable::CommitPendingFabricData()
     }
 
     // ==== Start of actual commit transaction after pre-flight checks ====
+    // All the writes below, down to clearing the commit marker, only need to reach the disk once, at the end of the batch.
+    // What an interrupted commit leaves on disk depends on the storage backend:
+    // - Without batching support (the default), each write is durable on its own and in order, so the commit marker
+    //   is durable before anything it covers.
+    // - The Linux INI backend rewrites its file once when the batch ends: either none of these writes, or all of them
+    //   (commit marker already cleared) are on disk.
+    // - The Linux log backend appends the writes in order and drops a torn tail on load: a prefix of these writes is
+    //   on disk, starting with the commit marker.
+    // In all cases a reboot sees the previous state, the commit marker along with part of the commit, or the full commit.
+    PersistentStorageWriteBatch writeBatch(mStorage);
+
     CHIP_ERROR stickyError  = StoreCommitMarker(CommitMarker{ fabricIndexBeingCommitted, isAdding });
     bool failedCommitMarker = (stickyError != CHIP_NO_ERROR);
     if (failedCommitMarker)
@@ -2021,6 +2034,9 @@ CHIP_ERROR FabricTable::CommitPendingFabricData()
     // did their job.
     ClearCommitMarker();
 
+    CHIP_ERROR flushErr = writeBatch.End();
+    stickyError         = (stickyError != CHIP_NO_ERROR) ? stickyError : flushErr;
+
     return stickyError;
 }
 
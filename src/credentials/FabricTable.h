@@ -26,6 +26,7 @@
 #include <app/util/basic-types.h>
 #include <credentials/CHIPCert.h>
 #include <credentials/CHIPCertificateSet.h>
+#include <credentials/CertificateSignatureCache.h>
 #include <credentials/CertificateValidityPolicy.h>
 #include <credentials/LastKnownGoodTime.h>
 #include <credentials/OperationalCertificateStore.h>
@@ -534,6 +535,12 @@ public:
         return mLastKnownGoodTime.GetLastKnownGoodChipEpochTime(lastKnownGoodChipEpochTime);
     }
 
+    /**
+     * Get the cache of verified certificate signatures shared by peer certificate chain
+     * validations (e.g. in CASE) against this table's fabrics.  Safe to use from any thread.
+     */
+    Credentials::CertificateSignatureCache * GetCertificateSignatureCache() { return &mCertificateSignatureCache; }
+
     /**
      * Validate that the passed Last Known Good Time is within bounds and then
      * store this and write back to storage.  Legal values are those which are
@@ -1181,6 +1188,8 @@ private:
 
     LastKnownGoodTime mLastKnownGoodTime;
 
+    Credentials::CertificateSignatureCache mCertificateSignatureCache;
+
     // We may not have an mNextAvailableFabricIndex if our table is as large as
     // it can go and is full.
     Optional<FabricIndex> mNextAvailableFabricIndex;
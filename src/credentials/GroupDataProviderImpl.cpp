@@ -17,6 +17,7 @@
 #include <credentials/GroupDataProviderImpl.h>
 #include <crypto/CHIPCryptoPAL.h>
 #include <lib/core/TLV.h>
+#include <lib/support/CHIPMem.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/CommonPersistentData.h>
 #include <lib/support/DefaultStorageKeyAllocator.h>
@@ -832,12 +833,14 @@ void GroupDataProviderImpl::Finish()
     mKeySetIterators.ReleaseAll();
     mGroupSessionsIterator.ReleaseAll();
     mGroupKeyContexPool.ReleaseAll();
+    ClearSessionIndex();
 }
 
 void GroupDataProviderImpl::SetStorageDelegate(PersistentStorageDelegate * storage)
 {
     VerifyOrDie(storage != nullptr);
-    mStorage = storage;
+    mStorage           = storage;
+    mSessionIndexValid = false;
 }
 
 //
@@ -1349,6 +1352,7 @@ CHIP_ERROR GroupDataProviderImpl::RemoveEndpoints(chip::FabricIndex fabric_index
 CHIP_ERROR GroupDataProviderImpl::SetGroupKeyAt(chip::FabricIndex fabric_index, size_t index, const GroupKey & in_map)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    mSessionIndexValid = false;
 
     FabricData fabric(fabric_index);
     KeyMapData map(fabric_index);
@@ -1415,6 +1419,7 @@ CHIP_ERROR GroupDataProviderImpl::GetGroupKeyAt(chip::FabricIndex fabric_index,
 CHIP_ERROR GroupDataProviderImpl::RemoveGroupKeyAt(chip::FabricIndex fabric_index, size_t index)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    mSessionIndexValid = false;
 
     FabricData fabric(fabric_index);
     KeyMapData map;
@@ -1447,6 +1452,7 @@ CHIP_ERROR GroupDataProviderImpl::RemoveGroupKeyAt(chip::FabricIndex fabric_inde
 CHIP_ERROR GroupDataProviderImpl::RemoveGroupKeys(chip::FabricIndex fabric_index)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    mSessionIndexValid = false;
 
     FabricData fabric(fabric_index);
     VerifyOrReturnError(CHIP_NO_ERROR == fabric.Load(mStorage), CHIP_ERROR_INVALID_FABRIC_INDEX);
@@ -1523,6 +1529,7 @@ CHIP_ERROR GroupDataProviderImpl::SetKeySet(chip::FabricIndex fabric_index, cons
                                             const KeySet & in_keyset)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    mSessionIndexValid = false;
 
     FabricData fabric(fabric_index);
     KeySetData keyset;
@@ -1559,13 +1566,16 @@ CHIP_ERROR GroupDataProviderImpl::SetKeySet(chip::FabricIndex fabric_index, cons
     // New keyset
     VerifyOrReturnError(fabric.keyset_count < mMaxGroupKeysPerFabric, CHIP_ERROR_INVALID_LIST_LENGTH);
 
+    PersistentStorageWriteBatch writeBatch(mStorage);
+
     // Insert first
     keyset.next = fabric.first_keyset;
     ReturnErrorOnFailure(keyset.Save(mStorage));
     // Update fabric
     fabric.keyset_count++;
     fabric.first_keyset = in_keyset.keyset_id;
-    return fabric.Save(mStorage);
+    ReturnErrorOnFailure(fabric.Save(mStorage));
+    return writeBatch.End();
 }
 
 CHIP_ERROR GroupDataProviderImpl::GetKeySet(chip::FabricIndex fabric_index, uint16_t target_id, KeySet & out_keyset)
@@ -1594,12 +1604,15 @@ CHIP_ERROR GroupDataProviderImpl::GetKeySet(chip::FabricIndex fabric_index, uint
 CHIP_ERROR GroupDataProviderImpl::RemoveKeySet(chip::FabricIndex fabric_index, uint16_t target_id)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    mSessionIndexValid = false;
 
     FabricData fabric(fabric_index);
     KeySetData keyset;
 
     ReturnErrorOnFailure(fabric.Load(mStorage));
     VerifyOrReturnError(keyset.Find(mStorage, fabric, target_id), CHIP_ERROR_NOT_FOUND);
+
+    PersistentStorageWriteBatch writeBatch(mStorage);
     ReturnErrorOnFailure(keyset.Delete(mStorage));
 
     if (keyset.first)
@@ -1638,7 +1651,7 @@ CHIP_ERROR GroupDataProviderImpl::RemoveKeySet(chip::FabricIndex fabric_index, u
         // open to suggestsions for the correct behavior.
         RemoveGroupKeyAt(fabric_index, idx);
     }
-    return CHIP_NO_ERROR;
+    return writeBatch.End();
 }
 
 GroupDataProvider::KeySetIterator * GroupDataProviderImpl::IterateKeySets(chip::FabricIndex fabric_index)
@@ -1696,12 +1709,15 @@ void GroupDataProviderImpl::KeySetIteratorImpl::Release()
 CHIP_ERROR GroupDataProviderImpl::RemoveFabric(chip::FabricIndex fabric_index)
 {
     FabricData fabric(fabric_index);
+    mSessionIndexValid = false;
 
     // Fabric data defaults to zero, so if not entry is found, no mappings, or keys are removed
     // However, states has a separate list, and needs to be removed regardless
     CHIP_ERROR err = fabric.Load(mStorage);
     VerifyOrReturnError(CHIP_NO_ERROR == err || CHIP_ERROR_NOT_FOUND == err, err);
 
+    PersistentStorageWriteBatch writeBatch(mStorage);
+
     // Remove Group mappings
 
     for (size_t i = 0; i < fabric.map_count; i++)
@@ -1734,7 +1750,8 @@ CHIP_ERROR GroupDataProviderImpl::RemoveFabric(chip::FabricIndex fabric_index)
     }
 
     // Remove fabric
-    return fabric.Delete(mStorage);
+    ReturnErrorOnFailure(fabric.Delete(mStorage));
+    return writeBatch.End();
 }
 
 //
@@ -1839,12 +1856,165 @@ CHIP_ERROR GroupDataProviderImpl::GroupKeyContext::PrivacyDecrypt(const ByteSpan
 GroupDataProviderImpl::GroupSessionIterator * GroupDataProviderImpl::IterateGroupSessions(uint16_t session_id)
 {
     VerifyOrReturnError(IsInitialized(), nullptr);
-    return mGroupSessionsIterator.CreateObject(*this, session_id);
+
+    // Fall back to reading the keys from storage if the index cannot be loaded
+    GroupSessionEntry * first = nullptr;
+    if (CHIP_NO_ERROR == LoadSessionIndex())
+    {
+        first = mSessionIndex[SessionIndexBucket(session_id)];
+    }
+    return mGroupSessionsIterator.CreateObject(*this, session_id, first);
 }
 
-GroupDataProviderImpl::GroupSessionIteratorImpl::GroupSessionIteratorImpl(GroupDataProviderImpl & provider, uint16_t session_id) :
-    mProvider(provider), mSessionId(session_id), mGroupKeyContext(provider)
+CHIP_ERROR GroupDataProviderImpl::LoadSessionIndex()
 {
+    VerifyOrReturnError(!mSessionIndexValid, CHIP_NO_ERROR);
+    VerifyOrReturnError(nullptr != mSessionKeystore, CHIP_ERROR_INCORRECT_STATE);
+    // Live iterators may still point to the current entries
+    VerifyOrReturnError(0 == mGroupSessionsIterator.Allocated(), CHIP_ERROR_INCORRECT_STATE);
+
+    ClearSessionIndex();
+
+    FabricList fabric_list;
+    CHIP_ERROR err = fabric_list.Load(mStorage);
+    if (CHIP_ERROR_NOT_FOUND == err)
+    {
+        // No fabrics, no keys
+        mSessionIndexValid = true;
+        return CHIP_NO_ERROR;
+    }
+    ReturnErrorOnFailure(err);
+
+    // Same traversal as the storage-backed iterator: it stops at the first record that cannot be loaded.
+    FabricData fabric(fabric_list.first_entry);
+    bool complete = true;
+    for (size_t i = 0; complete && i < fabric_list.entry_count; i++, fabric.fabric_index = fabric.next)
+    {
+        if (CHIP_NO_ERROR != fabric.Load(mStorage))
+        {
+            break;
+        }
+
+        KeyMapData mapping(fabric.fabric_index, fabric.first_map);
+        for (uint16_t j = 0; j < fabric.map_count; ++j, mapping.id = mapping.next)
+        {
+            KeySetData keyset;
+            if (CHIP_NO_ERROR != mapping.Load(mStorage) || !keyset.Find(mStorage, fabric, mapping.keyset_id))
+            {
+                complete = false;
+                break;
+            }
+            for (uint16_t k = 0; k < keyset.keys_count && k < ArraySize(keyset.operational_keys); ++k)
+            {
+                err = AddSessionIndexEntry(fabric.fabric_index, mapping.group_id, keyset.policy, keyset.operational_keys[k]);
+                if (CHIP_NO_ERROR != err)
+                {
+                    ClearSessionIndex();
+                    return err;
+                }
+            }
+        }
+    }
+
+    mSessionIndexValid = true;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR GroupDataProviderImpl::AddSessionIndexEntry(FabricIndex fabric_index, GroupId group_id, SecurityPolicy policy,
+                                                       const Crypto::GroupOperationalCredentials & creds)
+{
+    GroupSessionEntry * entry = Platform::New<GroupSessionEntry>(*mSessionKeystore);
+    VerifyOrReturnError(nullptr != entry, CHIP_ERROR_NO_MEMORY);
+
+    CHIP_ERROR err = entry->Initialize(creds);
+    if (CHIP_NO_ERROR != err)
+    {
+        Platform::Delete(entry);
+        return err;
+    }
+    entry->fabric_index    = fabric_index;
+    entry->group_id        = group_id;
+    entry->security_policy = policy;
+
+    // Append, so that candidates keep the fabric/map/key order of storage
+    GroupSessionEntry ** tail = &mSessionIndex[SessionIndexBucket(creds.hash)];
+    while (nullptr != *tail)
+    {
+        tail = &(*tail)->next;
+    }
+    *tail = entry;
+    return CHIP_NO_ERROR;
+}
+
+void GroupDataProviderImpl::ClearSessionIndex()
+{
+    for (auto & bucket : mSessionIndex)
+    {
+        while (nullptr != bucket)
+        {
+            GroupSessionEntry * entry = bucket;
+            bucket                    = entry->next;
+            Platform::Delete(entry);
+        }
+    }
+    mSessionIndexValid = false;
+}
+
+GroupDataProviderImpl::GroupSessionEntry::~GroupSessionEntry()
+{
+    mCipher.Clear();
+    mKeystore.DestroyKey(mEncryptionKey);
+    mKeystore.DestroyKey(mPrivacyKey);
+}
+
+CHIP_ERROR GroupDataProviderImpl::GroupSessionEntry::Initialize(const Crypto::GroupOperationalCredentials & creds)
+{
+    mKeyHash = creds.hash;
+    ReturnErrorOnFailure(mKeystore.CreateKey(creds.encryption_key, mEncryptionKey));
+    ReturnErrorOnFailure(mKeystore.CreateKey(creds.privacy_key, mPrivacyKey));
+    return mCipher.Init(mEncryptionKey);
+}
+
+CHIP_ERROR GroupDataProviderImpl::GroupSessionEntry::MessageEncrypt(const ByteSpan & plaintext, const ByteSpan & aad,
+                                                                    const ByteSpan & nonce, MutableByteSpan & mic,
+                                                                    MutableByteSpan & ciphertext) const
+{
+    return mCipher.Encrypt(plaintext.data(), plaintext.size(), aad.data(), aad.size(), nonce.data(), nonce.size(),
+                           ciphertext.data(), mic.data(), mic.size());
+}
+
+CHIP_ERROR GroupDataProviderImpl::GroupSessionEntry::MessageDecrypt(const ByteSpan & ciphertext, const ByteSpan & aad,
+                                                                    const ByteSpan & nonce, const ByteSpan & mic,
+                                                                    MutableByteSpan & plaintext) const
+{
+    return mCipher.Decrypt(ciphertext.data(), ciphertext.size(), aad.data(), aad.size(), mic.data(), mic.size(), nonce.data(),
+                           nonce.size(), plaintext.data());
+}
+
+CHIP_ERROR GroupDataProviderImpl::GroupSessionEntry::PrivacyEncrypt(const ByteSpan & input, const ByteSpan & nonce,
+                                                                    MutableByteSpan & output) const
+{
+    return Crypto::AES_CTR_crypt(input.data(), input.size(), mPrivacyKey, nonce.data(), nonce.size(), output.data());
+}
+
+CHIP_ERROR GroupDataProviderImpl::GroupSessionEntry::PrivacyDecrypt(const ByteSpan & input, const ByteSpan & nonce,
+                                                                    MutableByteSpan & output) const
+{
+    return Crypto::AES_CTR_crypt(input.data(), input.size(), mPrivacyKey, nonce.data(), nonce.size(), output.data());
+}
+
+GroupDataProviderImpl::GroupSessionIteratorImpl::GroupSessionIteratorImpl(GroupDataProviderImpl & provider, uint16_t session_id,
+                                                                          GroupSessionEntry * first) :
+    mProvider(provider),
+    mSessionId(session_id), mGroupKeyContext(provider)
+{
+    if (provider.mSessionIndexValid)
+    {
+        mIndexed = true;
+        mEntry   = first;
+        return;
+    }
+
     FabricList fabric_list;
     ReturnOnFailure(fabric_list.Load(provider.mStorage));
     mFirstFabric = fabric_list.first_entry;
@@ -1857,9 +2027,22 @@ GroupDataProviderImpl::GroupSessionIteratorImpl::GroupSessionIteratorImpl(GroupD
 
 size_t GroupDataProviderImpl::GroupSessionIteratorImpl::Count()
 {
-    FabricData fabric(mFirstFabric);
     size_t count = 0;
 
+    if (mIndexed)
+    {
+        for (GroupSessionEntry * entry = mEntry; nullptr != entry; entry = entry->next)
+        {
+            if (entry->GetKeyHash() == mSessionId)
+            {
+                count++;
+            }
+        }
+        return count;
+    }
+
+    FabricData fabric(mFirstFabric);
+
     for (size_t i = 0; i < mFabricTotal; i++, fabric.fabric_index = fabric.next)
     {
         if (CHIP_NO_ERROR != fabric.Load(mProvider.mStorage))
@@ -1898,6 +2081,23 @@ size_t GroupDataProviderImpl::GroupSessionIteratorImpl::Count()
 
 bool GroupDataProviderImpl::GroupSessionIteratorImpl::Next(GroupSession & output)
 {
+    if (mIndexed)
+    {
+        for (; nullptr != mEntry; mEntry = mEntry->next)
+        {
+            if (mEntry->GetKeyHash() == mSessionId)
+            {
+                output.fabric_index    = mEntry->fabric_index;
+                output.group_id        = mEntry->group_id;
+                output.security_policy = mEntry->security_policy;
+                output.keyContext      = mEntry;
+                mEntry                 = mEntry->next;
+                return true;
+            }
+        }
+        return false;
+    }
+
     while (mFabricCount < mFabricTotal)
     {
         FabricData fabric(mFabric);
@@ -33,7 +33,6 @@ public:
     GroupDataProviderImpl(uint16_t maxGroupsPerFabric, uint16_t maxGroupKeysPerFabric) :
         GroupDataProvider(maxGroupsPerFabric, maxGroupKeysPerFabric)
     {}
-    ~GroupDataProviderImpl() override {}
 
     /**
      * @brief Set the storage implementation used for non-volatile storage of configuration data.
@@ -43,7 +42,11 @@ public:
      */
     void SetStorageDelegate(PersistentStorageDelegate * storage);
 
-    void SetSessionKeystore(Crypto::SessionKeystore * keystore) { mSessionKeystore = keystore; }
+    void SetSessionKeystore(Crypto::SessionKeystore * keystore)
+    {
+        mSessionKeystore   = keystore;
+        mSessionIndexValid = false;
+    }
     Crypto::SessionKeystore * GetSessionKeystore() const { return mSessionKeystore; }
 
     CHIP_ERROR Init() override;
@@ -221,31 +224,81 @@ protected:
         size_t mTotal       = 0;
     };
 
+    /**
+     * @brief Operational group key kept in memory for the decryption of incoming group messages.
+     *
+     * Entries are owned by the provider's session index and live until the index is rebuilt, so
+     * Release() does nothing.
+     */
+    class GroupSessionEntry : public Crypto::SymmetricKeyContext
+    {
+    public:
+        GroupSessionEntry(Crypto::SessionKeystore & keystore) : mKeystore(keystore) {}
+        ~GroupSessionEntry() override;
+
+        CHIP_ERROR Initialize(const Crypto::GroupOperationalCredentials & creds);
+
+        uint16_t GetKeyHash() override { return mKeyHash; }
+
+        CHIP_ERROR MessageEncrypt(const ByteSpan & plaintext, const ByteSpan & aad, const ByteSpan & nonce, MutableByteSpan & mic,
+                                  MutableByteSpan & ciphertext) const override;
+        CHIP_ERROR MessageDecrypt(const ByteSpan & ciphertext, const ByteSpan & aad, const ByteSpan & nonce, const ByteSpan & mic,
+                                  MutableByteSpan & plaintext) const override;
+        CHIP_ERROR PrivacyEncrypt(const ByteSpan & input, const ByteSpan & nonce, MutableByteSpan & output) const override;
+        CHIP_ERROR PrivacyDecrypt(const ByteSpan & input, const ByteSpan & nonce, MutableByteSpan & output) const override;
+
+        void Release() override {}
+
+        FabricIndex fabric_index       = kUndefinedFabricIndex;
+        GroupId group_id               = kUndefinedGroupId;
+        SecurityPolicy security_policy = SecurityPolicy::kCacheAndSync;
+        GroupSessionEntry * next       = nullptr;
+
+    protected:
+        Crypto::SessionKeystore & mKeystore;
+        uint16_t mKeyHash = 0;
+        Crypto::Aes128KeyHandle mEncryptionKey;
+        Crypto::Aes128KeyHandle mPrivacyKey;
+        Crypto::Aes128CcmContext mCipher;
+    };
+
     class GroupSessionIteratorImpl : public GroupSessionIterator
     {
     public:
-        GroupSessionIteratorImpl(GroupDataProviderImpl & provider, uint16_t session_id);
+        GroupSessionIteratorImpl(GroupDataProviderImpl & provider, uint16_t session_id, GroupSessionEntry * first);
         size_t Count() override;
         bool Next(GroupSession & output) override;
         void Release() override;
 
     protected:
         GroupDataProviderImpl & mProvider;
-        uint16_t mSessionId      = 0;
-        FabricIndex mFirstFabric = kUndefinedFabricIndex;
-        FabricIndex mFabric      = kUndefinedFabricIndex;
-        uint16_t mFabricCount    = 0;
-        uint16_t mFabricTotal    = 0;
-        uint16_t mMapping        = 0;
-        uint16_t mMapCount       = 0;
-        uint16_t mKeyIndex       = 0;
-        uint16_t mKeyCount       = 0;
-        bool mFirstMap           = true;
+        uint16_t mSessionId        = 0;
+        bool mIndexed              = false;
+        GroupSessionEntry * mEntry = nullptr;
+        FabricIndex mFirstFabric   = kUndefinedFabricIndex;
+        FabricIndex mFabric        = kUndefinedFabricIndex;
+        uint16_t mFabricCount      = 0;
+        uint16_t mFabricTotal      = 0;
+        uint16_t mMapping          = 0;
+        uint16_t mMapCount         = 0;
+        uint16_t mKeyIndex         = 0;
+        uint16_t mKeyCount         = 0;
+        bool mFirstMap             = true;
         GroupKeyContext mGroupKeyContext;
     };
     bool IsInitialized() { return (mStorage != nullptr); }
     CHIP_ERROR RemoveEndpoints(FabricIndex fabric_index, GroupId group_id);
 
+    // Session index: operational group keys of all fabrics, bucketed by key hash. It is loaded
+    // lazily on the first IterateGroupSessions() call after a key set, group-key map or fabric
+    // change, so that trial decryption of group messages does not read persistent storage.
+    static constexpr size_t kSessionIndexBuckets = 16;
+    static size_t SessionIndexBucket(uint16_t hash) { return hash % kSessionIndexBuckets; }
+    CHIP_ERROR LoadSessionIndex();
+    CHIP_ERROR AddSessionIndexEntry(FabricIndex fabric_index, GroupId group_id, SecurityPolicy policy,
+                                    const Crypto::GroupOperationalCredentials & creds);
+    void ClearSessionIndex();
+
     PersistentStorageDelegate * mStorage       = nullptr;
     Crypto::SessionKeystore * mSessionKeystore = nullptr;
     ObjectPool<GroupInfoIteratorImpl, kIteratorsMax> mGroupInfoIterators;
@@ -254,6 +307,8 @@ protected:
     ObjectPool<KeySetIteratorImpl, kIteratorsMax> mKeySetIterators;
     ObjectPool<GroupSessionIteratorImpl, kIteratorsMax> mGroupSessionsIterator;
     ObjectPool<GroupKeyContext, kIteratorsMax> mGroupKeyContexPool;
+    GroupSessionEntry * mSessionIndex[kSessionIndexBuckets] = {};
+    bool mSessionIndexValid                                 = false;
 };
 
 } // namespace Credentials
@@ -335,6 +335,8 @@ CHIP_ERROR PersistentStorageOpCertStore::CommitOpCertsForFabric(FabricIndex fabr
 
     // TODO: Handle transaction marking to revert partial certs at next boot if we get interrupted by reboot.
 
+    PersistentStorageWriteBatch writeBatch(mStorage);
+
     // Start committing NOC first so we don't have dangling roots if one was added.
     ByteSpan pendingNocSpan{ mPendingNoc.Get(), mPendingNoc.AllocatedSize() };
     CHIP_ERROR nocErr = SaveCertToStorage(mStorage, mPendingFabricIndex, CertChainElement::kNoc, pendingNocSpan);
@@ -377,6 +379,8 @@ CHIP_ERROR PersistentStorageOpCertStore::CommitOpCertsForFabric(FabricIndex fabr
         return stickyErr;
     }
 
+    ReturnErrorOnFailure(writeBatch.End());
+
     // If we got here, we succeeded and can reset the pending certs: next `GetCertificate` will use the stored certs
     RevertPendingOpCerts();
     return CHIP_NO_ERROR;
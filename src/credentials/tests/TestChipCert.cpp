@@ -1072,6 +1072,105 @@ static void TestChipCert_CertValidityPolicyInjection(nlTestSuite * inSuite, void
     certSet.Release();
 }
 
+static void TestChipCert_CertSignatureCache(nlTestSuite * inSuite, void * inContext)
+{
+    CHIP_ERROR err;
+    ChipCertificateSet certSet;
+    ValidationContext validContext;
+    CertificateSignatureCache cache;
+
+    NL_TEST_ASSERT(inSuite, cache.Init() == CHIP_NO_ERROR);
+
+    err = certSet.Init(kStandardCertsCount);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = LoadTestCertSet01(certSet);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    const ChipCertificateData * rootCert = &certSet.GetCertSet()[0];
+    const ChipCertificateData * icaCert  = &certSet.GetCertSet()[1];
+    const ChipCertificateData * nodeCert = &certSet.GetCertSet()[2];
+
+    validContext.Reset();
+    validContext.mRequiredKeyUsages.Set(KeyUsageFlags::kDigitalSignature);
+    validContext.mRequiredKeyPurposes.Set(KeyPurposeFlags::kServerAuth);
+    validContext.mSignatureCache = &cache;
+
+    err = SetCurrentTime(validContext, 2022, 02, 23, 12, 30, 01);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    // The first validation records the NOC and ICAC signatures.
+    err = certSet.ValidateCert(nodeCert, validContext);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, cache.Count() == 2);
+    NL_TEST_ASSERT(inSuite, cache.Contains(*nodeCert, *icaCert));
+    NL_TEST_ASSERT(inSuite, cache.Contains(*icaCert, *rootCert));
+    NL_TEST_ASSERT(inSuite, !cache.Contains(*nodeCert, *rootCert));
+
+    // Validating again is served from the cache.
+    err = certSet.ValidateCert(nodeCert, validContext);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, cache.Count() == 2);
+
+    // A hit skips the signature check: a NOC with a damaged signature fails validation until the cache
+    // vouches for it.  The signature is the last element of the certificate, before the end of the structure.
+    {
+        ByteSpan nodeCertTLV;
+        NL_TEST_ASSERT(inSuite, GetTestCert(TestCert::kNode01_01, sNullLoadFlag, nodeCertTLV) == CHIP_NO_ERROR);
+        uint8_t tamperedCertTLV[kMaxCHIPCertLength];
+        VerifyOrReturn(nodeCertTLV.size() <= sizeof(tamperedCertTLV));
+        memcpy(tamperedCertTLV, nodeCertTLV.data(), nodeCertTLV.size());
+        tamperedCertTLV[nodeCertTLV.size() - 2] ^= 0x01;
+
+        ChipCertificateSet tamperedSet;
+        NL_TEST_ASSERT(inSuite, tamperedSet.Init(kStandardCertsCount) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, LoadTestCert(tamperedSet, TestCert::kRoot01, sNullLoadFlag, sTrustAnchorFlag) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, LoadTestCert(tamperedSet, TestCert::kICA01, sNullLoadFlag, sGenTBSHashFlag) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite,
+                       tamperedSet.LoadCert(ByteSpan(tamperedCertTLV, nodeCertTLV.size()), sGenTBSHashFlag) == CHIP_NO_ERROR);
+        const ChipCertificateData * tamperedIcaCert  = &tamperedSet.GetCertSet()[1];
+        const ChipCertificateData * tamperedNodeCert = &tamperedSet.GetCertSet()[2];
+
+        err = tamperedSet.ValidateCert(tamperedNodeCert, validContext);
+        NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_INVALID_SIGNATURE);
+        NL_TEST_ASSERT(inSuite, cache.Count() == 2);
+
+        cache.Add(*tamperedNodeCert, *tamperedIcaCert);
+        err = tamperedSet.ValidateCert(tamperedNodeCert, validContext);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, cache.Count() == 3);
+
+        tamperedSet.Release();
+    }
+
+    // Validity periods are still enforced for cached signatures.
+    err = SetCurrentTime(validContext, 2020, 1, 3);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = certSet.ValidateCert(nodeCert, validContext);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_CERT_NOT_VALID_YET);
+
+    // The least recently used entry is evicted once the cache is full.
+    cache.Clear();
+    NL_TEST_ASSERT(inSuite, cache.Count() == 0);
+    for (size_t i = 0; i < CertificateSignatureCache::kCapacity; i++)
+    {
+        ChipCertificateData signer;
+        uint8_t publicKey[Crypto::kP256_PublicKey_Length] = { static_cast<uint8_t>(i), static_cast<uint8_t>(i >> 8) };
+        signer.mPublicKey                                 = P256PublicKeySpan(publicKey);
+        cache.Add(*nodeCert, signer);
+    }
+    NL_TEST_ASSERT(inSuite, cache.Count() == CertificateSignatureCache::kCapacity);
+    cache.Add(*nodeCert, *icaCert);
+    NL_TEST_ASSERT(inSuite, cache.Count() == CertificateSignatureCache::kCapacity);
+    NL_TEST_ASSERT(inSuite, cache.Contains(*nodeCert, *icaCert));
+    {
+        ChipCertificateData signer;
+        uint8_t publicKey[Crypto::kP256_PublicKey_Length] = { 0 };
+        signer.mPublicKey                                 = P256PublicKeySpan(publicKey);
+        NL_TEST_ASSERT(inSuite, !cache.Contains(*nodeCert, signer));
+    }
+}
+
 static void TestChipCert_CertUsage(nlTestSuite * inSuite, void * inContext)
 {
     CHIP_ERROR err;
@@ -2232,6 +2331,7 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("Test CHIP Certificate Validation time", TestChipCert_CertValidTime),
     NL_TEST_DEF("Test CHIP Root Certificate Validation", TestChipCert_ValidateChipRCAC),
     NL_TEST_DEF("Test CHIP Certificate Validity Policy injection", TestChipCert_CertValidityPolicyInjection),
+    NL_TEST_DEF("Test CHIP Certificate Signature Cache", TestChipCert_CertSignatureCache),
     NL_TEST_DEF("Test CHIP Certificate Usage", TestChipCert_CertUsage),
     NL_TEST_DEF("Test CHIP Certificate Type", TestChipCert_CertType),
     NL_TEST_DEF("Test CHIP Certificate ID", TestChipCert_CertId),
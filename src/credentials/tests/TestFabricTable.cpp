@@ -625,10 +625,12 @@ void TestBasicAddNocUpdateNocFlow(nlTestSuite * inSuite, void * inContext)
             NL_TEST_ASSERT(inSuite, saw1 == true);
         }
 
-        // Commit, now storage should have keys
+        // Commit, now storage should have keys, written with a single flush
+        size_t numFlushesBeforeCommit = storage.GetNumFlushes();
         NL_TEST_ASSERT_SUCCESS(inSuite, fabricTable.CommitPendingFabricData());
 
         NL_TEST_ASSERT(inSuite, storage.GetNumKeys() == (numStorageKeysAtStart + 4)); // 2 opcerts + fabric metadata + index
+        NL_TEST_ASSERT_EQUALS(inSuite, storage.GetNumFlushes(), numFlushesBeforeCommit + 1);
 
         // Next fabric index has been updated.
         {
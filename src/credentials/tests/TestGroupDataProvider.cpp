@@ -28,6 +28,7 @@
 #include <string.h>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 using namespace chip::Credentials;
 using GroupInfo      = GroupDataProvider::GroupInfo;
@@ -1196,6 +1197,141 @@ void TestGroupDecryption(nlTestSuite * apSuite, void * apContext)
     }
 }
 
+using SessionCandidates = std::vector<std::pair<FabricIndex, GroupId>>;
+
+// Returns the (fabric, group) pairs of the sessions matching session_id, in iteration order.
+SessionCandidates GetSessionCandidates(nlTestSuite * apSuite, GroupDataProvider * provider, uint16_t session_id)
+{
+    SessionCandidates candidates;
+    GroupSession session;
+    auto it = provider->IterateGroupSessions(session_id);
+
+    NL_TEST_ASSERT(apSuite, it);
+    if (it)
+    {
+        size_t total = it->Count();
+        while (it->Next(session))
+        {
+            NL_TEST_ASSERT(apSuite, session.keyContext != nullptr);
+            NL_TEST_ASSERT(apSuite, session.keyContext == nullptr || session.keyContext->GetKeyHash() == session_id);
+            candidates.emplace_back(session.fabric_index, session.group_id);
+        }
+        NL_TEST_ASSERT(apSuite, candidates.size() == total);
+        it->Release();
+    }
+    return candidates;
+}
+
+uint16_t GetSessionId(GroupDataProvider * provider, FabricIndex fabric_index, GroupId group_id)
+{
+    uint16_t session_id                       = 0;
+    Crypto::SymmetricKeyContext * key_context = provider->GetKeyContext(fabric_index, group_id);
+    if (key_context)
+    {
+        session_id = key_context->GetKeyHash();
+        key_context->Release();
+    }
+    return session_id;
+}
+
+void TestGroupSessionIndex(nlTestSuite * apSuite, void * apContext)
+{
+    GroupDataProvider * provider = GetGroupDataProvider();
+    NL_TEST_ASSERT(apSuite, provider);
+
+    // Reset test
+    ResetProvider(provider);
+
+    // The same keyset is mapped to two groups of fabric 1
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric1, kCompressedFabricId1, kKeySet2));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetGroupKeyAt(kFabric1, 0, kGroup1Keyset2));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetGroupKeyAt(kFabric1, 1, kGroup2Keyset2));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric2, kCompressedFabricId2, kKeySet1));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetGroupKeyAt(kFabric2, 0, kGroup3Keyset1));
+
+    const uint16_t session1 = GetSessionId(provider, kFabric1, kGroup1);
+    const uint16_t session2 = GetSessionId(provider, kFabric2, kGroup3);
+    NL_TEST_ASSERT(apSuite, session1 != session2);
+
+    const SessionCandidates kBothGroups = { { kFabric1, kGroup1 }, { kFabric1, kGroup2 } };
+    NL_TEST_ASSERT(apSuite, GetSessionCandidates(apSuite, provider, session1) == kBothGroups);
+    NL_TEST_ASSERT(apSuite, GetSessionCandidates(apSuite, provider, session2) == SessionCandidates({ { kFabric2, kGroup3 } }));
+
+    // Messages encrypted with the group key can be decrypted and deobfuscated with the session key context
+    const uint8_t kMessage[] = { 0xa0, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9 };
+    const uint8_t kNonce[13] = { 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x18, 0x1a, 0x1b, 0x1c };
+    const uint8_t kAad[]     = { 0x0a, 0x1a, 0x2a, 0x3a, 0x4a, 0x5a, 0x6a, 0x7a };
+    uint8_t mic[16]          = { 0 };
+    uint8_t ciphertext[sizeof(kMessage)];
+    uint8_t obfuscated[sizeof(kMessage)];
+    uint8_t output[sizeof(kMessage)];
+    MutableByteSpan tag(mic);
+    ByteSpan aad(kAad);
+    ByteSpan nonce(kNonce);
+    MutableByteSpan ciphertextSpan(ciphertext);
+    MutableByteSpan obfuscatedSpan(obfuscated);
+    MutableByteSpan outputSpan(output);
+
+    Crypto::SymmetricKeyContext * key_context = provider->GetKeyContext(kFabric1, kGroup2);
+    NL_TEST_ASSERT(apSuite, key_context);
+    if (key_context)
+    {
+        NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == key_context->MessageEncrypt(ByteSpan(kMessage), aad, nonce, tag, ciphertextSpan));
+        NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == key_context->PrivacyEncrypt(ByteSpan(kMessage), nonce, obfuscatedSpan));
+        key_context->Release();
+    }
+
+    GroupSession session;
+    auto it = provider->IterateGroupSessions(session1);
+    NL_TEST_ASSERT(apSuite, it && it->Next(session));
+    if (it)
+    {
+        NL_TEST_ASSERT(apSuite,
+                       CHIP_NO_ERROR == session.keyContext->MessageDecrypt(ByteSpan(ciphertext), aad, nonce, tag, outputSpan));
+        NL_TEST_ASSERT(apSuite, 0 == memcmp(output, kMessage, sizeof(kMessage)));
+        NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == session.keyContext->PrivacyDecrypt(ByteSpan(obfuscated), nonce, outputSpan));
+        NL_TEST_ASSERT(apSuite, 0 == memcmp(output, kMessage, sizeof(kMessage)));
+
+        // A tampered message is rejected
+        ciphertext[0] ^= 0x01;
+        NL_TEST_ASSERT(apSuite,
+                       CHIP_NO_ERROR != session.keyContext->MessageDecrypt(ByteSpan(ciphertext), aad, nonce, tag, outputSpan));
+        it->Release();
+    }
+
+    // Updating the keys replaces the sessions
+    KeySet keyset = kKeySet2;
+    keyset.epoch_keys[0].key[0] ^= 0xff;
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric1, kCompressedFabricId1, keyset));
+    const uint16_t session3 = GetSessionId(provider, kFabric1, kGroup1);
+    NL_TEST_ASSERT(apSuite, session3 != session1);
+    NL_TEST_ASSERT(apSuite, GetSessionCandidates(apSuite, provider, session1).empty());
+    NL_TEST_ASSERT(apSuite, GetSessionCandidates(apSuite, provider, session3) == kBothGroups);
+
+    // Removing a mapping removes its session
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->RemoveGroupKeyAt(kFabric1, 0));
+    NL_TEST_ASSERT(apSuite, GetSessionCandidates(apSuite, provider, session3) == SessionCandidates({ { kFabric1, kGroup2 } }));
+
+    // Changes made while an iterator is alive are seen by new iterators, and the old one stays usable
+    it = provider->IterateGroupSessions(session3);
+    NL_TEST_ASSERT(apSuite, it);
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->RemoveKeySet(kFabric1, kKeysetId2));
+    NL_TEST_ASSERT(apSuite, GetSessionCandidates(apSuite, provider, session3).empty());
+    if (it)
+    {
+        NL_TEST_ASSERT(apSuite, it->Next(session));
+        NL_TEST_ASSERT(apSuite, session.fabric_index == kFabric1 && session.group_id == kGroup2);
+        NL_TEST_ASSERT(apSuite, session.keyContext != nullptr && session.keyContext->GetKeyHash() == session3);
+        NL_TEST_ASSERT(apSuite, !it->Next(session));
+        it->Release();
+    }
+    NL_TEST_ASSERT(apSuite, GetSessionCandidates(apSuite, provider, session3).empty());
+
+    // Removing the fabric removes its sessions
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->RemoveFabric(kFabric2));
+    NL_TEST_ASSERT(apSuite, GetSessionCandidates(apSuite, provider, session2).empty());
+}
+
 } // namespace TestGroups
 } // namespace app
 } // namespace chip
@@ -1275,6 +1411,7 @@ const nlTest sTests[] = { NL_TEST_DEF("TestStorageDelegate", chip::app::TestGrou
                           NL_TEST_DEF("TestIpk", chip::app::TestGroups::TestIpk),
                           NL_TEST_DEF("TestPerFabricData", chip::app::TestGroups::TestPerFabricData),
                           NL_TEST_DEF("TestGroupDecryption", chip::app::TestGroups::TestGroupDecryption),
+                          NL_TEST_DEF("TestGroupSessionIndex", chip::app::TestGroups::TestGroupSessionIndex),
                           NL_TEST_SENTINEL() };
 } // namespace
 
@@ -789,6 +789,37 @@ CHIP_ERROR AES_CTR_crypt(const uint8_t * input, size_t input_length, const Aes12
     return AES_CCM_encrypt(input, input_length, nullptr, 0, key, nonce, nonce_length, output, tag, kTagLen);
 }
 
+#if !(CHIP_CRYPTO_OPENSSL || CHIP_CRYPTO_BORINGSSL)
+// Backends without reusable cipher state process every message with the one-shot functions.
+CHIP_ERROR Aes128CcmContext::Init(const Aes128KeyHandle & key)
+{
+    mKey = &key;
+    return CHIP_NO_ERROR;
+}
+
+void Aes128CcmContext::Clear()
+{
+    mKey = nullptr;
+}
+
+CHIP_ERROR Aes128CcmContext::Encrypt(const uint8_t * plaintext, size_t plaintext_length, const uint8_t * aad, size_t aad_length,
+                                     const uint8_t * nonce, size_t nonce_length, uint8_t * ciphertext, uint8_t * tag,
+                                     size_t tag_length) const
+{
+    VerifyOrReturnError(mKey != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    return AES_CCM_encrypt(plaintext, plaintext_length, aad, aad_length, *mKey, nonce, nonce_length, ciphertext, tag, tag_length);
+}
+
+CHIP_ERROR Aes128CcmContext::Decrypt(const uint8_t * ciphertext, size_t ciphertext_length, const uint8_t * aad, size_t aad_length,
+                                     const uint8_t * tag, size_t tag_length, const uint8_t * nonce, size_t nonce_length,
+                                     uint8_t * plaintext) const
+{
+    VerifyOrReturnError(mKey != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    return AES_CCM_decrypt(ciphertext, ciphertext_length, aad, aad_length, tag, tag_length, *mKey, nonce, nonce_length,
+                           plaintext);
+}
+#endif // !(CHIP_CRYPTO_OPENSSL || CHIP_CRYPTO_BORINGSSL)
+
 CHIP_ERROR GenerateCompressedFabricId(const Crypto::P256PublicKey & root_public_key, uint64_t fabric_id,
                                       MutableByteSpan & out_compressed_fabric_id)
 {
@@ -785,6 +785,58 @@ CHIP_ERROR AES_CCM_decrypt(const uint8_t * ciphertext, size_t ciphertext_length,
                            const uint8_t * tag, size_t tag_length, const Aes128KeyHandle & key, const uint8_t * nonce,
                            size_t nonce_length, uint8_t * plaintext);
 
+/**
+ * @brief AES-CCM cipher bound to a single key, for encrypting or decrypting many messages with it.
+ *
+ * AES_CCM_encrypt() and AES_CCM_decrypt() set up the cipher, including the key schedule, on every
+ * call. Backends that support it set up the cipher for each direction on first use and keep it in
+ * this object, so that later messages only pay for their nonce, additional authenticated data and
+ * payload. Other backends forward to AES_CCM_encrypt() and AES_CCM_decrypt().
+ *
+ * The key handle passed to Init() must outlive the context, or the next call to Init() or Clear().
+ */
+class Aes128CcmContext
+{
+public:
+    Aes128CcmContext() = default;
+    ~Aes128CcmContext() { Clear(); }
+
+    Aes128CcmContext(const Aes128CcmContext &) = delete;
+    Aes128CcmContext(Aes128CcmContext &&)      = delete;
+    void operator=(const Aes128CcmContext &)   = delete;
+    void operator=(Aes128CcmContext &&)        = delete;
+
+    /**
+     * @brief Bind the context to the given key, releasing any state held for a previous key.
+     */
+    CHIP_ERROR Init(const Aes128KeyHandle & key);
+
+    /**
+     * @brief Release any state held by the context and unbind it from its key.
+     */
+    void Clear();
+
+    bool IsInitialized() const { return mKey != nullptr; }
+
+    /**
+     * @brief Equivalent to AES_CCM_encrypt() with the key the context is bound to.
+     */
+    CHIP_ERROR Encrypt(const uint8_t * plaintext, size_t plaintext_length, const uint8_t * aad, size_t aad_length,
+                       const uint8_t * nonce, size_t nonce_length, uint8_t * ciphertext, uint8_t * tag, size_t tag_length) const;
+
+    /**
+     * @brief Equivalent to AES_CCM_decrypt() with the key the context is bound to.
+     */
+    CHIP_ERROR Decrypt(const uint8_t * ciphertext, size_t ciphertext_length, const uint8_t * aad, size_t aad_length,
+                       const uint8_t * tag, size_t tag_length, const uint8_t * nonce, size_t nonce_length,
+                       uint8_t * plaintext) const;
+
+private:
+    const Aes128KeyHandle * mKey   = nullptr;
+    mutable void * mEncryptContext = nullptr;
+    mutable void * mDecryptContext = nullptr;
+};
+
 /**
  * @brief A function that implements AES-CTR encryption/decryption
  *
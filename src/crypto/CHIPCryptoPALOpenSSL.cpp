@@ -146,19 +146,85 @@ static int _compareDaysAndSeconds(const int days, const int seconds)
     return 0;
 }
 
-CHIP_ERROR AES_CCM_encrypt(const uint8_t * plaintext, size_t plaintext_length, const uint8_t * aad, size_t aad_length,
-                           const Aes128KeyHandle & key, const uint8_t * nonce, size_t nonce_length, uint8_t * ciphertext,
-                           uint8_t * tag, size_t tag_length)
+#if CHIP_CRYPTO_BORINGSSL
+using AesCcmCipherContext = EVP_AEAD_CTX;
+#else
+using AesCcmCipherContext = EVP_CIPHER_CTX;
+#endif // CHIP_CRYPTO_BORINGSSL
+
+/**
+ * Create an AES-CCM cipher context with the key schedule for the given key, for messages with the
+ * given nonce and tag lengths. Each message then only needs to provide its nonce.
+ */
+static CHIP_ERROR NewAesCcmContext(const Aes128KeyHandle & key, bool encrypt, size_t nonce_length, size_t tag_length,
+                                   AesCcmCipherContext *& context)
 {
 #if CHIP_CRYPTO_BORINGSSL
-    EVP_AEAD_CTX * context = nullptr;
+    IgnoreUnusedVariable(encrypt);
+    IgnoreUnusedVariable(nonce_length);
+
+    context = EVP_AEAD_CTX_new(EVP_aead_aes_128_ccm_matter(), key.As<Symmetric128BitsKeyByteArray>(),
+                               sizeof(Symmetric128BitsKeyByteArray), tag_length);
+    VerifyOrReturnError(context != nullptr, CHIP_ERROR_NO_MEMORY);
+#else
+    CHIP_ERROR error = CHIP_NO_ERROR;
+    int result       = 1;
+
+    context = EVP_CIPHER_CTX_new();
+    VerifyOrReturnError(context != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    // Pass in cipher
+    result = EVP_CipherInit_ex(context, EVP_aes_128_ccm(), nullptr, nullptr, nullptr, encrypt ? 1 : 0);
+    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+    // Pass in nonce length.  Cast is safe because callers checked with CanCastTo.
+    result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_IVLEN, static_cast<int>(nonce_length), nullptr);
+    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+    // Pass in tag length. Cast is safe because callers checked against CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES.
+    result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_TAG, static_cast<int>(tag_length), nullptr);
+    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+    // Pass in key
+    static_assert(kAES_CCM128_Key_Length == sizeof(Symmetric128BitsKeyByteArray), "Unexpected key length");
+    result = EVP_CipherInit_ex(context, nullptr, nullptr, key.As<Symmetric128BitsKeyByteArray>(), nullptr, -1);
+    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+exit:
+    if (error != CHIP_NO_ERROR)
+    {
+        EVP_CIPHER_CTX_free(context);
+        context = nullptr;
+    }
+    return error;
+#endif // CHIP_CRYPTO_BORINGSSL
+
+    return CHIP_NO_ERROR;
+}
+
+static void FreeAesCcmContext(AesCcmCipherContext * context)
+{
+#if CHIP_CRYPTO_BORINGSSL
+    EVP_AEAD_CTX_free(context);
+#else
+    EVP_CIPHER_CTX_free(context);
+#endif // CHIP_CRYPTO_BORINGSSL
+}
+
+/**
+ * Implements AES_CCM_encrypt(), using keyedContext when it is not null and a context created for
+ * this message otherwise.
+ */
+static CHIP_ERROR AES_CCM_encrypt(AesCcmCipherContext * keyedContext, const uint8_t * plaintext, size_t plaintext_length,
+                                  const uint8_t * aad, size_t aad_length, const Aes128KeyHandle & key, const uint8_t * nonce,
+                                  size_t nonce_length, uint8_t * ciphertext, uint8_t * tag, size_t tag_length)
+{
+    AesCcmCipherContext * context = nullptr;
+#if CHIP_CRYPTO_BORINGSSL
     size_t written_tag_len = 0;
-    const EVP_AEAD * aead  = nullptr;
 #else
-    EVP_CIPHER_CTX * context = nullptr;
     int bytesWritten         = 0;
     size_t ciphertext_length = 0;
-    const EVP_CIPHER * type  = nullptr;
 #endif
     CHIP_ERROR error = CHIP_NO_ERROR;
     int result       = 1;
@@ -201,38 +267,21 @@ CHIP_ERROR AES_CCM_encrypt(const uint8_t * plaintext, size_t plaintext_length, c
                               error = CHIP_ERROR_INVALID_ARGUMENT);
 #endif // CHIP_CRYPTO_BORINGSSL
 
-#if CHIP_CRYPTO_BORINGSSL
-    aead = EVP_aead_aes_128_ccm_matter();
-
-    context = EVP_AEAD_CTX_new(aead, key.As<Symmetric128BitsKeyByteArray>(), sizeof(Symmetric128BitsKeyByteArray), tag_length);
-    VerifyOrExit(context != nullptr, error = CHIP_ERROR_NO_MEMORY);
+    context = keyedContext;
+    if (context == nullptr)
+    {
+        SuccessOrExit(error = NewAesCcmContext(key, true, nonce_length, tag_length, context));
+    }
 
+#if CHIP_CRYPTO_BORINGSSL
     result = EVP_AEAD_CTX_seal_scatter(context, ciphertext, tag, &written_tag_len, tag_length, nonce, nonce_length, plaintext,
                                        plaintext_length, nullptr, 0, aad, aad_length);
     VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
     VerifyOrExit(written_tag_len == tag_length, error = CHIP_ERROR_INTERNAL);
 #else
 
-    type = EVP_aes_128_ccm();
-
-    context = EVP_CIPHER_CTX_new();
-    VerifyOrExit(context != nullptr, error = CHIP_ERROR_NO_MEMORY);
-
-    // Pass in cipher
-    result = EVP_EncryptInit_ex(context, type, nullptr, nullptr, nullptr);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
-
-    // Pass in nonce length.  Cast is safe because we checked with CanCastTo.
-    result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_IVLEN, static_cast<int>(nonce_length), nullptr);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
-
-    // Pass in tag length. Cast is safe because we checked against CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES.
-    result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_TAG, static_cast<int>(tag_length), nullptr);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
-
-    // Pass in key + nonce
-    static_assert(kAES_CCM128_Key_Length == sizeof(Symmetric128BitsKeyByteArray), "Unexpected key length");
-    result = EVP_EncryptInit_ex(context, nullptr, nullptr, key.As<Symmetric128BitsKeyByteArray>(), Uint8::to_const_uchar(nonce));
+    // Pass in nonce
+    result = EVP_EncryptInit_ex(context, nullptr, nullptr, nullptr, Uint8::to_const_uchar(nonce));
     VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 
     // Pass in plain text length
@@ -268,31 +317,26 @@ CHIP_ERROR AES_CCM_encrypt(const uint8_t * plaintext, size_t plaintext_length, c
 #endif // CHIP_CRYPTO_BORINGSSL
 
 exit:
-    if (context != nullptr)
+    if (context != nullptr && context != keyedContext)
     {
-#if CHIP_CRYPTO_BORINGSSL
-        EVP_AEAD_CTX_free(context);
-#else
-        EVP_CIPHER_CTX_free(context);
-#endif // CHIP_CRYPTO_BORINGSSL
+        FreeAesCcmContext(context);
         context = nullptr;
     }
 
     return error;
 }
 
-CHIP_ERROR AES_CCM_decrypt(const uint8_t * ciphertext, size_t ciphertext_length, const uint8_t * aad, size_t aad_length,
-                           const uint8_t * tag, size_t tag_length, const Aes128KeyHandle & key, const uint8_t * nonce,
-                           size_t nonce_length, uint8_t * plaintext)
+/**
+ * Implements AES_CCM_decrypt(), using keyedContext when it is not null and a context created for
+ * this message otherwise.
+ */
+static CHIP_ERROR AES_CCM_decrypt(AesCcmCipherContext * keyedContext, const uint8_t * ciphertext, size_t ciphertext_length,
+                                  const uint8_t * aad, size_t aad_length, const uint8_t * tag, size_t tag_length,
+                                  const Aes128KeyHandle & key, const uint8_t * nonce, size_t nonce_length, uint8_t * plaintext)
 {
-#if CHIP_CRYPTO_BORINGSSL
-    EVP_AEAD_CTX * context = nullptr;
-    const EVP_AEAD * aead  = nullptr;
-#else
-
-    EVP_CIPHER_CTX * context = nullptr;
-    int bytesOutput          = 0;
-    const EVP_CIPHER * type  = nullptr;
+    AesCcmCipherContext * context = nullptr;
+#if !CHIP_CRYPTO_BORINGSSL
+    int bytesOutput = 0;
 #endif // CHIP_CRYPTO_BORINGSSL
     CHIP_ERROR error = CHIP_NO_ERROR;
     int result       = 1;
@@ -332,31 +376,19 @@ CHIP_ERROR AES_CCM_decrypt(const uint8_t * ciphertext, size_t ciphertext_length,
 #endif // CHIP_CRYPTO_BORINGSSL
     VerifyOrExit(nonce != nullptr, error = CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrExit(nonce_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(CanCastTo<int>(nonce_length), error = CHIP_ERROR_INVALID_ARGUMENT);
 
-#if CHIP_CRYPTO_BORINGSSL
-    aead = EVP_aead_aes_128_ccm_matter();
-
-    context = EVP_AEAD_CTX_new(aead, key.As<Symmetric128BitsKeyByteArray>(), sizeof(Symmetric128BitsKeyByteArray), tag_length);
-    VerifyOrExit(context != nullptr, error = CHIP_ERROR_NO_MEMORY);
+    context = keyedContext;
+    if (context == nullptr)
+    {
+        SuccessOrExit(error = NewAesCcmContext(key, false, nonce_length, tag_length, context));
+    }
 
+#if CHIP_CRYPTO_BORINGSSL
     result = EVP_AEAD_CTX_open_gather(context, plaintext, nonce, nonce_length, ciphertext, ciphertext_length, tag, tag_length, aad,
                                       aad_length);
     VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 #else
-    type = EVP_aes_128_ccm();
-
-    context = EVP_CIPHER_CTX_new();
-    VerifyOrExit(context != nullptr, error = CHIP_ERROR_NO_MEMORY);
-
-    // Pass in cipher
-    result = EVP_DecryptInit_ex(context, type, nullptr, nullptr, nullptr);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
-
-    // Pass in nonce length
-    VerifyOrExit(CanCastTo<int>(nonce_length), error = CHIP_ERROR_INVALID_ARGUMENT);
-    result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_IVLEN, static_cast<int>(nonce_length), nullptr);
-    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
-
     // Pass in expected tag
     // Removing "const" from |tag| here should hopefully be safe as
     // we're writing the tag, not reading.
@@ -365,9 +397,8 @@ CHIP_ERROR AES_CCM_decrypt(const uint8_t * ciphertext, size_t ciphertext_length,
                                               const_cast<void *>(static_cast<const void *>(tag)));
     VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 
-    // Pass in key + nonce
-    static_assert(kAES_CCM128_Key_Length == sizeof(Symmetric128BitsKeyByteArray), "Unexpected key length");
-    result = EVP_DecryptInit_ex(context, nullptr, nullptr, key.As<Symmetric128BitsKeyByteArray>(), Uint8::to_const_uchar(nonce));
+    // Pass in nonce
+    result = EVP_DecryptInit_ex(context, nullptr, nullptr, nullptr, Uint8::to_const_uchar(nonce));
     VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
 
     // Pass in cipher text length
@@ -397,20 +428,97 @@ CHIP_ERROR AES_CCM_decrypt(const uint8_t * ciphertext, size_t ciphertext_length,
 #endif // CHIP_CRYPTO_BORINGSSL
 
 exit:
-    if (context != nullptr)
+    if (context != nullptr && context != keyedContext)
     {
-#if CHIP_CRYPTO_BORINGSSL
-        EVP_AEAD_CTX_free(context);
-#else
-        EVP_CIPHER_CTX_free(context);
-#endif // CHIP_CRYPTO_BORINGSSL
-
+        FreeAesCcmContext(context);
         context = nullptr;
     }
 
     return error;
 }
 
+CHIP_ERROR AES_CCM_encrypt(const uint8_t * plaintext, size_t plaintext_length, const uint8_t * aad, size_t aad_length,
+                           const Aes128KeyHandle & key, const uint8_t * nonce, size_t nonce_length, uint8_t * ciphertext,
+                           uint8_t * tag, size_t tag_length)
+{
+    return AES_CCM_encrypt(nullptr, plaintext, plaintext_length, aad, aad_length, key, nonce, nonce_length, ciphertext, tag,
+                           tag_length);
+}
+
+CHIP_ERROR AES_CCM_decrypt(const uint8_t * ciphertext, size_t ciphertext_length, const uint8_t * aad, size_t aad_length,
+                           const uint8_t * tag, size_t tag_length, const Aes128KeyHandle & key, const uint8_t * nonce,
+                           size_t nonce_length, uint8_t * plaintext)
+{
+    return AES_CCM_decrypt(nullptr, ciphertext, ciphertext_length, aad, aad_length, tag, tag_length, key, nonce, nonce_length,
+                           plaintext);
+}
+
+// The contexts kept by Aes128CcmContext are set up for the nonce and tag lengths of Matter messages.
+// Messages with other lengths, or for which the context could not be created, use a context created
+// for the message.
+static constexpr size_t kAesCcmContextNonceLength = CHIP_CRYPTO_AEAD_NONCE_LENGTH_BYTES;
+static constexpr size_t kAesCcmContextTagLength   = CHIP_CRYPTO_AEAD_MIC_LENGTH_BYTES;
+
+static AesCcmCipherContext * GetAesCcmContext(const Aes128KeyHandle & key, bool encrypt, size_t nonce_length, size_t tag_length,
+                                              void *& cachedContext)
+{
+    VerifyOrReturnValue(nonce_length == kAesCcmContextNonceLength && tag_length == kAesCcmContextTagLength, nullptr);
+
+    if (cachedContext == nullptr)
+    {
+        AesCcmCipherContext * context = nullptr;
+        VerifyOrReturnValue(NewAesCcmContext(key, encrypt, nonce_length, tag_length, context) == CHIP_NO_ERROR, nullptr);
+        cachedContext = context;
+    }
+
+    return static_cast<AesCcmCipherContext *>(cachedContext);
+}
+
+CHIP_ERROR Aes128CcmContext::Init(const Aes128KeyHandle & key)
+{
+    Clear();
+    mKey = &key;
+    return CHIP_NO_ERROR;
+}
+
+void Aes128CcmContext::Clear()
+{
+    if (mEncryptContext != nullptr)
+    {
+        FreeAesCcmContext(static_cast<AesCcmCipherContext *>(mEncryptContext));
+    }
+    if (mDecryptContext != nullptr)
+    {
+        FreeAesCcmContext(static_cast<AesCcmCipherContext *>(mDecryptContext));
+    }
+
+    mKey            = nullptr;
+    mEncryptContext = nullptr;
+    mDecryptContext = nullptr;
+}
+
+CHIP_ERROR Aes128CcmContext::Encrypt(const uint8_t * plaintext, size_t plaintext_length, const uint8_t * aad, size_t aad_length,
+                                     const uint8_t * nonce, size_t nonce_length, uint8_t * ciphertext, uint8_t * tag,
+                                     size_t tag_length) const
+{
+    VerifyOrReturnError(mKey != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    AesCcmCipherContext * context = GetAesCcmContext(*mKey, true, nonce_length, tag_length, mEncryptContext);
+    return AES_CCM_encrypt(context, plaintext, plaintext_length, aad, aad_length, *mKey, nonce, nonce_length, ciphertext, tag,
+                           tag_length);
+}
+
+CHIP_ERROR Aes128CcmContext::Decrypt(const uint8_t * ciphertext, size_t ciphertext_length, const uint8_t * aad, size_t aad_length,
+                                     const uint8_t * tag, size_t tag_length, const uint8_t * nonce, size_t nonce_length,
+                                     uint8_t * plaintext) const
+{
+    VerifyOrReturnError(mKey != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    AesCcmCipherContext * context = GetAesCcmContext(*mKey, false, nonce_length, tag_length, mDecryptContext);
+    return AES_CCM_decrypt(context, ciphertext, ciphertext_length, aad, aad_length, tag, tag_length, *mKey, nonce, nonce_length,
+                           plaintext);
+}
+
 CHIP_ERROR Hash_SHA256(const uint8_t * data, const size_t data_length, uint8_t * out_buffer)
 {
     // zero data length hash is supported.
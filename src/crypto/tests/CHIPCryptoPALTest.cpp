@@ -348,6 +348,69 @@ static void TestAES_CCM_128DecryptTestVectors(nlTestSuite * inSuite, void * inCo
     NL_TEST_ASSERT(inSuite, numOfTestsRan > 0);
 }
 
+static void TestAES_CCM_128ContextTestVectors(nlTestSuite * inSuite, void * inContext)
+{
+    HeapChecker heapChecker(inSuite);
+    int numOfTestVectors = ArraySize(ccm_128_test_vectors);
+    int numOfTestsRan    = 0;
+    for (int vectorIndex = 0; vectorIndex < numOfTestVectors; vectorIndex++)
+    {
+        const ccm_128_test_vector * vector = ccm_128_test_vectors[vectorIndex];
+        if (vector->pt_len > 0 && vector->result == CHIP_NO_ERROR)
+        {
+            numOfTestsRan++;
+            chip::Platform::ScopedMemoryBuffer<uint8_t> out_ct;
+            out_ct.Alloc(vector->ct_len);
+            NL_TEST_ASSERT(inSuite, out_ct);
+            chip::Platform::ScopedMemoryBuffer<uint8_t> out_tag;
+            out_tag.Alloc(vector->tag_len);
+            NL_TEST_ASSERT(inSuite, out_tag);
+            chip::Platform::ScopedMemoryBuffer<uint8_t> out_pt;
+            out_pt.Alloc(vector->pt_len);
+            NL_TEST_ASSERT(inSuite, out_pt);
+            chip::Platform::ScopedMemoryBuffer<uint8_t> bad_tag;
+            bad_tag.Alloc(vector->tag_len);
+            NL_TEST_ASSERT(inSuite, bad_tag);
+
+            TestAesKey key(inSuite, vector->key, vector->key_len);
+            Aes128CcmContext context;
+            NL_TEST_ASSERT(inSuite, !context.IsInitialized());
+            NL_TEST_ASSERT(inSuite, context.Init(key.key) == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(inSuite, context.IsInitialized());
+
+            // Each message must come out the same, whatever the context was previously used for.
+            for (int i = 0; i < 2; i++)
+            {
+                CHIP_ERROR err = context.Encrypt(vector->pt, vector->pt_len, vector->aad, vector->aad_len, vector->nonce,
+                                                 vector->nonce_len, out_ct.Get(), out_tag.Get(), vector->tag_len);
+                NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+                NL_TEST_ASSERT(inSuite, memcmp(out_ct.Get(), vector->ct, vector->ct_len) == 0);
+                NL_TEST_ASSERT(inSuite, memcmp(out_tag.Get(), vector->tag, vector->tag_len) == 0);
+
+                err = context.Decrypt(vector->ct, vector->ct_len, vector->aad, vector->aad_len, vector->tag, vector->tag_len,
+                                      vector->nonce, vector->nonce_len, out_pt.Get());
+                NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+                NL_TEST_ASSERT(inSuite, memcmp(out_pt.Get(), vector->pt, vector->pt_len) == 0);
+
+                // A message that fails authentication must not affect the next one.
+                memcpy(bad_tag.Get(), vector->tag, vector->tag_len);
+                bad_tag[0] ^= 0x01;
+                err = context.Decrypt(vector->ct, vector->ct_len, vector->aad, vector->aad_len, bad_tag.Get(), vector->tag_len,
+                                      vector->nonce, vector->nonce_len, out_pt.Get());
+                NL_TEST_ASSERT(inSuite, err != CHIP_NO_ERROR);
+            }
+
+            context.Clear();
+            NL_TEST_ASSERT(inSuite, !context.IsInitialized());
+            NL_TEST_ASSERT(inSuite,
+                           context.Encrypt(vector->pt, vector->pt_len, vector->aad, vector->aad_len, vector->nonce,
+                                           vector->nonce_len, out_ct.Get(), out_tag.Get(),
+                                           vector->tag_len) == CHIP_ERROR_INCORRECT_STATE);
+        }
+    }
+    NL_TEST_ASSERT(inSuite, numOfTestsRan > 0);
+}
+
 static void TestAES_CCM_128EncryptInvalidNonceLen(nlTestSuite * inSuite, void * inContext)
 {
     HeapChecker heapChecker(inSuite);
@@ -2981,6 +3044,7 @@ static const nlTest sTests[] = {
 
     NL_TEST_DEF("Test encrypting AES-CCM-128 test vectors", TestAES_CCM_128EncryptTestVectors),
     NL_TEST_DEF("Test decrypting AES-CCM-128 test vectors", TestAES_CCM_128DecryptTestVectors),
+    NL_TEST_DEF("Test AES-CCM-128 context with test vectors", TestAES_CCM_128ContextTestVectors),
     NL_TEST_DEF("Test encrypting AES-CCM-128 using invalid nonce", TestAES_CCM_128EncryptInvalidNonceLen),
     NL_TEST_DEF("Test encrypting AES-CCM-128 using invalid tag", TestAES_CCM_128EncryptInvalidTagLen),
     NL_TEST_DEF("Test decrypting AES-CCM-128 invalid nonce", TestAES_CCM_128DecryptInvalidNonceLen),
@@ -127,6 +127,17 @@
 #define CHIP_DEVICE_CONFIG_BG_TASK_PRIORITY 1
 #endif
 
+/**
+ * CHIP_DEVICE_CONFIG_BG_TASK_COUNT
+ *
+ * The number of threads serving the background event queue, on platforms that run the
+ * background event loop on a pool of threads (POSIX).  Background work such as the
+ * certificate and signature checks of CASE session establishment is spread across them.
+ */
+#ifndef CHIP_DEVICE_CONFIG_BG_TASK_COUNT
+#define CHIP_DEVICE_CONFIG_BG_TASK_COUNT 1
+#endif
+
 /**
  * CHIP_DEVICE_CONFIG_BG_MAX_EVENT_QUEUE_SIZE
  *
@@ -170,6 +170,27 @@ public:
      */
     CHIP_ERROR Delete(const char * key);
 
+    /**
+     * @brief
+     * Starts a batch of writes: until the matching EndWriteBatch, the
+     * implementation may defer flushing Put and Delete to persistent storage,
+     * so that they are all flushed at once. Batches nest, only ending the
+     * outermost one flushes. Reads always see the writes made so far.
+     */
+    void BeginWriteBatch();
+
+    /**
+     * @brief
+     * Ends a batch of writes started with BeginWriteBatch.
+     *
+     * @return CHIP_NO_ERROR the writes of the batch were flushed, or the batch
+     *                       was nested in another one
+     *         CHIP_ERROR_PERSISTED_STORAGE_FAILED or another error from the
+     *                                             implementation if flushing
+     *                                             failed
+     */
+    CHIP_ERROR EndWriteBatch();
+
 private:
     using ImplClass = ::chip::DeviceLayer::PersistedStorage::KeyValueStoreManagerImpl;
 
@@ -178,6 +199,11 @@ protected:
     KeyValueStoreManager()  = default;
     ~KeyValueStoreManager() = default;
 
+    // Default batching for implementations that flush every write on its own; hidden by
+    // implementations that can do better.
+    void _BeginWriteBatch() {}
+    CHIP_ERROR _EndWriteBatch() { return CHIP_NO_ERROR; }
+
     // No copy, move or assignment.
     KeyValueStoreManager(const KeyValueStoreManager &)             = delete;
     KeyValueStoreManager(const KeyValueStoreManager &&)            = delete;
@@ -233,6 +259,16 @@ inline CHIP_ERROR KeyValueStoreManager::Delete(const char * key)
     return static_cast<ImplClass *>(this)->_Delete(key);
 }
 
+inline void KeyValueStoreManager::BeginWriteBatch()
+{
+    static_cast<ImplClass *>(this)->_BeginWriteBatch();
+}
+
+inline CHIP_ERROR KeyValueStoreManager::EndWriteBatch()
+{
+    return static_cast<ImplClass *>(this)->_EndWriteBatch();
+}
+
 } // namespace PersistedStorage
 } // namespace DeviceLayer
 } // namespace chip
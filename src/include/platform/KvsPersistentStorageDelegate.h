@@ -103,6 +103,18 @@ public:
         return mKvsManager->Delete(key);
     }
 
+    void BeginWriteBatch() override
+    {
+        VerifyOrReturn(mKvsManager != nullptr);
+        mKvsManager->BeginWriteBatch();
+    }
+
+    CHIP_ERROR EndWriteBatch() override
+    {
+        VerifyOrReturnError(mKvsManager != nullptr, CHIP_ERROR_INCORRECT_STATE);
+        return mKvsManager->EndWriteBatch();
+    }
+
 protected:
     DeviceLayer::PersistedStorage::KeyValueStoreManager * mKvsManager = nullptr;
 };
@@ -93,6 +93,13 @@ protected:
     CHIP_ERROR _StartChipTimer(System::Clock::Timeout duration);
     void _Shutdown();
 
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING && !CHIP_SYSTEM_CONFIG_USE_LIBEV
+    CHIP_ERROR _PostBackgroundEvent(const ChipDeviceEvent * event);
+    void _RunBackgroundEventLoop();
+    CHIP_ERROR _StartBackgroundEventLoopTask();
+    CHIP_ERROR _StopBackgroundEventLoopTask();
+#endif
+
 #if CHIP_STACK_LOCK_TRACKING_ENABLED
     bool _IsChipStackLockedByCurrentThread() const;
 #endif
@@ -111,6 +118,18 @@ private:
     DeviceSafeQueue mChipEventQueue;
     std::atomic<bool> mShouldRunEventLoop{ true };
     static void * EventLoopTaskMain(void * arg);
+
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+    // Background work is shared by a pool of CHIP_DEVICE_CONFIG_BG_TASK_COUNT threads, all of
+    // which wait on the same queue. All members below are protected by mBackgroundEventQueueLock.
+    std::queue<ChipDeviceEvent> mBackgroundEventQueue;
+    pthread_mutex_t mBackgroundEventQueueLock = PTHREAD_MUTEX_INITIALIZER;
+    pthread_cond_t mBackgroundEventQueueCond  = PTHREAD_COND_INITIALIZER;
+    bool mShouldRunBackgroundEventLoop        = false;
+    size_t mBackgroundEventLoopTaskCount      = 0;
+    pthread_t mBackgroundEventLoopTasks[CHIP_DEVICE_CONFIG_BG_TASK_COUNT];
+    static void * BackgroundEventLoopTaskMain(void * arg);
+#endif
 #endif
     void ProcessDeviceEvents();
 };
@@ -307,6 +307,123 @@ CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_StartEventLoopTask()
 #endif // CHIP_SYSTEM_CONFIG_USE_LIBEV
 }
 
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING && !CHIP_SYSTEM_CONFIG_USE_LIBEV
+template <class ImplClass>
+CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_PostBackgroundEvent(const ChipDeviceEvent * event)
+{
+    if (!(event->Type == DeviceEventType::kCallWorkFunct || event->Type == DeviceEventType::kNoOp))
+    {
+        return CHIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    pthread_mutex_lock(&mBackgroundEventQueueLock);
+    if (!mShouldRunBackgroundEventLoop)
+    {
+        pthread_mutex_unlock(&mBackgroundEventQueueLock);
+
+        // No background threads are running; use the foreground event loop for background events.
+        return _PostEvent(event);
+    }
+    mBackgroundEventQueue.push(*event);
+    pthread_cond_signal(&mBackgroundEventQueueCond);
+    pthread_mutex_unlock(&mBackgroundEventQueueLock);
+
+    return CHIP_NO_ERROR;
+}
+
+template <class ImplClass>
+void GenericPlatformManagerImpl_POSIX<ImplClass>::_RunBackgroundEventLoop()
+{
+    // Several threads may run this loop at the same time; each one takes the next
+    // queued event, so independent pieces of background work proceed in parallel.
+    // Only _StartBackgroundEventLoopTask sets mShouldRunBackgroundEventLoop: a thread that
+    // gets here after _StopBackgroundEventLoopTask must exit rather than undo the stop.
+    pthread_mutex_lock(&mBackgroundEventQueueLock);
+    while (mShouldRunBackgroundEventLoop)
+    {
+        if (mBackgroundEventQueue.empty())
+        {
+            pthread_cond_wait(&mBackgroundEventQueueCond, &mBackgroundEventQueueLock);
+            continue;
+        }
+
+        const ChipDeviceEvent event = mBackgroundEventQueue.front();
+        mBackgroundEventQueue.pop();
+
+        pthread_mutex_unlock(&mBackgroundEventQueueLock);
+        Impl()->DispatchEvent(&event);
+        pthread_mutex_lock(&mBackgroundEventQueueLock);
+    }
+    pthread_mutex_unlock(&mBackgroundEventQueueLock);
+}
+
+template <class ImplClass>
+void * GenericPlatformManagerImpl_POSIX<ImplClass>::BackgroundEventLoopTaskMain(void * arg)
+{
+    ChipLogDetail(DeviceLayer, "CHIP background task running");
+    static_cast<GenericPlatformManagerImpl_POSIX<ImplClass> *>(arg)->Impl()->RunBackgroundEventLoop();
+    return nullptr;
+}
+
+template <class ImplClass>
+CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_StartBackgroundEventLoopTask()
+{
+    int err = 0;
+
+    pthread_mutex_lock(&mBackgroundEventQueueLock);
+    VerifyOrExit(mBackgroundEventLoopTaskCount == 0, err = EBUSY);
+
+    // Set the flag before the threads start, so that work scheduled from now on is queued for them.
+    mShouldRunBackgroundEventLoop = true;
+    while (mBackgroundEventLoopTaskCount < CHIP_DEVICE_CONFIG_BG_TASK_COUNT)
+    {
+        err = pthread_create(&mBackgroundEventLoopTasks[mBackgroundEventLoopTaskCount], nullptr, BackgroundEventLoopTaskMain, this);
+        VerifyOrExit(err == 0, );
+        mBackgroundEventLoopTaskCount++;
+    }
+
+exit:
+    pthread_mutex_unlock(&mBackgroundEventQueueLock);
+    if (err != 0 && err != EBUSY)
+    {
+        ChipLogError(DeviceLayer, "Failed to start CHIP background task: %d", err);
+        _StopBackgroundEventLoopTask();
+    }
+    return CHIP_ERROR_POSIX(err);
+}
+
+template <class ImplClass>
+CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_StopBackgroundEventLoopTask()
+{
+    pthread_mutex_lock(&mBackgroundEventQueueLock);
+    mShouldRunBackgroundEventLoop = false;
+    pthread_cond_broadcast(&mBackgroundEventQueueCond);
+    size_t taskCount              = mBackgroundEventLoopTaskCount;
+    mBackgroundEventLoopTaskCount = 0;
+    pthread_mutex_unlock(&mBackgroundEventQueueLock);
+
+    for (size_t i = 0; i < taskCount; i++)
+    {
+        if (!pthread_equal(pthread_self(), mBackgroundEventLoopTasks[i]))
+        {
+            pthread_join(mBackgroundEventLoopTasks[i], nullptr);
+        }
+    }
+
+    // Work that was queued but never picked up still has to run, since its owner is waiting
+    // for the completion callback; hand it over to the foreground event loop.
+    pthread_mutex_lock(&mBackgroundEventQueueLock);
+    while (!mBackgroundEventQueue.empty())
+    {
+        _PostEvent(&mBackgroundEventQueue.front());
+        mBackgroundEventQueue.pop();
+    }
+    pthread_mutex_unlock(&mBackgroundEventQueueLock);
+
+    return CHIP_NO_ERROR;
+}
+#endif // CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING && !CHIP_SYSTEM_CONFIG_USE_LIBEV
+
 #if CHIP_SYSTEM_CONFIG_USE_LIBEV
 // fallback implementation
 void __attribute__((weak)) ExitExternalMainLoop()
@@ -393,6 +510,10 @@ void GenericPlatformManagerImpl_POSIX<ImplClass>::_Shutdown()
     //
     VerifyOrDie(mState.load(std::memory_order_relaxed) == State::kStopped);
 
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING && !CHIP_SYSTEM_CONFIG_USE_LIBEV
+    _StopBackgroundEventLoopTask();
+#endif
+
 #if !CHIP_SYSTEM_CONFIG_USE_LIBEV
     pthread_mutex_destroy(&mStateLock);
     pthread_cond_destroy(&mEventQueueStoppedCond);
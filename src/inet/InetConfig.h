@@ -272,6 +272,24 @@
 #endif
 #endif // INET_CONFIG_UDP_SOCKET_PKTINFO
 
+/**
+ *  @def INET_CONFIG_UDP_SOCKET_MAX_RECEIVES_PER_EVENT
+ *
+ *  @brief
+ *    Maximum number of datagrams the socket-based implementation of UDP
+ *    endpoints reads each time the socket is reported readable.
+ *
+ *  @details
+ *    Values above 1 let a busy endpoint (e.g. a controller or bridge serving
+ *    many peers) drain a burst of datagrams in one pass of the event loop
+ *    instead of waking up once per datagram. Datagrams left in the socket are
+ *    read on the next pass, so the value only bounds how long a single
+ *    endpoint may hold the event loop.
+ */
+#ifndef INET_CONFIG_UDP_SOCKET_MAX_RECEIVES_PER_EVENT
+#define INET_CONFIG_UDP_SOCKET_MAX_RECEIVES_PER_EVENT 1
+#endif // INET_CONFIG_UDP_SOCKET_MAX_RECEIVES_PER_EVENT
+
 /**
  *  @def HAVE_SO_BINDTODEVICE
  *
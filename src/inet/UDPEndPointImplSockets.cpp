@@ -575,6 +575,20 @@ void UDPEndPointImplSockets::HandlePendingIO(System::SocketEvents events)
         return;
     }
 
+    // A receive callback may close and release the endpoint; keep it alive until the loop has checked its state.
+    Retain();
+    for (unsigned i = 0; i < INET_CONFIG_UDP_SOCKET_MAX_RECEIVES_PER_EVENT; i++)
+    {
+        if (!ReceiveMessage() || mState != State::kListening || OnMessageReceived == nullptr)
+        {
+            break;
+        }
+    }
+    Release();
+}
+
+bool UDPEndPointImplSockets::ReceiveMessage()
+{
     CHIP_ERROR lStatus = CHIP_NO_ERROR;
     IPPacketInfo lPacketInfo;
     System::PacketBufferHandle lBuffer;
@@ -686,14 +700,14 @@ void UDPEndPointImplSockets::HandlePendingIO(System::SocketEvents events)
     {
         lBuffer.RightSize();
         OnMessageReceived(this, std::move(lBuffer), &lPacketInfo);
+        return true;
     }
-    else
+
+    if (OnReceiveError != nullptr && lStatus != CHIP_ERROR_POSIX(EAGAIN))
     {
-        if (OnReceiveError != nullptr && lStatus != CHIP_ERROR_POSIX(EAGAIN))
-        {
-            OnReceiveError(this, lStatus, nullptr);
-        }
+        OnReceiveError(this, lStatus, nullptr);
     }
+    return false;
 }
 
 #ifdef IPV6_MULTICAST_LOOP
@@ -56,6 +56,7 @@ private:
 
     CHIP_ERROR GetSocket(IPAddressType addressType);
     void HandlePendingIO(System::SocketEvents events);
+    bool ReceiveMessage();
     static void HandlePendingIO(System::SocketEvents events, intptr_t data);
 
     InterfaceId mBoundIntfId;
@@ -361,6 +361,128 @@ static void TestInetEndPointInternal(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, SYSTEM_STATS_TEST_HIGH_WATER_MARK(System::Stats::kInetLayer_NumTCPEps, 1));
 }
 
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_UDP_ENDPOINT
+struct UDPBurstState
+{
+    enum class Action : uint8_t
+    {
+        kNone,
+        kClose,
+        kFree,
+    };
+
+    unsigned received   = 0;
+    unsigned errors     = 0;
+    unsigned actOnCount = 0;
+    Action action       = Action::kNone;
+};
+
+static void HandleBurstMessage(UDPEndPoint * endPoint, PacketBufferHandle && msg, const IPPacketInfo * pktInfo)
+{
+    auto * state = static_cast<UDPBurstState *>(endPoint->mAppState);
+    if (++state->received != state->actOnCount)
+    {
+        return;
+    }
+
+    switch (state->action)
+    {
+    case UDPBurstState::Action::kClose:
+        endPoint->Close();
+        break;
+    case UDPBurstState::Action::kFree:
+        endPoint->Free();
+        break;
+    case UDPBurstState::Action::kNone:
+        break;
+    }
+}
+
+static void HandleBurstError(UDPEndPoint * endPoint, CHIP_ERROR err, const IPPacketInfo * pktInfo)
+{
+    static_cast<UDPBurstState *>(endPoint->mAppState)->errors++;
+}
+
+static CHIP_ERROR ListenOnLoopback(UDPEndPoint * endPoint, UDPBurstState & state, IPAddress & addr)
+{
+#if INET_CONFIG_ENABLE_IPV4
+    VerifyOrReturnError(IPAddress::FromString("127.0.0.1", addr), CHIP_ERROR_INTERNAL);
+    ReturnErrorOnFailure(endPoint->Bind(IPAddressType::kIPv4, addr, 0));
+#else
+    VerifyOrReturnError(IPAddress::FromString("::1", addr), CHIP_ERROR_INTERNAL);
+    ReturnErrorOnFailure(endPoint->Bind(IPAddressType::kIPv6, addr, 0));
+#endif // INET_CONFIG_ENABLE_IPV4
+    return endPoint->Listen(HandleBurstMessage, HandleBurstError, &state);
+}
+
+static void SendBurst(nlTestSuite * inSuite, UDPEndPoint * sender, const IPAddress & addr, uint16_t port, unsigned count)
+{
+    for (unsigned i = 0; i < count; i++)
+    {
+        PacketBufferHandle buf = PacketBufferHandle::New(PacketBuffer::kMaxSize);
+        NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, !buf.IsNull());
+        buf->SetDataLength(1);
+        NL_TEST_ASSERT(inSuite, sender->SendTo(addr, port, std::move(buf)) == CHIP_NO_ERROR);
+    }
+}
+
+// Test that a readable UDP socket is drained up to INET_CONFIG_UDP_SOCKET_MAX_RECEIVES_PER_EVENT datagrams per event,
+// that running out of datagrams (EAGAIN) is not reported as an error, and that the receive loop stops as soon as a
+// callback closes or frees the endpoint.
+static void TestInetUDPReceiveBurst(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr unsigned kMaxPerEvent = INET_CONFIG_UDP_SOCKET_MAX_RECEIVES_PER_EVENT;
+    constexpr unsigned kBurst       = 2 * kMaxPerEvent + 1;
+
+    UDPBurstState state;
+    IPAddress addr;
+    UDPEndPoint * receiver = nullptr;
+    UDPEndPoint * sender   = nullptr;
+
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, gUDP.NewEndPoint(&sender) == CHIP_NO_ERROR);
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, gUDP.NewEndPoint(&receiver) == CHIP_NO_ERROR);
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, ListenOnLoopback(receiver, state, addr) == CHIP_NO_ERROR);
+
+    // Each pass of the event loop reads at most kMaxPerEvent datagrams; the last pass reads the remainder and then hits EAGAIN.
+    SendBurst(inSuite, sender, addr, receiver->GetBoundPort(), kBurst);
+    ServiceEvents(100);
+    NL_TEST_ASSERT(inSuite, state.received == kMaxPerEvent);
+    for (int i = 0; i < 10 && state.received < kBurst; i++)
+    {
+        ServiceEvents(100);
+    }
+    NL_TEST_ASSERT(inSuite, state.received == kBurst);
+    NL_TEST_ASSERT(inSuite, state.errors == 0);
+
+    // Closing the endpoint from the first callback stops the loop with datagrams still queued.
+    state            = UDPBurstState();
+    state.action     = UDPBurstState::Action::kClose;
+    state.actOnCount = 1;
+    SendBurst(inSuite, sender, addr, receiver->GetBoundPort(), kBurst);
+    ServiceEvents(100);
+    NL_TEST_ASSERT(inSuite, state.received == 1);
+    ServiceEvents(10);
+    NL_TEST_ASSERT(inSuite, state.received == 1);
+    NL_TEST_ASSERT(inSuite, state.errors == 0);
+    receiver->Free();
+
+    // Releasing the last reference from a callback must not free the endpoint under the loop.
+    state = UDPBurstState();
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, gUDP.NewEndPoint(&receiver) == CHIP_NO_ERROR);
+    NL_TEST_EXIT_ON_FAILED_ASSERT(inSuite, ListenOnLoopback(receiver, state, addr) == CHIP_NO_ERROR);
+    state.action     = UDPBurstState::Action::kFree;
+    state.actOnCount = 1;
+    SendBurst(inSuite, sender, addr, receiver->GetBoundPort(), kBurst);
+    ServiceEvents(100);
+    NL_TEST_ASSERT(inSuite, state.received == 1);
+    ServiceEvents(10);
+    NL_TEST_ASSERT(inSuite, state.received == 1);
+    NL_TEST_ASSERT(inSuite, state.errors == 0);
+
+    sender->Free();
+}
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_UDP_ENDPOINT
+
 #if !CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
 // Test the Inet resource limitations.
 static void TestInetEndPointLimit(nlTestSuite * inSuite, void * inContext)
@@ -452,6 +574,9 @@ static const nlTest sTests[] = { NL_TEST_DEF("InetEndPoint::PreTest", TestInetPr
                                  NL_TEST_DEF("InetEndPoint::TestInetError", TestInetError),
                                  NL_TEST_DEF("InetEndPoint::TestInetInterface", TestInetInterface),
                                  NL_TEST_DEF("InetEndPoint::TestInetEndPoint", TestInetEndPointInternal),
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_UDP_ENDPOINT
+                                 NL_TEST_DEF("InetEndPoint::TestInetUDPReceiveBurst", TestInetUDPReceiveBurst),
+#endif
 #if !CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
                                  NL_TEST_DEF("InetEndPoint::TestEndPointLimit", TestInetEndPointLimit),
 #endif
@@ -370,6 +370,19 @@
 #define CHIP_CONFIG_CERT_MAX_RDN_ATTRIBUTES 5
 #endif // CHIP_CONFIG_CERT_MAX_RDN_ATTRIBUTES
 
+/**
+ *  @def CHIP_CONFIG_CERT_SIGNATURE_CACHE_SIZE
+ *
+ *  @brief
+ *    The number of successfully verified certificate signatures remembered by the
+ *    FabricTable, so that peer certificate chains seen again during CASE are not
+ *    re-verified.  Each entry takes 32 bytes.  Set to 0 to disable the cache.
+ *
+ */
+#ifndef CHIP_CONFIG_CERT_SIGNATURE_CACHE_SIZE
+#define CHIP_CONFIG_CERT_SIGNATURE_CACHE_SIZE 8
+#endif // CHIP_CONFIG_CERT_SIGNATURE_CACHE_SIZE
+
 /**
  *  @def CHIP_ERROR_LOGGING
  *
@@ -1103,6 +1116,25 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MAX_GROUP_NAME_LENGTH 16
 #endif
 
+/**
+ * @def CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE
+ *
+ * Defines the number of access control decisions remembered by the default
+ * check of AccessControl, so that repeated checks of the same subject, endpoint,
+ * cluster and privilege (e.g. one per attribute in a wildcard read) do not walk
+ * the access control entries again.
+ *
+ * When non-zero, the entries of a fabric are also decoded out of the access
+ * control delegate on first use, into a heap allocation that indexes them by
+ * target cluster. Both are invalidated whenever entries of the fabric are
+ * created, updated or deleted through AccessControl.
+ *
+ * Set to 0 to disable both.
+ */
+#ifndef CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE
+#define CHIP_CONFIG_ACCESS_CONTROL_DECISION_CACHE_SIZE 8
+#endif
+
 /**
  * @def CHIP_CONFIG_EXAMPLE_ACCESS_CONTROL_MAX_ENTRIES_PER_FABRIC
  *
@@ -1223,6 +1255,24 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_EVENT_LOGGING_BYTE_THRESHOLD 512
 #endif /* CHIP_CONFIG_EVENT_LOGGING_BYTE_THRESHOLD */
 
+/**
+ * @def CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE
+ *
+ * @brief The number of events, per event buffer, whose event number and
+ *   location in the buffer are remembered so that event reads can seek
+ *   directly to the first requested event instead of decoding every
+ *   older event in the buffer.
+ *
+ * Only the most recently stored events of each buffer are indexed; reads
+ * of older events start scanning from the head of the buffer.  Each entry
+ * costs 16 bytes of RAM per buffer.  Setting this to 0 disables the seek,
+ * while whole buffers are still skipped based on their event numbers and
+ * clusters.
+ */
+#ifndef CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE
+#define CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE 8
+#endif /* CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE */
+
 /**
  * @def CHIP_CONFIG_ENABLE_SERVER_IM_EVENT
  *
@@ -1346,6 +1396,34 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MINMDNS_MAX_PARALLEL_RESOLVES 2
 #endif // CHIP_CONFIG_MINMDNS_MAX_PARALLEL_RESOLVES
 
+/*
+ * @def CHIP_CONFIG_MINMDNS_MAX_ACTIVE_RESOLVE_ATTEMPTS
+ *
+ * @brief Maximum number of node resolves, browses and address lookups that the
+ *        minmdns resolver keeps querying for at once.  When more are requested,
+ *        the oldest one stops being queried for.
+ *
+ *        The queries that are due at the same time are packed into as few
+ *        packets as possible.
+ */
+#ifndef CHIP_CONFIG_MINMDNS_MAX_ACTIVE_RESOLVE_ATTEMPTS
+#define CHIP_CONFIG_MINMDNS_MAX_ACTIVE_RESOLVE_ATTEMPTS 4
+#endif // CHIP_CONFIG_MINMDNS_MAX_ACTIVE_RESOLVE_ATTEMPTS
+
+/*
+ * @def CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE
+ *
+ * @brief Number of records of operational nodes that the minmdns resolver
+ *        keeps from the responses it receives, so that resolving a node again
+ *        while its records are still valid does not send a query.
+ *
+ *        Each record takes about 180 bytes.  A resolved node needs its SRV and
+ *        TXT records and the records of its addresses.  0 disables the cache.
+ */
+#ifndef CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE
+#define CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE 0
+#endif // CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE
+
 /**
  * def CHIP_CONFIG_MDNS_RESOLVE_LOOKUP_RESULTS
  *
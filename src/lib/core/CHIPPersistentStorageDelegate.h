@@ -110,6 +110,66 @@ public:
         CHIP_ERROR err = SyncGetKeyValue(key, nullptr, size);
         return (err == CHIP_ERROR_BUFFER_TOO_SMALL) || (err == CHIP_NO_ERROR);
     }
+
+    /**
+     * @brief
+     *   Start a batch of writes.
+     *
+     *   Until the matching EndWriteBatch(), the implementation may defer making the effect of
+     *   SyncSetKeyValue and SyncDeleteKeyValue durable, so that all of them reach persistent storage
+     *   with a single flush. Reads always observe the writes made so far. Batches nest: only ending
+     *   the outermost batch flushes.
+     *
+     *   A batch is not a transaction: ending it, even on an error path, keeps every write made within it.
+     *
+     *   The default implementation makes every write durable on its own. Prefer using
+     *   PersistentStorageWriteBatch over calling this directly.
+     */
+    virtual void BeginWriteBatch() {}
+
+    /**
+     * @brief
+     *   End a batch of writes started with BeginWriteBatch().
+     *
+     * @return CHIP_NO_ERROR on success, or the error from flushing the writes of the outermost batch.
+     */
+    virtual CHIP_ERROR EndWriteBatch() { return CHIP_NO_ERROR; }
+};
+
+/**
+ * Scoped batch of writes on a PersistentStorageDelegate, see PersistentStorageDelegate::BeginWriteBatch.
+ *
+ * The batch ends when the object goes out of scope, ignoring flush errors. Call End() on success
+ * paths to get the flush result.
+ */
+class PersistentStorageWriteBatch
+{
+public:
+    explicit PersistentStorageWriteBatch(PersistentStorageDelegate * storage) : mStorage(storage)
+    {
+        if (mStorage != nullptr)
+        {
+            mStorage->BeginWriteBatch();
+        }
+    }
+
+    ~PersistentStorageWriteBatch() { (void) End(); }
+
+    PersistentStorageWriteBatch(const PersistentStorageWriteBatch &)             = delete;
+    PersistentStorageWriteBatch & operator=(const PersistentStorageWriteBatch &) = delete;
+
+    /**
+     * End the batch now. Further calls do nothing.
+     */
+    CHIP_ERROR End()
+    {
+        PersistentStorageDelegate * storage = mStorage;
+        mStorage                            = nullptr;
+        return (storage != nullptr) ? storage->EndWriteBatch() : CHIP_NO_ERROR;
+    }
+
+private:
+    PersistentStorageDelegate * mStorage;
 };
 
 } // namespace chip
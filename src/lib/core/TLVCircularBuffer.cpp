@@ -109,6 +109,13 @@ void TLVCircularBuffer::Init(uint8_t * inBuffer, uint32_t inBufferLength)
     mImplicitProfileId = kCommonProfileId;
 }
 
+void TLVCircularBuffer::SetQueueState(uint32_t inHeadOffset, uint32_t inDataLength)
+{
+    VerifyOrDie(inHeadOffset < mQueueSize && inDataLength <= mQueueSize);
+    mQueueHead   = mQueue + inHeadOffset;
+    mQueueLength = inDataLength;
+}
+
 /**
  * @brief
  *   Evicts the oldest top-level TLV element in the TLVCircularBuffer
@@ -139,6 +139,18 @@ protected:
      */
     void GetCurrentWritableBuffer(uint8_t *& outBufStart, uint32_t & outBufLen) const;
 
+    /**
+     * @brief
+     *   Sets the extent of the data in the buffer, e.g. to recover the
+     *   elements of a backing store that outlived a previous
+     *   TLVCircularBuffer.
+     *
+     * @param[in] inHeadOffset  Offset of the oldest element from the start of the backing store
+     *
+     * @param[in] inDataLength  Length, in bytes, of the elements in the buffer
+     */
+    void SetQueueState(uint32_t inHeadOffset, uint32_t inDataLength);
+
 private:
     uint8_t * mQueue;
     uint32_t mQueueSize;
@@ -41,6 +41,48 @@ using namespace chip::Encoding;
 
 static const uint8_t sTagSizes[] = { 0, 1, 2, 4, 2, 4, 6, 8 };
 
+/**
+ * Verify that an element of the given type may carry the given tag when it appears within a
+ * container of the given type.
+ */
+static CHIP_ERROR VerifyElementTag(TLVElementType elemType, Tag tag, TLVType containerType)
+{
+    if (elemType == TLVElementType::EndOfContainer)
+    {
+        if (containerType == kTLVType_NotSpecified)
+            return CHIP_ERROR_INVALID_TLV_ELEMENT;
+        if (tag != AnonymousTag())
+            return CHIP_ERROR_INVALID_TLV_TAG;
+    }
+    else
+    {
+        if (tag == UnknownImplicitTag())
+            return CHIP_ERROR_UNKNOWN_IMPLICIT_TLV_TAG;
+        switch (containerType)
+        {
+        case kTLVType_NotSpecified:
+            if (IsContextTag(tag))
+                return CHIP_ERROR_INVALID_TLV_TAG;
+            break;
+        case kTLVType_Structure:
+            if (tag == AnonymousTag())
+                return CHIP_ERROR_INVALID_TLV_TAG;
+            break;
+        case kTLVType_Array:
+            if (tag != AnonymousTag())
+                return CHIP_ERROR_INVALID_TLV_TAG;
+            break;
+        case kTLVType_UnknownContainer:
+        case kTLVType_List:
+            break;
+        default:
+            return CHIP_ERROR_INCORRECT_STATE;
+        }
+    }
+
+    return CHIP_NO_ERROR;
+}
+
 void TLVReader::Init(const uint8_t * data, size_t dataLen)
 {
     // TODO: Maybe we can just make mMaxLen and mLenRead size_t instead?
@@ -710,6 +752,9 @@ CHIP_ERROR TLVReader::SkipToEndOfContainer()
     // from calling CloseContainer() with the now orphaned container reader.
     SetContainerOpen(false);
 
+    if (IsRemainderInBuffer())
+        return SkipToEndOfContainerInBuffer();
+
     while (true)
     {
         TLVElementType elemType = ElementType();
@@ -739,6 +784,142 @@ CHIP_ERROR TLVReader::SkipToEndOfContainer()
     }
 }
 
+/**
+ * Returns true if everything the reader may still read is in the current buffer, i.e. no further
+ * buffers will be requested from the backing store.  This is always the case for readers that
+ * were initialized over a single contiguous span.
+ */
+bool TLVReader::IsRemainderInBuffer() const
+{
+    return static_cast<uint32_t>(mBufEnd - mReadPoint) >= mMaxLen - mLenRead;
+}
+
+/**
+ * Equivalent of SkipToEndOfContainer() for the case where IsRemainderInBuffer() holds.
+ *
+ * Element heads are decoded directly from the buffer and the bodies of strings are stepped over in
+ * a single pointer adjustment, rather than materializing each nested element through ReadElement()
+ * and SkipData().  Each element is subjected to the same checks, and produces the same errors, as
+ * it would when read by ReadElement().
+ */
+CHIP_ERROR TLVReader::SkipToEndOfContainerInBuffer()
+{
+    const TLVType outerContainerType = mContainerType;
+    uint32_t nestLevel               = 0;
+    TLVElementType elemType          = ElementType();
+
+    if (elemType == TLVElementType::EndOfContainer)
+        return CHIP_NO_ERROR;
+
+    if (TLVTypeIsContainer(elemType))
+    {
+        nestLevel++;
+        mContainerType = static_cast<TLVType>(elemType);
+    }
+
+    CHIP_ERROR err = SkipData();
+    if (err != CHIP_NO_ERROR)
+        return err;
+
+    const uint8_t * p   = mReadPoint;
+    const uint8_t * end = mReadPoint + (mMaxLen - mLenRead);
+
+    while (true)
+    {
+        if (p == end)
+        {
+            err = CHIP_END_OF_TLV;
+            break;
+        }
+
+        uint8_t controlByte = *p;
+        elemType            = static_cast<TLVElementType>(controlByte & kTLVTypeMask);
+        if (!IsValidTLVType(elemType))
+        {
+            err = CHIP_ERROR_INVALID_TLV_ELEMENT;
+            break;
+        }
+
+        TLVTagControl tagControl       = static_cast<TLVTagControl>(controlByte & kTLVTagControlMask);
+        TLVFieldSize lenOrValFieldSize = GetTLVFieldSize(elemType);
+        uint8_t elemHeadBytes =
+            static_cast<uint8_t>(1 + sTagSizes[tagControl >> kTLVTagControlShift] + TLVFieldSizeToBytes(lenOrValFieldSize));
+        if (elemHeadBytes > (end - p))
+        {
+            err = CHIP_ERROR_TLV_UNDERRUN;
+            break;
+        }
+
+        const uint8_t * head = p + 1;
+        p += elemHeadBytes;
+
+        Tag tag           = ReadTag(tagControl, head);
+        uint64_t lenOrVal = 0;
+        switch (lenOrValFieldSize)
+        {
+        case kTLVFieldSize_0Byte:
+            break;
+        case kTLVFieldSize_1Byte:
+            lenOrVal = Read8(head);
+            break;
+        case kTLVFieldSize_2Byte:
+            lenOrVal = LittleEndian::Read16(head);
+            break;
+        case kTLVFieldSize_4Byte:
+            lenOrVal = LittleEndian::Read32(head);
+            break;
+        case kTLVFieldSize_8Byte:
+            lenOrVal = LittleEndian::Read64(head);
+            break;
+        }
+
+        bool hasLength = TLVTypeHasLength(elemType);
+        if (hasLength && lenOrVal > UINT32_MAX)
+        {
+            err = CHIP_ERROR_NOT_IMPLEMENTED;
+            break;
+        }
+
+        err = VerifyElementTag(elemType, tag, mContainerType);
+        if (err != CHIP_NO_ERROR)
+            break;
+
+        if (hasLength && lenOrVal > static_cast<uint64_t>(end - p))
+        {
+            err = CHIP_ERROR_TLV_UNDERRUN;
+            break;
+        }
+
+        if (elemType == TLVElementType::EndOfContainer)
+        {
+            if (nestLevel == 0)
+            {
+                mControlByte  = controlByte;
+                mElemTag      = tag;
+                mElemLenOrVal = lenOrVal;
+                break;
+            }
+
+            nestLevel--;
+            mContainerType = (nestLevel == 0) ? outerContainerType : kTLVType_UnknownContainer;
+        }
+        else if (TLVTypeIsContainer(elemType))
+        {
+            nestLevel++;
+            mContainerType = static_cast<TLVType>(elemType);
+        }
+        else if (hasLength)
+        {
+            p += lenOrVal;
+        }
+    }
+
+    mLenRead += static_cast<uint32_t>(p - mReadPoint);
+    mReadPoint = p;
+
+    return err;
+}
+
 CHIP_ERROR TLVReader::ReadElement()
 {
     CHIP_ERROR err;
@@ -827,38 +1008,7 @@ CHIP_ERROR TLVReader::ReadElement()
 
 CHIP_ERROR TLVReader::VerifyElement()
 {
-    if (ElementType() == TLVElementType::EndOfContainer)
-    {
-        if (mContainerType == kTLVType_NotSpecified)
-            return CHIP_ERROR_INVALID_TLV_ELEMENT;
-        if (mElemTag != AnonymousTag())
-            return CHIP_ERROR_INVALID_TLV_TAG;
-    }
-    else
-    {
-        if (mElemTag == UnknownImplicitTag())
-            return CHIP_ERROR_UNKNOWN_IMPLICIT_TLV_TAG;
-        switch (mContainerType)
-        {
-        case kTLVType_NotSpecified:
-            if (IsContextTag(mElemTag))
-                return CHIP_ERROR_INVALID_TLV_TAG;
-            break;
-        case kTLVType_Structure:
-            if (mElemTag == AnonymousTag())
-                return CHIP_ERROR_INVALID_TLV_TAG;
-            break;
-        case kTLVType_Array:
-            if (mElemTag != AnonymousTag())
-                return CHIP_ERROR_INVALID_TLV_TAG;
-            break;
-        case kTLVType_UnknownContainer:
-        case kTLVType_List:
-            break;
-        default:
-            return CHIP_ERROR_INCORRECT_STATE;
-        }
-    }
+    ReturnErrorOnFailure(VerifyElementTag(ElementType(), mElemTag, mContainerType));
 
     // If the current element encodes a specific length (e.g. a UTF8 string or a byte string), verify
     // that the purported length fits within the remaining bytes of the encoding (as delineated by mMaxLen).
@@ -961,6 +961,8 @@ protected:
     void ClearElementState();
     CHIP_ERROR SkipData();
     CHIP_ERROR SkipToEndOfContainer();
+    CHIP_ERROR SkipToEndOfContainerInBuffer();
+    bool IsRemainderInBuffer() const;
     CHIP_ERROR VerifyElement();
     Tag ReadTag(TLVTagControl tagControl, const uint8_t *& p) const;
     CHIP_ERROR EnsureData(CHIP_ERROR noDataErr);
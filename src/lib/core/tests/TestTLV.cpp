@@ -3832,6 +3832,131 @@ void TestTLVReader_SkipOverContainer(nlTestSuite * inSuite)
     ForEachElement(inSuite, reader, nullptr, TestTLVReader_SkipOverContainer_ProcessElement);
 }
 
+/**
+ * Backing store that hands out its data one byte at a time, so that a reader using it never has
+ * the remainder of the encoding in its current buffer.
+ */
+class ByteAtATimeBackingStore : public TLVBackingStore
+{
+public:
+    ByteAtATimeBackingStore(const uint8_t * data, uint32_t dataLen) : mData(data), mDataLen(dataLen) {}
+
+    CHIP_ERROR OnInit(TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen) override
+    {
+        mOffset = 0;
+        return GetNextBuffer(reader, bufStart, bufLen);
+    }
+    CHIP_ERROR GetNextBuffer(TLVReader & reader, const uint8_t *& bufStart, uint32_t & bufLen) override
+    {
+        bufStart = mData + mOffset;
+        bufLen   = (mOffset < mDataLen) ? 1 : 0;
+        mOffset += bufLen;
+        return CHIP_NO_ERROR;
+    }
+    CHIP_ERROR OnInit(TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override { return CHIP_ERROR_NOT_IMPLEMENTED; }
+    CHIP_ERROR GetNewBuffer(TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+    CHIP_ERROR FinalizeBuffer(TLVWriter & writer, uint8_t * bufStart, uint32_t bufLen) override
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+
+private:
+    const uint8_t * mData;
+    uint32_t mDataLen;
+    uint32_t mOffset = 0;
+};
+
+/**
+ * Step into the first container, then skip over everything that follows.
+ */
+CHIP_ERROR SkipEncoding(TLVReader & reader)
+{
+    CHIP_ERROR err;
+    TLVType outerContainerType;
+
+    ReturnErrorOnFailure(reader.Next());
+    if (TLVTypeIsContainer(reader.GetType()))
+    {
+        ReturnErrorOnFailure(reader.EnterContainer(outerContainerType));
+        ReturnErrorOnFailure(reader.Next());
+        ReturnErrorOnFailure(reader.ExitContainer(outerContainerType));
+    }
+
+    while ((err = reader.Next()) == CHIP_NO_ERROR)
+    {
+    }
+    return err;
+}
+
+void CheckSkipEncoding(nlTestSuite * inSuite, const uint8_t * data, uint32_t dataLen)
+{
+    TLVReader contiguousReader;
+    contiguousReader.Init(data, dataLen);
+    contiguousReader.ImplicitProfileId = TestProfile_2;
+
+    ByteAtATimeBackingStore backingStore(data, dataLen);
+    TLVReader chainedReader;
+    NL_TEST_ASSERT(inSuite, chainedReader.Init(backingStore, dataLen) == CHIP_NO_ERROR);
+    chainedReader.ImplicitProfileId = TestProfile_2;
+
+    CHIP_ERROR contiguousErr = SkipEncoding(contiguousReader);
+    CHIP_ERROR chainedErr    = SkipEncoding(chainedReader);
+
+    NL_TEST_ASSERT(inSuite, contiguousErr == chainedErr);
+    if (contiguousErr == CHIP_END_OF_TLV)
+    {
+        NL_TEST_ASSERT(inSuite, contiguousReader.GetLengthRead() == chainedReader.GetLengthRead());
+    }
+}
+
+/**
+ * Test that skipping containers within a single buffer behaves the same as skipping them across a
+ * chain of buffers, for well-formed, truncated and corrupted encodings.
+ */
+void TestTLVReader_SkipInBuffer(nlTestSuite * inSuite)
+{
+    // clang-format off
+    static const uint8_t sMutations[] =
+    {
+        0x00, // 1-byte signed integer, anonymous
+        0x15, // Structure, anonymous
+        0x16, // Array, anonymous
+        0x17, // List, anonymous
+        0x18, // End of container
+        0x1B, // Byte string with 8-byte length, anonymous
+        0x24, // 1-byte unsigned integer with context tag
+        0x30, // Byte string with 1-byte length and context tag
+        0x35, // Structure with context tag
+        0x36, // Array with context tag
+        0x51, // 2-byte signed integer with implicit profile tag
+        0xFF,
+    };
+    // clang-format on
+
+    uint8_t data[sizeof(Encoding1)];
+    memcpy(data, Encoding1, sizeof(data));
+
+    CheckSkipEncoding(inSuite, data, sizeof(data));
+
+    for (uint32_t len = 0; len < sizeof(data); len++)
+    {
+        CheckSkipEncoding(inSuite, data, len);
+    }
+
+    for (size_t i = 0; i < sizeof(data); i++)
+    {
+        for (uint8_t mutation : sMutations)
+        {
+            data[i] = mutation;
+            CheckSkipEncoding(inSuite, data, sizeof(data));
+        }
+        data[i] = Encoding1[i];
+    }
+}
+
 /**
  *  Test CHIP TLV Reader
  */
@@ -3852,6 +3977,8 @@ void CheckTLVReader(nlTestSuite * inSuite, void * inContext)
     TestTLVReader_NextOverContainer(inSuite);
 
     TestTLVReader_SkipOverContainer(inSuite);
+
+    TestTLVReader_SkipInBuffer(inSuite);
 }
 
 /**
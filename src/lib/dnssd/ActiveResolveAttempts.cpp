@@ -134,22 +134,33 @@ void ActiveResolveAttempts::NodeIdResolutionNoLongerNeeded(const PeerId & peerId
     }
 }
 
-void ActiveResolveAttempts::MarkPending(const chip::PeerId & peerId)
+Optional<PeerId> ActiveResolveAttempts::MarkPending(const chip::PeerId & peerId)
 {
-    MarkPending(ScheduledAttempt(peerId, /* firstSend */ true));
+    return MarkPending(ScheduledAttempt(peerId, /* firstSend */ true));
 }
 
-void ActiveResolveAttempts::MarkPending(const chip::Dnssd::DiscoveryFilter & filter, const chip::Dnssd::DiscoveryType type)
+Optional<PeerId> ActiveResolveAttempts::MarkPending(const chip::Dnssd::DiscoveryFilter & filter,
+                                                    const chip::Dnssd::DiscoveryType type)
 {
-    MarkPending(ScheduledAttempt(filter, type, /* firstSend */ true));
+    return MarkPending(ScheduledAttempt(filter, type, /* firstSend */ true));
 }
 
-void ActiveResolveAttempts::MarkPending(ScheduledAttempt::IpResolve && resolve)
+Optional<PeerId> ActiveResolveAttempts::MarkPending(ScheduledAttempt::IpResolve && resolve)
 {
-    MarkPending(ScheduledAttempt(std::move(resolve), /* firstSend */ true));
+    return MarkPending(ScheduledAttempt(std::move(resolve), /* firstSend */ true));
 }
 
-void ActiveResolveAttempts::MarkPending(ScheduledAttempt && attempt)
+Optional<ActiveResolveAttempts::ScheduledAttempt> ActiveResolveAttempts::EvictionCandidate(const chip::PeerId & peerId) const
+{
+    const RetryEntry & entry = mRetryQueue[SelectEntry(ScheduledAttempt(peerId, /* firstSend */ true))];
+    if (entry.attempt.IsEmpty() || entry.attempt.Matches(peerId))
+    {
+        return Optional<ScheduledAttempt>::Missing();
+    }
+    return MakeOptional(entry.attempt);
+}
+
+size_t ActiveResolveAttempts::SelectEntry(const ScheduledAttempt & attempt) const
 {
     // Strategy when picking the peer id to use:
     //   1 if a matching peer id is already found, use that one
@@ -158,7 +169,7 @@ void ActiveResolveAttempts::MarkPending(ScheduledAttempt && attempt)
     //     or if equal nextRetryDelay, pick the one with the oldest
     //     queryDueTime
 
-    RetryEntry * entryToUse = &mRetryQueue[0];
+    const RetryEntry * entryToUse = &mRetryQueue[0];
 
     for (size_t i = 1; i < kRetryQueueSize; i++)
     {
@@ -167,7 +178,7 @@ void ActiveResolveAttempts::MarkPending(ScheduledAttempt && attempt)
             break; // best match possible
         }
 
-        RetryEntry * entry = mRetryQueue + i;
+        const RetryEntry * entry = mRetryQueue + i;
 
         // Rule 1: attempt match always matches
         if (entry->attempt.Matches(attempt))
@@ -202,22 +213,32 @@ void ActiveResolveAttempts::MarkPending(ScheduledAttempt && attempt)
         }
     }
 
+    return static_cast<size_t>(entryToUse - mRetryQueue);
+}
+
+Optional<PeerId> ActiveResolveAttempts::MarkPending(ScheduledAttempt && attempt)
+{
+    RetryEntry * entryToUse = &mRetryQueue[SelectEntry(attempt)];
+
+    Optional<PeerId> evicted;
     if ((!entryToUse->attempt.IsEmpty()) && (!entryToUse->attempt.Matches(attempt)))
     {
-        // TODO: node was evicted here, if/when resolution failures are
-        // supported this could be a place for error callbacks
-        //
-        // Note however that this is NOT an actual 'timeout' it is showing
-        // a burst of lookups for which we cannot maintain state. A reply may
-        // still be received for this peer id (query was already sent on the
-        // network)
+        // Note that this is NOT an actual 'timeout' it is showing a burst of
+        // lookups for which we cannot maintain state. The caller reports the
+        // failure of an evicted node id resolution.
         ChipLogError(Discovery, "Re-using pending resolve entry before reply was received.");
+        if (entryToUse->attempt.IsResolve())
+        {
+            evicted.SetValue(entryToUse->attempt.ResolveData().peerId);
+        }
     }
 
     attempt.WillCoalesceWith(entryToUse->attempt);
     entryToUse->attempt        = attempt;
     entryToUse->queryDueTime   = mClock->GetMonotonicTimestamp();
     entryToUse->nextRetryDelay = System::Clock::Seconds16(1);
+
+    return evicted;
 }
 
 Optional<System::Clock::Timeout> ActiveResolveAttempts::GetTimeUntilNextExpectedResponse() const
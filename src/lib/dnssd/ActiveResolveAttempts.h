@@ -20,6 +20,7 @@
 #include <cstddef>
 #include <cstdint>
 
+#include <lib/core/CHIPConfig.h>
 #include <lib/core/Optional.h>
 #include <lib/core/PeerId.h>
 #include <lib/dnssd/Resolver.h>
@@ -41,7 +42,7 @@ namespace Minimal {
 class ActiveResolveAttempts
 {
 public:
-    static constexpr size_t kRetryQueueSize                      = 4;
+    static constexpr size_t kRetryQueueSize                      = CHIP_CONFIG_MINMDNS_MAX_ACTIVE_RESOLVE_ATTEMPTS;
     static constexpr chip::System::Clock::Timeout kMaxRetryDelay = chip::System::Clock::Seconds16(16);
 
     struct ScheduledAttempt
@@ -265,9 +266,15 @@ public:
     ///
     /// Once this complete, this peer id will be returned immediately
     /// by NextScheduled (potentially with others as well)
-    void MarkPending(const chip::PeerId & peerId);
-    void MarkPending(const chip::Dnssd::DiscoveryFilter & filter, const chip::Dnssd::DiscoveryType type);
-    void MarkPending(ScheduledAttempt::IpResolve && resolve);
+    ///
+    /// If the list is full, another attempt is dropped to make room for this one.
+    /// Returns the peer id of the dropped attempt if it was a node id resolution.
+    chip::Optional<chip::PeerId> MarkPending(const chip::PeerId & peerId);
+    chip::Optional<chip::PeerId> MarkPending(const chip::Dnssd::DiscoveryFilter & filter, const chip::Dnssd::DiscoveryType type);
+    chip::Optional<chip::PeerId> MarkPending(ScheduledAttempt::IpResolve && resolve);
+
+    /// Get the attempt that marking the given peer id as pending would drop, if any.
+    chip::Optional<ScheduledAttempt> EvictionCandidate(const chip::PeerId & peerId) const;
 
     // Get minimum time until the next pending reply is required.
     //
@@ -308,7 +315,9 @@ private:
         //      least a factor of two
         chip::System::Clock::Timeout nextRetryDelay = chip::System::Clock::Seconds16(1);
     };
-    void MarkPending(ScheduledAttempt && attempt);
+    chip::Optional<chip::PeerId> MarkPending(ScheduledAttempt && attempt);
+    /// Index of the entry that MarkPending would use for the given attempt.
+    size_t SelectEntry(const ScheduledAttempt & attempt) const;
     chip::System::Clock::ClockBase * mClock;
     RetryEntry mRetryQueue[kRetryQueueSize];
 };
@@ -207,6 +207,10 @@ private:
     /// removes all records by advertising a 0 TTL)
     void AdvertiseRecords(BroadcastAdvertiseType type);
 
+    /// Serialize the responses of freshly configured records once, rather than for
+    /// every query they answer.
+    void PrecompileResponses(QueryResponderBase * queryResponder);
+
     FullQName GetCommissioningTxtEntries(const CommissionAdvertisingParameters & params);
     FullQName GetOperationalTxtEntries(OperationalQueryAllocator::Allocator * allocator,
                                        const OperationalAdvertisingParameters & params);
@@ -572,6 +576,8 @@ CHIP_ERROR AdvertiserMinMdns::Advertise(const OperationalAdvertisingParameters &
         return CHIP_ERROR_NO_MEMORY;
     }
 
+    PrecompileResponses(operationalAllocator->GetQueryResponder());
+
     ChipLogProgress(Discovery, "CHIP minimal mDNS configured as 'Operational device'; instance name: %s.", instanceName.names[0]);
 
     AdvertiseRecords(BroadcastAdvertiseType::kStarted);
@@ -771,6 +777,8 @@ CHIP_ERROR AdvertiserMinMdns::Advertise(const CommissionAdvertisingParameters &
         return CHIP_ERROR_NO_MEMORY;
     }
 
+    PrecompileResponses(allocator->GetQueryResponder());
+
     if (params.GetCommissionAdvertiseMode() == CommssionAdvertiseMode::kCommissionableNode)
     {
         ChipLogProgress(Discovery, "CHIP minimal mDNS configured as 'Commissionable node device'; instance name: %s.",
@@ -896,6 +904,16 @@ FullQName AdvertiserMinMdns::GetCommissioningTxtEntries(const CommissionAdvertis
     return allocator->AllocateQNameFromArray(txtFields, numTxtFields);
 }
 
+void AdvertiserMinMdns::PrecompileResponses(QueryResponderBase * queryResponder)
+{
+    CHIP_ERROR err = queryResponder->PrecompileResponses();
+    if (err != CHIP_NO_ERROR)
+    {
+        // Not fatal: responses are built for every query instead
+        ChipLogError(Discovery, "Failed to precompile mDNS responses: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+}
+
 void AdvertiserMinMdns::AdvertiseRecords(BroadcastAdvertiseType type)
 {
     ResponseConfiguration responseConfiguration;
@@ -0,0 +1,80 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <lib/dnssd/QueryPacker.h>
+
+#include <lib/support/CodeUtils.h>
+
+namespace chip {
+namespace Dnssd {
+
+using namespace mdns::Minimal;
+
+CHIP_ERROR QueryPacker::AddQuery(const Query & query)
+{
+    const bool unicastAnswers = query.IsAnswerViaUnicast();
+    PendingPacket & packet    = PacketFor(unicastAnswers);
+
+    if (packet.active && !packet.builder.HasRoomFor(query))
+    {
+        ReturnErrorOnFailure(Send(unicastAnswers));
+    }
+
+    if (!packet.active)
+    {
+        System::PacketBufferHandle buffer = System::PacketBufferHandle::New(mPacketSize);
+        VerifyOrReturnError(!buffer.IsNull(), CHIP_ERROR_NO_MEMORY);
+
+        packet.builder.Reset(std::move(buffer), mPacketSize);
+        packet.builder.Header().SetMessageId(0);
+        packet.active = true;
+    }
+
+    packet.builder.AddQuery(query);
+    if (!packet.builder.Ok())
+    {
+        // Only happens for a query too large for an empty packet: nothing to send.
+        packet.active = false;
+        return CHIP_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR QueryPacker::Flush()
+{
+    if (mMulticastAnswersPacket.active)
+    {
+        ReturnErrorOnFailure(Send(false));
+    }
+    if (mUnicastAnswersPacket.active)
+    {
+        ReturnErrorOnFailure(Send(true));
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR QueryPacker::Send(bool unicastAnswers)
+{
+    PendingPacket & packet = PacketFor(unicastAnswers);
+    packet.active          = false;
+
+    return mDelegate.SendQueries(packet.builder.ReleasePacket(), unicastAnswers);
+}
+
+} // namespace Dnssd
+} // namespace chip
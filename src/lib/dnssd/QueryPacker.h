@@ -0,0 +1,79 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <lib/dnssd/minimal_mdns/Query.h>
+#include <lib/dnssd/minimal_mdns/QueryBuilder.h>
+#include <system/SystemPacketBuffer.h>
+
+#include <stddef.h>
+
+namespace chip {
+namespace Dnssd {
+
+/// Packs queries into as few packets as possible: a query goes into the packet
+/// being built, unless it may not fit in it, in which case that packet is sent
+/// first and a new one is started.
+///
+/// Queries asking for unicast answers are sent differently from the others, so
+/// each kind has its own packet.
+///
+/// Queries that are not sent by the time the packer is destroyed are dropped.
+class QueryPacker
+{
+public:
+    class Delegate
+    {
+    public:
+        virtual ~Delegate() = default;
+
+        /// Send a packet of queries, that ask for unicast answers if [unicastAnswers] is set.
+        virtual CHIP_ERROR SendQueries(System::PacketBufferHandle && packet, bool unicastAnswers) = 0;
+    };
+
+    QueryPacker(Delegate & delegate, size_t packetSize) : mDelegate(delegate), mPacketSize(packetSize) {}
+
+    QueryPacker(const QueryPacker &)             = delete;
+    QueryPacker & operator=(const QueryPacker &) = delete;
+
+    CHIP_ERROR AddQuery(const mdns::Minimal::Query & query);
+
+    /// Send the packets being built.
+    CHIP_ERROR Flush();
+
+private:
+    struct PendingPacket
+    {
+        mdns::Minimal::QueryBuilder builder;
+        bool active = false;
+    };
+
+    PendingPacket & PacketFor(bool unicastAnswers) { return unicastAnswers ? mUnicastAnswersPacket : mMulticastAnswersPacket; }
+
+    CHIP_ERROR Send(bool unicastAnswers);
+
+    Delegate & mDelegate;
+    const size_t mPacketSize;
+
+    PendingPacket mMulticastAnswersPacket;
+    PendingPacket mUnicastAnswersPacket;
+};
+
+} // namespace Dnssd
+} // namespace chip
@@ -0,0 +1,311 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <lib/dnssd/RecordCache.h>
+
+#include <lib/dnssd/ServiceNaming.h>
+#include <lib/dnssd/minimal_mdns/Parser.h>
+#include <lib/dnssd/minimal_mdns/RecordData.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/TypeTraits.h>
+
+#include <algorithm>
+#include <limits>
+#include <string.h>
+
+namespace chip {
+namespace Dnssd {
+
+using namespace mdns::Minimal;
+
+namespace {
+
+constexpr QNamePart kOperationalSuffix[] = { kOperationalServiceName, kOperationalProtocol, kLocalDomain };
+
+// Cached SRV data is priority, weight and port followed by the uncompressed target.
+constexpr size_t kSrvTargetOffset = 3 * sizeof(uint16_t);
+
+bool IsOperationalName(SerializedQNameIterator name)
+{
+    // <compressed-fabric-id>-<node-id>._matter._tcp.local
+    return name.Next() && name.IsValid() && (name == kOperationalSuffix);
+}
+
+} // namespace
+
+/// Goes through a response twice: SRV records first, so that the addresses of
+/// their targets are known to be relevant when going through the others.
+class RecordCacheBase::PacketCacher : public ParserDelegate
+{
+public:
+    PacketCacher(RecordCacheBase & cache, Inet::InterfaceId interface, const BytesRange & packet,
+                 System::Clock::Timestamp now) :
+        mCache(cache),
+        mInterface(interface), mPacket(packet), mNow(now)
+    {}
+
+    void Run()
+    {
+        mSrvPass = true;
+        VerifyOrReturn(ParsePacket(mPacket, this));
+        mSrvPass = false;
+        ParsePacket(mPacket, this);
+    }
+
+    void OnHeader(ConstHeaderRef & header) override { mIsResponse = header.GetFlags().IsResponse(); }
+    void OnQuery(const QueryData & data) override {}
+    void OnResource(ResourceType type, const ResourceData & data) override;
+
+private:
+    RecordCacheBase & mCache;
+    Inet::InterfaceId mInterface;
+    BytesRange mPacket;
+    System::Clock::Timestamp mNow;
+    bool mSrvPass    = true;
+    bool mIsResponse = false;
+};
+
+void RecordCacheBase::PacketCacher::OnResource(ResourceType type, const ResourceData & data)
+{
+    VerifyOrReturn(mIsResponse);
+
+    const bool cacheFlush = (to_underlying(data.GetClass()) & kQClassResponseFlushBit) != 0;
+    const uint32_t ttl    = static_cast<uint32_t>(std::min<uint64_t>(data.GetTtlSeconds(), std::numeric_limits<uint32_t>::max()));
+
+    switch (data.GetType())
+    {
+    case QType::SRV: {
+        VerifyOrReturn(mSrvPass && IsOperationalName(data.GetName()));
+
+        SrvRecord srv;
+        VerifyOrReturn(srv.Parse(data.GetData(), mPacket));
+
+        // The target may be compressed against the packet: store it in full.
+        uint8_t buffer[kMaxRecordDataLength];
+        Encoding::BigEndian::BufferWriter out(buffer, sizeof(buffer));
+        RecordWriter writer(&out);
+        writer.Put16(srv.GetPriority()).Put16(srv.GetWeight()).Put16(srv.GetPort()).WriteQName(srv.GetName());
+        VerifyOrReturn(writer.Fit());
+
+        mCache.Store(data.GetName(), QType::SRV, mInterface, ttl, cacheFlush, BytesRange(buffer, buffer + out.Needed()), mNow);
+        break;
+    }
+    case QType::TXT:
+        VerifyOrReturn(!mSrvPass && IsOperationalName(data.GetName()));
+        mCache.Store(data.GetName(), QType::TXT, mInterface, ttl, cacheFlush, data.GetData(), mNow);
+        break;
+    case QType::A:
+    case QType::AAAA:
+        VerifyOrReturn(!mSrvPass && mCache.IsSrvTarget(data.GetName(), mNow));
+        mCache.Store(data.GetName(), data.GetType(), mInterface, ttl, cacheFlush, data.GetData(), mNow);
+        break;
+    default:
+        break;
+    }
+}
+
+void RecordCacheBase::Clear()
+{
+    for (size_t i = 0; i < mCapacity; i++)
+    {
+        mEntries[i].mExpiry = System::Clock::kZero;
+    }
+}
+
+void RecordCacheBase::AddRecords(Inet::InterfaceId interface, const BytesRange & packet, System::Clock::Timestamp now)
+{
+    mGeneration++;
+
+    PacketCacher cacher(*this, interface, packet, now);
+    cacher.Run();
+}
+
+SerializedQNameIterator RecordCacheBase::SrvTarget(const Entry & entry)
+{
+    return SerializedQNameIterator(BytesRange(entry.mData, entry.mData + entry.mDataLength), entry.mData + kSrvTargetOffset);
+}
+
+bool RecordCacheBase::IsSrvTarget(SerializedQNameIterator hostName, System::Clock::Timestamp now) const
+{
+    for (size_t i = 0; i < mCapacity; i++)
+    {
+        const Entry & entry = mEntries[i];
+        if (entry.IsValid(now) && entry.mType == QType::SRV && SrvTarget(entry) == hostName)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void RecordCacheBase::Store(SerializedQNameIterator name, QType type, Inet::InterfaceId interface, uint32_t ttlSeconds,
+                            bool cacheFlush, const BytesRange & data, System::Clock::Timestamp now)
+{
+    VerifyOrReturn(data.Size() <= kMaxRecordDataLength);
+
+    // An operational node has a single SRV and TXT record, but may have several addresses.
+    const bool singleValued = (type == QType::SRV) || (type == QType::TXT);
+    Entry * existing        = nullptr;
+
+    for (size_t i = 0; i < mCapacity; i++)
+    {
+        Entry & entry = mEntries[i];
+        if (!entry.IsValid(now) || entry.mType != type || entry.mInterface != interface || entry.mName.Get() != name)
+        {
+            continue;
+        }
+
+        const bool sameRecord =
+            singleValued || (entry.mDataLength == data.Size() && memcmp(entry.mData, data.Start(), data.Size()) == 0);
+        if (ttlSeconds == 0)
+        {
+            // Goodbye record.
+            if (sameRecord)
+            {
+                entry.mExpiry = System::Clock::kZero;
+            }
+        }
+        else if (sameRecord)
+        {
+            existing = &entry;
+        }
+        else if (cacheFlush && entry.mGeneration != mGeneration)
+        {
+            // Records of a cache-flush set that were not received along with this one are stale.
+            entry.mExpiry = System::Clock::kZero;
+        }
+    }
+
+    VerifyOrReturn(ttlSeconds > 0);
+
+    Entry & entry = (existing != nullptr) ? *existing : AllocateEntry(now);
+    if (entry.mName.Set(name) != CHIP_NO_ERROR)
+    {
+        entry.mExpiry = System::Clock::kZero;
+        return;
+    }
+    entry.mType       = type;
+    entry.mInterface  = interface;
+    entry.mGeneration = mGeneration;
+    entry.mExpiry     = now + System::Clock::Seconds32(ttlSeconds);
+    entry.mDataLength = static_cast<uint16_t>(data.Size());
+    memcpy(entry.mData, data.Start(), data.Size());
+}
+
+RecordCacheBase::Entry & RecordCacheBase::AllocateEntry(System::Clock::Timestamp now)
+{
+    Entry * oldest = &mEntries[0];
+    for (size_t i = 0; i < mCapacity; i++)
+    {
+        if (!mEntries[i].IsValid(now))
+        {
+            return mEntries[i];
+        }
+        if (mEntries[i].mExpiry < oldest->mExpiry)
+        {
+            oldest = &mEntries[i];
+        }
+    }
+
+    mStatistics.evictions++;
+    return *oldest;
+}
+
+bool RecordCacheBase::AppendRecord(const Entry & entry, System::Clock::Timestamp now, RecordWriter & writer) const
+{
+    // Never announce a TTL of 0 for a valid record: that would be a goodbye.
+    uint32_t ttl = std::chrono::duration_cast<System::Clock::Seconds32>(entry.mExpiry - now).count();
+
+    writer.WriteQName(entry.mName.Get())
+        .Put16(to_underlying(entry.mType))
+        .Put16(to_underlying(QClass::IN))
+        .Put32(std::max<uint32_t>(ttl, 1))
+        .Put16(entry.mDataLength)
+        .Put(BytesRange(entry.mData, entry.mData + entry.mDataLength));
+
+    return writer.Fit();
+}
+
+CHIP_ERROR RecordCacheBase::BuildResponse(const FullQName & instanceName, System::Clock::Timestamp now,
+                                          Encoding::BigEndian::BufferWriter & out, Inet::InterfaceId & interface)
+{
+    mStatistics.lookups++;
+
+    const Entry * srv = nullptr;
+    for (size_t i = 0; i < mCapacity && srv == nullptr; i++)
+    {
+        const Entry & entry = mEntries[i];
+        if (entry.IsValid(now) && entry.mType == QType::SRV && entry.mName.Get() == instanceName)
+        {
+            srv = &entry;
+        }
+    }
+    VerifyOrReturnError(srv != nullptr, CHIP_ERROR_NOT_FOUND);
+
+    // Only records received over the interface of the SRV record go along with it.
+    const SerializedQNameIterator target = SrvTarget(*srv);
+    auto isAnswer                        = [&](const Entry & entry) {
+        if (!entry.IsValid(now) || entry.mInterface != srv->mInterface)
+        {
+            return false;
+        }
+        if (entry.mType == QType::TXT)
+        {
+            return entry.mName.Get() == instanceName;
+        }
+        return (entry.mType == QType::A || entry.mType == QType::AAAA) && entry.mName.Get() == target;
+    };
+
+    uint16_t answerCount  = 1;
+    uint16_t addressCount = 0;
+    for (size_t i = 0; i < mCapacity; i++)
+    {
+        if (isAnswer(mEntries[i]))
+        {
+            answerCount++;
+            addressCount = static_cast<uint16_t>(addressCount + (mEntries[i].mType == QType::TXT ? 0 : 1));
+        }
+    }
+    VerifyOrReturnError(addressCount > 0, CHIP_ERROR_NOT_FOUND);
+
+    out.Put16(0) // message id
+        .Put16(BitPackedFlags(0).SetResponse().SetAuthoritative().RawValue())
+        .Put16(0) // queries
+        .Put16(answerCount)
+        .Put16(0) // authority
+        .Put16(0) // additional
+        ;
+
+    // SRV first, as receivers need it to make sense of the others.
+    RecordWriter writer(&out);
+    bool fit = AppendRecord(*srv, now, writer);
+    for (size_t i = 0; i < mCapacity; i++)
+    {
+        if (isAnswer(mEntries[i]))
+        {
+            fit = AppendRecord(mEntries[i], now, writer);
+        }
+    }
+    VerifyOrReturnError(fit, CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    interface = srv->mInterface;
+    mStatistics.hits++;
+    return CHIP_NO_ERROR;
+}
+
+} // namespace Dnssd
+} // namespace chip
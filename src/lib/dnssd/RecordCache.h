@@ -0,0 +1,128 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <inet/InetInterface.h>
+#include <lib/core/CHIPError.h>
+#include <lib/dnssd/IncrementalResolve.h>
+#include <lib/dnssd/minimal_mdns/core/BytesRange.h>
+#include <lib/dnssd/minimal_mdns/core/Constants.h>
+#include <lib/dnssd/minimal_mdns/core/QName.h>
+#include <lib/dnssd/minimal_mdns/core/RecordWriter.h>
+#include <lib/support/BufferWriter.h>
+#include <system/SystemClock.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace Dnssd {
+
+/// Remembers the records of operational nodes seen in mDNS responses, so that
+/// resolving a node again while its records are still valid does not need
+/// another query.
+///
+/// The SRV and TXT records of `<fabric>-<node>._matter._tcp.local` names are
+/// kept, along with the A/AAAA records of the hosts these SRV records point to.
+/// Records expire with their TTL, are dropped by goodbye (TTL 0) records and
+/// honor the cache-flush bit (RFC 6762 section 10.2). Once full, the record
+/// that expires first is evicted.
+class RecordCacheBase
+{
+public:
+    /// Records with larger data (e.g. long TXT records) are not cached.
+    static constexpr size_t kMaxRecordDataLength = 80;
+
+    struct Statistics
+    {
+        uint32_t lookups   = 0; // BuildResponse calls
+        uint32_t hits      = 0; // BuildResponse calls answered from the cache
+        uint32_t evictions = 0; // valid records dropped to make room for others
+    };
+
+    /// Drop all records.
+    void Clear();
+
+    /// Cache the relevant records of the response in [packet], received over [interface] at [now].
+    ///
+    /// Packets that are not responses are ignored.
+    void AddRecords(Inet::InterfaceId interface, const mdns::Minimal::BytesRange & packet, System::Clock::Timestamp now);
+
+    /// Write to [out] a response packet holding the cached SRV, TXT and A/AAAA records of
+    /// [instanceName], as valid at [now].  [interface] is set to the interface these records
+    /// were received over.
+    ///
+    /// Returns CHIP_ERROR_NOT_FOUND unless both the SRV record and an address of its target
+    /// are cached and CHIP_ERROR_BUFFER_TOO_SMALL if the response does not fit in [out].
+    CHIP_ERROR BuildResponse(const mdns::Minimal::FullQName & instanceName, System::Clock::Timestamp now,
+                             Encoding::BigEndian::BufferWriter & out, Inet::InterfaceId & interface);
+
+    const Statistics & GetStatistics() const { return mStatistics; }
+
+protected:
+    struct Entry
+    {
+        bool IsValid(System::Clock::Timestamp now) const { return mExpiry > now; }
+
+        StoredServerName mName;
+        System::Clock::Timestamp mExpiry = System::Clock::kZero;
+        Inet::InterfaceId mInterface     = Inet::InterfaceId::Null();
+        mdns::Minimal::QType mType       = mdns::Minimal::QType::ANY;
+        uint32_t mGeneration             = 0; // AddRecords call the record was last received in
+        uint16_t mDataLength             = 0;
+        uint8_t mData[kMaxRecordDataLength];
+    };
+
+    RecordCacheBase(Entry * entries, size_t capacity) : mEntries(entries), mCapacity(capacity) {}
+
+private:
+    class PacketCacher;
+
+    /// Target host name of a cached SRV record.
+    static mdns::Minimal::SerializedQNameIterator SrvTarget(const Entry & entry);
+
+    /// Whether a valid SRV record points to [hostName].
+    bool IsSrvTarget(mdns::Minimal::SerializedQNameIterator hostName, System::Clock::Timestamp now) const;
+
+    /// Store a record, with its data already free of compressed names.
+    void Store(mdns::Minimal::SerializedQNameIterator name, mdns::Minimal::QType type, Inet::InterfaceId interface,
+               uint32_t ttlSeconds, bool cacheFlush, const mdns::Minimal::BytesRange & data, System::Clock::Timestamp now);
+
+    /// Find room for a new record, evicting the one that expires first if needed.
+    Entry & AllocateEntry(System::Clock::Timestamp now);
+
+    bool AppendRecord(const Entry & entry, System::Clock::Timestamp now, mdns::Minimal::RecordWriter & writer) const;
+
+    Entry * mEntries;
+    size_t mCapacity;
+    uint32_t mGeneration = 0;
+    Statistics mStatistics;
+};
+
+template <size_t N>
+class RecordCache : public RecordCacheBase
+{
+public:
+    RecordCache() : RecordCacheBase(mStorage, N) {}
+
+private:
+    Entry mStorage[N];
+};
+
+} // namespace Dnssd
+} // namespace chip
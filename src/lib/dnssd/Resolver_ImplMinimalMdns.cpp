@@ -23,10 +23,11 @@
 #include <lib/dnssd/ActiveResolveAttempts.h>
 #include <lib/dnssd/IncrementalResolve.h>
 #include <lib/dnssd/MinimalMdnsServer.h>
+#include <lib/dnssd/QueryPacker.h>
+#include <lib/dnssd/RecordCache.h>
 #include <lib/dnssd/ServiceNaming.h>
 #include <lib/dnssd/minimal_mdns/Logging.h>
 #include <lib/dnssd/minimal_mdns/Parser.h>
-#include <lib/dnssd/minimal_mdns/QueryBuilder.h>
 #include <lib/dnssd/minimal_mdns/RecordData.h>
 #include <lib/dnssd/minimal_mdns/core/FlatAllocatedQName.h>
 #include <lib/support/CHIPMemString.h>
@@ -266,7 +267,7 @@ void PacketParser::ParseNonSrvRecords(Inet::InterfaceId interface, const BytesRa
     mParsingState = RecordParsingState::kIdle;
 }
 
-class MinMdnsResolver : public Resolver, public MdnsPacketDelegate
+class MinMdnsResolver : public Resolver, public MdnsPacketDelegate, public QueryPacker::Delegate
 {
 public:
     MinMdnsResolver() : mActiveResolves(&chip::System::SystemClock()), mPacketParser(mActiveResolves)
@@ -278,6 +279,9 @@ public:
     //// MdnsPacketDelegate implementation
     void OnMdnsPacketData(const BytesRange & data, const chip::Inet::IPPacketInfo * info) override;
 
+    //// QueryPacker::Delegate implementation
+    CHIP_ERROR SendQueries(System::PacketBufferHandle && packet, bool unicastAnswers) override;
+
     ///// Resolver implementation
     CHIP_ERROR Init(chip::Inet::EndPointManager<chip::Inet::UDPEndPoint> * udpEndPointManager) override;
     bool IsInitialized() override;
@@ -296,20 +300,38 @@ private:
     System::Layer * mSystemLayer                      = nullptr;
     ActiveResolveAttempts mActiveResolves;
     PacketParser mPacketParser;
+    bool mFlushScheduled = false;
+
+    // Evicted node id resolutions whose failure is not reported yet
+    PeerId mEvictedResolves[ActiveResolveAttempts::kRetryQueueSize];
+    size_t mEvictedResolveCount = 0;
 
     void SetDiscoveryContext(DiscoveryContext * context);
     void ScheduleIpAddressResolve(SerializedQNameIterator hostName);
 
+    /// Feed a response, received or built from cached records, to the pending resolves.
+    void ProcessResponse(const BytesRange & data, Inet::InterfaceId interface);
+
     CHIP_ERROR SendAllPendingQueries();
     CHIP_ERROR ScheduleRetries();
 
+    /// Send the pending queries on the next event loop iteration, so that the
+    /// lookups requested in the meantime share packets.
+    CHIP_ERROR ScheduleFlush();
+    static void FlushCallback(System::Layer *, void * self);
+
+    /// Report the failure of a node id resolution that was dropped to make room
+    /// for other attempts.  The failure is delivered with the next flush.
+    void ReportEvicted(const Optional<PeerId> & peerId);
+    void NotifyResolutionFailed(const PeerId & peerId, CHIP_ERROR error);
+
     /// Prepare a query for the given schedule attempt
-    CHIP_ERROR BuildQuery(QueryBuilder & builder, const ActiveResolveAttempts::ScheduledAttempt & attempt);
+    CHIP_ERROR BuildQuery(QueryPacker & packer, const ActiveResolveAttempts::ScheduledAttempt & attempt);
 
     /// Prepare a query for specific resolve types
-    CHIP_ERROR BuildQuery(QueryBuilder & builder, const ActiveResolveAttempts::ScheduledAttempt::Browse & data, bool firstSend);
-    CHIP_ERROR BuildQuery(QueryBuilder & builder, const ActiveResolveAttempts::ScheduledAttempt::Resolve & data, bool firstSend);
-    CHIP_ERROR BuildQuery(QueryBuilder & builder, const ActiveResolveAttempts::ScheduledAttempt::IpResolve & data, bool firstSend);
+    CHIP_ERROR BuildQuery(QueryPacker & packer, const ActiveResolveAttempts::ScheduledAttempt::Browse & data, bool firstSend);
+    CHIP_ERROR BuildQuery(QueryPacker & packer, const ActiveResolveAttempts::ScheduledAttempt::Resolve & data, bool firstSend);
+    CHIP_ERROR BuildQuery(QueryPacker & packer, const ActiveResolveAttempts::ScheduledAttempt::IpResolve & data, bool firstSend);
 
     /// Clear any incremental resolver that is not waiting for a AAAA address.
     void ExpireIncrementalResolvers();
@@ -317,6 +339,26 @@ private:
 
     static void RetryCallback(System::Layer *, void * self);
 
+#if CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+    struct CachedResponse
+    {
+        System::PacketBufferHandle packet;
+        Inet::InterfaceId interface;
+    };
+
+    /// Answer the resolve of [peerId] from cached records instead of sending a query.
+    ///
+    /// The response is processed asynchronously, as callers expect resolution results
+    /// to be delivered after ResolveNodeId returns.  Returns false if the cache cannot
+    /// answer the resolve.
+    bool ScheduleCachedResolve(const PeerId & peerId);
+
+    static void CachedResponsesCallback(System::Layer *, void * self);
+
+    RecordCache<CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE> mRecordCache;
+    CachedResponse mCachedResponses[ActiveResolveAttempts::kRetryQueueSize];
+#endif // CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+
     CHIP_ERROR BrowseNodes(DiscoveryType type, DiscoveryFilter subtype);
     template <typename... Args>
     mdns::Minimal::FullQName CheckAndAllocateQName(Args &&... parts)
@@ -355,7 +397,7 @@ void MinMdnsResolver::ScheduleIpAddressResolve(SerializedQNameIterator hostName)
         ChipLogError(Discovery, "Memory allocation error for IP address resolution");
         return;
     }
-    mActiveResolves.MarkPending(ActiveResolveAttempts::ScheduledAttempt::IpResolve(std::move(target)));
+    ReportEvicted(mActiveResolves.MarkPending(ActiveResolveAttempts::ScheduledAttempt::IpResolve(std::move(target))));
 }
 
 void MinMdnsResolver::AdvancePendingResolverStates()
@@ -471,9 +513,18 @@ void MinMdnsResolver::OnMdnsPacketData(const BytesRange & data, const chip::Inet
 {
     MATTER_TRACE_SCOPE("Received MDNS Packet", "MinMdnsResolver");
 
+#if CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+    mRecordCache.AddRecords(info->Interface, data, System::SystemClock().GetMonotonicTimestamp());
+#endif
+
+    ProcessResponse(data, info->Interface);
+}
+
+void MinMdnsResolver::ProcessResponse(const BytesRange & data, Inet::InterfaceId interface)
+{
     // Fill up any relevant data
     mPacketParser.ParseSrvRecords(data);
-    mPacketParser.ParseNonSrvRecords(info->Interface, data);
+    mPacketParser.ParseNonSrvRecords(interface, data);
 
     AdvancePendingResolverStates();
 
@@ -501,10 +552,25 @@ bool MinMdnsResolver::IsInitialized()
 
 void MinMdnsResolver::Shutdown()
 {
+    if (mSystemLayer != nullptr)
+    {
+        mSystemLayer->CancelTimer(&FlushCallback, this);
+    }
+    mFlushScheduled      = false;
+    mEvictedResolveCount = 0;
+
+#if CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+    for (CachedResponse & response : mCachedResponses)
+    {
+        response.packet = nullptr;
+    }
+    mRecordCache.Clear();
+#endif
+
     GlobalMinimalMdnsServer::Instance().ShutdownServer();
 }
 
-CHIP_ERROR MinMdnsResolver::BuildQuery(QueryBuilder & builder, const ActiveResolveAttempts::ScheduledAttempt::Browse & data,
+CHIP_ERROR MinMdnsResolver::BuildQuery(QueryPacker & packer, const ActiveResolveAttempts::ScheduledAttempt::Browse & data,
                                        bool firstSend)
 {
     mdns::Minimal::FullQName qname;
@@ -558,12 +624,10 @@ CHIP_ERROR MinMdnsResolver::BuildQuery(QueryBuilder & builder, const ActiveResol
         ;
 
     mdns::Minimal::Logging::LogSendingQuery(query);
-    builder.AddQuery(query);
-
-    return CHIP_NO_ERROR;
+    return packer.AddQuery(query);
 }
 
-CHIP_ERROR MinMdnsResolver::BuildQuery(QueryBuilder & builder, const ActiveResolveAttempts::ScheduledAttempt::Resolve & data,
+CHIP_ERROR MinMdnsResolver::BuildQuery(QueryPacker & packer, const ActiveResolveAttempts::ScheduledAttempt::Resolve & data,
                                        bool firstSend)
 {
     char nameBuffer[kMaxOperationalServiceNameSize] = "";
@@ -581,12 +645,10 @@ CHIP_ERROR MinMdnsResolver::BuildQuery(QueryBuilder & builder, const ActiveResol
         ;
 
     mdns::Minimal::Logging::LogSendingQuery(query);
-    builder.AddQuery(query);
-
-    return CHIP_NO_ERROR;
+    return packer.AddQuery(query);
 }
 
-CHIP_ERROR MinMdnsResolver::BuildQuery(QueryBuilder & builder, const ActiveResolveAttempts::ScheduledAttempt::IpResolve & data,
+CHIP_ERROR MinMdnsResolver::BuildQuery(QueryPacker & packer, const ActiveResolveAttempts::ScheduledAttempt::IpResolve & data,
                                        bool firstSend)
 {
 
@@ -599,36 +661,50 @@ CHIP_ERROR MinMdnsResolver::BuildQuery(QueryBuilder & builder, const ActiveResol
         ;
 
     mdns::Minimal::Logging::LogSendingQuery(query);
-    builder.AddQuery(query);
-
-    return CHIP_NO_ERROR;
+    return packer.AddQuery(query);
 }
 
-CHIP_ERROR MinMdnsResolver::BuildQuery(QueryBuilder & builder, const ActiveResolveAttempts::ScheduledAttempt & attempt)
+CHIP_ERROR MinMdnsResolver::BuildQuery(QueryPacker & packer, const ActiveResolveAttempts::ScheduledAttempt & attempt)
 {
     if (attempt.IsResolve())
     {
-        ReturnErrorOnFailure(BuildQuery(builder, attempt.ResolveData(), attempt.firstSend));
+        ReturnErrorOnFailure(BuildQuery(packer, attempt.ResolveData(), attempt.firstSend));
     }
     else if (attempt.IsBrowse())
     {
-        ReturnErrorOnFailure(BuildQuery(builder, attempt.BrowseData(), attempt.firstSend));
+        ReturnErrorOnFailure(BuildQuery(packer, attempt.BrowseData(), attempt.firstSend));
     }
     else if (attempt.IsIpResolve())
     {
-        ReturnErrorOnFailure(BuildQuery(builder, attempt.IpResolveData(), attempt.firstSend));
+        ReturnErrorOnFailure(BuildQuery(packer, attempt.IpResolveData(), attempt.firstSend));
     }
     else
     {
         return CHIP_ERROR_INVALID_ARGUMENT;
     }
 
-    ReturnErrorCodeIf(!builder.Ok(), CHIP_ERROR_INTERNAL);
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR MinMdnsResolver::SendQueries(System::PacketBufferHandle && packet, bool unicastAnswers)
+{
+    if (unicastAnswers)
+    {
+        return GlobalMinimalMdnsServer::Server().BroadcastUnicastQuery(std::move(packet), kMdnsPort);
+    }
+    return GlobalMinimalMdnsServer::Server().BroadcastSend(std::move(packet), kMdnsPort);
+}
+
 CHIP_ERROR MinMdnsResolver::SendAllPendingQueries()
 {
+    // All queries due now share as few packets as possible.
+    //
+    // No known answers are listed: the record cache only holds the SRV, TXT and address records
+    // of operational nodes, and a resolve or address lookup that is still being sent needs every
+    // one of them (otherwise ScheduleCachedResolve would have answered it).  Listing them would
+    // make responders leave out the very records that are missing.
+    QueryPacker packer(*this, kMdnsMaxPacketSize);
+
     while (true)
     {
         Optional<ActiveResolveAttempts::ScheduledAttempt> resolve = mActiveResolves.NextScheduled();
@@ -638,29 +714,93 @@ CHIP_ERROR MinMdnsResolver::SendAllPendingQueries()
             break;
         }
 
-        System::PacketBufferHandle buffer = System::PacketBufferHandle::New(kMdnsMaxPacketSize);
-        ReturnErrorCodeIf(buffer.IsNull(), CHIP_ERROR_NO_MEMORY);
+#if CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+        if (resolve.Value().IsResolve() && ScheduleCachedResolve(resolve.Value().ResolveData().peerId))
+        {
+            continue;
+        }
+#endif
 
-        QueryBuilder builder(std::move(buffer));
-        builder.Header().SetMessageId(0);
+        ReturnErrorOnFailure(BuildQuery(packer, resolve.Value()));
+    }
 
-        ReturnErrorOnFailure(BuildQuery(builder, resolve.Value()));
+    ReturnErrorOnFailure(packer.Flush());
 
-        if (resolve.Value().firstSend)
+    ExpireIncrementalResolvers();
+
+    return ScheduleRetries();
+}
+
+#if CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+bool MinMdnsResolver::ScheduleCachedResolve(const PeerId & peerId)
+{
+    CachedResponse * slot = nullptr;
+    bool scheduled        = false;
+    for (CachedResponse & response : mCachedResponses)
+    {
+        if (!response.packet.IsNull())
         {
-            ReturnErrorOnFailure(GlobalMinimalMdnsServer::Server().BroadcastUnicastQuery(builder.ReleasePacket(), kMdnsPort));
+            scheduled = true;
         }
-        else
+        else if (slot == nullptr)
         {
-            ReturnErrorOnFailure(GlobalMinimalMdnsServer::Server().BroadcastSend(builder.ReleasePacket(), kMdnsPort));
+            slot = &response;
         }
     }
+    VerifyOrReturnValue(slot != nullptr && mSystemLayer != nullptr, false);
 
-    ExpireIncrementalResolvers();
+    char nameBuffer[kMaxOperationalServiceNameSize] = "";
+    VerifyOrReturnValue(MakeInstanceName(nameBuffer, sizeof(nameBuffer), peerId) == CHIP_NO_ERROR, false);
+    const char * instanceQName[] = { nameBuffer, kOperationalServiceName, kOperationalProtocol, kLocalDomain };
 
-    return ScheduleRetries();
+    System::PacketBufferHandle packet = System::PacketBufferHandle::New(kMdnsMaxPacketSize);
+    VerifyOrReturnValue(!packet.IsNull(), false);
+
+    Encoding::BigEndian::BufferWriter writer(packet->Start(), packet->AvailableDataLength());
+    Inet::InterfaceId interface;
+    VerifyOrReturnValue(mRecordCache.BuildResponse(instanceQName, System::SystemClock().GetMonotonicTimestamp(), writer,
+                                                   interface) == CHIP_NO_ERROR,
+                        false);
+    packet->SetDataLength(static_cast<uint16_t>(writer.Needed()));
+
+    if (!scheduled && mSystemLayer->ScheduleWork(&CachedResponsesCallback, this) != CHIP_NO_ERROR)
+    {
+        return false;
+    }
+
+    const RecordCacheBase::Statistics & statistics = mRecordCache.GetStatistics();
+    ChipLogProgress(Discovery, "Resolving " ChipLogFormatX64 ":" ChipLogFormatX64 " from cached records (%u/%u hits)",
+                    ChipLogValueX64(peerId.GetCompressedFabricId()), ChipLogValueX64(peerId.GetNodeId()),
+                    static_cast<unsigned>(statistics.hits), static_cast<unsigned>(statistics.lookups));
+
+    slot->packet    = std::move(packet);
+    slot->interface = interface;
+    return true;
 }
 
+void MinMdnsResolver::CachedResponsesCallback(System::Layer *, void * self)
+{
+    MinMdnsResolver * resolver = reinterpret_cast<MinMdnsResolver *>(self);
+
+    // Processing may schedule more cached resolves: free all slots first.
+    CachedResponse responses[ArraySize(resolver->mCachedResponses)];
+    for (size_t i = 0; i < ArraySize(responses); i++)
+    {
+        responses[i].packet    = std::move(resolver->mCachedResponses[i].packet);
+        responses[i].interface = resolver->mCachedResponses[i].interface;
+    }
+
+    for (CachedResponse & response : responses)
+    {
+        if (!response.packet.IsNull())
+        {
+            System::PacketBufferHandle & packet = response.packet;
+            resolver->ProcessResponse(BytesRange(packet->Start(), packet->Start() + packet->DataLength()), response.interface);
+        }
+    }
+}
+#endif // CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+
 void MinMdnsResolver::ExpireIncrementalResolvers()
 {
     // once all queries are sent, if any SRV cannot receive AAAA addresses, expire it
@@ -715,16 +855,29 @@ CHIP_ERROR MinMdnsResolver::ReconfirmRecord(const char * hostname, Inet::IPAddre
 
 CHIP_ERROR MinMdnsResolver::BrowseNodes(DiscoveryType type, DiscoveryFilter filter)
 {
-    mActiveResolves.MarkPending(filter, type);
+    ReportEvicted(mActiveResolves.MarkPending(filter, type));
 
-    return SendAllPendingQueries();
+    return ScheduleFlush();
 }
 
 CHIP_ERROR MinMdnsResolver::ResolveNodeId(const PeerId & peerId)
 {
-    mActiveResolves.MarkPending(peerId);
+    // Every lookup is queried at least once before it may be dropped to make room for this one,
+    // and the failure of a dropped lookup is reported after this call returns.
+    Optional<ActiveResolveAttempts::ScheduledAttempt> evicted = mActiveResolves.EvictionCandidate(peerId);
+    if (evicted.HasValue() && evicted.Value().firstSend)
+    {
+        ReturnErrorOnFailure(SendAllPendingQueries());
+        evicted = mActiveResolves.EvictionCandidate(peerId);
+    }
+    if (evicted.HasValue() && evicted.Value().IsResolve())
+    {
+        VerifyOrReturnError(mEvictedResolveCount < ArraySize(mEvictedResolves), CHIP_ERROR_NO_MEMORY);
+    }
+
+    ReportEvicted(mActiveResolves.MarkPending(peerId));
 
-    return SendAllPendingQueries();
+    return ScheduleFlush();
 }
 
 void MinMdnsResolver::NodeIdResolutionNoLongerNeeded(const PeerId & peerId)
@@ -754,6 +907,68 @@ void MinMdnsResolver::RetryCallback(System::Layer *, void * self)
     reinterpret_cast<MinMdnsResolver *>(self)->SendAllPendingQueries();
 }
 
+CHIP_ERROR MinMdnsResolver::ScheduleFlush()
+{
+    ReturnErrorCodeIf(mSystemLayer == nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(!mFlushScheduled, CHIP_NO_ERROR);
+
+    ReturnErrorOnFailure(mSystemLayer->ScheduleWork(&FlushCallback, this));
+    mFlushScheduled = true;
+    return CHIP_NO_ERROR;
+}
+
+void MinMdnsResolver::FlushCallback(System::Layer *, void * self)
+{
+    MinMdnsResolver * resolver = reinterpret_cast<MinMdnsResolver *>(self);
+    resolver->mFlushScheduled  = false;
+
+    CHIP_ERROR err = resolver->SendAllPendingQueries();
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(Discovery, "Failed to send mDNS queries: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+
+    // Delegates may request more lookups: empty the list first.
+    PeerId evicted[ArraySize(resolver->mEvictedResolves)];
+    const size_t evictedCount = resolver->mEvictedResolveCount;
+    for (size_t i = 0; i < evictedCount; i++)
+    {
+        evicted[i] = resolver->mEvictedResolves[i];
+    }
+    resolver->mEvictedResolveCount = 0;
+
+    for (size_t i = 0; i < evictedCount; i++)
+    {
+        resolver->NotifyResolutionFailed(evicted[i], CHIP_ERROR_NO_MEMORY);
+    }
+}
+
+void MinMdnsResolver::ReportEvicted(const Optional<PeerId> & peerId)
+{
+    VerifyOrReturn(peerId.HasValue());
+
+    if (mEvictedResolveCount < ArraySize(mEvictedResolves) && ScheduleFlush() == CHIP_NO_ERROR)
+    {
+        mEvictedResolves[mEvictedResolveCount++] = peerId.Value();
+        return;
+    }
+
+    // ResolveNodeId makes room before evicting: only reached while processing responses or browsing,
+    // where the delegate may be called right away.
+    NotifyResolutionFailed(peerId.Value(), CHIP_ERROR_NO_MEMORY);
+}
+
+void MinMdnsResolver::NotifyResolutionFailed(const PeerId & peerId, CHIP_ERROR error)
+{
+    ChipLogError(Discovery, "Resolve of " ChipLogFormatX64 ":" ChipLogFormatX64 " failed: %" CHIP_ERROR_FORMAT,
+                 ChipLogValueX64(peerId.GetCompressedFabricId()), ChipLogValueX64(peerId.GetNodeId()), error.Format());
+
+    if (mOperationalDelegate != nullptr)
+    {
+        mOperationalDelegate->OnOperationalNodeResolutionFailed(peerId, error);
+    }
+}
+
 MinMdnsResolver gResolver;
 
 } // namespace
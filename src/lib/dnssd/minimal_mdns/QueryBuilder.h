@@ -19,27 +19,44 @@
 
 #include <system/SystemPacketBuffer.h>
 
+#include <algorithm>
+#include <limits>
+
 #include <lib/dnssd/minimal_mdns/Query.h>
 #include <lib/dnssd/minimal_mdns/core/DnsHeader.h>
+#include <lib/dnssd/minimal_mdns/core/RecordWriter.h>
 
 namespace mdns {
 namespace Minimal {
 
+/// Builds query packets.
+///
+/// Names are compressed across all the queries of the packet.
 class QueryBuilder
 {
 public:
-    QueryBuilder() : mHeader(nullptr) {}
-    QueryBuilder(chip::System::PacketBufferHandle && packet) : mHeader(nullptr) { Reset(std::move(packet)); }
+    QueryBuilder() : mHeader(nullptr), mOutput(nullptr, 0), mWriter(&mOutput) {}
+    QueryBuilder(chip::System::PacketBufferHandle && packet) : QueryBuilder() { Reset(std::move(packet)); }
+
+    // The record writer refers to the output buffer of this object
+    QueryBuilder(const QueryBuilder &)             = delete;
+    QueryBuilder & operator=(const QueryBuilder &) = delete;
 
-    QueryBuilder & Reset(chip::System::PacketBufferHandle && packet)
+    /// Start building a packet in [packet], of up to [maxSize] bytes.
+    QueryBuilder & Reset(chip::System::PacketBufferHandle && packet, size_t maxSize = std::numeric_limits<size_t>::max())
     {
         mPacket = std::move(packet);
         mHeader = HeaderRef(mPacket->Start());
+        mOutput = chip::Encoding::BigEndian::BufferWriter(
+            mPacket->Start(), std::min<size_t>(mPacket->DataLength() + mPacket->AvailableDataLength(), maxSize));
+        mWriter.Reset();
 
-        if (mPacket->AvailableDataLength() >= HeaderRef::kSizeBytes)
+        if (mOutput.Size() >= HeaderRef::kSizeBytes)
         {
             mPacket->SetDataLength(HeaderRef::kSizeBytes);
+            mOutput.Skip(HeaderRef::kSizeBytes);
             mHeader.Clear();
+            mQueryBuildOk = true;
         }
         else
         {
@@ -67,25 +84,41 @@ public:
             return *this;
         }
 
-        chip::Encoding::BigEndian::BufferWriter out(mPacket->Start() + mPacket->DataLength(), mPacket->AvailableDataLength());
-        RecordWriter writer(&out);
-
-        if (!query.Append(mHeader, writer))
+        if (!query.Append(mHeader, mWriter))
         {
             mQueryBuildOk = false;
         }
         else
         {
-            mPacket->SetDataLength(static_cast<uint16_t>(mPacket->DataLength() + out.Needed()));
+            mPacket->SetDataLength(static_cast<uint16_t>(mOutput.Needed()));
         }
         return *this;
     }
 
+    /// Whether [query] is sure to fit in the packet, even if none of its name can be compressed.
+    bool HasRoomFor(const Query & query) const
+    {
+        return mQueryBuildOk && (mOutput.Available() >= QNameSize(query.GetName()) + 2 * sizeof(uint16_t));
+    }
+
     bool Ok() const { return mQueryBuildOk; }
 
 private:
+    /// Size of [name] when written without compression
+    static size_t QNameSize(const FullQName & name)
+    {
+        size_t size = 1; // terminating empty label
+        for (size_t i = 0; i < name.nameCount; i++)
+        {
+            size += 1 + strlen(name.names[i]);
+        }
+        return size;
+    }
+
     chip::System::PacketBufferHandle mPacket;
     HeaderRef mHeader;
+    chip::Encoding::BigEndian::BufferWriter mOutput;
+    RecordWriter mWriter;
     bool mQueryBuildOk = true;
 };
 
@@ -53,6 +53,14 @@ public:
     /// compression if possible
     RecordWriter & WriteQName(const SerializedQNameIterator & qname);
 
+    /// Keep track of a qname that was put into the underlying buffer at the given
+    /// offset by other means than WriteQName, so that later qnames may point to it
+    RecordWriter & RememberQName(size_t offset)
+    {
+        RememberWrittenQnameOffset(offset);
+        return *this;
+    }
+
     inline RecordWriter & Put8(uint8_t value)
     {
         mOutput->Put8(value);
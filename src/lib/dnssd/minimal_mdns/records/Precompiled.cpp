@@ -0,0 +1,165 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "Precompiled.h"
+
+#include <lib/support/CodeUtils.h>
+
+#include <string.h>
+#include <utility>
+
+namespace mdns {
+namespace Minimal {
+
+namespace {
+
+constexpr uint8_t kPtrMask = 0xC0;
+
+// Type, class, TTL and data length, written between the owner name and the data
+constexpr size_t kRecordFieldsSize = 10;
+
+} // namespace
+
+CHIP_ERROR PrecompiledRecordData::Build(const ResourceRecord & record)
+{
+    Clear();
+
+    uint16_t nameOffset = kNoName;
+    switch (record.GetType())
+    {
+    case QType::PTR:
+        nameOffset = 0;
+        break;
+    case QType::SRV:
+        nameOffset = 6; // after priority, weight and port
+        break;
+    case QType::TXT:
+    case QType::A:
+    case QType::AAAA:
+        break;
+    default:
+        // data may hold names that would not be found here
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+
+    uint8_t headerBuffer[HeaderRef::kSizeBytes];
+    HeaderRef header(headerBuffer);
+    header.Clear();
+
+    // Nothing is written to a writer without room, so no name gets compressed either:
+    // this gives an upper bound of the serialized record size.
+    chip::Encoding::BigEndian::BufferWriter sizeOutput(nullptr, 0);
+    RecordWriter sizeWriter(&sizeOutput);
+    (void) record.Append(header, ResourceType::kAnswer, sizeWriter);
+
+    chip::Platform::ScopedMemoryBuffer<uint8_t> buffer;
+    VerifyOrReturnError(buffer.Alloc(sizeOutput.Needed()), CHIP_ERROR_NO_MEMORY);
+
+    chip::Encoding::BigEndian::BufferWriter output(buffer.Get(), sizeOutput.Needed());
+    RecordWriter writer(&output);
+    VerifyOrReturnError(record.Append(header, ResourceType::kAnswer, writer), CHIP_ERROR_INVALID_ARGUMENT);
+
+    // The owner name comes first, so it is not compressed: names in the data
+    // can only point to it.
+    uint8_t * start = buffer.Get();
+    const BytesRange serialized(start, start + output.Needed());
+
+    SerializedQNameIterator ownerName(serialized, start);
+    const uint8_t * ownerNameEnd = ownerName.FindDataEnd();
+    VerifyOrReturnError(ownerNameEnd != nullptr, CHIP_ERROR_INTERNAL);
+
+    const uint8_t * data = ownerNameEnd + kRecordFieldsSize;
+    VerifyOrReturnError(serialized.Contains(data) || (data == serialized.End()), CHIP_ERROR_INTERNAL);
+    size_t dataSize = static_cast<size_t>(serialized.End() - data);
+    VerifyOrReturnError(dataSize <= UINT16_MAX, CHIP_ERROR_INVALID_ARGUMENT);
+
+    uint16_t suffix = kNoSuffix;
+    if (nameOffset != kNoName)
+    {
+        size_t pos = nameOffset;
+        while ((pos < dataSize) && (data[pos] != 0) && ((data[pos] & kPtrMask) != kPtrMask))
+        {
+            pos += static_cast<size_t>(data[pos] + 1);
+        }
+        VerifyOrReturnError(pos < dataSize, CHIP_ERROR_INTERNAL);
+
+        if ((data[pos] & kPtrMask) == kPtrMask)
+        {
+            VerifyOrReturnError(pos + 1 < dataSize, CHIP_ERROR_INTERNAL);
+            const size_t target = static_cast<size_t>(((data[pos] & 0x3F) << 8) | data[pos + 1]);
+
+            // Find the owner name label pointed to
+            size_t labelPos = 0;
+            suffix          = 0;
+            while ((labelPos < target) && (start[labelPos] != 0))
+            {
+                labelPos += static_cast<size_t>(start[labelPos] + 1);
+                suffix++;
+            }
+            VerifyOrReturnError((labelPos == target) && (start[labelPos] != 0), CHIP_ERROR_INTERNAL);
+
+            // the suffix is written when replying, as it may point elsewhere then
+            dataSize = pos;
+        }
+    }
+
+    memmove(start, data, dataSize);
+
+    mData       = std::move(buffer);
+    mDataSize   = static_cast<uint16_t>(dataSize);
+    mNameOffset = nameOffset;
+    mSuffix     = suffix;
+
+    return CHIP_NO_ERROR;
+}
+
+void PrecompiledRecordData::Clear()
+{
+    mData.Free();
+    mDataSize   = 0;
+    mNameOffset = kNoName;
+    mSuffix     = kNoSuffix;
+}
+
+bool PrecompiledRecordData::Write(const FullQName & name, RecordWriter & out) const
+{
+    VerifyOrReturnValue(IsBuilt(), false);
+
+    const size_t dataStart = out.Writer().WritePos();
+    out.Put(BytesRange(mData.Get(), mData.Get() + mDataSize));
+
+    if (mSuffix != kNoSuffix)
+    {
+        VerifyOrReturnValue(mSuffix < name.nameCount, false);
+
+        FullQName suffix;
+        suffix.names     = name.names + mSuffix;
+        suffix.nameCount = name.nameCount - mSuffix;
+        out.WriteQName(suffix);
+    }
+
+    // Let later names point to this one, as if it had been written through WriteQName
+    if ((mNameOffset != kNoName) && (mNameOffset < mDataSize) && out.Fit())
+    {
+        out.RememberQName(dataStart + mNameOffset);
+    }
+
+    return out.Fit();
+}
+
+} // namespace Minimal
+} // namespace mdns
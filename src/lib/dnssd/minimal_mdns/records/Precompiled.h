@@ -0,0 +1,85 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+#include <lib/dnssd/minimal_mdns/records/ResourceRecord.h>
+#include <lib/support/ScopedBuffer.h>
+
+namespace mdns {
+namespace Minimal {
+
+/// Data of a resource record, serialized once so that replying with the record
+/// is mostly a copy rather than a rebuild of its content.
+///
+/// Serialization stays compression-aware. A name in the record data (PTR and
+/// SRV targets) is kept as its own labels followed by the index of the owner name
+/// label its suffix starts at (e.g. "_matter._tcp.local" for the target of a
+/// "_matter._tcp.local" PTR record). That suffix is then written through the
+/// RecordWriter, so it points to wherever the owner name ended up in the packet.
+class PrecompiledRecordData
+{
+public:
+    PrecompiledRecordData() {}
+    PrecompiledRecordData(const PrecompiledRecordData &)             = delete;
+    PrecompiledRecordData & operator=(const PrecompiledRecordData &) = delete;
+
+    /// Serialize the data of [record].
+    ///
+    /// On failure, nothing is kept: the record has to be written as usual.
+    CHIP_ERROR Build(const ResourceRecord & record);
+
+    void Clear();
+
+    bool IsBuilt() const { return static_cast<bool>(mData); }
+
+    /// Write the record data, for a record owned by [name], into [out].
+    bool Write(const FullQName & name, RecordWriter & out) const;
+
+private:
+    static constexpr uint16_t kNoName   = 0xFFFF;
+    static constexpr uint16_t kNoSuffix = 0xFFFF;
+
+    chip::Platform::ScopedMemoryBuffer<uint8_t> mData;
+    uint16_t mDataSize   = 0;
+    uint16_t mNameOffset = kNoName;   // where the name in the data starts, if any
+    uint16_t mSuffix     = kNoSuffix; // owner name label the name ends with, if any
+};
+
+/// A record written from its precompiled data.
+///
+/// [data] has to be built from [record] and outlive this record.
+class PrecompiledResourceRecord : public ResourceRecord
+{
+public:
+    PrecompiledResourceRecord(const ResourceRecord & record, const PrecompiledRecordData & data) :
+        ResourceRecord(record.GetType(), record.GetName()), mData(data)
+    {
+        SetTtl(record.GetTtl());
+        SetCacheFlush(record.GetCacheFlush());
+    }
+
+protected:
+    bool WriteData(RecordWriter & out) const override { return mData.Write(GetName(), out); }
+
+private:
+    const PrecompiledRecordData & mData;
+};
+
+} // namespace Minimal
+} // namespace mdns
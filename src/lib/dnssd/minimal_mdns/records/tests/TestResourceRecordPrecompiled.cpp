@@ -0,0 +1,159 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <lib/dnssd/minimal_mdns/records/Precompiled.h>
+
+#include <lib/dnssd/minimal_mdns/records/Ptr.h>
+#include <lib/dnssd/minimal_mdns/records/Srv.h>
+#include <lib/dnssd/minimal_mdns/records/Txt.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/UnitTestRegistration.h>
+
+#include <nlunit-test.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::Encoding;
+using namespace mdns::Minimal;
+
+const QNamePart kServiceName[]  = { "_service", "_udp", "local" };
+const QNamePart kInstanceName[] = { "instance", "_service", "_udp", "local" };
+const QNamePart kHostName[]     = { "host", "local" };
+
+/// Writes records to a packet, either as they are or from their precompiled data.
+class PacketWriter
+{
+public:
+    PacketWriter() : mOutput(mData, sizeof(mData)), mWriter(&mOutput) { mHeader.Clear(); }
+
+    bool Add(const ResourceRecord & record) { return record.Append(mHeader, ResourceType::kAnswer, mWriter); }
+
+    bool AddPrecompiled(const ResourceRecord & record)
+    {
+        PrecompiledRecordData data;
+        if (data.Build(record) != CHIP_NO_ERROR)
+        {
+            return false;
+        }
+        return PrecompiledResourceRecord(record, data).Append(mHeader, ResourceType::kAnswer, mWriter);
+    }
+
+    bool SameAs(const PacketWriter & other) const
+    {
+        return (mOutput.Needed() == other.mOutput.Needed()) && (memcmp(mData, other.mData, mOutput.Needed()) == 0) &&
+            (mHeader.GetAnswerCount() == other.mHeader.GetAnswerCount());
+    }
+
+private:
+    uint8_t mHeaderBuffer[HeaderRef::kSizeBytes];
+    uint8_t mData[512];
+    HeaderRef mHeader = HeaderRef(mHeaderBuffer);
+    BigEndian::BufferWriter mOutput;
+    RecordWriter mWriter;
+};
+
+void TestSameOutput(nlTestSuite * inSuite, void * inContext)
+{
+    const char * entries[] = { "some", "text=entries" };
+
+    PtrResourceRecord ptr(kServiceName, kInstanceName);
+    SrvResourceRecord srv(kInstanceName, kHostName, 0x1234);
+    TxtResourceRecord txt(kInstanceName, entries);
+    srv.SetCacheFlush(true).SetTtl(12);
+
+    PacketWriter expected;
+    NL_TEST_ASSERT(inSuite, expected.Add(ptr));
+    NL_TEST_ASSERT(inSuite, expected.Add(srv));
+    NL_TEST_ASSERT(inSuite, expected.Add(txt));
+
+    // Names in precompiled data still point to the names written before them, and
+    // later names point to them.
+    PacketWriter precompiled;
+    NL_TEST_ASSERT(inSuite, precompiled.AddPrecompiled(ptr));
+    NL_TEST_ASSERT(inSuite, precompiled.AddPrecompiled(srv));
+    NL_TEST_ASSERT(inSuite, precompiled.AddPrecompiled(txt));
+
+    NL_TEST_ASSERT(inSuite, precompiled.SameAs(expected));
+}
+
+void TestSameOutputAfterOtherNames(nlTestSuite * inSuite, void * inContext)
+{
+    const QNamePart kOtherHostName[] = { "other", "local" };
+    const char * entries[]           = { "some", "text=entries" };
+
+    SrvResourceRecord otherSrv(kInstanceName, kOtherHostName, 0x1234);
+    SrvResourceRecord srv(kInstanceName, kHostName, 0x4321);
+    TxtResourceRecord txt(kInstanceName, entries);
+
+    // The owner names of the precompiled records are written elsewhere than when building
+    // their data: compressed, after other names.
+    PacketWriter expected;
+    NL_TEST_ASSERT(inSuite, expected.Add(otherSrv));
+    NL_TEST_ASSERT(inSuite, expected.Add(srv));
+    NL_TEST_ASSERT(inSuite, expected.Add(txt));
+
+    PacketWriter precompiled;
+    NL_TEST_ASSERT(inSuite, precompiled.Add(otherSrv));
+    NL_TEST_ASSERT(inSuite, precompiled.AddPrecompiled(srv));
+    NL_TEST_ASSERT(inSuite, precompiled.AddPrecompiled(txt));
+
+    NL_TEST_ASSERT(inSuite, precompiled.SameAs(expected));
+}
+
+void TestUnsupportedRecords(nlTestSuite * inSuite, void * inContext)
+{
+    const char * tooLongEntries[] = { "this-text-entry-is-far-longer-than-the-sixty-three-bytes-an-entry-may-take" };
+
+    PrecompiledRecordData data;
+    NL_TEST_ASSERT(inSuite, data.Build(TxtResourceRecord(kInstanceName, tooLongEntries)) != CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, !data.IsBuilt());
+
+    NL_TEST_ASSERT(inSuite, data.Build(PtrResourceRecord(kServiceName, kInstanceName)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, data.IsBuilt());
+
+    data.Clear();
+    NL_TEST_ASSERT(inSuite, !data.IsBuilt());
+}
+
+const nlTest sTests[] = {
+    NL_TEST_DEF("SameOutput", TestSameOutput),                               //
+    NL_TEST_DEF("SameOutputAfterOtherNames", TestSameOutputAfterOtherNames), //
+    NL_TEST_DEF("UnsupportedRecords", TestUnsupportedRecords),               //
+    NL_TEST_SENTINEL()                                                       //
+};
+
+int Setup(void * inContext)
+{
+    return (Platform::MemoryInit() == CHIP_NO_ERROR) ? SUCCESS : FAILURE;
+}
+
+int Teardown(void * inContext)
+{
+    Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+} // namespace
+
+int TestPrecompiled()
+{
+    nlTestSuite theSuite = { "Precompiled", sTests, Setup, Teardown };
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestPrecompiled)
@@ -37,11 +37,12 @@ public:
         }
 
         PtrResourceRecord record(GetQName(), mTarget);
-        configuration.Adjust(record);
-        delegate->AddResponse(record);
+        AddResponse(record, delegate, configuration);
         delegate->ResponsesAdded(*this);
     }
 
+    CHIP_ERROR PrecompileResponses() override { return mPrecompiledData.Build(PtrResourceRecord(GetQName(), mTarget)); }
+
 private:
     const FullQName mTarget;
 };
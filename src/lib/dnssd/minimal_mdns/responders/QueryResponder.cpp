@@ -33,6 +33,8 @@ QueryResponderBase::QueryResponderBase(Internal::QueryResponderInfo * infos, siz
 
 void QueryResponderBase::Init()
 {
+    mAdditionalsPrecompiled = false;
+
     for (size_t i = 0; i < mResponderInfoSize; i++)
     {
         mResponderInfos[i].Clear();
@@ -59,6 +61,8 @@ QueryResponderSettings QueryResponderBase::AddResponder(RecordResponder * respon
     }
     ChipLogDetail(Discovery, "Responding with %s", QNameString(responder->GetQName()).c_str());
 
+    mAdditionalsPrecompiled = false;
+
     for (size_t i = 0; i < mResponderInfoSize; i++)
     {
         if (mResponderInfos[i].responder == nullptr)
@@ -115,6 +119,18 @@ void QueryResponderBase::MarkAdditionalRepliesFor(QueryResponderIterator it)
         return; // nothing additional to report
     }
 
+    if (mAdditionalsPrecompiled)
+    {
+        for (size_t i = 0; i < mResponderInfoSize; i++)
+        {
+            if ((info->precompiledAdditionals & (1u << i)) != 0)
+            {
+                mResponderInfos[i].reportNowAsAdditional = true;
+            }
+        }
+        return;
+    }
+
     if (MarkAdditional(info->additionalQName) == 0)
     {
         return; // nothing additional added
@@ -168,6 +184,77 @@ void QueryResponderBase::AddAllResponses(const chip::Inet::IPPacketInfo * source
     delegate->ResponsesAdded(*this);
 }
 
+CHIP_ERROR QueryResponderBase::PrecompileResponses()
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    for (size_t i = 0; i < mResponderInfoSize; i++)
+    {
+        Internal::QueryResponderInfo & info = mResponderInfos[i];
+        if ((info.responder == nullptr) || (info.responder == this))
+        {
+            continue;
+        }
+
+        CHIP_ERROR responderErr = info.responder->PrecompileResponses();
+        if (responderErr != CHIP_NO_ERROR)
+        {
+            err = responderErr;
+        }
+    }
+
+    mAdditionalsPrecompiled = false;
+    if (mResponderInfoSize > kMaxPrecompiledAdditionals)
+    {
+        // Additional replies are looked up for every query instead
+        return err;
+    }
+
+    // Same as MarkAdditionalRepliesFor: additional replies of additional replies are reported as well
+    for (size_t i = 0; i < mResponderInfoSize; i++)
+    {
+        Internal::QueryResponderInfo & info = mResponderInfos[i];
+        info.precompiledAdditionals         = 0;
+
+        if ((info.responder == nullptr) || !info.alsoReportAdditionalQName)
+        {
+            continue;
+        }
+
+        uint32_t pending = InfosFor(info.additionalQName);
+        while (pending != 0)
+        {
+            info.precompiledAdditionals |= pending;
+
+            uint32_t next = 0;
+            for (size_t j = 0; j < mResponderInfoSize; j++)
+            {
+                if (((pending & (1u << j)) != 0) && mResponderInfos[j].alsoReportAdditionalQName)
+                {
+                    next |= InfosFor(mResponderInfos[j].additionalQName);
+                }
+            }
+            pending = next & ~info.precompiledAdditionals;
+        }
+    }
+    mAdditionalsPrecompiled = true;
+
+    return err;
+}
+
+uint32_t QueryResponderBase::InfosFor(const FullQName & qname) const
+{
+    uint32_t result = 0;
+    for (size_t i = 0; i < mResponderInfoSize; i++)
+    {
+        if ((mResponderInfos[i].responder != nullptr) && (mResponderInfos[i].responder->GetQName() == qname))
+        {
+            result |= (1u << i);
+        }
+    }
+    return result;
+}
+
 void QueryResponderBase::ClearBroadcastThrottle()
 {
     for (size_t i = 0; i < mResponderInfoSize; i++)
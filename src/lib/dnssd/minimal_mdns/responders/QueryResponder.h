@@ -44,12 +44,15 @@ struct QueryResponderInfo : public QueryResponderRecord
     bool alsoReportAdditionalQName = false; // report more data when this record is listed
     FullQName additionalQName;              // if alsoReportAdditionalQName is set, send this extra data
 
+    uint32_t precompiledAdditionals = 0; // bit mask of the infos to report as additional, see PrecompileResponses
+
     void Clear()
     {
         responder                 = nullptr;
         reportService             = false;
         reportNowAsAdditional     = false;
         alsoReportAdditionalQName = false;
+        precompiledAdditionals    = 0;
     }
 };
 
@@ -255,6 +258,12 @@ public:
     void AddAllResponses(const chip::Inet::IPPacketInfo * source, ResponderDelegate * delegate,
                          const ResponseConfiguration & configuration) override;
 
+    /// Precompiles the responses of all added responders, along with the
+    /// additional replies each of them requires.
+    ///
+    /// Call once all responders are added and their settings applied.
+    CHIP_ERROR PrecompileResponses() override;
+
     QueryResponderIterator begin(QueryResponderRecordFilter * filter)
     {
         return QueryResponderIterator(filter, mResponderInfos, mResponderInfoSize);
@@ -276,8 +285,15 @@ public:
     void ClearBroadcastThrottle();
 
 private:
+    /// Additional replies are precompiled as a bit mask of infos.
+    static constexpr size_t kMaxPrecompiledAdditionals = 32;
+
+    /// Bit mask of the infos whose responder reports the given qname.
+    uint32_t InfosFor(const FullQName & qname) const;
+
     Internal::QueryResponderInfo * mResponderInfos;
     size_t mResponderInfoSize;
+    bool mAdditionalsPrecompiled = false;
 };
 
 template <size_t kSize>
@@ -17,7 +17,9 @@
 
 #pragma once
 
+#include <lib/dnssd/minimal_mdns/records/Precompiled.h>
 #include <lib/dnssd/minimal_mdns/responders/Responder.h>
+
 namespace mdns {
 namespace Minimal {
 
@@ -27,6 +29,24 @@ class RecordResponder : public Responder
 {
 public:
     RecordResponder(QType qType, const FullQName & qName) : Responder(qType, qName) {}
+
+protected:
+    /// Report [record] to [delegate], written from mPrecompiledData if it was built.
+    void AddResponse(ResourceRecord & record, ResponderDelegate * delegate, const ResponseConfiguration & configuration)
+    {
+        if (mPrecompiledData.IsBuilt())
+        {
+            PrecompiledResourceRecord precompiled(record, mPrecompiledData);
+            configuration.Adjust(precompiled);
+            delegate->AddResponse(precompiled);
+            return;
+        }
+
+        configuration.Adjust(record);
+        delegate->AddResponse(record);
+    }
+
+    PrecompiledRecordData mPrecompiledData;
 };
 
 } // namespace Minimal
@@ -21,6 +21,7 @@
 #include <lib/dnssd/minimal_mdns/records/ResourceRecord.h>
 
 #include <inet/IPPacketInfo.h>
+#include <lib/core/CHIPError.h>
 #include <lib/core/Optional.h>
 
 namespace mdns {
@@ -81,6 +82,13 @@ public:
     virtual void AddAllResponses(const chip::Inet::IPPacketInfo * source, ResponderDelegate * delegate,
                                  const ResponseConfiguration & configuration) = 0;
 
+    /// Serialize ahead of time the responses that do not depend on the query, so
+    /// that AddAllResponses mostly copies them.
+    ///
+    /// Has to be called again if the responses change. On failure, responses are
+    /// built for every query as usual.
+    virtual CHIP_ERROR PrecompileResponses() { return CHIP_NO_ERROR; }
+
 private:
     const QType mQType;
     const FullQName mQName;
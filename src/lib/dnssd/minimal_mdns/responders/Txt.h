@@ -37,11 +37,12 @@ public:
         }
 
         TxtResourceRecord record = mRecord;
-        configuration.Adjust(record);
-        delegate->AddResponse(record);
+        AddResponse(record, delegate, configuration);
         delegate->ResponsesAdded(*this);
     }
 
+    CHIP_ERROR PrecompileResponses() override { return mPrecompiledData.Build(mRecord); }
+
 private:
     const TxtResourceRecord mRecord;
 };
@@ -169,11 +169,58 @@ void NonDiscoverableService(nlTestSuite * inSuite, void * inContext)
     }
 }
 
+void PrecompiledAdditionals(nlTestSuite * inSuite, void * inContext)
+{
+    const QNamePart kName3[] = { "yet", "another", "test" };
+
+    EmptyResponder empty1(kName1);
+    EmptyResponder empty2(kName2);
+    EmptyResponder empty3(kName3);
+    EmptyResponder empty4(kName2);
+
+    // Reports additionals the same way whether precompiled or not
+    for (bool precompile : { false, true })
+    {
+        QueryResponder<10> responder;
+
+        NL_TEST_ASSERT(inSuite, responder.AddResponder(&empty1).SetReportAdditional(kName2).IsValid());
+        NL_TEST_ASSERT(inSuite, responder.AddResponder(&empty2).SetReportAdditional(kName3).IsValid());
+        NL_TEST_ASSERT(inSuite, responder.AddResponder(&empty3).IsValid());
+        NL_TEST_ASSERT(inSuite, responder.AddResponder(&empty4).IsValid());
+
+        if (precompile)
+        {
+            NL_TEST_ASSERT(inSuite, responder.PrecompileResponses() == CHIP_NO_ERROR);
+        }
+
+        QueryResponderRecordFilter noFilter;
+        responder.ResetAdditionals();
+        for (auto it = responder.begin(&noFilter); it != responder.end(); it++)
+        {
+            if (it->responder == &empty1)
+            {
+                responder.MarkAdditionalRepliesFor(it);
+            }
+        }
+
+        QueryResponderRecordFilter additionalsFilter;
+        additionalsFilter.SetIncludeAdditionalRepliesOnly(true);
+
+        int count = 0;
+        for (auto it = responder.begin(&additionalsFilter); it != responder.end(); it++, count++)
+        {
+            NL_TEST_ASSERT(inSuite, (it->responder == &empty2) || (it->responder == &empty3) || (it->responder == &empty4));
+        }
+        NL_TEST_ASSERT(inSuite, count == 3);
+    }
+}
+
 const nlTest sTests[] = {
     NL_TEST_DEF("CanIterateOverResponders", CanIterateOverResponders), //
     NL_TEST_DEF("RespondsToDnsSdQueries", RespondsToDnsSdQueries),     //
     NL_TEST_DEF("LimitedStorage", LimitedStorage),                     //
     NL_TEST_DEF("NonDiscoverableService", NonDiscoverableService),     //
+    NL_TEST_DEF("PrecompiledAdditionals", PrecompiledAdditionals),     //
     NL_TEST_SENTINEL()                                                 //
 };
 
@@ -402,7 +402,7 @@ private:
 
 struct ServerSwapper
 {
-    ServerSwapper(CheckOnlyServer * server)
+    ServerSwapper(ServerBase * server)
     {
         chip::Dnssd::GlobalMinimalMdnsServer::Instance().Server().Shutdown();
         chip::Dnssd::GlobalMinimalMdnsServer::Instance().SetReplacementServer(server);
@@ -0,0 +1,308 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <lib/dnssd/ActiveResolveAttempts.h>
+#include <lib/dnssd/MinimalMdnsServer.h>
+#include <lib/dnssd/Resolver.h>
+#include <lib/dnssd/ServiceNaming.h>
+#include <lib/dnssd/minimal_mdns/Parser.h>
+#include <lib/dnssd/minimal_mdns/records/IP.h>
+#include <lib/dnssd/minimal_mdns/records/Srv.h>
+#include <lib/dnssd/minimal_mdns/records/Txt.h>
+#include <lib/dnssd/minimal_mdns/tests/CheckOnlyServer.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <lib/support/UnitTestUtils.h>
+#include <system/SystemPacketBuffer.h>
+#include <transport/raw/tests/NetworkTestHelpers.h>
+
+#include <nlunit-test.h>
+
+#include <set>
+
+namespace {
+
+using namespace chip;
+using namespace chip::Dnssd;
+using namespace mdns::Minimal;
+
+constexpr uint64_t kCompressedFabricId = 0x1234567898765432LL;
+constexpr NodeId kNodeId               = 0xABCDEFEDCBAABCDE;
+
+const char * kHostName[] = { "ABCDEF0123456789", "local" };
+
+/// Stands in for the mDNS server: counts the queries and known answers that the resolver sends.
+class QueryCounter : private chip::PoolImpl<ServerBase::EndpointInfo, 0, chip::ObjectPoolMem::kInline,
+                                            ServerBase::EndpointInfoPoolType::Interface>,
+                     public ServerBase,
+                     public ParserDelegate
+{
+public:
+    QueryCounter() : ServerBase(*static_cast<ServerBase::EndpointInfoPoolType *>(this)) {}
+
+    using ServerBase::BroadcastSend;
+    using ServerBase::BroadcastUnicastQuery;
+
+    CHIP_ERROR BroadcastSend(System::PacketBufferHandle && data, uint16_t port) override { return Count(std::move(data)); }
+    CHIP_ERROR BroadcastUnicastQuery(System::PacketBufferHandle && data, uint16_t port) override { return Count(std::move(data)); }
+
+    void OnHeader(ConstHeaderRef & header) override {}
+    void OnQuery(const QueryData & data) override { mQueryCount++; }
+    void OnResource(ResourceType type, const ResourceData & data) override { mKnownAnswerCount++; }
+
+    void Reset()
+    {
+        mPacketCount      = 0;
+        mQueryCount       = 0;
+        mKnownAnswerCount = 0;
+    }
+
+    size_t mPacketCount      = 0;
+    size_t mQueryCount       = 0;
+    size_t mKnownAnswerCount = 0;
+
+private:
+    CHIP_ERROR Count(System::PacketBufferHandle && data)
+    {
+        mPacketCount++;
+        ParsePacket(BytesRange(data->Start(), data->Start() + data->DataLength()), this);
+        return CHIP_NO_ERROR;
+    }
+};
+
+struct TestContext
+{
+    chip::Test::IOContext * ioContext;
+    QueryCounter * server;
+};
+
+class ResolveCounter : public OperationalResolveDelegate
+{
+public:
+    void OnOperationalNodeResolved(const ResolvedNodeData & nodeData) override { mResolvedCount++; }
+    void OnOperationalNodeResolutionFailed(const PeerId & peerId, CHIP_ERROR error) override
+    {
+        mFailedNodes.insert(peerId.GetNodeId());
+        mLastError = error;
+    }
+
+    size_t mResolvedCount = 0;
+    std::set<NodeId> mFailedNodes;
+    CHIP_ERROR mLastError = CHIP_NO_ERROR;
+};
+
+PeerId MakePeerId(NodeId nodeId)
+{
+    return PeerId().SetCompressedFabricId(kCompressedFabricId).SetNodeId(nodeId);
+}
+
+/// Hand the resolver a response about [nodeId], with an SRV and TXT record when [withService]
+/// is set and an AAAA record of the given TTL.
+void SendResponse(nlTestSuite * inSuite, bool withService, uint32_t addressTtl, NodeId nodeId = kNodeId)
+{
+    char nameBuffer[kMaxOperationalServiceNameSize] = "";
+    NL_TEST_ASSERT(inSuite, MakeInstanceName(nameBuffer, sizeof(nameBuffer), MakePeerId(nodeId)) == CHIP_NO_ERROR);
+    const char * instanceName[] = { nameBuffer, kOperationalServiceName, kOperationalProtocol, kLocalDomain };
+    const char * entries[]      = { "SII=23" };
+
+    Inet::IPAddress address;
+    NL_TEST_ASSERT(inSuite, Inet::IPAddress::FromString("fe80::abcd", address));
+
+    uint8_t buffer[512];
+    Encoding::BigEndian::BufferWriter output(buffer, sizeof(buffer));
+    RecordWriter writer(&output);
+    HeaderRef header(buffer);
+    header.Clear().SetFlags(BitPackedFlags(0).SetResponse().SetAuthoritative());
+    output.Skip(HeaderRef::kSizeBytes);
+
+    if (withService)
+    {
+        SrvResourceRecord(FullQName(instanceName), FullQName(kHostName), CHIP_PORT).Append(header, ResourceType::kAnswer, writer);
+        TxtResourceRecord(FullQName(instanceName), entries).Append(header, ResourceType::kAnswer, writer);
+    }
+    IPResourceRecord(FullQName(kHostName), address).SetTtl(addressTtl).Append(header, ResourceType::kAdditional, writer);
+    NL_TEST_ASSERT(inSuite, writer.Fit());
+
+    Inet::IPPacketInfo info;
+    info.Clear();
+    info.Interface = Inet::InterfaceId::Null();
+    GlobalMinimalMdnsServer::Instance().OnResponse(BytesRange(buffer, buffer + output.Needed()), &info);
+}
+
+void TestCachedServiceWithoutAddress(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx     = *static_cast<TestContext *>(inContext);
+    QueryCounter & server = *ctx.server;
+    ResolveCounter delegate;
+    Resolver & resolver = Resolver::Instance();
+    resolver.SetOperationalDelegate(&delegate);
+
+    server.Reset();
+    NL_TEST_ASSERT(inSuite, resolver.ResolveNodeId(MakePeerId(kNodeId)) == CHIP_NO_ERROR);
+    ctx.ioContext->DriveIO();
+    NL_TEST_ASSERT(inSuite, server.mQueryCount == 1);
+    SendResponse(inSuite, true /* withService */, 120 /* addressTtl */);
+    NL_TEST_ASSERT(inSuite, delegate.mResolvedCount == 1);
+
+    // The node says goodbye to its address: its SRV and TXT records alone do not resolve it
+    SendResponse(inSuite, false /* withService */, 0 /* addressTtl */);
+
+    // The new query must not list the cached SRV and TXT records as known answers, as
+    // responders would then leave them out and the resolve could never complete.
+    server.Reset();
+    NL_TEST_ASSERT(inSuite, resolver.ResolveNodeId(MakePeerId(kNodeId)) == CHIP_NO_ERROR);
+    ctx.ioContext->DriveIO();
+    NL_TEST_ASSERT(inSuite, server.mPacketCount == 1);
+    NL_TEST_ASSERT(inSuite, server.mQueryCount == 1);
+    NL_TEST_ASSERT(inSuite, server.mKnownAnswerCount == 0);
+
+    SendResponse(inSuite, true /* withService */, 120 /* addressTtl */);
+    NL_TEST_ASSERT(inSuite, delegate.mResolvedCount == 2);
+
+    resolver.SetOperationalDelegate(nullptr);
+}
+
+void TestMoreLookupsThanRetryQueue(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr size_t kQueueSize   = ActiveResolveAttempts::kRetryQueueSize;
+    constexpr size_t kLookupCount = kQueueSize + 4;
+
+    TestContext & ctx     = *static_cast<TestContext *>(inContext);
+    QueryCounter & server = *ctx.server;
+    ResolveCounter delegate;
+    Resolver & resolver = Resolver::Instance();
+    resolver.SetOperationalDelegate(&delegate);
+
+    // Lookups are sent together on the next event loop iteration.  Lookups beyond the
+    // retry queue size first send the lookups that are queued, then replace the oldest.
+    server.Reset();
+    for (size_t i = 0; i < kLookupCount; i++)
+    {
+        NL_TEST_ASSERT(inSuite, resolver.ResolveNodeId(MakePeerId(0x1000 + i)) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, server.mQueryCount == kQueueSize);
+    NL_TEST_ASSERT(inSuite, server.mPacketCount <= kQueueSize / 20 + 1);
+    NL_TEST_ASSERT(inSuite, delegate.mFailedNodes.empty());
+
+    // The replaced lookups fail once the last ones are sent
+    ctx.ioContext->DriveIO();
+    NL_TEST_ASSERT(inSuite, server.mQueryCount == kLookupCount);
+    NL_TEST_ASSERT(inSuite, delegate.mFailedNodes.size() == kLookupCount - kQueueSize);
+    for (size_t i = 0; i < kLookupCount - kQueueSize; i++)
+    {
+        NL_TEST_ASSERT(inSuite, delegate.mFailedNodes.count(0x1000 + i) == 1);
+    }
+    NL_TEST_ASSERT(inSuite, delegate.mLastError == CHIP_ERROR_NO_MEMORY);
+
+    // Retries are due at the same time and share packets.
+    server.Reset();
+    chip::test_utils::SleepMillis(1100);
+    ctx.ioContext->DriveIO();
+    NL_TEST_ASSERT(inSuite, server.mQueryCount == kQueueSize);
+    NL_TEST_ASSERT(inSuite, server.mPacketCount <= kQueueSize / 20 + 1);
+
+    for (size_t i = 0; i < kLookupCount; i++)
+    {
+        resolver.NodeIdResolutionNoLongerNeeded(MakePeerId(0x1000 + i));
+    }
+    resolver.SetOperationalDelegate(nullptr);
+}
+
+void TestManySimultaneousLookups(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr size_t kQueueSize   = ActiveResolveAttempts::kRetryQueueSize;
+    constexpr size_t kLookupCount = 500;
+
+    TestContext & ctx     = *static_cast<TestContext *>(inContext);
+    QueryCounter & server = *ctx.server;
+    ResolveCounter delegate;
+    Resolver & resolver = Resolver::Instance();
+    resolver.SetOperationalDelegate(&delegate);
+
+    // Each lookup is either refused, reported as failed or kept pending: none is lost.
+    server.Reset();
+    std::set<NodeId> refusedNodes;
+    for (size_t i = 0; i < kLookupCount; i++)
+    {
+        CHIP_ERROR err = resolver.ResolveNodeId(MakePeerId(0x1000 + i));
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR || err == CHIP_ERROR_NO_MEMORY);
+        if (err != CHIP_NO_ERROR)
+        {
+            refusedNodes.insert(0x1000 + i);
+        }
+    }
+    ctx.ioContext->DriveIO();
+
+    NL_TEST_ASSERT(inSuite, delegate.mFailedNodes.size() == kQueueSize);
+    NL_TEST_ASSERT(inSuite, refusedNodes.size() == kLookupCount - 2 * kQueueSize);
+    for (NodeId nodeId : refusedNodes)
+    {
+        NL_TEST_ASSERT(inSuite, delegate.mFailedNodes.count(nodeId) == 0);
+    }
+
+    // Every lookup that was not refused was sent once, in shared packets.
+    NL_TEST_ASSERT(inSuite, server.mQueryCount == 2 * kQueueSize);
+    NL_TEST_ASSERT(inSuite, server.mPacketCount <= 2 * (kQueueSize / 20 + 1));
+
+    // The pending lookups resolve as soon as their node answers.
+    for (size_t i = 0; i < kLookupCount; i++)
+    {
+        const NodeId nodeId = 0x1000 + i;
+        if (refusedNodes.count(nodeId) == 0 && delegate.mFailedNodes.count(nodeId) == 0)
+        {
+            SendResponse(inSuite, true /* withService */, 120 /* addressTtl */, nodeId);
+        }
+    }
+    NL_TEST_ASSERT(inSuite, delegate.mResolvedCount == kQueueSize);
+
+    for (size_t i = 0; i < kLookupCount; i++)
+    {
+        resolver.NodeIdResolutionNoLongerNeeded(MakePeerId(0x1000 + i));
+    }
+    resolver.SetOperationalDelegate(nullptr);
+}
+
+const nlTest sTests[] = {
+    NL_TEST_DEF("CachedServiceWithoutAddress", TestCachedServiceWithoutAddress), //
+    NL_TEST_DEF("MoreLookupsThanRetryQueue", TestMoreLookupsThanRetryQueue),     //
+    NL_TEST_DEF("ManySimultaneousLookups", TestManySimultaneousLookups),         //
+    NL_TEST_SENTINEL()                                                           //
+};
+
+} // namespace
+
+int TestMinimalMdnsResolver()
+{
+    chip::Platform::MemoryInit();
+
+    chip::Test::IOContext context;
+    context.Init();
+
+    nlTestSuite theSuite = { "MinimalMdnsResolver", sTests, nullptr, nullptr };
+    QueryCounter server;
+    test::ServerSwapper swapper(&server);
+    auto & resolver = Resolver::Instance();
+    resolver.Init(context.GetUDPEndPointManager());
+    TestContext ctx = { &context, &server };
+    nlTestRunner(&theSuite, &ctx);
+    resolver.Shutdown();
+    context.Shutdown();
+    chip::Platform::MemoryShutdown();
+
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestMinimalMdnsResolver)
@@ -223,7 +223,8 @@ void TestLRU(nlTestSuite * inSuite, void * inContext)
 
     for (uint32_t i = 1; i < mdns::Minimal::ActiveResolveAttempts::kRetryQueueSize; i++)
     {
-        attempts.MarkPending(MakePeerId(i));
+        NL_TEST_ASSERT(inSuite, !attempts.EvictionCandidate(MakePeerId(i)).HasValue());
+        NL_TEST_ASSERT(inSuite, !attempts.MarkPending(MakePeerId(i)).HasValue());
         mockClock.AdvanceMonotonic(1_ms32);
 
         NL_TEST_ASSERT(inSuite, attempts.NextScheduled() == ScheduledPeer(i, true));
@@ -236,8 +237,16 @@ void TestLRU(nlTestSuite * inSuite, void * inContext)
                        Optional<System::Clock::Timeout>::Value(
                            System::Clock::Milliseconds32(1000 - mdns::Minimal::ActiveResolveAttempts::kRetryQueueSize + 2)));
 
+    // rescheduling a pending peer does not evict anything
+    NL_TEST_ASSERT(inSuite, !attempts.EvictionCandidate(MakePeerId(9999)).HasValue());
+
     // add another element - this should overwrite peer 9999
-    attempts.MarkPending(MakePeerId(mdns::Minimal::ActiveResolveAttempts::kRetryQueueSize));
+    NL_TEST_ASSERT(inSuite,
+                   attempts.EvictionCandidate(MakePeerId(mdns::Minimal::ActiveResolveAttempts::kRetryQueueSize)) ==
+                       ScheduledPeer(9999, false));
+    NL_TEST_ASSERT(inSuite,
+                   attempts.MarkPending(MakePeerId(mdns::Minimal::ActiveResolveAttempts::kRetryQueueSize)) ==
+                       Optional<PeerId>(MakePeerId(9999)));
     mockClock.AdvanceMonotonic(32_s16);
 
     for (Optional<ActiveResolveAttempts::ScheduledAttempt> s = attempts.NextScheduled(); s.HasValue(); s = attempts.NextScheduled())
@@ -0,0 +1,146 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <lib/dnssd/QueryPacker.h>
+
+#include <lib/dnssd/ServiceNaming.h>
+#include <lib/dnssd/minimal_mdns/Parser.h>
+#include <lib/support/UnitTestRegistration.h>
+
+#include <nlunit-test.h>
+
+#include <algorithm>
+
+using namespace chip;
+using namespace chip::Dnssd;
+using namespace mdns::Minimal;
+
+namespace {
+
+constexpr size_t kPacketSize = 1024;
+
+/// Counts the queries of the packets it is given.
+class PacketCounter : public QueryPacker::Delegate, public ParserDelegate
+{
+public:
+    CHIP_ERROR SendQueries(System::PacketBufferHandle && packet, bool unicastAnswers) override
+    {
+        mPacketCount++;
+        mMaxPacketSize = std::max<size_t>(mMaxPacketSize, packet->DataLength());
+
+        if (!ParsePacket(BytesRange(packet->Start(), packet->Start() + packet->DataLength()), this))
+        {
+            mValid = false;
+        }
+        if (mUnicastAnswers != unicastAnswers)
+        {
+            mUnicastAnswersMismatch = true;
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    void OnHeader(ConstHeaderRef & header) override {}
+    void OnQuery(const QueryData & data) override
+    {
+        mQueryCount++;
+        mUnicastAnswers = data.RequestedUnicastAnswer();
+    }
+    // Query packets hold no records
+    void OnResource(ResourceType type, const ResourceData & data) override { mValid = false; }
+
+    size_t mPacketCount          = 0;
+    size_t mMaxPacketSize        = 0;
+    size_t mQueryCount           = 0;
+    bool mValid                  = true;
+    bool mUnicastAnswers         = false; // as requested by the last query
+    bool mUnicastAnswersMismatch = false;
+};
+
+CHIP_ERROR AddResolveQuery(QueryPacker & packer, NodeId nodeId, bool unicastAnswers)
+{
+    char nameBuffer[kMaxOperationalServiceNameSize] = "";
+    ReturnErrorOnFailure(
+        MakeInstanceName(nameBuffer, sizeof(nameBuffer), PeerId().SetCompressedFabricId(0x1234567898765432LL).SetNodeId(nodeId)));
+
+    const char * instanceQName[] = { nameBuffer, kOperationalServiceName, kOperationalProtocol, kLocalDomain };
+    Query query(instanceQName);
+    query.SetClass(QClass::IN).SetType(QType::ANY).SetAnswerViaUnicast(unicastAnswers);
+
+    return packer.AddQuery(query);
+}
+
+void TestPackManyQueries(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr size_t kLookupCount = 500;
+
+    PacketCounter counter;
+    QueryPacker packer(counter, kPacketSize);
+
+    for (size_t i = 0; i < kLookupCount; i++)
+    {
+        NL_TEST_ASSERT(inSuite, AddResolveQuery(packer, 0x1000 + i, false) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, packer.Flush() == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, counter.mValid);
+    NL_TEST_ASSERT(inSuite, !counter.mUnicastAnswersMismatch);
+    NL_TEST_ASSERT(inSuite, counter.mQueryCount == kLookupCount);
+    NL_TEST_ASSERT(inSuite, counter.mMaxPacketSize <= kPacketSize);
+
+    // Once the service name is written, each query only takes its instance name, a pointer,
+    // type and class: 40 bytes.  Over 20 queries fit in a packet.
+    NL_TEST_ASSERT(inSuite, counter.mPacketCount <= kLookupCount / 20);
+
+    // Nothing left to send
+    NL_TEST_ASSERT(inSuite, packer.Flush() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, counter.mQueryCount == kLookupCount);
+}
+
+void TestSeparateUnicastAnswers(nlTestSuite * inSuite, void * inContext)
+{
+    PacketCounter counter;
+    QueryPacker packer(counter, kPacketSize);
+
+    NL_TEST_ASSERT(inSuite, AddResolveQuery(packer, 1, false) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, AddResolveQuery(packer, 2, true) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, AddResolveQuery(packer, 3, false) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, AddResolveQuery(packer, 4, true) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, packer.Flush() == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, counter.mValid);
+    NL_TEST_ASSERT(inSuite, !counter.mUnicastAnswersMismatch);
+    NL_TEST_ASSERT(inSuite, counter.mPacketCount == 2);
+    NL_TEST_ASSERT(inSuite, counter.mQueryCount == 4);
+}
+
+const nlTest sTests[] = {
+    NL_TEST_DEF("PackManyQueries", TestPackManyQueries),               //
+    NL_TEST_DEF("SeparateUnicastAnswers", TestSeparateUnicastAnswers), //
+    NL_TEST_SENTINEL()                                                 //
+};
+
+} // namespace
+
+int TestChipDnsSdQueryPacker()
+{
+    nlTestSuite theSuite = { "QueryPacker", &sTests[0], nullptr, nullptr };
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestChipDnsSdQueryPacker)
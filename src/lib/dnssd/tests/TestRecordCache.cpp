@@ -0,0 +1,359 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <lib/dnssd/RecordCache.h>
+
+#include <lib/dnssd/IncrementalResolve.h>
+#include <lib/dnssd/minimal_mdns/Parser.h>
+#include <lib/dnssd/minimal_mdns/RecordData.h>
+#include <lib/dnssd/minimal_mdns/core/tests/QNameStrings.h>
+#include <lib/dnssd/minimal_mdns/records/IP.h>
+#include <lib/dnssd/minimal_mdns/records/Srv.h>
+#include <lib/dnssd/minimal_mdns/records/Txt.h>
+#include <lib/support/UnitTestRegistration.h>
+
+#include <nlunit-test.h>
+
+using namespace chip;
+using namespace chip::Dnssd;
+using namespace chip::System::Clock::Literals;
+using namespace mdns::Minimal;
+
+namespace {
+
+const auto kTestOperationalName    = testing::TestQName<4>({ "1234567898765432-ABCDEFEDCBAABCDE", "_matter", "_tcp", "local" });
+const auto kOtherOperationalName   = testing::TestQName<4>({ "1234567898765432-0000000000000001", "_matter", "_tcp", "local" });
+const auto kTestCommissionableNode = testing::TestQName<4>({ "C5038835313B8B98", "_matterc", "_udp", "local" });
+
+const auto kTestHostName  = testing::TestQName<2>({ "abcd", "local" });
+const auto kOtherHostName = testing::TestQName<2>({ "other", "local" });
+
+const System::Clock::Timestamp kStartTime = 1000_ms64;
+
+Inet::IPAddress MakeAddress(const char * text)
+{
+    Inet::IPAddress addr;
+    Inet::IPAddress::FromString(text, addr);
+    return addr;
+}
+
+/// Builds an mDNS packet out of resource records.
+class TestPacket
+{
+public:
+    TestPacket(bool isResponse = true) : mOutput(mBuffer, sizeof(mBuffer)), mWriter(&mOutput), mHeader(mBuffer)
+    {
+        mHeader.Clear();
+        if (isResponse)
+        {
+            mHeader.SetFlags(BitPackedFlags(0).SetResponse().SetAuthoritative());
+        }
+        mOutput.Skip(HeaderRef::kSizeBytes);
+    }
+
+    TestPacket & Add(const ResourceRecord & record)
+    {
+        record.Append(mHeader, ResourceType::kAnswer, mWriter);
+        return *this;
+    }
+
+    BytesRange Range() const { return BytesRange(mBuffer, mBuffer + mOutput.Needed()); }
+
+private:
+    uint8_t mBuffer[512] = {};
+    Encoding::BigEndian::BufferWriter mOutput;
+    RecordWriter mWriter;
+    HeaderRef mHeader;
+};
+
+/// Resolves a node out of a response built by the cache, as the resolver does.
+class ResponseResolver : public ParserDelegate
+{
+public:
+    bool Resolve(const BytesRange & packet, ResolvedNodeData & nodeData)
+    {
+        mPacket = packet;
+        mMinTtl = UINT64_MAX;
+        VerifyOrReturnValue(ParsePacket(packet, this), false);
+        return !mResolver.GetMissingRequiredInformation().HasAny() && mResolver.Take(nodeData) == CHIP_NO_ERROR;
+    }
+
+    size_t GetRecordCount() const { return mRecordCount; }
+    uint64_t GetMinTtl() const { return mMinTtl; }
+
+    void OnHeader(ConstHeaderRef & header) override { mRecordCount = header.GetAnswerCount(); }
+    void OnQuery(const QueryData & data) override {}
+    void OnResource(ResourceType type, const ResourceData & data) override
+    {
+        mMinTtl = std::min(mMinTtl, data.GetTtlSeconds());
+
+        // The cache writes the SRV record first
+        if (!mResolver.IsActive())
+        {
+            SrvRecord srv;
+            if (data.GetType() == QType::SRV && srv.Parse(data.GetData(), mPacket))
+            {
+                mResolver.InitializeParsing(data.GetName(), srv);
+            }
+            return;
+        }
+        mResolver.OnRecord(Inet::InterfaceId::Null(), data, mPacket);
+    }
+
+private:
+    IncrementalResolver mResolver;
+    BytesRange mPacket;
+    size_t mRecordCount = 0;
+    uint64_t mMinTtl    = 0;
+};
+
+CHIP_ERROR BuildResponse(RecordCacheBase & cache, System::Clock::Timestamp now, uint8_t * buffer, size_t size, BytesRange & out)
+{
+    Encoding::BigEndian::BufferWriter writer(buffer, size);
+    Inet::InterfaceId interface;
+    ReturnErrorOnFailure(cache.BuildResponse(kTestOperationalName.Full(), now, writer, interface));
+    out = BytesRange(buffer, buffer + writer.Needed());
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR BuildResponse(RecordCacheBase & cache, System::Clock::Timestamp now)
+{
+    uint8_t buffer[512];
+    BytesRange unused;
+    return BuildResponse(cache, now, buffer, sizeof(buffer), unused);
+}
+
+void AddTestNode(RecordCacheBase & cache, System::Clock::Timestamp now)
+{
+    const char * entries[] = { "SII=23" };
+
+    TestPacket packet;
+    packet.Add(SrvResourceRecord(kTestOperationalName.Full(), kTestHostName.Full(), 0x1234 /* port */).SetTtl(120))
+        .Add(TxtResourceRecord(kTestOperationalName.Full(), entries).SetTtl(4500))
+        .Add(IPResourceRecord(kTestHostName.Full(), MakeAddress("fe80::abcd:ef11:2233:4455")).SetTtl(120));
+    cache.AddRecords(Inet::InterfaceId::Null(), packet.Range(), now);
+}
+
+void TestCachedResolve(nlTestSuite * inSuite, void * inContext)
+{
+    RecordCache<16> cache;
+
+    {
+        const char * entries[] = { "SII=23" };
+
+        // Records of other nodes, of commissionable nodes and of unrelated hosts are not kept.
+        TestPacket packet;
+        packet.Add(SrvResourceRecord(kTestOperationalName.Full(), kTestHostName.Full(), 0x1234 /* port */).SetTtl(120))
+            .Add(TxtResourceRecord(kTestOperationalName.Full(), entries).SetTtl(4500))
+            .Add(IPResourceRecord(kTestHostName.Full(), MakeAddress("fe80::abcd:ef11:2233:4455")).SetTtl(120))
+            .Add(IPResourceRecord(kOtherHostName.Full(), MakeAddress("fe80::1")).SetTtl(120))
+            .Add(SrvResourceRecord(kTestCommissionableNode.Full(), kTestHostName.Full(), 5540).SetTtl(120));
+        cache.AddRecords(Inet::InterfaceId::Null(), packet.Range(), kStartTime);
+    }
+
+    uint8_t buffer[512];
+    BytesRange response;
+    NL_TEST_ASSERT(inSuite, BuildResponse(cache, kStartTime + 10_s, buffer, sizeof(buffer), response) == CHIP_NO_ERROR);
+
+    ResponseResolver resolver;
+    ResolvedNodeData nodeData;
+    NL_TEST_ASSERT(inSuite, resolver.Resolve(response, nodeData));
+    NL_TEST_ASSERT(inSuite, resolver.GetRecordCount() == 3);
+    NL_TEST_ASSERT(inSuite, resolver.GetMinTtl() == 110);
+
+    NL_TEST_ASSERT(inSuite,
+                   nodeData.operationalData.peerId ==
+                       PeerId().SetCompressedFabricId(0x1234567898765432LL).SetNodeId(0xABCDEFEDCBAABCDELL));
+    NL_TEST_ASSERT(inSuite, nodeData.resolutionData.port == 0x1234);
+    NL_TEST_ASSERT(inSuite, nodeData.resolutionData.numIPs == 1);
+    NL_TEST_ASSERT(inSuite, nodeData.resolutionData.ipAddress[0] == MakeAddress("fe80::abcd:ef11:2233:4455"));
+    NL_TEST_ASSERT(inSuite, nodeData.resolutionData.GetMrpRetryIntervalIdle().HasValue());
+    NL_TEST_ASSERT(inSuite, nodeData.resolutionData.GetMrpRetryIntervalIdle().Value() == chip::System::Clock::Milliseconds32(23));
+
+    // Other nodes are not known
+    Encoding::BigEndian::BufferWriter writer(buffer, sizeof(buffer));
+    Inet::InterfaceId interface;
+    NL_TEST_ASSERT(inSuite,
+                   cache.BuildResponse(kOtherOperationalName.Full(), kStartTime, writer, interface) == CHIP_ERROR_NOT_FOUND);
+
+    NL_TEST_ASSERT(inSuite, BuildResponse(cache, kStartTime, buffer, 64, response) == CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    NL_TEST_ASSERT(inSuite, cache.GetStatistics().lookups == 3);
+    NL_TEST_ASSERT(inSuite, cache.GetStatistics().hits == 1);
+    NL_TEST_ASSERT(inSuite, cache.GetStatistics().evictions == 0);
+}
+
+void TestRequiresAddress(nlTestSuite * inSuite, void * inContext)
+{
+    RecordCache<16> cache;
+
+    {
+        const char * entries[] = { "SII=23" };
+
+        TestPacket packet;
+        packet.Add(SrvResourceRecord(kTestOperationalName.Full(), kTestHostName.Full(), 0x1234 /* port */).SetTtl(120))
+            .Add(TxtResourceRecord(kTestOperationalName.Full(), entries).SetTtl(4500));
+        cache.AddRecords(Inet::InterfaceId::Null(), packet.Range(), kStartTime);
+    }
+    NL_TEST_ASSERT(inSuite, BuildResponse(cache, kStartTime) == CHIP_ERROR_NOT_FOUND);
+
+    // Addresses are usually received in a separate response
+    {
+        TestPacket packet;
+        packet.Add(IPResourceRecord(kTestHostName.Full(), MakeAddress("fe80::abcd:ef11:2233:4455")).SetTtl(120));
+        cache.AddRecords(Inet::InterfaceId::Null(), packet.Range(), kStartTime);
+    }
+    NL_TEST_ASSERT(inSuite, BuildResponse(cache, kStartTime) == CHIP_NO_ERROR);
+
+    cache.Clear();
+    NL_TEST_ASSERT(inSuite, BuildResponse(cache, kStartTime) == CHIP_ERROR_NOT_FOUND);
+}
+
+void TestIgnoresQueries(nlTestSuite * inSuite, void * inContext)
+{
+    RecordCache<16> cache;
+
+    TestPacket packet(false /* isResponse */);
+    packet.Add(SrvResourceRecord(kTestOperationalName.Full(), kTestHostName.Full(), 0x1234 /* port */).SetTtl(120))
+        .Add(IPResourceRecord(kTestHostName.Full(), MakeAddress("fe80::abcd:ef11:2233:4455")).SetTtl(120));
+    cache.AddRecords(Inet::InterfaceId::Null(), packet.Range(), kStartTime);
+
+    NL_TEST_ASSERT(inSuite, BuildResponse(cache, kStartTime) == CHIP_ERROR_NOT_FOUND);
+}
+
+void TestExpiry(nlTestSuite * inSuite, void * inContext)
+{
+    RecordCache<16> cache;
+
+    AddTestNode(cache, kStartTime);
+    NL_TEST_ASSERT(inSuite, BuildResponse(cache, kStartTime + 119_s) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, BuildResponse(cache, kStartTime + 120_s) == CHIP_ERROR_NOT_FOUND);
+
+    // Records received again are valid again
+    AddTestNode(cache, kStartTime + 200_s);
+    NL_TEST_ASSERT(inSuite, BuildResponse(cache, kStartTime + 300_s) == CHIP_NO_ERROR);
+}
+
+void TestGoodbye(nlTestSuite * inSuite, void * inContext)
+{
+    RecordCache<16> cache;
+
+    AddTestNode(cache, kStartTime);
+
+    // A goodbye for another address keeps the cached one
+    {
+        TestPacket packet;
+        packet.Add(IPResourceRecord(kTestHostName.Full(), MakeAddress("fe80::1")).SetTtl(0));
+        cache.AddRecords(Inet::InterfaceId::Null(), packet.Range(), kStartTime);
+    }
+    NL_TEST_ASSERT(inSuite, BuildResponse(cache, kStartTime) == CHIP_NO_ERROR);
+
+    {
+        TestPacket packet;
+        packet.Add(IPResourceRecord(kTestHostName.Full(), MakeAddress("fe80::abcd:ef11:2233:4455")).SetTtl(0));
+        cache.AddRecords(Inet::InterfaceId::Null(), packet.Range(), kStartTime);
+    }
+    NL_TEST_ASSERT(inSuite, BuildResponse(cache, kStartTime) == CHIP_ERROR_NOT_FOUND);
+}
+
+void TestCacheFlush(nlTestSuite * inSuite, void * inContext)
+{
+    RecordCache<16> cache;
+
+    AddTestNode(cache, kStartTime);
+
+    // Addresses without the cache-flush bit add up
+    {
+        TestPacket packet;
+        packet.Add(IPResourceRecord(kTestHostName.Full(), MakeAddress("fe80::1")).SetTtl(120))
+            .Add(IPResourceRecord(kTestHostName.Full(), MakeAddress("fe80::2")).SetTtl(120));
+        cache.AddRecords(Inet::InterfaceId::Null(), packet.Range(), kStartTime);
+    }
+
+    uint8_t buffer[512];
+    BytesRange response;
+    ResponseResolver resolver;
+    ResolvedNodeData nodeData;
+    NL_TEST_ASSERT(inSuite, BuildResponse(cache, kStartTime, buffer, sizeof(buffer), response) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, resolver.Resolve(response, nodeData));
+    NL_TEST_ASSERT(inSuite, resolver.GetRecordCount() == 5);
+
+    // Addresses with the cache-flush bit replace those received in other responses
+    {
+        TestPacket packet;
+        packet.Add(IPResourceRecord(kTestHostName.Full(), MakeAddress("fe80::2")).SetTtl(120).SetCacheFlush(true))
+            .Add(IPResourceRecord(kTestHostName.Full(), MakeAddress("fe80::3")).SetTtl(120).SetCacheFlush(true));
+        cache.AddRecords(Inet::InterfaceId::Null(), packet.Range(), kStartTime);
+    }
+
+    NL_TEST_ASSERT(inSuite, BuildResponse(cache, kStartTime, buffer, sizeof(buffer), response) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, resolver.Resolve(response, nodeData));
+    NL_TEST_ASSERT(inSuite, resolver.GetRecordCount() == 4);
+    NL_TEST_ASSERT(inSuite, nodeData.resolutionData.numIPs == 2);
+    NL_TEST_ASSERT(inSuite,
+                   (nodeData.resolutionData.ipAddress[0] == MakeAddress("fe80::2") &&
+                    nodeData.resolutionData.ipAddress[1] == MakeAddress("fe80::3")) ||
+                       (nodeData.resolutionData.ipAddress[0] == MakeAddress("fe80::3") &&
+                        nodeData.resolutionData.ipAddress[1] == MakeAddress("fe80::2")));
+}
+
+void TestEviction(nlTestSuite * inSuite, void * inContext)
+{
+    RecordCache<4> cache;
+
+    AddTestNode(cache, kStartTime);
+    NL_TEST_ASSERT(inSuite, BuildResponse(cache, kStartTime) == CHIP_NO_ERROR);
+
+    // Records that expire first make room for the others
+    {
+        TestPacket packet;
+        packet.Add(SrvResourceRecord(kOtherOperationalName.Full(), kOtherHostName.Full(), 5540).SetTtl(4500))
+            .Add(IPResourceRecord(kOtherHostName.Full(), MakeAddress("fe80::1")).SetTtl(4500));
+        cache.AddRecords(Inet::InterfaceId::Null(), packet.Range(), kStartTime);
+    }
+
+    NL_TEST_ASSERT(inSuite, BuildResponse(cache, kStartTime) == CHIP_ERROR_NOT_FOUND);
+    NL_TEST_ASSERT(inSuite, cache.GetStatistics().evictions == 1);
+
+    uint8_t buffer[512];
+    Encoding::BigEndian::BufferWriter writer(buffer, sizeof(buffer));
+    Inet::InterfaceId interface;
+    NL_TEST_ASSERT(inSuite, cache.BuildResponse(kOtherOperationalName.Full(), kStartTime, writer, interface) == CHIP_NO_ERROR);
+}
+
+const nlTest sTests[] = {
+    NL_TEST_DEF("CachedResolve", TestCachedResolve),     //
+    NL_TEST_DEF("RequiresAddress", TestRequiresAddress), //
+    NL_TEST_DEF("IgnoresQueries", TestIgnoresQueries),   //
+    NL_TEST_DEF("Expiry", TestExpiry),                   //
+    NL_TEST_DEF("Goodbye", TestGoodbye),                 //
+    NL_TEST_DEF("CacheFlush", TestCacheFlush),           //
+    NL_TEST_DEF("Eviction", TestEviction),               //
+    NL_TEST_SENTINEL()                                   //
+};
+
+} // namespace
+
+int TestChipDnsSdRecordCache()
+{
+    nlTestSuite theSuite = { "RecordCache", &sTests[0], nullptr, nullptr };
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestChipDnsSdRecordCache)
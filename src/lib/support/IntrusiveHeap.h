@@ -0,0 +1,205 @@
+/*
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <lib/core/CHIPError.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+
+namespace chip {
+
+/**
+ * A d-ary min-heap of pointers to objects that are owned elsewhere (typically by an ObjectPool).
+ *
+ * Every object records its own position in the heap, so that an arbitrary object can be removed, or
+ * re-positioned after its key changed, in O(log n) without searching for it.
+ *
+ * Traits must provide:
+ *
+ *      // Strict weak ordering; the object for which no other is Less is at the top.
+ *      static bool Less(const T & a, const T & b);
+ *      // Storage for the position of the object in the heap. Objects that were never inserted
+ *      // should have it initialized (e.g. to SIZE_MAX) so that Contains() is well defined.
+ *      static size_t & Index(T & object);
+ *
+ * The pointer array grows on demand from the platform heap. Use Reserve() up front where the number of
+ * objects is bounded, so that Insert() never allocates afterwards.
+ */
+template <typename T, typename Traits, size_t kArity = 2>
+class IntrusiveHeap
+{
+public:
+    static_assert(kArity >= 2, "A heap needs at least two children per node");
+
+    IntrusiveHeap() = default;
+    ~IntrusiveHeap() { Platform::MemoryFree(mItems); }
+
+    IntrusiveHeap(const IntrusiveHeap &)             = delete;
+    IntrusiveHeap & operator=(const IntrusiveHeap &) = delete;
+
+    bool Empty() const { return mSize == 0; }
+    size_t Size() const { return mSize; }
+
+    /**
+     * Return the least object, or nullptr if the heap is empty.
+     */
+    T * Top() const { return mSize == 0 ? nullptr : mItems[0]; }
+
+    /**
+     * Test whether the given object is currently in this heap.
+     */
+    bool Contains(T & object) const
+    {
+        size_t index = Traits::Index(object);
+        return index < mSize && mItems[index] == &object;
+    }
+
+    /**
+     * Make sure at least @a capacity objects can be inserted without allocating.
+     */
+    CHIP_ERROR Reserve(size_t capacity)
+    {
+        VerifyOrReturnError(capacity > mCapacity, CHIP_NO_ERROR);
+        VerifyOrReturnError(capacity <= SIZE_MAX / sizeof(T *), CHIP_ERROR_NO_MEMORY);
+        T ** items = static_cast<T **>(Platform::MemoryRealloc(mItems, capacity * sizeof(T *)));
+        VerifyOrReturnError(items != nullptr, CHIP_ERROR_NO_MEMORY);
+        mItems    = items;
+        mCapacity = capacity;
+        return CHIP_NO_ERROR;
+    }
+
+    /**
+     * Add an object that is not already in the heap.
+     */
+    CHIP_ERROR Insert(T & object)
+    {
+        if (mSize == mCapacity)
+        {
+            ReturnErrorOnFailure(Reserve(mCapacity == 0 ? kInitialCapacity : mCapacity * 2));
+        }
+        Place(mSize++, &object);
+        SiftUp(Traits::Index(object));
+        return CHIP_NO_ERROR;
+    }
+
+    /**
+     * Remove an object from the heap. It is not an error for the object not to be present.
+     */
+    void Remove(T & object)
+    {
+        VerifyOrReturn(Contains(object));
+        size_t index = Traits::Index(object);
+        T * last     = mItems[--mSize];
+        if (last != &object)
+        {
+            Place(index, last);
+            Update(*last);
+        }
+    }
+
+    /**
+     * Restore the heap order after the key of an object in the heap changed.
+     */
+    void Update(T & object)
+    {
+        size_t index = Traits::Index(object);
+        SiftUp(index);
+        if (Traits::Index(object) == index)
+        {
+            SiftDown(index);
+        }
+    }
+
+    /**
+     * Remove all objects. Storage is kept for re-use.
+     */
+    void Clear() { mSize = 0; }
+
+    /**
+     * Remove all objects and free the storage.
+     */
+    void Reset()
+    {
+        Platform::MemoryFree(mItems);
+        mItems    = nullptr;
+        mSize     = 0;
+        mCapacity = 0;
+    }
+
+private:
+    static constexpr size_t kInitialCapacity = 8;
+
+    void Place(size_t index, T * object)
+    {
+        mItems[index]          = object;
+        Traits::Index(*object) = index;
+    }
+
+    void SiftUp(size_t index)
+    {
+        T * object = mItems[index];
+        while (index > 0)
+        {
+            size_t parent = (index - 1) / kArity;
+            if (!Traits::Less(*object, *mItems[parent]))
+            {
+                break;
+            }
+            Place(index, mItems[parent]);
+            index = parent;
+        }
+        Place(index, object);
+    }
+
+    void SiftDown(size_t index)
+    {
+        T * object = mItems[index];
+        for (;;)
+        {
+            size_t first = index * kArity + 1;
+            if (first >= mSize)
+            {
+                break;
+            }
+            size_t last  = (first + kArity < mSize) ? first + kArity : mSize;
+            size_t least = first;
+            for (size_t child = first + 1; child < last; child++)
+            {
+                if (Traits::Less(*mItems[child], *mItems[least]))
+                {
+                    least = child;
+                }
+            }
+            if (!Traits::Less(*mItems[least], *object))
+            {
+                break;
+            }
+            Place(index, mItems[least]);
+            index = least;
+        }
+        Place(index, object);
+    }
+
+    T ** mItems      = nullptr;
+    size_t mSize     = 0;
+    size_t mCapacity = 0;
+};
+
+} // namespace chip
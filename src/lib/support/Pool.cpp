@@ -20,6 +20,8 @@
 #include <lib/support/CodeUtils.h>
 #include <lib/support/Pool.h>
 
+#include <string.h>
+
 namespace chip {
 
 #if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
@@ -179,6 +181,170 @@ Loop HeapObjectList::ForEachNode(void * context, Lambda lambda)
     return result;
 }
 
+namespace {
+
+constexpr size_t AlignUp(size_t value, size_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+HeapSlabList::HeapSlabList(size_t elementSize, size_t elementAlignment, size_t slabCapacity) :
+    mElementSize(elementSize), mSlabCapacity(slabCapacity), mUsageWords((slabCapacity + kBitChunkSize - 1) / kBitChunkSize),
+    mElementsOffset(AlignUp(sizeof(HeapSlab) + mUsageWords * sizeof(tBitChunkType), elementAlignment))
+{}
+
+HeapSlabList::~HeapSlabList()
+{
+    // Slabs that still hold objects are leaked along with them.
+    HeapSlab * slab = mSlabs;
+    while (slab != nullptr)
+    {
+        HeapSlab * next = slab->mNext;
+        if (slab->mAllocated == 0)
+        {
+            Platform::MemoryFree(slab);
+        }
+        slab = next;
+    }
+}
+
+void * HeapSlabList::Allocate()
+{
+    HeapSlab ** link = &mSlabs;
+    for (; *link != nullptr; link = &(*link)->mNext)
+    {
+        if ((*link)->mAllocated < mSlabCapacity)
+        {
+            return AllocateFrom(*link);
+        }
+    }
+
+    HeapSlab * slab = static_cast<HeapSlab *>(Platform::MemoryAlloc(mElementsOffset + mSlabCapacity * mElementSize));
+    VerifyOrReturnValue(slab != nullptr, nullptr);
+    slab->mNext      = nullptr;
+    slab->mAllocated = 0;
+    memset(Usage(slab), 0, mUsageWords * sizeof(tBitChunkType));
+    *link = slab;
+    return AllocateFrom(slab);
+}
+
+void * HeapSlabList::AllocateFrom(HeapSlab * slab)
+{
+    tBitChunkType * usage = Usage(slab);
+    for (size_t word = 0; word < mUsageWords; ++word)
+    {
+        if (usage[word] == std::numeric_limits<tBitChunkType>::max())
+        {
+            continue;
+        }
+        for (size_t offset = 0; offset < kBitChunkSize && offset + word * kBitChunkSize < mSlabCapacity; ++offset)
+        {
+            if ((usage[word] & (kBit1 << offset)) == 0)
+            {
+                usage[word] |= (kBit1 << offset);
+                ++slab->mAllocated;
+                return At(slab, word * kBitChunkSize + offset);
+            }
+        }
+    }
+    // The caller only picks slabs that are not full.
+    chipDie();
+    return nullptr;
+}
+
+HeapSlab * HeapSlabList::FindSlab(void * element) const
+{
+    for (HeapSlab * slab = mSlabs; slab != nullptr; slab = slab->mNext)
+    {
+        uint8_t * elements = Elements(slab);
+        uint8_t * target   = static_cast<uint8_t *>(element);
+        if (target >= elements && target < elements + mSlabCapacity * mElementSize)
+        {
+            return slab;
+        }
+    }
+    return nullptr;
+}
+
+void HeapSlabList::Deallocate(HeapSlab * slab, void * element)
+{
+    auto diff = static_cast<size_t>(static_cast<uint8_t *>(element) - Elements(slab));
+    VerifyOrDie(diff % mElementSize == 0);
+    size_t index  = diff / mElementSize;
+    size_t word   = index / kBitChunkSize;
+    size_t offset = index - (word * kBitChunkSize);
+
+    tBitChunkType * usage = Usage(slab);
+    VerifyOrDie((usage[word] & (kBit1 << offset)) != 0); // assert fail when free an unused slot
+    usage[word] &= ~(kBit1 << offset);
+
+    if (--slab->mAllocated == 0 && slab != mSlabs)
+    {
+        // The slab needs to be freed immediately if we are not in the middle of iteration.
+        // Otherwise it is deferred until all iteration on this list completes and it's safe to free slabs.
+        if (mIterationDepth == 0)
+        {
+            FreeEmptySlabs();
+        }
+        else
+        {
+            mHaveDeferredSlabRemovals = true;
+        }
+    }
+}
+
+void HeapSlabList::FreeEmptySlabs()
+{
+    // The first slab is kept, so that a pool going back and forth between zero and one object does not hit the heap.
+    HeapSlab * previous = mSlabs;
+    while (previous != nullptr && previous->mNext != nullptr)
+    {
+        HeapSlab * slab = previous->mNext;
+        if (slab->mAllocated == 0)
+        {
+            previous->mNext = slab->mNext;
+            Platform::MemoryFree(slab);
+        }
+        else
+        {
+            previous = slab;
+        }
+    }
+}
+
+Loop HeapSlabList::ForEachElement(void * context, Lambda lambda)
+{
+    ++mIterationDepth;
+    Loop result = Loop::Finish;
+    for (HeapSlab * slab = mSlabs; slab != nullptr && result == Loop::Finish; slab = slab->mNext)
+    {
+        tBitChunkType * usage = Usage(slab);
+        for (size_t word = 0; word < mUsageWords && result == Loop::Finish; ++word)
+        {
+            // The usage is checked again before visiting an element, as the lambda may release any object.
+            tBitChunkType pending = usage[word];
+            for (size_t offset = 0; pending != 0; ++offset, pending >>= 1)
+            {
+                if ((pending & kBit1) != 0 && (usage[word] & (kBit1 << offset)) != 0 &&
+                    lambda(context, At(slab, word * kBitChunkSize + offset)) == Loop::Break)
+                {
+                    result = Loop::Break;
+                    break;
+                }
+            }
+        }
+    }
+    --mIterationDepth;
+    if (mIterationDepth == 0 && mHaveDeferredSlabRemovals)
+    {
+        FreeEmptySlabs();
+        mHaveDeferredSlabRemovals = false;
+    }
+    return result;
+}
+
 #endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
 
 } // namespace internal
@@ -29,6 +29,7 @@
 #include <lib/support/Iterators.h>
 
 #include <atomic>
+#include <cstddef>
 #include <limits>
 #include <new>
 #include <stddef.h>
@@ -174,6 +175,59 @@ struct HeapObjectList : HeapObjectListNode
     bool mHaveDeferredNodeRemovals = false;
 };
 
+struct HeapSlab
+{
+    HeapSlab * mNext;
+    size_t mAllocated;
+    // Followed, in the same allocation, by the usage bitmap and the element storage.
+};
+
+/**
+ * A list of heap-allocated slabs, each holding the storage for a fixed number of elements and a bitmap of the ones in use.
+ *
+ * A slab is only allocated once all the others are full.  Slabs that become empty are freed, except for the first one,
+ * once no iteration is in progress.
+ */
+class HeapSlabList
+{
+public:
+    HeapSlabList(size_t elementSize, size_t elementAlignment, size_t slabCapacity);
+    ~HeapSlabList();
+
+    void * Allocate();
+    HeapSlab * FindSlab(void * element) const;
+    void Deallocate(HeapSlab * slab, void * element);
+
+    using Lambda = Loop (*)(void *, void *);
+    Loop ForEachElement(void * context, Lambda lambda);
+    Loop ForEachElement(void * context, Loop lambda(void * context, const void * object)) const
+    {
+        return const_cast<HeapSlabList *>(this)->ForEachElement(context, reinterpret_cast<Lambda>(lambda));
+    }
+
+private:
+    using tBitChunkType                         = unsigned long;
+    static constexpr const tBitChunkType kBit1  = 1; // make sure bitshifts produce the right type
+    static constexpr const size_t kBitChunkSize = std::numeric_limits<tBitChunkType>::digits;
+
+    tBitChunkType * Usage(HeapSlab * slab) const
+    {
+        return reinterpret_cast<tBitChunkType *>(reinterpret_cast<uint8_t *>(slab) + sizeof(HeapSlab));
+    }
+    uint8_t * Elements(HeapSlab * slab) const { return reinterpret_cast<uint8_t *>(slab) + mElementsOffset; }
+    void * At(HeapSlab * slab, size_t index) const { return Elements(slab) + mElementSize * index; }
+    void * AllocateFrom(HeapSlab * slab);
+    void FreeEmptySlabs();
+
+    const size_t mElementSize;
+    const size_t mSlabCapacity;
+    const size_t mUsageWords;
+    const size_t mElementsOffset;
+    HeapSlab * mSlabs              = nullptr;
+    size_t mIterationDepth         = 0;
+    bool mHaveDeferredSlabRemovals = false;
+};
+
 #endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
 
 } // namespace internal
@@ -444,6 +498,120 @@ private:
     internal::HeapObjectList mObjects;
 };
 
+/**
+ * A class template used for allocating objects from the heap, N at a time.
+ *
+ * Objects live in slabs of N, so creating or releasing one only allocates or frees memory when a slab is added or
+ * becomes empty, and iteration walks the contiguous storage of each slab.  Like HeapObjectPool, the pool is never
+ * exhausted.
+ *
+ *  @tparam     T   type to be allocated.
+ *  @tparam     N   a positive integer number of objects per slab.
+ */
+template <class T, size_t N>
+class HeapSlabObjectPool : public internal::Statistics, public internal::PoolCommon<T>, public HeapObjectPoolExitHandling
+{
+public:
+    static_assert(N > 0, "HeapSlabObjectPool needs room for at least one object per slab");
+    static_assert(alignof(T) <= alignof(std::max_align_t), "HeapSlabObjectPool cannot align T");
+
+    HeapSlabObjectPool() : mSlabs(sizeof(T), alignof(T), N) {}
+    ~HeapSlabObjectPool()
+    {
+#if __SANITIZE_ADDRESS__
+        // Free all remaining objects so that ASAN can catch specific use-after-free cases.
+        ReleaseAll();
+#else  // __SANITIZE_ADDRESS__
+        if (!sIgnoringLeaksOnExit)
+        {
+            // Verify that no live objects remain, to prevent potential use-after-free.
+            VerifyOrDie(Allocated() == 0);
+        }
+#endif // __SANITIZE_ADDRESS__
+    }
+
+    template <typename... Args>
+    T * CreateObject(Args &&... args)
+    {
+        void * element = mSlabs.Allocate();
+        if (element != nullptr)
+        {
+            IncreaseUsage();
+            return new (element) T(std::forward<Args>(args)...);
+        }
+        return nullptr;
+    }
+
+    /*
+     * This method exists purely to line up with the static allocator version.
+     * Consequently, return a nonsensically large number to normalize comparison
+     * operations that act on this value.
+     */
+    size_t Capacity() const { return SIZE_MAX; }
+
+    /*
+     * This method exists purely to line up with the static allocator version. Heap based object pool will never be exhausted.
+     */
+    bool Exhausted() const { return false; }
+
+    void ReleaseObject(T * object)
+    {
+        if (object != nullptr)
+        {
+            internal::HeapSlab * slab = mSlabs.FindSlab(object);
+            // Releasing an object that is not allocated indicates likely memory
+            // corruption; better to safe-crash than proceed at this point.
+            VerifyOrDie(slab != nullptr);
+
+            object->~T();
+            mSlabs.Deallocate(slab, object);
+            DecreaseUsage();
+        }
+    }
+
+    void ReleaseAll() { mSlabs.ForEachElement(this, ReleaseObject); }
+
+    /**
+     * @brief
+     *   Run a functor for each active object in the pool
+     *
+     *  @param     function A functor of type `Loop (*)(T*)`.
+     *                      Return Loop::Break to break the iteration.
+     *                      The only modification the functor is allowed to make
+     *                      to the pool before returning is releasing the
+     *                      object that was passed to the functor.  Any other
+     *                      desired changes need to be made after iteration
+     *                      completes.
+     *  @return    Loop     Returns Break if some call to the functor returned
+     *                      Break.  Otherwise returns Finish.
+     */
+    template <typename Function>
+    Loop ForEachActiveObject(Function && function)
+    {
+        static_assert(std::is_same<Loop, decltype(function(std::declval<T *>()))>::value,
+                      "The function must take T* and return Loop");
+        internal::LambdaProxy<T, Function> proxy(std::forward<Function>(function));
+        return mSlabs.ForEachElement(&proxy, &internal::LambdaProxy<T, Function>::Call);
+    }
+    template <typename Function>
+    Loop ForEachActiveObject(Function && function) const
+    {
+        static_assert(std::is_same<Loop, decltype(function(std::declval<const T *>()))>::value,
+                      "The function must take const T* and return Loop");
+        internal::LambdaProxy<const T, Function> proxy(std::forward<Function>(function));
+        return mSlabs.ForEachElement(&proxy, &internal::LambdaProxy<const T, Function>::ConstCall);
+    }
+
+private:
+    static Loop ReleaseObject(void * context, void * object)
+    {
+        static_cast<HeapSlabObjectPool *>(context)->ReleaseObject(static_cast<T *>(object));
+        return Loop::Continue;
+    }
+
+    internal::HeapSlabList mSlabs;
+};
+
 #endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
 
 /**
@@ -462,9 +630,20 @@ enum class ObjectPoolMem
      * For this case, the ObjectPool size parameter is ignored.
      */
     kHeap,
-    kDefault = kHeap
+    /**
+     * Allocate objects from the heap in slabs of contiguous storage, with only pool management state in the containing scope.
+     *
+     * For this case, the ObjectPool size parameter is the number of objects per slab.
+     */
+    kHeapSlab,
+    kDefault = kHeap,
+    /**
+     * Used by pools that are iterated on hot paths.
+     */
+    kDefaultIterable = kHeapSlab
 #else  // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
-    kDefault = kInline
+    kDefault         = kInline,
+    kDefaultIterable = kInline
 #endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
 };
 
@@ -481,6 +660,11 @@ template <typename T, size_t N>
 class ObjectPool<T, N, ObjectPoolMem::kHeap> : public HeapObjectPool<T>
 {
 };
+
+template <typename T, size_t N>
+class ObjectPool<T, N, ObjectPoolMem::kHeapSlab> : public HeapSlabObjectPool<T, N>
+{
+};
 #endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
 
 } // namespace chip
@@ -88,6 +88,10 @@ public:
         }
 
         CHIP_ERROR err = SyncSetKeyValueInternal(key, value, size);
+        if (err == CHIP_NO_ERROR)
+        {
+            RecordMutation();
+        }
 
         if (mLoggingLevel >= LoggingLevel::kLogMutationAndReads)
         {
@@ -108,6 +112,10 @@ public:
             ChipLogDetail(Test, "TestPersistentStorageDelegate::SyncDeleteKeyValue, Delete key '%s'", StringOrNullMarker(key));
         }
         CHIP_ERROR err = SyncDeleteKeyValueInternal(key);
+        if (err == CHIP_NO_ERROR)
+        {
+            RecordMutation();
+        }
 
         if (mLoggingLevel >= LoggingLevel::kLogMutation)
         {
@@ -126,6 +134,25 @@ public:
         return err;
     }
 
+    void BeginWriteBatch() override { mWriteBatchDepth++; }
+
+    CHIP_ERROR EndWriteBatch() override
+    {
+        VerifyOrReturnError(mWriteBatchDepth > 0, CHIP_ERROR_INCORRECT_STATE);
+        if (--mWriteBatchDepth == 0 && mHasUnflushedMutations)
+        {
+            mHasUnflushedMutations = false;
+            mNumFlushes++;
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    /**
+     * @return the number of flushes a backend would have done so far: one per successful set or delete
+     *         outside of a write batch, and one per outermost write batch that had any.
+     */
+    virtual size_t GetNumFlushes() { return mNumFlushes; }
+
     /**
      * @brief Adds a "poison key": a key that, if read/written, implies some bad
      *        behavior occurred.
@@ -271,9 +298,24 @@ protected:
         return CHIP_NO_ERROR;
     }
 
+    void RecordMutation()
+    {
+        if (mWriteBatchDepth > 0)
+        {
+            mHasUnflushedMutations = true;
+        }
+        else
+        {
+            mNumFlushes++;
+        }
+    }
+
     std::map<std::string, std::vector<uint8_t>> mStorage;
     std::set<std::string> mPoisonKeys;
-    LoggingLevel mLoggingLevel = LoggingLevel::kDisabled;
+    LoggingLevel mLoggingLevel  = LoggingLevel::kDisabled;
+    unsigned mWriteBatchDepth   = 0;
+    bool mHasUnflushedMutations = false;
+    size_t mNumFlushes          = 0;
 };
 
 } // namespace chip
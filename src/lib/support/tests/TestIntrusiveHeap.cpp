@@ -0,0 +1,197 @@
+/*
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <ctime>
+#include <set>
+#include <utility>
+
+#include <lib/support/CHIPMem.h>
+#include <lib/support/IntrusiveHeap.h>
+#include <lib/support/UnitTestRegistration.h>
+
+#include <nlunit-test.h>
+
+namespace {
+
+using namespace chip;
+
+struct HeapNode
+{
+    int mKey      = 0;
+    size_t mIndex = SIZE_MAX;
+    uintptr_t mId = 0;
+};
+
+struct HeapNodeTraits
+{
+    static bool Less(const HeapNode & a, const HeapNode & b) { return a.mKey < b.mKey; }
+    static size_t & Index(HeapNode & node) { return node.mIndex; }
+};
+
+template <size_t kArity>
+void TestIntrusiveHeapRandom(nlTestSuite * inSuite)
+{
+    IntrusiveHeap<HeapNode, HeapNodeTraits, kArity> heap;
+    HeapNode nodes[100];
+    std::multiset<std::pair<int, uintptr_t>> reference;
+
+    for (auto & n : nodes)
+    {
+        n.mId = reinterpret_cast<uintptr_t>(&n);
+    }
+
+    for (int step = 0; step < 10000; step++)
+    {
+        HeapNode & n = nodes[static_cast<size_t>(std::rand()) % ArraySize(nodes)];
+        switch (std::rand() % 4)
+        {
+        case 0: // Insert
+            if (!heap.Contains(n))
+            {
+                n.mKey = std::rand() % 1000;
+                NL_TEST_ASSERT(inSuite, heap.Insert(n) == CHIP_NO_ERROR);
+                reference.insert({ n.mKey, n.mId });
+            }
+            break;
+        case 1: // Remove
+            if (heap.Contains(n))
+            {
+                heap.Remove(n);
+                reference.erase(reference.find({ n.mKey, n.mId }));
+            }
+            break;
+        case 2: // Update
+            if (heap.Contains(n))
+            {
+                reference.erase(reference.find({ n.mKey, n.mId }));
+                n.mKey = std::rand() % 1000;
+                heap.Update(n);
+                reference.insert({ n.mKey, n.mId });
+            }
+            break;
+        case 3: // Pop
+            if (!heap.Empty())
+            {
+                HeapNode * top = heap.Top();
+                NL_TEST_ASSERT(inSuite, top->mKey == reference.begin()->first);
+                heap.Remove(*top);
+                reference.erase(reference.find({ top->mKey, top->mId }));
+            }
+            break;
+        }
+        NL_TEST_ASSERT(inSuite, heap.Size() == reference.size());
+    }
+}
+
+void TestBinaryHeapRandom(nlTestSuite * inSuite, void * inContext)
+{
+    TestIntrusiveHeapRandom<2>(inSuite);
+}
+
+void TestQuaternaryHeapRandom(nlTestSuite * inSuite, void * inContext)
+{
+    TestIntrusiveHeapRandom<4>(inSuite);
+}
+
+void TestHeapOrder(nlTestSuite * inSuite, void * inContext)
+{
+    IntrusiveHeap<HeapNode, HeapNodeTraits> heap;
+    HeapNode nodes[5];
+    const int keys[] = { 30, 10, 50, 20, 40 };
+
+    NL_TEST_ASSERT(inSuite, heap.Top() == nullptr);
+    NL_TEST_ASSERT(inSuite, heap.Reserve(ArraySize(nodes)) == CHIP_NO_ERROR);
+
+    for (size_t i = 0; i < ArraySize(nodes); i++)
+    {
+        nodes[i].mKey = keys[i];
+        NL_TEST_ASSERT(inSuite, heap.Insert(nodes[i]) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, heap.Top() == &nodes[1]);
+
+    // Removing an object that is not in the heap is allowed.
+    heap.Remove(nodes[1]);
+    heap.Remove(nodes[1]);
+    NL_TEST_ASSERT(inSuite, heap.Size() == 4);
+    NL_TEST_ASSERT(inSuite, heap.Top() == &nodes[3]);
+
+    // Moving the key of an object re-positions it.
+    nodes[2].mKey = 5;
+    heap.Update(nodes[2]);
+    NL_TEST_ASSERT(inSuite, heap.Top() == &nodes[2]);
+
+    int previous = INT32_MIN;
+    while (!heap.Empty())
+    {
+        HeapNode * top = heap.Top();
+        NL_TEST_ASSERT(inSuite, top->mKey >= previous);
+        previous = top->mKey;
+        heap.Remove(*top);
+    }
+
+    heap.Clear();
+    NL_TEST_ASSERT(inSuite, heap.Empty());
+
+    // The heap is usable again after its storage is freed.
+    NL_TEST_ASSERT(inSuite, heap.Insert(nodes[0]) == CHIP_NO_ERROR);
+    heap.Reset();
+    NL_TEST_ASSERT(inSuite, heap.Empty());
+    NL_TEST_ASSERT(inSuite, !heap.Contains(nodes[0]));
+    NL_TEST_ASSERT(inSuite, heap.Insert(nodes[4]) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, heap.Top() == &nodes[4]);
+    heap.Reset();
+}
+
+int Setup(void * inContext)
+{
+    VerifyOrReturnError(chip::Platform::MemoryInit() == CHIP_NO_ERROR, FAILURE);
+    return SUCCESS;
+}
+
+int Teardown(void * inContext)
+{
+    chip::Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+} // namespace
+
+#define NL_TEST_DEF_FN(fn) NL_TEST_DEF("Test " #fn, fn)
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF_FN(TestBinaryHeapRandom),     //
+    NL_TEST_DEF_FN(TestQuaternaryHeapRandom), //
+    NL_TEST_DEF_FN(TestHeapOrder),            //
+    NL_TEST_SENTINEL(),                       //
+};
+
+int TestIntrusiveHeap()
+{
+    nlTestSuite theSuite = { "CHIP IntrusiveHeap tests", &sTests[0], Setup, Teardown };
+
+    unsigned seed = static_cast<unsigned>(std::time(nullptr));
+    printf("Running " __FILE__ " using seed %d", seed);
+    std::srand(seed);
+
+    // Run test suite against one context.
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestIntrusiveHeap);
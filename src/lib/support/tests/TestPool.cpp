@@ -70,6 +70,11 @@ void TestReleaseNullDynamic(nlTestSuite * inSuite, void * inContext)
 {
     TestReleaseNull<uint32_t, 10, ObjectPoolMem::kHeap>(inSuite, inContext);
 }
+
+void TestReleaseNullSlab(nlTestSuite * inSuite, void * inContext)
+{
+    TestReleaseNull<uint32_t, 10, ObjectPoolMem::kHeapSlab>(inSuite, inContext);
+}
 #endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
 
 template <typename T, size_t N, ObjectPoolMem P>
@@ -146,6 +151,11 @@ void TestCreateReleaseObjectDynamic(nlTestSuite * inSuite, void * inContext)
 {
     TestCreateReleaseObject<uint32_t, 100, ObjectPoolMem::kHeap>(inSuite, inContext);
 }
+
+void TestCreateReleaseObjectSlab(nlTestSuite * inSuite, void * inContext)
+{
+    TestCreateReleaseObject<uint32_t, 100, ObjectPoolMem::kHeapSlab>(inSuite, inContext);
+}
 #endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
 
 template <ObjectPoolMem P>
@@ -209,6 +219,11 @@ void TestCreateReleaseStructDynamic(nlTestSuite * inSuite, void * inContext)
 {
     TestCreateReleaseStruct<ObjectPoolMem::kHeap>(inSuite, inContext);
 }
+
+void TestCreateReleaseStructSlab(nlTestSuite * inSuite, void * inContext)
+{
+    TestCreateReleaseStruct<ObjectPoolMem::kHeapSlab>(inSuite, inContext);
+}
 #endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
 
 template <ObjectPoolMem P>
@@ -347,6 +362,11 @@ void TestForEachActiveObjectDynamic(nlTestSuite * inSuite, void * inContext)
 {
     TestForEachActiveObject<ObjectPoolMem::kHeap>(inSuite, inContext);
 }
+
+void TestForEachActiveObjectSlab(nlTestSuite * inSuite, void * inContext)
+{
+    TestForEachActiveObject<ObjectPoolMem::kHeapSlab>(inSuite, inContext);
+}
 #endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
 
 template <ObjectPoolMem P>
@@ -410,6 +430,102 @@ void TestPoolInterfaceDynamic(nlTestSuite * inSuite, void * inContext)
 {
     TestPoolInterface<ObjectPoolMem::kHeap>(inSuite, inContext);
 }
+
+void TestPoolInterfaceSlab(nlTestSuite * inSuite, void * inContext)
+{
+    TestPoolInterface<ObjectPoolMem::kHeapSlab>(inSuite, inContext);
+}
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+template <size_t N, ObjectPoolMem P>
+void TestPoolStress(nlTestSuite * inSuite, void * inContext)
+{
+    struct S
+    {
+        S(size_t id) : mId(id) {}
+        size_t mId;
+    };
+
+    constexpr size_t kObjects = 1000;
+    constexpr size_t kSteps   = 20000;
+    S * objs[kObjects]        = {};
+    size_t live               = 0;
+    uint32_t random           = 1;
+
+    ObjectPool<S, N, P> pool;
+
+    // Create and release objects in a pseudo-random order, so that the pool fragments.
+    for (size_t step = 0; step < kSteps; ++step)
+    {
+        random       = random * 1103515245 + 12345;
+        size_t index = (random >> 8) % kObjects;
+        if (objs[index] == nullptr)
+        {
+            objs[index] = pool.CreateObject(index);
+            NL_TEST_ASSERT(inSuite, objs[index] != nullptr);
+            ++live;
+        }
+        else
+        {
+            pool.ReleaseObject(objs[index]);
+            objs[index] = nullptr;
+            --live;
+        }
+    }
+    NL_TEST_ASSERT(inSuite, pool.Allocated() == live);
+
+    // Walk the pool as the hot paths do.
+    size_t count = 0;
+    for (size_t pass = 0; pass < 100; ++pass)
+    {
+        pool.ForEachActiveObject([&](S * object) {
+            NL_TEST_ASSERT(inSuite, objs[object->mId] == object);
+            ++count;
+            return Loop::Continue;
+        });
+    }
+    NL_TEST_ASSERT(inSuite, count == live * 100);
+
+    // Release some of the visited objects along the way; every object is still visited exactly once.
+    count = 0;
+    pool.ForEachActiveObject([&](S * object) {
+        NL_TEST_ASSERT(inSuite, objs[object->mId] == object);
+        ++count;
+        if (object->mId % 2)
+        {
+            objs[object->mId] = nullptr;
+            pool.ReleaseObject(object);
+        }
+        return Loop::Continue;
+    });
+    NL_TEST_ASSERT(inSuite, count == live);
+    live = 0;
+    for (auto & obj : objs)
+    {
+        live += (obj != nullptr);
+    }
+    NL_TEST_ASSERT(inSuite, GetNumObjectsInUse(pool) == live);
+    NL_TEST_ASSERT(inSuite, pool.Allocated() == live);
+
+    for (auto & obj : objs)
+    {
+        pool.ReleaseObject(obj);
+        obj = nullptr;
+    }
+    NL_TEST_ASSERT(inSuite, GetNumObjectsInUse(pool) == 0);
+    NL_TEST_ASSERT(inSuite, pool.Allocated() == 0);
+}
+
+void TestPoolStressDynamic(nlTestSuite * inSuite, void * inContext)
+{
+    TestPoolStress<16, ObjectPoolMem::kHeap>(inSuite, inContext);
+}
+
+void TestPoolStressSlab(nlTestSuite * inSuite, void * inContext)
+{
+    TestPoolStress<16, ObjectPoolMem::kHeapSlab>(inSuite, inContext);
+}
 #endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
 
 int Setup(void * inContext)
@@ -442,6 +558,13 @@ static const nlTest sTests[] = {
     NL_TEST_DEF_FN(TestCreateReleaseStructDynamic),
     NL_TEST_DEF_FN(TestForEachActiveObjectDynamic),
     NL_TEST_DEF_FN(TestPoolInterfaceDynamic),
+    NL_TEST_DEF_FN(TestPoolStressDynamic),
+    NL_TEST_DEF_FN(TestReleaseNullSlab),
+    NL_TEST_DEF_FN(TestCreateReleaseObjectSlab),
+    NL_TEST_DEF_FN(TestCreateReleaseStructSlab),
+    NL_TEST_DEF_FN(TestForEachActiveObjectSlab),
+    NL_TEST_DEF_FN(TestPoolInterfaceSlab),
+    NL_TEST_DEF_FN(TestPoolStressSlab),
 #endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
     NL_TEST_SENTINEL()
     // clang-format on
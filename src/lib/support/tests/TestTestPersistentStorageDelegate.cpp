@@ -341,9 +341,55 @@ void TestClearStorage(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, size == sizeof(buf));
 }
 
+void TestWriteBatch(nlTestSuite * inSuite, void * inContext)
+{
+    TestPersistentStorageDelegate storage;
+    static const char kValue[] = "abcd";
+
+    // Outside of a batch, every mutation is flushed on its own
+    NL_TEST_ASSERT(inSuite, storage.SyncSetKeyValue("key1", kValue, static_cast<uint16_t>(sizeof(kValue))) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.GetNumFlushes() == 1);
+
+    {
+        PersistentStorageWriteBatch outer(&storage);
+        NL_TEST_ASSERT(inSuite, storage.SyncSetKeyValue("key2", kValue, static_cast<uint16_t>(sizeof(kValue))) == CHIP_NO_ERROR);
+
+        {
+            PersistentStorageWriteBatch inner(&storage);
+            NL_TEST_ASSERT(inSuite, storage.SyncDeleteKeyValue("key1") == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(inSuite, inner.End() == CHIP_NO_ERROR);
+        }
+
+        // Only ending the outermost batch flushes, and writes are visible before that
+        NL_TEST_ASSERT(inSuite, storage.GetNumFlushes() == 1);
+        NL_TEST_ASSERT(inSuite, !storage.SyncDoesKeyExist("key1"));
+        NL_TEST_ASSERT(inSuite, storage.SyncDoesKeyExist("key2"));
+        NL_TEST_ASSERT(inSuite, outer.End() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.GetNumFlushes() == 2);
+
+        // Ending twice does nothing
+        NL_TEST_ASSERT(inSuite, outer.End() == CHIP_NO_ERROR);
+    }
+
+    // A batch without mutations does not flush, and one going out of scope still does
+    {
+        PersistentStorageWriteBatch empty(&storage);
+    }
+    NL_TEST_ASSERT(inSuite, storage.GetNumFlushes() == 2);
+    {
+        PersistentStorageWriteBatch aborted(&storage);
+        NL_TEST_ASSERT(inSuite, storage.SyncDeleteKeyValue("key2") == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, storage.GetNumFlushes() == 3);
+    NL_TEST_ASSERT(inSuite, storage.GetNumKeys() == 0);
+
+    // Unbalanced end
+    NL_TEST_ASSERT(inSuite, storage.EndWriteBatch() == CHIP_ERROR_INCORRECT_STATE);
+}
+
 const nlTest sTests[] = { NL_TEST_DEF("Test basic API", TestBasicApi),
                           NL_TEST_DEF("Test ClearStorage method of TestPersistentStorageDelegate", TestClearStorage),
-                          NL_TEST_SENTINEL() };
+                          NL_TEST_DEF("Test write batches", TestWriteBatch), NL_TEST_SENTINEL() };
 
 } // namespace
 
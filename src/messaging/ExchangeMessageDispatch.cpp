@@ -102,7 +102,7 @@ CHIP_ERROR ExchangeMessageDispatch::PrepareAndSendNonMRPMessage(SessionManager *
     payloadHeader.SetNeedsAck(false);
     EncryptedPacketBufferHandle preparedMessage;
     ReturnErrorOnFailure(sessionManager->PrepareMessage(session, payloadHeader, std::move(message), preparedMessage));
-    ReturnErrorOnFailure(sessionManager->SendPreparedMessage(session, preparedMessage));
+    ReturnErrorOnFailure(sessionManager->SendPreparedMessage(session, std::move(preparedMessage)));
 
     return CHIP_NO_ERROR;
 }
@@ -228,7 +228,7 @@ private:
 
     FabricIndex mFabricIndex = 0;
 
-    ObjectPool<ExchangeContext, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS> mContextPool;
+    ExchangeContextPool mContextPool;
 
     SessionManager * mSessionManager;
     ReliableMessageMgr mReliableMessageMgr;
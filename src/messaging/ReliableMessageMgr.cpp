@@ -35,6 +35,7 @@
 #include <messaging/ReliableMessageContext.h>
 #include <messaging/ReliableMessageMgr.h>
 #include <platform/ConnectivityManager.h>
+#include <system/SystemStats.h>
 
 #if CHIP_CONFIG_ENABLE_ICD_SERVER
 #include <app/icd/ICDConfigurationData.h> // nogncheck
@@ -50,29 +51,35 @@ ReliableMessageMgr::RetransTableEntry::RetransTableEntry(ReliableMessageContext
     ec(*rc->GetExchangeContext()), nextRetransTime(0), sendCount(0)
 {
     ec->SetWaitingForAck(true);
+    SYSTEM_STATS_INCREMENT(chip::System::Stats::kExchangeMgr_NumRetransEntries);
 }
 
 ReliableMessageMgr::RetransTableEntry::~RetransTableEntry()
 {
     ec->SetWaitingForAck(false);
+    SYSTEM_STATS_DECREMENT(chip::System::Stats::kExchangeMgr_NumRetransEntries);
 }
 
-ReliableMessageMgr::ReliableMessageMgr(ObjectPool<ExchangeContext, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS> & contextPool) :
-    mContextPool(contextPool), mSystemLayer(nullptr)
-{}
+ReliableMessageMgr::ReliableMessageMgr(ExchangeContextPool & contextPool) : mContextPool(contextPool), mSystemLayer(nullptr) {}
 
 ReliableMessageMgr::~ReliableMessageMgr() {}
 
 void ReliableMessageMgr::Init(chip::System::Layer * systemLayer)
 {
-    mSystemLayer = systemLayer;
+    mSystemLayer  = systemLayer;
+    mRetransStats = RetransStats();
+
+    // The table is bounded, so size the schedule up front; if this fails it still grows on demand.
+    (void) mRetransSchedule.Reserve(CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE);
 }
 
 void ReliableMessageMgr::Shutdown()
 {
     StopTimer();
 
-    // Clear the retransmit table
+    // Clear the retransmit table, and free the schedule storage so that a later Init starts afresh
+    mRetransSchedule.Reset();
+    mNextScheduleSequence = 0;
     mRetransTable.ForEachActiveObject([&](auto * entry) {
         mRetransTable.ReleaseObject(entry);
         return Loop::Continue;
@@ -118,11 +125,16 @@ void ReliableMessageMgr::ExecuteActions()
         }
     });
 
-    // Retransmit / cancel anything in the retrans table whose retrans timeout has expired
-    mRetransTable.ForEachActiveObject([&](auto * entry) {
-        if (entry->nextRetransTime > now)
-            return Loop::Continue;
-
+    // Retransmit / cancel anything in the retrans table whose retrans timeout has expired.  Entries are
+    // taken in deadline order from the schedule, which is re-read after each one because sending can
+    // clear arbitrary entries.  An entry that gets rescheduled during this pass is never due before
+    // the entries it was due with, so stopping at the first one scheduled after we started makes sure
+    // every entry is handled at most once per pass, even with a zero backoff.
+    const uint64_t passSequence = mNextScheduleSequence;
+    RetransTableEntry * entry;
+    while ((entry = mRetransSchedule.Top()) != nullptr && entry->nextRetransTime <= now &&
+           entry->scheduleSequence < passSequence)
+    {
         VerifyOrDie(!entry->retainedBuf.IsNull());
 
         uint8_t sendCount = entry->sendCount;
@@ -157,12 +169,14 @@ void ReliableMessageMgr::ExecuteActions()
             }
 
             // Do not StartTimer, we will schedule the timer at the end of the timer handler.
-            mRetransTable.ReleaseObject(entry);
+            ReleaseRetransEntry(*entry);
+            mRetransStats.timeouts++;
 
-            return Loop::Continue;
+            continue;
         }
 
         entry->sendCount++;
+        mRetransStats.retransmits++;
         ChipLogProgress(ExchangeManager,
                         "Retransmitting MessageCounter:" ChipLogFormatMessageCounter " on exchange " ChipLogFormatExchange
                         " Send Cnt %d",
@@ -170,9 +184,7 @@ void ReliableMessageMgr::ExecuteActions()
 
         CalculateNextRetransTime(*entry);
         SendFromRetransTable(entry);
-
-        return Loop::Continue;
-    });
+    }
 
     TicklessDebugDumpRetransTable("ReliableMessageMgr::ExecuteActions Dumping mRetransTable entries after processing");
 }
@@ -205,7 +217,15 @@ CHIP_ERROR ReliableMessageMgr::AddToRetransTable(ReliableMessageContext * rc, Re
         return CHIP_ERROR_RETRANS_TABLE_FULL;
     }
 
-    return CHIP_NO_ERROR;
+    (*rEntry)->scheduleSequence = mNextScheduleSequence++;
+    CHIP_ERROR err              = mRetransSchedule.Insert(**rEntry);
+    if (err != CHIP_NO_ERROR)
+    {
+        mRetransTable.ReleaseObject(*rEntry);
+        *rEntry = nullptr;
+    }
+
+    return err;
 }
 
 System::Clock::Timestamp ReliableMessageMgr::GetBackoff(System::Clock::Timestamp baseInterval, uint8_t sendCount,
@@ -363,7 +383,7 @@ void ReliableMessageMgr::ClearRetransTable(ReliableMessageContext * rc)
 
 void ReliableMessageMgr::ClearRetransTable(RetransTableEntry & entry)
 {
-    mRetransTable.ReleaseObject(&entry);
+    ReleaseRetransEntry(entry);
     // Expire any virtual ticks that have expired so all wakeup sources reflect the current time
     StartTimer();
 }
@@ -381,13 +401,11 @@ void ReliableMessageMgr::StartTimer()
     });
 
     // When do we need to next wake up for ReliableMessageProtocol retransmit?
-    mRetransTable.ForEachActiveObject([&](auto * entry) {
-        if (entry->nextRetransTime < nextWakeTime)
-        {
-            nextWakeTime = entry->nextRetransTime;
-        }
-        return Loop::Continue;
-    });
+    RetransTableEntry * nextRetrans = mRetransSchedule.Top();
+    if (nextRetrans != nullptr && nextRetrans->nextRetransTime < nextWakeTime)
+    {
+        nextWakeTime = nextRetrans->nextRetransTime;
+    }
 
     StopTimer();
 
@@ -471,6 +489,14 @@ void ReliableMessageMgr::CalculateNextRetransTime(RetransTableEntry & entry)
 
     System::Clock::Timestamp backoff = ReliableMessageMgr::GetBackoff(baseTimeout, entry.sendCount);
     entry.nextRetransTime            = System::SystemClock().GetMonotonicTimestamp() + backoff;
+    entry.scheduleSequence           = mNextScheduleSequence++;
+    mRetransSchedule.Update(entry);
+}
+
+void ReliableMessageMgr::ReleaseRetransEntry(RetransTableEntry & entry)
+{
+    mRetransSchedule.Remove(entry);
+    mRetransTable.ReleaseObject(&entry);
 }
 
 #if CHIP_CONFIG_TEST
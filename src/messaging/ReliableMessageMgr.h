@@ -28,6 +28,7 @@
 
 #include <lib/core/CHIPError.h>
 #include <lib/support/BitFlags.h>
+#include <lib/support/IntrusiveHeap.h>
 #include <lib/support/Pool.h>
 #include <messaging/ExchangeContext.h>
 #include <messaging/ReliableMessageProtocolConfig.h>
@@ -42,6 +43,9 @@ namespace Messaging {
 enum class SendMessageFlags : uint16_t;
 class ReliableMessageContext;
 
+// Exchanges are walked on every retransmission tick and session event.
+using ExchangeContextPool = ObjectPool<ExchangeContext, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS, ObjectPoolMem::kDefaultIterable>;
+
 class ReliableMessageMgr
 {
 public:
@@ -65,9 +69,20 @@ public:
         System::Clock::Timestamp nextRetransTime; /**< A counter representing the next retransmission time for the message. */
         uint8_t sendCount;                        /**< The number of times we have tried to send this entry,
                                                        including both successfully and failure send. */
+        uint64_t scheduleSequence = 0;            /**< Order in which nextRetransTime was set, to break ties. */
+        size_t scheduleIndex      = SIZE_MAX;     /**< Position of this entry in the retransmission schedule. */
+    };
+
+    /**
+     *  Cumulative counters for retransmission activity since Init().
+     */
+    struct RetransStats
+    {
+        uint32_t retransmits = 0; /**< Number of messages re-sent from the retransmission table. */
+        uint32_t timeouts    = 0; /**< Number of messages dropped after exhausting their retransmissions. */
     };
 
-    ReliableMessageMgr(ObjectPool<ExchangeContext, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS> & contextPool);
+    ReliableMessageMgr(ExchangeContextPool & contextPool);
     ~ReliableMessageMgr();
 
     void Init(chip::System::Layer * systemLayer);
@@ -191,9 +206,12 @@ public:
      */
     static CHIP_ERROR MapSendError(CHIP_ERROR error, uint16_t exchangeId, bool isInitiator);
 
+    const RetransStats & GetRetransStats() const { return mRetransStats; }
+
 #if CHIP_CONFIG_TEST
     // Functions for testing
     int TestGetCountRetransTable();
+    size_t TestGetRetransScheduleSize() const { return mRetransSchedule.Size(); }
 
     // Enumerate the retransmission table.  Clearing an entry while enumerating
     // that entry is allowed.  F must take a RetransTableEntry as an argument
@@ -214,7 +232,24 @@ private:
      */
     void CalculateNextRetransTime(RetransTableEntry & entry);
 
-    ObjectPool<ExchangeContext, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS> & mContextPool;
+    /**
+     * Remove an entry from the retransmission schedule and return it to the pool, without touching the timer.
+     */
+    void ReleaseRetransEntry(RetransTableEntry & entry);
+
+    // Entries are ordered by next retransmission time; among entries due at the same time, the one scheduled
+    // first comes first.
+    struct RetransScheduleTraits
+    {
+        static bool Less(const RetransTableEntry & a, const RetransTableEntry & b)
+        {
+            return a.nextRetransTime < b.nextRetransTime ||
+                (a.nextRetransTime == b.nextRetransTime && a.scheduleSequence < b.scheduleSequence);
+        }
+        static size_t & Index(RetransTableEntry & entry) { return entry.scheduleIndex; }
+    };
+
+    ExchangeContextPool & mContextPool;
     chip::System::Layer * mSystemLayer;
 
     /* Placeholder function to run a function for all exchanges */
@@ -232,6 +267,13 @@ private:
     // ReliableMessageProtocol Global tables for timer context
     ObjectPool<RetransTableEntry, CHIP_CONFIG_RMP_RETRANS_TABLE_SIZE> mRetransTable;
 
+    // Every entry of mRetransTable, keyed by nextRetransTime, so that finding due entries and the next
+    // wakeup does not need to walk the whole table.
+    IntrusiveHeap<RetransTableEntry, RetransScheduleTraits> mRetransSchedule;
+    uint64_t mNextScheduleSequence = 0;
+
+    RetransStats mRetransStats;
+
     SessionUpdateDelegate * mSessionUpdateDelegate = nullptr;
 };
 
@@ -317,6 +317,7 @@ class TestReliableMessageProtocol
 {
 public:
     static void CheckAddClearRetrans(nlTestSuite * inSuite, void * inContext);
+    static void CheckShutdownAndReinit(nlTestSuite * inSuite, void * inContext);
     static void CheckResendApplicationMessage(nlTestSuite * inSuite, void * inContext);
     static void CheckCloseExchangeAndResendApplicationMessage(nlTestSuite * inSuite, void * inContext);
     static void CheckFailedMessageRetainOnSend(nlTestSuite * inSuite, void * inContext);
@@ -362,6 +363,45 @@ void TestReliableMessageProtocol::CheckAddClearRetrans(nlTestSuite * inSuite, vo
     exchange->Close();
 }
 
+void TestReliableMessageProtocol::CheckShutdownAndReinit(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    MockAppDelegate mockAppDelegate(ctx);
+    ExchangeContext * exchange = ctx.NewExchangeToAlice(&mockAppDelegate);
+    NL_TEST_ASSERT(inSuite, exchange != nullptr);
+
+    ReliableMessageMgr * rm     = ctx.GetExchangeManager().GetReliableMessageMgr();
+    ReliableMessageContext * rc = exchange->GetReliableMessageContext();
+    NL_TEST_ASSERT(inSuite, rm != nullptr);
+    NL_TEST_ASSERT(inSuite, rc != nullptr);
+
+    ReliableMessageMgr::RetransTableEntry * entry;
+
+    NL_TEST_ASSERT(inSuite, rm->AddToRetransTable(rc, &entry) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 1);
+    NL_TEST_ASSERT(inSuite, rm->TestGetRetransScheduleSize() == 1);
+
+    // Shutting down drops pending retransmissions, and Init starts from an empty schedule
+    rm->Shutdown();
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 0);
+    NL_TEST_ASSERT(inSuite, rm->TestGetRetransScheduleSize() == 0);
+    NL_TEST_ASSERT(inSuite, !rc->IsWaitingForAck());
+
+    rm->Init(&ctx.GetSystemLayer());
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 0);
+    NL_TEST_ASSERT(inSuite, rm->TestGetRetransScheduleSize() == 0);
+
+    NL_TEST_ASSERT(inSuite, rm->AddToRetransTable(rc, &entry) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 1);
+    NL_TEST_ASSERT(inSuite, rm->TestGetRetransScheduleSize() == 1);
+    rm->ClearRetransTable(*entry);
+    NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 0);
+    NL_TEST_ASSERT(inSuite, rm->TestGetRetransScheduleSize() == 0);
+
+    exchange->Close();
+}
+
 /**
  * Tests MRP retransmission logic with the following scenario:
  *
@@ -422,6 +462,7 @@ void TestReliableMessageProtocol::CheckResendApplicationMessage(nlTestSuite * in
 
     // Ensure the retransmit table is empty right now
     NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 0);
+    const ReliableMessageMgr::RetransStats statsBefore = rm->GetRetransStats();
 
     // Ensure the exchange stays open after we send (unlike the CheckCloseExchangeAndResendApplicationMessage case), by claiming to
     // expect a response.
@@ -502,6 +543,10 @@ void TestReliableMessageProtocol::CheckResendApplicationMessage(nlTestSuite * in
     NL_TEST_ASSERT(inSuite, loopback.mDroppedMessageCount == 4);
     NL_TEST_ASSERT(inSuite, rm->TestGetCountRetransTable() == 0);
 
+    // Four retransmissions were needed, none of which timed out.
+    NL_TEST_ASSERT(inSuite, rm->GetRetransStats().retransmits - statsBefore.retransmits == 4);
+    NL_TEST_ASSERT(inSuite, rm->GetRetransStats().timeouts == statsBefore.timeouts);
+
     exchange->Close();
 }
 
@@ -2161,6 +2206,7 @@ void TestReliableMessageProtocol::CheckApplicationResponseNeverComes(nlTestSuite
 
 const nlTest sTests[] = {
     NL_TEST_DEF("Test ReliableMessageMgr::CheckAddClearRetrans", TestReliableMessageProtocol::CheckAddClearRetrans),
+    NL_TEST_DEF("Test ReliableMessageMgr::CheckShutdownAndReinit", TestReliableMessageProtocol::CheckShutdownAndReinit),
     NL_TEST_DEF("Test ReliableMessageMgr::CheckResendApplicationMessage",
                 TestReliableMessageProtocol::CheckResendApplicationMessage),
     NL_TEST_DEF("Test ReliableMessageMgr::CheckCloseExchangeAndResendApplicationMessage",
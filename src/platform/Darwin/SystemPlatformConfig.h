@@ -49,4 +49,5 @@ struct ChipDeviceEvent;
 #define CHIP_SYSTEM_CONFIG_PLATFORM_LOG_INCLUDE <platform/Darwin/Logging.h>
 
 // ========== Platform-specific Configuration Overrides =========
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SIZE 8
 #define CHIP_CONFIG_MDNS_RESOLVE_LOOKUP_RESULTS 5
@@ -42,6 +42,18 @@
 #define CHIP_DEVICE_CONFIG_ENABLE_CHIPOBLE 0
 #endif
 
+// Background work runs on a thread pool once the application calls
+// StartBackgroundEventLoopTask(), as the Linux example apps do in
+// ChipLinuxAppMainLoop(); until then it runs on the CHIP event loop.
+#ifndef CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+#define CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING 1
+#endif
+
+// Lets several CASE handshakes run their key exchange, signing and certificate checks at once.
+#ifndef CHIP_DEVICE_CONFIG_BG_TASK_COUNT
+#define CHIP_DEVICE_CONFIG_BG_TASK_COUNT 4
+#endif
+
 // Start GLib main event loop if BLE, Thread or WiFi is enabled. This is needed
 // to handle D-Bus communication with BlueZ or wpa_supplicant.
 #if CHIP_DEVICE_CONFIG_ENABLE_CHIPOBLE || CHIP_DEVICE_CONFIG_ENABLE_THREAD || CHIP_DEVICE_CONFIG_ENABLE_WIFI
@@ -55,6 +67,66 @@
 // These are configuration options that are unique to Linux platforms.
 // These can be overridden by the application as needed.
 
+/**
+ * CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STRUCTURED
+ *
+ * Back the KeyValueStoreManager with an append-only log (ChipLinuxStorageLog) instead of
+ * an INI file that is rewritten on every change. An existing INI file is converted on Init.
+ */
+#ifndef CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STRUCTURED
+#define CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STRUCTURED 0
+#endif // CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STRUCTURED
+
+/**
+ * CHIP_DEVICE_CONFIG_LINUX_KVS_SYNC_THRESHOLD_BYTES
+ *
+ * Number of bytes appended to the KVS log before it is flushed with fdatasync().
+ * 0 flushes on every write.
+ */
+#ifndef CHIP_DEVICE_CONFIG_LINUX_KVS_SYNC_THRESHOLD_BYTES
+#define CHIP_DEVICE_CONFIG_LINUX_KVS_SYNC_THRESHOLD_BYTES 4096
+#endif // CHIP_DEVICE_CONFIG_LINUX_KVS_SYNC_THRESHOLD_BYTES
+
+/**
+ * CHIP_DEVICE_CONFIG_LINUX_KVS_COMPACTION_MIN_BYTES
+ *
+ * The KVS log is compacted once it is larger than this and more than half of it is
+ * overwritten or deleted records.
+ */
+#ifndef CHIP_DEVICE_CONFIG_LINUX_KVS_COMPACTION_MIN_BYTES
+#define CHIP_DEVICE_CONFIG_LINUX_KVS_COMPACTION_MIN_BYTES (64 * 1024)
+#endif // CHIP_DEVICE_CONFIG_LINUX_KVS_COMPACTION_MIN_BYTES
+
+/**
+ * CHIP_DEVICE_CONFIG_LINUX_PERSISTENT_EVENT_LOG
+ *
+ * Keep the event logging buffers of the server in a memory-mapped file
+ * (PersistentEventLogStorage), so that events survive a restart.
+ */
+#ifndef CHIP_DEVICE_CONFIG_LINUX_PERSISTENT_EVENT_LOG
+#define CHIP_DEVICE_CONFIG_LINUX_PERSISTENT_EVENT_LOG 0
+#endif // CHIP_DEVICE_CONFIG_LINUX_PERSISTENT_EVENT_LOG
+
+/**
+ * CHIP_DEVICE_CONFIG_LINUX_PERSISTENT_EVENT_LOG_PATH
+ *
+ * Path of the file backing the event logging buffers.
+ */
+#ifndef CHIP_DEVICE_CONFIG_LINUX_PERSISTENT_EVENT_LOG_PATH
+#define CHIP_DEVICE_CONFIG_LINUX_PERSISTENT_EVENT_LOG_PATH "/tmp/chip_event_log"
+#endif // CHIP_DEVICE_CONFIG_LINUX_PERSISTENT_EVENT_LOG_PATH
+
+/**
+ * CHIP_DEVICE_CONFIG_LINUX_PERSISTENT_EVENT_LOG_SYNC_INTERVAL_MS
+ *
+ * Delay, in milliseconds, between logging an event and flushing the event log file
+ * with msync(); the events logged in the meantime are flushed together. 0 flushes
+ * on every event.
+ */
+#ifndef CHIP_DEVICE_CONFIG_LINUX_PERSISTENT_EVENT_LOG_SYNC_INTERVAL_MS
+#define CHIP_DEVICE_CONFIG_LINUX_PERSISTENT_EVENT_LOG_SYNC_INTERVAL_MS 1000
+#endif // CHIP_DEVICE_CONFIG_LINUX_PERSISTENT_EVENT_LOG_SYNC_INTERVAL_MS
+
 // ========== Platform-specific Configuration Overrides =========
 
 #ifndef CHIP_DEVICE_CONFIG_CHIP_TASK_STACK_SIZE
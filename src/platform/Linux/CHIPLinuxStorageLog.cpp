@@ -0,0 +1,548 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *          Provides a log-structured key-value store for the Linux KeyValueStoreManager.
+ *
+ *          File layout: an 8 byte header, followed by records of the form
+ *
+ *              crc32 (4) | type (1) | key length (2) | value length (4) | key | value
+ *
+ *          with little-endian integers. The CRC-32 covers everything after itself.
+ */
+
+#include <platform/Linux/CHIPLinuxStorageLog.h>
+
+#include <algorithm>
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <libgen.h>
+#include <sstream>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <inipp/inipp.h>
+#include <lib/core/CHIPEncoding.h>
+#include <lib/support/Base64.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/IniEscaping.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <platform/internal/CHIPDeviceLayerInternal.h>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+namespace {
+
+constexpr uint8_t kLogHeader[]         = { 'C', 'H', 'I', 'P', 'K', 'V', 'L', '1' };
+constexpr size_t kRecordHeaderSize     = 4 + 1 + 2 + 4;
+constexpr size_t kRecordCrcSize        = 4;
+constexpr uint8_t kRecordTypePut       = 1;
+constexpr uint8_t kRecordTypeDelete    = 2;
+constexpr size_t kSyncThresholdSize    = CHIP_DEVICE_CONFIG_LINUX_KVS_SYNC_THRESHOLD_BYTES;
+constexpr size_t kCompactionMinLogSize = CHIP_DEVICE_CONFIG_LINUX_KVS_COMPACTION_MIN_BYTES;
+
+struct Crc32Table
+{
+    constexpr Crc32Table() : values()
+    {
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            uint32_t value = i;
+            for (int bit = 0; bit < 8; bit++)
+            {
+                value = (value & 1) ? (value >> 1) ^ 0xEDB88320 : value >> 1;
+            }
+            values[i] = value;
+        }
+    }
+    uint32_t values[256];
+};
+
+constexpr Crc32Table kCrc32Table;
+
+uint32_t Crc32(const uint8_t * data, size_t length)
+{
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < length; i++)
+    {
+        crc = kCrc32Table.values[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFF;
+}
+
+size_t RecordSize(const std::string & key, size_t valueSize)
+{
+    return kRecordHeaderSize + key.size() + valueSize;
+}
+
+void EncodeRecord(std::vector<uint8_t> & out, uint8_t type, const std::string & key, const uint8_t * value, size_t valueSize)
+{
+    size_t start = out.size();
+    out.resize(start + RecordSize(key, valueSize));
+
+    uint8_t * p = &out[start + kRecordCrcSize];
+    *p++        = type;
+    Encoding::LittleEndian::Put16(p, static_cast<uint16_t>(key.size()));
+    Encoding::LittleEndian::Put32(p + 2, static_cast<uint32_t>(valueSize));
+    p += 6;
+    memcpy(p, key.data(), key.size());
+    if (valueSize > 0)
+    {
+        memcpy(p + key.size(), value, valueSize);
+    }
+
+    Encoding::LittleEndian::Put32(&out[start],
+                                  Crc32(&out[start + kRecordCrcSize], kRecordHeaderSize - kRecordCrcSize + key.size() + valueSize));
+}
+
+CHIP_ERROR WriteAll(int fd, const uint8_t * data, size_t length, size_t offset)
+{
+    while (length > 0)
+    {
+        ssize_t written = pwrite(fd, data, length, static_cast<off_t>(offset));
+        if (written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        VerifyOrReturnError(written > 0, CHIP_ERROR_WRITE_FAILED);
+        data += written;
+        length -= static_cast<size_t>(written);
+        offset += static_cast<size_t>(written);
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ReadAll(int fd, std::vector<uint8_t> & out)
+{
+    struct stat st;
+    VerifyOrReturnError(fstat(fd, &st) == 0, CHIP_ERROR_READ_FAILED);
+    out.resize(static_cast<size_t>(st.st_size));
+
+    size_t offset = 0;
+    while (offset < out.size())
+    {
+        ssize_t got = pread(fd, &out[offset], out.size() - offset, static_cast<off_t>(offset));
+        if (got < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        VerifyOrReturnError(got >= 0, CHIP_ERROR_READ_FAILED);
+        if (got == 0)
+        {
+            break;
+        }
+        offset += static_cast<size_t>(got);
+    }
+    out.resize(offset);
+    return CHIP_NO_ERROR;
+}
+
+bool IsText(const std::string & content)
+{
+    return std::all_of(content.begin(), content.end(), [](char c) {
+        return isprint(static_cast<unsigned char>(c)) || isspace(static_cast<unsigned char>(c));
+    });
+}
+
+// Make a rename in the directory of path durable.
+void SyncParentDirectory(const std::string & path)
+{
+    std::string copy = path;
+    int fd           = open(dirname(&copy[0]), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd >= 0)
+    {
+        fsync(fd);
+        close(fd);
+    }
+}
+
+} // namespace
+
+CHIP_ERROR ChipLinuxStorageLog::Init(const char * path)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    ChipLogDetail(DeviceLayer, "ChipLinuxStorageLog::Init: Using KVS file: %s", StringOrNullMarker(path));
+    VerifyOrReturnError(path != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    if (mFd >= 0)
+    {
+        ChipLogError(DeviceLayer, "ChipLinuxStorageLog::Init: Attempt to re-initialize with KVS file: %s", path);
+        return CHIP_NO_ERROR;
+    }
+
+    mPath.assign(path);
+    mFd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (mFd < 0)
+    {
+        ChipLogError(DeviceLayer, "Failed to open KVS file (%s), %s (%d)", path, strerror(errno), errno);
+        return CHIP_ERROR_OPEN_FAILED;
+    }
+
+    CHIP_ERROR err = Load();
+    if (err != CHIP_NO_ERROR)
+    {
+        CloseLocked();
+    }
+    return err;
+}
+
+void ChipLinuxStorageLog::Shutdown()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    VerifyOrReturn(mFd >= 0);
+    SyncLocked();
+    CloseLocked();
+}
+
+void ChipLinuxStorageLog::CloseLocked()
+{
+    if (mFd >= 0)
+    {
+        close(mFd);
+        mFd = -1;
+    }
+    mEntries.clear();
+    mLogSize      = 0;
+    mLiveSize     = 0;
+    mUnsyncedSize = 0;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Load()
+{
+    std::vector<uint8_t> content;
+    ReturnErrorOnFailure(ReadAll(mFd, content));
+
+    mEntries.clear();
+    mLogSize      = sizeof(kLogHeader);
+    mLiveSize     = sizeof(kLogHeader);
+    mUnsyncedSize = 0;
+
+    if (content.empty())
+    {
+        return WriteAll(mFd, kLogHeader, sizeof(kLogHeader), 0);
+    }
+
+    if (content.size() < sizeof(kLogHeader) || memcmp(content.data(), kLogHeader, sizeof(kLogHeader)) != 0)
+    {
+        std::string ini(content.begin(), content.end());
+        content.clear();
+        CHIP_ERROR err = ImportIni(ini);
+        if (err != CHIP_NO_ERROR)
+        {
+            // The file is left as is, so that whatever it holds can still be recovered.
+            ChipLogError(DeviceLayer, "KVS file (%s) is neither a log nor an INI store: %" CHIP_ERROR_FORMAT, mPath.c_str(),
+                         err.Format());
+            return err;
+        }
+        ChipLogProgress(DeviceLayer, "Converting INI KVS file (%s) to a log", mPath.c_str());
+        return Compact();
+    }
+
+    size_t offset = sizeof(kLogHeader);
+    while (offset < content.size())
+    {
+        const uint8_t * record = &content[offset];
+        size_t available       = content.size() - offset;
+        if (available < kRecordHeaderSize)
+        {
+            break;
+        }
+
+        uint8_t type     = record[kRecordCrcSize];
+        size_t keySize   = Encoding::LittleEndian::Get16(record + kRecordCrcSize + 1);
+        size_t valueSize = Encoding::LittleEndian::Get32(record + kRecordCrcSize + 3);
+        if (available - kRecordHeaderSize < keySize || available - kRecordHeaderSize - keySize < valueSize ||
+            Encoding::LittleEndian::Get32(record) !=
+                Crc32(record + kRecordCrcSize, kRecordHeaderSize - kRecordCrcSize + keySize + valueSize))
+        {
+            break;
+        }
+
+        std::string key(reinterpret_cast<const char *>(record + kRecordHeaderSize), keySize);
+        auto it = mEntries.find(key);
+        if (it != mEntries.end())
+        {
+            mLiveSize -= RecordSize(key, it->second.size());
+        }
+
+        if (type == kRecordTypePut)
+        {
+            const uint8_t * value = record + kRecordHeaderSize + keySize;
+            mEntries[key].assign(value, value + valueSize);
+            mLiveSize += RecordSize(key, valueSize);
+        }
+        else if (it != mEntries.end())
+        {
+            mEntries.erase(it);
+        }
+
+        offset += kRecordHeaderSize + keySize + valueSize;
+    }
+
+    mLogSize = offset;
+    if (offset < content.size())
+    {
+        // Anything after a corrupted record was appended after a write that did not complete.
+        ChipLogError(DeviceLayer, "Dropping %u bytes at the end of KVS file (%s)", static_cast<unsigned>(content.size() - offset),
+                     mPath.c_str());
+        VerifyOrReturnError(ftruncate(mFd, static_cast<off_t>(offset)) == 0, CHIP_ERROR_WRITE_FAILED);
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::ImportIni(const std::string & ini)
+{
+    // ChipLinuxStorage only writes printable text, in a single DEFAULT section. Log records hold binary
+    // lengths and CRCs, so a log with a damaged or truncated header fails these checks instead of being
+    // imported as an empty store.
+    VerifyOrReturnError(IsText(ini), CHIP_ERROR_INTEGRITY_CHECK_FAILED);
+
+    inipp::Ini<char> store;
+    std::istringstream stream(ini);
+    store.parse(stream);
+    VerifyOrReturnError(store.errors.empty(), CHIP_ERROR_INTEGRITY_CHECK_FAILED);
+
+    auto section = store.sections.find("DEFAULT");
+    VerifyOrReturnError(store.sections.size() == ((section != store.sections.end()) ? 1u : 0u),
+                        CHIP_ERROR_INTEGRITY_CHECK_FAILED);
+    VerifyOrReturnError(section != store.sections.end(), CHIP_NO_ERROR);
+
+    for (const auto & entry : section->second)
+    {
+        std::string key = IniEscaping::UnescapeKey(entry.first);
+        std::vector<uint8_t> value(entry.second.size() * 3 / 4 + 1);
+        uint32_t valueSize = Base64Decode32(entry.second.data(), static_cast<uint32_t>(entry.second.size()), value.data());
+        if (key.empty() || key.size() > UINT16_MAX || valueSize == UINT32_MAX)
+        {
+            ChipLogError(DeviceLayer, "Skipping invalid INI KVS entry: %s", entry.first.c_str());
+            continue;
+        }
+        value.resize(valueSize);
+        mLiveSize += RecordSize(key, value.size());
+        mEntries[key] = std::move(value);
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Get(const char * key, void * value, size_t valueSize, size_t * readBytesSize, size_t offset)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    VerifyOrReturnError(key != nullptr && value != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(mFd >= 0, CHIP_ERROR_INCORRECT_STATE);
+
+    auto it = mEntries.find(key);
+    VerifyOrReturnError(it != mEntries.end(), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+
+    const std::vector<uint8_t> & stored = it->second;
+    VerifyOrReturnError(offset <= stored.size(), CHIP_ERROR_INVALID_ARGUMENT);
+
+    size_t remaining = stored.size() - offset;
+    size_t copySize  = std::min(valueSize, remaining);
+    if (copySize > 0)
+    {
+        memcpy(value, stored.data() + offset, copySize);
+    }
+    if (readBytesSize != nullptr)
+    {
+        *readBytesSize = copySize;
+    }
+
+    return (valueSize < remaining) ? CHIP_ERROR_BUFFER_TOO_SMALL : CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Put(const char * key, const void * value, size_t valueSize)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    VerifyOrReturnError(key != nullptr && (value != nullptr || valueSize == 0), CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(mFd >= 0, CHIP_ERROR_INCORRECT_STATE);
+
+    std::string keyString(key);
+    VerifyOrReturnError(!keyString.empty() && keyString.size() <= UINT16_MAX && valueSize <= UINT32_MAX,
+                        CHIP_ERROR_INVALID_ARGUMENT);
+
+    const uint8_t * bytes = static_cast<const uint8_t *>(value);
+    ReturnErrorOnFailure(Append(kRecordTypePut, keyString, bytes, valueSize));
+
+    auto it = mEntries.find(keyString);
+    if (it != mEntries.end())
+    {
+        mLiveSize -= RecordSize(keyString, it->second.size());
+        it->second.assign(bytes, bytes + valueSize);
+    }
+    else
+    {
+        mEntries.emplace(keyString, std::vector<uint8_t>(bytes, bytes + valueSize));
+    }
+    mLiveSize += RecordSize(keyString, valueSize);
+
+    CompactOrSync();
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Delete(const char * key)
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    VerifyOrReturnError(key != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(mFd >= 0, CHIP_ERROR_INCORRECT_STATE);
+
+    auto it = mEntries.find(key);
+    VerifyOrReturnError(it != mEntries.end(), CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+
+    ReturnErrorOnFailure(Append(kRecordTypeDelete, it->first, nullptr, 0));
+    mLiveSize -= RecordSize(it->first, it->second.size());
+    mEntries.erase(it);
+
+    CompactOrSync();
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Append(uint8_t type, const std::string & key, const uint8_t * value, size_t valueSize)
+{
+    std::vector<uint8_t> record;
+    EncodeRecord(record, type, key, value, valueSize);
+
+    CHIP_ERROR err = WriteAll(mFd, record.data(), record.size(), mLogSize);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DeviceLayer, "Failed to append to KVS file (%s), %s (%d)", mPath.c_str(), strerror(errno), errno);
+        // Do not leave a partial record in front of the next one.
+        if (ftruncate(mFd, static_cast<off_t>(mLogSize)) != 0)
+        {
+            ChipLogError(DeviceLayer, "Failed to truncate KVS file (%s)", mPath.c_str());
+        }
+        return err;
+    }
+
+    mLogSize += record.size();
+    mUnsyncedSize += record.size();
+    return CHIP_NO_ERROR;
+}
+
+void ChipLinuxStorageLog::CompactOrSync()
+{
+    if (mLogSize >= kCompactionMinLogSize && mLogSize > 2 * mLiveSize)
+    {
+        // The change is already in the log, a failed compaction only leaves the log longer.
+        CHIP_ERROR err = Compact();
+        if (err == CHIP_NO_ERROR)
+        {
+            return;
+        }
+        ChipLogError(DeviceLayer, "Failed to compact KVS file (%s): %" CHIP_ERROR_FORMAT, mPath.c_str(), err.Format());
+    }
+
+    if (mBatchDepth == 0 && mUnsyncedSize >= kSyncThresholdSize)
+    {
+        SyncLocked();
+    }
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Compact()
+{
+    std::vector<uint8_t> content(kLogHeader, kLogHeader + sizeof(kLogHeader));
+    content.reserve(mLiveSize);
+    for (const auto & entry : mEntries)
+    {
+        EncodeRecord(content, kRecordTypePut, entry.first, entry.second.data(), entry.second.size());
+    }
+
+    std::string tmpPath = mPath + "-XXXXXX";
+    int fd              = mkostemp(&tmpPath[0], O_CLOEXEC);
+    if (fd < 0)
+    {
+        ChipLogError(DeviceLayer, "Failed to open file (%s) for writing", tmpPath.c_str());
+        return CHIP_ERROR_OPEN_FAILED;
+    }
+
+    CHIP_ERROR err = WriteAll(fd, content.data(), content.size(), 0);
+    if (err == CHIP_NO_ERROR && fdatasync(fd) != 0)
+    {
+        err = CHIP_ERROR_WRITE_FAILED;
+    }
+    if (err == CHIP_NO_ERROR && rename(tmpPath.c_str(), mPath.c_str()) != 0)
+    {
+        ChipLogError(DeviceLayer, "Failed to rename (%s), %s (%d)", tmpPath.c_str(), strerror(errno), errno);
+        err = CHIP_ERROR_WRITE_FAILED;
+    }
+    if (err != CHIP_NO_ERROR)
+    {
+        close(fd);
+        unlink(tmpPath.c_str());
+        return err;
+    }
+
+    SyncParentDirectory(mPath);
+
+    close(mFd);
+    mFd           = fd;
+    mLogSize      = content.size();
+    mLiveSize     = content.size();
+    mUnsyncedSize = 0;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::Sync()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    VerifyOrReturnError(mFd >= 0, CHIP_ERROR_INCORRECT_STATE);
+    return SyncLocked();
+}
+
+void ChipLinuxStorageLog::BeginBatch()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    mBatchDepth++;
+}
+
+CHIP_ERROR ChipLinuxStorageLog::EndBatch()
+{
+    std::lock_guard<std::mutex> lock(mLock);
+
+    VerifyOrReturnError(mBatchDepth > 0, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(--mBatchDepth == 0 && mFd >= 0, CHIP_NO_ERROR);
+    return SyncLocked();
+}
+
+CHIP_ERROR ChipLinuxStorageLog::SyncLocked()
+{
+    VerifyOrReturnError(mUnsyncedSize > 0, CHIP_NO_ERROR);
+    if (fdatasync(mFd) != 0)
+    {
+        ChipLogError(DeviceLayer, "Failed to sync KVS file (%s), %s (%d)", mPath.c_str(), strerror(errno), errno);
+        return CHIP_ERROR_WRITE_FAILED;
+    }
+    mUnsyncedSize = 0;
+    return CHIP_NO_ERROR;
+}
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
@@ -0,0 +1,115 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *          Provides a log-structured key-value store for the Linux KeyValueStoreManager.
+ *
+ *          Every put or delete is appended to the file as a CRC-protected record, so
+ *          that the cost of a write does not depend on the size of the store. All live
+ *          values are kept in memory, indexed by key. The file is compacted (rewritten
+ *          with only the live records, then renamed over the log) once it has grown to
+ *          more than twice the size of the live data.
+ *
+ *          Appends reach the file before Put/Delete return, like the rename done by the
+ *          INI store; fdatasync() is batched and only issued once enough bytes have been
+ *          appended, on compaction, and on Shutdown(). A record torn by a crash is
+ *          detected by its CRC and dropped, along with everything after it, on the next
+ *          Init().
+ *
+ *          A file that does not start with the log header is imported as an INI store
+ *          written by ChipLinuxStorage, and replaced by a log. If it is not a valid INI
+ *          store either (e.g. a log whose header is damaged), Init() fails with
+ *          CHIP_ERROR_INTEGRITY_CHECK_FAILED and leaves the file untouched.
+ */
+
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <lib/core/CHIPError.h>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+class ChipLinuxStorageLog
+{
+public:
+    ChipLinuxStorageLog() = default;
+    ~ChipLinuxStorageLog() { Shutdown(); }
+
+    ChipLinuxStorageLog(const ChipLinuxStorageLog &)             = delete;
+    ChipLinuxStorageLog & operator=(const ChipLinuxStorageLog &) = delete;
+
+    CHIP_ERROR Init(const char * path);
+
+    /**
+     * Flush pending appends to disk and close the file.
+     */
+    void Shutdown();
+
+    /**
+     * Same contract as KeyValueStoreManager::Get.
+     */
+    CHIP_ERROR Get(const char * key, void * value, size_t valueSize, size_t * readBytesSize, size_t offset);
+    CHIP_ERROR Put(const char * key, const void * value, size_t valueSize);
+    CHIP_ERROR Delete(const char * key);
+
+    /**
+     * Flush pending appends to disk.
+     */
+    CHIP_ERROR Sync();
+
+    /**
+     * Defer flushing until the matching EndBatch(), which flushes everything appended so far once the
+     * outermost batch ends.
+     */
+    void BeginBatch();
+    CHIP_ERROR EndBatch();
+
+private:
+    CHIP_ERROR Load();
+    CHIP_ERROR ImportIni(const std::string & ini);
+    // Append a record, without updating mEntries or mLiveSize.
+    CHIP_ERROR Append(uint8_t type, const std::string & key, const uint8_t * value, size_t valueSize);
+    // Compact or sync the log once enough garbage or unsynced data has been appended.
+    void CompactOrSync();
+    CHIP_ERROR Compact();
+    CHIP_ERROR SyncLocked();
+    void CloseLocked();
+
+    std::mutex mLock;
+    std::string mPath;
+    int mFd = -1;
+
+    std::unordered_map<std::string, std::vector<uint8_t>> mEntries;
+    // Size of the file, and of the header plus the records of the live entries; their difference is the space compaction
+    // would reclaim.
+    size_t mLogSize      = 0;
+    size_t mLiveSize     = 0;
+    size_t mUnsyncedSize = 0;
+    unsigned mBatchDepth = 0;
+};
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
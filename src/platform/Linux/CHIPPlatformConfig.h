@@ -46,6 +46,11 @@ using CHIP_CONFIG_PERSISTED_STORAGE_KEY_TYPE = const char *;
 #define CHIP_CONFIG_SLOW_CRYPTO 0
 #endif // CHIP_CONFIG_SLOW_CRYPTO
 
+// Controllers on Linux may re-establish CASE with many peers at once
+#ifndef CHIP_CONFIG_CERT_SIGNATURE_CACHE_SIZE
+#define CHIP_CONFIG_CERT_SIGNATURE_CACHE_SIZE 256
+#endif // CHIP_CONFIG_CERT_SIGNATURE_CACHE_SIZE
+
 // ==================== General Configuration Overrides ====================
 
 #ifndef CHIP_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS
@@ -64,6 +69,16 @@ using CHIP_CONFIG_PERSISTED_STORAGE_KEY_TYPE = const char *;
 #define CHIP_CONFIG_BDX_MAX_NUM_TRANSFERS 1
 #endif // CHIP_CONFIG_BDX_MAX_NUM_TRANSFERS
 
+// Controllers on Linux may resolve the same operational nodes over and over
+#ifndef CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE
+#define CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE 64
+#endif // CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE
+
+// Controllers on Linux may resolve many operational nodes at once
+#ifndef CHIP_CONFIG_MINMDNS_MAX_ACTIVE_RESOLVE_ATTEMPTS
+#define CHIP_CONFIG_MINMDNS_MAX_ACTIVE_RESOLVE_ATTEMPTS 32
+#endif // CHIP_CONFIG_MINMDNS_MAX_ACTIVE_RESOLVE_ATTEMPTS
+
 // ==================== Security Configuration Overrides ====================
 
 #ifndef CHIP_CONFIG_KVS_PATH
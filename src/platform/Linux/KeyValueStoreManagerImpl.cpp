@@ -28,7 +28,6 @@
 
 #include <lib/support/CodeUtils.h>
 #include <lib/support/logging/CHIPLogging.h>
-#include <platform/Linux/CHIPLinuxStorage.h>
 
 namespace chip {
 namespace DeviceLayer {
@@ -36,6 +35,36 @@ namespace PersistedStorage {
 
 KeyValueStoreManagerImpl KeyValueStoreManagerImpl::sInstance;
 
+#if CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STRUCTURED
+
+CHIP_ERROR KeyValueStoreManagerImpl::_Get(const char * key, void * value, size_t value_size, size_t * read_bytes_size,
+                                          size_t offset_bytes)
+{
+    return mStorage.Get(key, value, value_size, read_bytes_size, offset_bytes);
+}
+
+CHIP_ERROR KeyValueStoreManagerImpl::_Put(const char * key, const void * value, size_t value_size)
+{
+    return mStorage.Put(key, value, value_size);
+}
+
+CHIP_ERROR KeyValueStoreManagerImpl::_Delete(const char * key)
+{
+    return mStorage.Delete(key);
+}
+
+void KeyValueStoreManagerImpl::_BeginWriteBatch()
+{
+    mStorage.BeginBatch();
+}
+
+CHIP_ERROR KeyValueStoreManagerImpl::_EndWriteBatch()
+{
+    return mStorage.EndBatch();
+}
+
+#else // CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STRUCTURED
+
 CHIP_ERROR KeyValueStoreManagerImpl::_Get(const char * key, void * value, size_t value_size, size_t * read_bytes_size,
                                           size_t offset_bytes)
 {
@@ -83,6 +112,12 @@ CHIP_ERROR KeyValueStoreManagerImpl::_Put(const char * key, const void * value,
     err = mStorage.WriteValueBin(key, reinterpret_cast<const uint8_t *>(value), value_size);
     SuccessOrExit(err);
 
+    if (mWriteBatchDepth > 0)
+    {
+        mWriteBatchDirty = true;
+        ExitNow();
+    }
+
     // Commit the value to the persistent store.
     err = mStorage.Commit();
     SuccessOrExit(err);
@@ -102,6 +137,12 @@ CHIP_ERROR KeyValueStoreManagerImpl::_Delete(const char * key)
     }
     SuccessOrExit(err);
 
+    if (mWriteBatchDepth > 0)
+    {
+        mWriteBatchDirty = true;
+        ExitNow();
+    }
+
     // Commit the value to the persistent store.
     err = mStorage.Commit();
     SuccessOrExit(err);
@@ -110,6 +151,22 @@ exit:
     return err;
 }
 
+void KeyValueStoreManagerImpl::_BeginWriteBatch()
+{
+    mWriteBatchDepth++;
+}
+
+CHIP_ERROR KeyValueStoreManagerImpl::_EndWriteBatch()
+{
+    VerifyOrReturnError(mWriteBatchDepth > 0, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(--mWriteBatchDepth == 0 && mWriteBatchDirty, CHIP_NO_ERROR);
+
+    mWriteBatchDirty = false;
+    return mStorage.Commit();
+}
+
+#endif // CHIP_DEVICE_CONFIG_LINUX_KVS_LOG_STRUCTURED
+
 } // namespace PersistedStorage
 } // namespace DeviceLayer
 } // namespace chip
@@ -0,0 +1,325 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the log-structured
+ *      key-value store of the Linux platform.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <nlunit-test.h>
+
+#include <platform/CHIPDeviceConfig.h>
+#include <platform/Linux/CHIPLinuxStorage.h>
+#include <platform/Linux/CHIPLinuxStorageLog.h>
+
+using namespace chip;
+using namespace chip::DeviceLayer::Internal;
+
+namespace {
+
+constexpr uint8_t kFirstValue[]  = { 0x01, 0x02, 0x03 };
+constexpr uint8_t kSecondValue[] = { 0x10, 0x20, 0x30, 0x40 };
+
+class TempFile
+{
+public:
+    TempFile()
+    {
+        strcpy(mPath, "/tmp/chip-kvs-log-test-XXXXXX");
+        int fd = mkstemp(mPath);
+        VerifyOrDie(fd >= 0);
+        close(fd);
+        // Start from a missing file, as a device that was never commissioned.
+        unlink(mPath);
+    }
+    ~TempFile() { unlink(mPath); }
+
+    const char * Path() const { return mPath; }
+
+    size_t Size() const
+    {
+        struct stat st;
+        return (stat(mPath, &st) == 0) ? static_cast<size_t>(st.st_size) : 0;
+    }
+
+private:
+    char mPath[64];
+};
+
+template <size_t N>
+bool HasValue(ChipLinuxStorageLog & storage, const char * key, const uint8_t (&expected)[N])
+{
+    uint8_t value[N + 1];
+    size_t readSize = 0;
+    return (storage.Get(key, value, sizeof(value), &readSize, 0) == CHIP_NO_ERROR) && (readSize == N) &&
+        (memcmp(value, expected, N) == 0);
+}
+
+bool IsMissing(ChipLinuxStorageLog & storage, const char * key)
+{
+    uint8_t value[1];
+    size_t readSize = 0;
+    return storage.Get(key, value, sizeof(value), &readSize, 0) == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND;
+}
+
+void TestReopen(nlTestSuite * inSuite, void * inContext)
+{
+    TempFile file;
+
+    {
+        ChipLinuxStorageLog storage;
+        NL_TEST_ASSERT(inSuite, storage.Init(file.Path()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Put("first", kFirstValue, sizeof(kFirstValue)) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Put("second", kFirstValue, sizeof(kFirstValue)) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Put("second", kSecondValue, sizeof(kSecondValue)) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Put("deleted", kFirstValue, sizeof(kFirstValue)) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Delete("deleted") == CHIP_NO_ERROR);
+    }
+
+    ChipLinuxStorageLog storage;
+    NL_TEST_ASSERT(inSuite, storage.Init(file.Path()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, HasValue(storage, "first", kFirstValue));
+    NL_TEST_ASSERT(inSuite, HasValue(storage, "second", kSecondValue));
+    NL_TEST_ASSERT(inSuite, IsMissing(storage, "deleted"));
+}
+
+void TestTornTail(nlTestSuite * inSuite, void * inContext)
+{
+    TempFile file;
+    size_t intactSize = 0;
+
+    {
+        ChipLinuxStorageLog storage;
+        NL_TEST_ASSERT(inSuite, storage.Init(file.Path()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Put("first", kFirstValue, sizeof(kFirstValue)) == CHIP_NO_ERROR);
+        intactSize = file.Size();
+        NL_TEST_ASSERT(inSuite, storage.Put("second", kSecondValue, sizeof(kSecondValue)) == CHIP_NO_ERROR);
+    }
+
+    // A write that did not complete: the last record misses its last bytes.
+    NL_TEST_ASSERT(inSuite, truncate(file.Path(), static_cast<off_t>(file.Size() - 2)) == 0);
+
+    {
+        ChipLinuxStorageLog storage;
+        NL_TEST_ASSERT(inSuite, storage.Init(file.Path()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, HasValue(storage, "first", kFirstValue));
+        NL_TEST_ASSERT(inSuite, IsMissing(storage, "second"));
+        NL_TEST_ASSERT(inSuite, file.Size() == intactSize);
+
+        // Records appended after the recovery are kept.
+        NL_TEST_ASSERT(inSuite, storage.Put("second", kSecondValue, sizeof(kSecondValue)) == CHIP_NO_ERROR);
+    }
+
+    ChipLinuxStorageLog storage;
+    NL_TEST_ASSERT(inSuite, storage.Init(file.Path()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, HasValue(storage, "first", kFirstValue));
+    NL_TEST_ASSERT(inSuite, HasValue(storage, "second", kSecondValue));
+}
+
+void TestCorruptedTail(nlTestSuite * inSuite, void * inContext)
+{
+    TempFile file;
+    size_t intactSize = 0;
+
+    {
+        ChipLinuxStorageLog storage;
+        NL_TEST_ASSERT(inSuite, storage.Init(file.Path()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Put("first", kFirstValue, sizeof(kFirstValue)) == CHIP_NO_ERROR);
+        intactSize = file.Size();
+        NL_TEST_ASSERT(inSuite, storage.Put("first", kSecondValue, sizeof(kSecondValue)) == CHIP_NO_ERROR);
+    }
+
+    // The last byte of the overwriting value is damaged, so its record fails its CRC.
+    FILE * stream = fopen(file.Path(), "r+b");
+    NL_TEST_ASSERT(inSuite, stream != nullptr);
+    VerifyOrReturn(stream != nullptr);
+    NL_TEST_ASSERT(inSuite, fseek(stream, -1, SEEK_END) == 0);
+    int last = fgetc(stream);
+    NL_TEST_ASSERT(inSuite, fseek(stream, -1, SEEK_END) == 0);
+    fputc(last ^ 0xFF, stream);
+    fclose(stream);
+
+    ChipLinuxStorageLog storage;
+    NL_TEST_ASSERT(inSuite, storage.Init(file.Path()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, HasValue(storage, "first", kFirstValue));
+    NL_TEST_ASSERT(inSuite, file.Size() == intactSize);
+}
+
+void TestCompaction(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr size_t kCompactionMinSize = CHIP_DEVICE_CONFIG_LINUX_KVS_COMPACTION_MIN_BYTES;
+    constexpr size_t kValueSize         = 4096;
+    constexpr size_t kOverwrites        = 4 * kCompactionMinSize / kValueSize;
+
+    TempFile file;
+    static uint8_t value[kValueSize];
+
+    {
+        ChipLinuxStorageLog storage;
+        NL_TEST_ASSERT(inSuite, storage.Init(file.Path()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Put("kept", kFirstValue, sizeof(kFirstValue)) == CHIP_NO_ERROR);
+
+        // Overwrite the same key until the log is mostly garbage, several times over.
+        for (size_t i = 0; i < kOverwrites; i++)
+        {
+            memset(value, static_cast<int>(i), sizeof(value));
+            NL_TEST_ASSERT(inSuite, storage.Put("overwritten", value, sizeof(value)) == CHIP_NO_ERROR);
+        }
+
+        // Without compaction, the log would hold every overwrite.
+        NL_TEST_ASSERT(inSuite, file.Size() < kOverwrites * kValueSize / 2);
+        NL_TEST_ASSERT(inSuite, file.Size() <= kCompactionMinSize + kValueSize + 64);
+    }
+
+    ChipLinuxStorageLog storage;
+    NL_TEST_ASSERT(inSuite, storage.Init(file.Path()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, HasValue(storage, "kept", kFirstValue));
+    NL_TEST_ASSERT(inSuite, HasValue(storage, "overwritten", value));
+}
+
+void TestIniImport(nlTestSuite * inSuite, void * inContext)
+{
+    TempFile file;
+
+    {
+        // A store written by the INI backend, with keys that need escaping.
+        ChipLinuxStorage ini;
+        NL_TEST_ASSERT(inSuite, ini.Init(file.Path()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, ini.WriteValueBin("f/1/n", kFirstValue, sizeof(kFirstValue)) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, ini.WriteValueBin("key with=spaces", kSecondValue, sizeof(kSecondValue)) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, ini.Commit() == CHIP_NO_ERROR);
+    }
+
+    {
+        ChipLinuxStorageLog storage;
+        NL_TEST_ASSERT(inSuite, storage.Init(file.Path()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, HasValue(storage, "f/1/n", kFirstValue));
+        NL_TEST_ASSERT(inSuite, HasValue(storage, "key with=spaces", kSecondValue));
+        NL_TEST_ASSERT(inSuite, storage.Put("added", kFirstValue, sizeof(kFirstValue)) == CHIP_NO_ERROR);
+    }
+
+    // The file is a log now: the import is not repeated, and later changes are kept.
+    FILE * stream = fopen(file.Path(), "rb");
+    NL_TEST_ASSERT(inSuite, stream != nullptr);
+    VerifyOrReturn(stream != nullptr);
+    char header[8];
+    NL_TEST_ASSERT(inSuite, fread(header, 1, sizeof(header), stream) == sizeof(header));
+    NL_TEST_ASSERT(inSuite, memcmp(header, "CHIPKVL1", sizeof(header)) == 0);
+    fclose(stream);
+
+    ChipLinuxStorageLog storage;
+    NL_TEST_ASSERT(inSuite, storage.Init(file.Path()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, HasValue(storage, "f/1/n", kFirstValue));
+    NL_TEST_ASSERT(inSuite, HasValue(storage, "key with=spaces", kSecondValue));
+    NL_TEST_ASSERT(inSuite, HasValue(storage, "added", kFirstValue));
+}
+
+void TestDamagedHeader(nlTestSuite * inSuite, void * inContext)
+{
+    TempFile file;
+
+    {
+        ChipLinuxStorageLog storage;
+        NL_TEST_ASSERT(inSuite, storage.Init(file.Path()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Put("first", kFirstValue, sizeof(kFirstValue)) == CHIP_NO_ERROR);
+    }
+    size_t logSize = file.Size();
+
+    // A bit flip in the header must not make the records look like an INI store without entries.
+    FILE * stream = fopen(file.Path(), "r+b");
+    NL_TEST_ASSERT(inSuite, stream != nullptr);
+    VerifyOrReturn(stream != nullptr);
+    fputc('X', stream);
+    fclose(stream);
+
+    {
+        ChipLinuxStorageLog storage;
+        NL_TEST_ASSERT(inSuite, storage.Init(file.Path()) == CHIP_ERROR_INTEGRITY_CHECK_FAILED);
+        NL_TEST_ASSERT(inSuite, storage.Put("first", kSecondValue, sizeof(kSecondValue)) == CHIP_ERROR_INCORRECT_STATE);
+    }
+
+    // The file is kept for recovery.
+    NL_TEST_ASSERT(inSuite, file.Size() == logSize);
+}
+
+void TestTruncatedHeader(nlTestSuite * inSuite, void * inContext)
+{
+    TempFile file;
+
+    {
+        ChipLinuxStorageLog storage;
+        NL_TEST_ASSERT(inSuite, storage.Init(file.Path()) == CHIP_NO_ERROR);
+    }
+
+    // Only part of the header made it to the file.
+    NL_TEST_ASSERT(inSuite, truncate(file.Path(), 5) == 0);
+
+    ChipLinuxStorageLog storage;
+    NL_TEST_ASSERT(inSuite, storage.Init(file.Path()) == CHIP_ERROR_INTEGRITY_CHECK_FAILED);
+    NL_TEST_ASSERT(inSuite, file.Size() == 5);
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+// clang-format off
+const nlTest sTests[] = {
+    NL_TEST_DEF("Test ChipLinuxStorageLog: Reopen", TestReopen),
+    NL_TEST_DEF("Test ChipLinuxStorageLog: TornTail", TestTornTail),
+    NL_TEST_DEF("Test ChipLinuxStorageLog: CorruptedTail", TestCorruptedTail),
+    NL_TEST_DEF("Test ChipLinuxStorageLog: Compaction", TestCompaction),
+    NL_TEST_DEF("Test ChipLinuxStorageLog: IniImport", TestIniImport),
+    NL_TEST_DEF("Test ChipLinuxStorageLog: DamagedHeader", TestDamagedHeader),
+    NL_TEST_DEF("Test ChipLinuxStorageLog: TruncatedHeader", TestTruncatedHeader),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int TestSetup(void * inContext)
+{
+    return (Platform::MemoryInit() == CHIP_NO_ERROR) ? SUCCESS : FAILURE;
+}
+
+int TestTeardown(void * inContext)
+{
+    Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+} // namespace
+
+int TestLinuxStorageLog()
+{
+    nlTestSuite theSuite = { "ChipLinuxStorageLog tests", &sTests[0], TestSetup, TestTeardown };
+
+    // Run test suite against one context.
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestLinuxStorageLog)
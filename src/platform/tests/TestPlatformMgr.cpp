@@ -189,6 +189,68 @@ static void TestPlatformMgr_RunEventLoopStopBeforeSleep(nlTestSuite * inSuite, v
     PlatformMgr().Shutdown();
 }
 
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+static std::atomic<int> sBackgroundWorkRun{ 0 };
+
+static void BackgroundWork(intptr_t)
+{
+    chip::test_utils::SleepMillis(10);
+    sBackgroundWorkRun++;
+}
+
+static void TestPlatformMgr_BackgroundEventLoopTask(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr int kWorkCount = 8;
+    sBackgroundWorkRun       = 0;
+
+    CHIP_ERROR err = PlatformMgr().InitChipStack();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = PlatformMgr().StartBackgroundEventLoopTask();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    // The background work must complete without the CHIP event loop running.
+    for (int i = 0; i < kWorkCount; i++)
+    {
+        NL_TEST_ASSERT(inSuite, PlatformMgr().ScheduleBackgroundWork(BackgroundWork) == CHIP_NO_ERROR);
+    }
+
+    for (size_t t = 0; sBackgroundWorkRun != kWorkCount && t < 1000; t++)
+        chip::test_utils::SleepMillis(1);
+    NL_TEST_ASSERT(inSuite, sBackgroundWorkRun == kWorkCount);
+
+    err = PlatformMgr().StopBackgroundEventLoopTask();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    PlatformMgr().Shutdown();
+}
+
+static void TestPlatformMgr_BackgroundEventLoopTaskStopAfterStart(nlTestSuite * inSuite, void * inContext)
+{
+    sBackgroundWorkRun = 0;
+
+    CHIP_ERROR err = PlatformMgr().InitChipStack();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    // Stopping before the threads have reached the queue must neither hang nor leave them running.
+    for (int i = 0; i < 100; i++)
+    {
+        NL_TEST_ASSERT(inSuite, PlatformMgr().StartBackgroundEventLoopTask() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, PlatformMgr().StopBackgroundEventLoopTask() == CHIP_NO_ERROR);
+    }
+
+    // The pool still works after all that.
+    NL_TEST_ASSERT(inSuite, PlatformMgr().StartBackgroundEventLoopTask() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, PlatformMgr().ScheduleBackgroundWork(BackgroundWork) == CHIP_NO_ERROR);
+    for (size_t t = 0; sBackgroundWorkRun != 1 && t < 1000; t++)
+        chip::test_utils::SleepMillis(1);
+    NL_TEST_ASSERT(inSuite, sBackgroundWorkRun == 1);
+    NL_TEST_ASSERT(inSuite, PlatformMgr().StopBackgroundEventLoopTask() == CHIP_NO_ERROR);
+
+    PlatformMgr().Shutdown();
+}
+#endif // CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+
 static void TestPlatformMgr_TryLockChipStack(nlTestSuite * inSuite, void * inContext)
 {
     bool locked = PlatformMgr().TryLockChipStack();
@@ -263,6 +325,10 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("Test basic PlatformMgr::RunEventLoop", TestPlatformMgr_BasicRunEventLoop),
     NL_TEST_DEF("Test PlatformMgr::RunEventLoop with two tasks", TestPlatformMgr_RunEventLoopTwoTasks),
     NL_TEST_DEF("Test PlatformMgr::RunEventLoop with stop before sleep", TestPlatformMgr_RunEventLoopStopBeforeSleep),
+#if CHIP_DEVICE_CONFIG_ENABLE_BG_EVENT_PROCESSING
+    NL_TEST_DEF("Test PlatformMgr::StartBackgroundEventLoopTask", TestPlatformMgr_BackgroundEventLoopTask),
+    NL_TEST_DEF("Test PlatformMgr::StopBackgroundEventLoopTask after start", TestPlatformMgr_BackgroundEventLoopTaskStopAfterStart),
+#endif
     NL_TEST_DEF("Test PlatformMgr::TryLockChipStack", TestPlatformMgr_TryLockChipStack),
     NL_TEST_DEF("Test PlatformMgr::AddEventHandler", TestPlatformMgr_AddEventHandler),
     NL_TEST_DEF("Test mock System::Layer", TestPlatformMgr_MockSystemLayer),
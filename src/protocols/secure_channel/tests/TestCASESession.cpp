@@ -69,7 +69,7 @@ void ServiceEvents(TestContext & ctx)
 {
     // Takes a few rounds of this because handling IO messages may schedule work,
     // and scheduled work may queue messages for sending...
-    for (int i = 0; i < 3; ++i)
+    for (int i = 0; i < 5; ++i)
     {
         ctx.DrainAndServiceIO();
 
@@ -358,6 +358,21 @@
 #define CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE 15
 #endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE */
 
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SIZE
+ *
+ *  @brief
+ *      When packet buffers are allocated from the heap (#CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE is zero), this is the
+ *      number of freed buffers each thread keeps for reuse in each size class (256 bytes, 512 bytes and the maximum buffer
+ *      size), so that buffers allocated and freed at a high rate do not go through malloc every time.
+ *
+ *      This may be set to zero (0) to release every packet buffer with Platform::MemoryFree. The cache is only used with
+ *      #CHIP_CONFIG_MEMORY_MGMT_MALLOC, since cached buffers are returned to the C heap directly when a thread exits.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SIZE
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SIZE 0
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SIZE */
+
 /**
  *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_LWIP_PBUF_RAM
  *
@@ -495,6 +510,21 @@ struct LwIPEvent;
 #define CHIP_SYSTEM_CONFIG_NUM_TIMERS 32
 #endif /* CHIP_SYSTEM_CONFIG_NUM_TIMERS */
 
+/**
+ *  @def CHIP_SYSTEM_CONFIG_TIMER_LIST_BUCKETS
+ *
+ *  @brief
+ *      Number of hash buckets each System::TimerList uses to find a timer by its callback, e.g. to cancel it.
+ *      Must be a power of two.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_TIMER_LIST_BUCKETS
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+#define CHIP_SYSTEM_CONFIG_TIMER_LIST_BUCKETS 64
+#else
+#define CHIP_SYSTEM_CONFIG_TIMER_LIST_BUCKETS 8
+#endif
+#endif /* CHIP_SYSTEM_CONFIG_TIMER_LIST_BUCKETS */
+
 /**
  *  @def CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
  *
@@ -0,0 +1,495 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements Layer using Linux epoll() and timerfd.
+ */
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/TimeUtils.h>
+#include <platform/LockTracker.h>
+#include <system/SystemFaultInjection.h>
+#include <system/SystemLayer.h>
+#include <system/SystemLayerImplEpoll.h>
+
+#include <errno.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+// Choose an approximation of PTHREAD_NULL if pthread.h doesn't define one.
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING && !defined(PTHREAD_NULL)
+#define PTHREAD_NULL 0
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING && !defined(PTHREAD_NULL)
+
+namespace chip {
+namespace System {
+
+CHIP_ERROR LayerImplEpoll::Init()
+{
+    VerifyOrReturnError(mLayerState.SetInitializing(), CHIP_ERROR_INCORRECT_STATE);
+
+    RegisterPOSIXErrorFormatter();
+
+    mFreeSocketWatch = nullptr;
+    for (int i = kSocketWatchMax - 1; i >= 0; i--)
+    {
+        mSocketWatchPool[i].Clear();
+        mSocketWatchPool[i].mNextFree = mFreeSocketWatch;
+        mFreeSocketWatch              = &mSocketWatchPool[i];
+    }
+    mEventCount    = 0;
+    mWaitTimeoutMs = -1;
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    mHandleSelectThread = PTHREAD_NULL;
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+    mEpollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    VerifyOrReturnError(mEpollFd >= 0, CHIP_ERROR_POSIX(errno));
+
+    // Timers are multiplexed onto a single timerfd that is always armed for the earliest pending timer.
+    // The timer fd is the only registration that does not carry a SocketWatch pointer.
+    mTimerFd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    VerifyOrReturnError(mTimerFd >= 0, CHIP_ERROR_POSIX(errno));
+
+    struct epoll_event event = {};
+    event.events             = EPOLLIN;
+    event.data.ptr           = nullptr;
+    VerifyOrReturnError(::epoll_ctl(mEpollFd, EPOLL_CTL_ADD, mTimerFd, &event) == 0, CHIP_ERROR_POSIX(errno));
+
+    // Create an event to allow an arbitrary thread to wake the thread in the epoll loop.
+    ReturnErrorOnFailure(mWakeEvent.Open(*this));
+
+    VerifyOrReturnError(mLayerState.SetInitialized(), CHIP_ERROR_INCORRECT_STATE);
+    return CHIP_NO_ERROR;
+}
+
+void LayerImplEpoll::Shutdown()
+{
+    VerifyOrReturn(mLayerState.SetShuttingDown());
+
+    mTimerList.Clear();
+    mTimerPool.ReleaseAll();
+
+    mWakeEvent.Close(*this);
+
+    if (mTimerFd != kInvalidFd)
+    {
+        VerifyOrDie(::close(mTimerFd) == 0);
+        mTimerFd = kInvalidFd;
+    }
+    if (mEpollFd != kInvalidFd)
+    {
+        VerifyOrDie(::close(mEpollFd) == 0);
+        mEpollFd = kInvalidFd;
+    }
+
+    mLayerState.ResetFromShuttingDown(); // Return to uninitialized state to permit re-initialization.
+}
+
+void LayerImplEpoll::Signal()
+{
+    /*
+     * Wake up the I/O thread by setting the wake event.
+     *
+     * If this is being called from within an I/O event callback, then the notification can be skipped,
+     * since the I/O thread is already awake.
+     */
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    if (pthread_equal(mHandleSelectThread, pthread_self()))
+    {
+        return;
+    }
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+    // Send notification to wake up the epoll_wait call.
+    CHIP_ERROR status = mWakeEvent.Notify();
+    if (status != CHIP_NO_ERROR)
+    {
+        ChipLogError(chipSystemLayer, "System wake event notify failed: %" CHIP_ERROR_FORMAT, status.Format());
+    }
+}
+
+CHIP_ERROR LayerImplEpoll::StartTimer(Clock::Timeout delay, TimerCompleteCallback onComplete, void * appState)
+{
+    assertChipStackLockedByCurrentThread();
+
+    VerifyOrReturnError(mLayerState.IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+
+    CHIP_SYSTEM_FAULT_INJECT(FaultInjection::kFault_TimeoutImmediate, delay = System::Clock::kZero);
+
+    CancelTimer(onComplete, appState);
+
+    TimerList::Node * timer = mTimerPool.Create(*this, SystemClock().GetMonotonicTimestamp() + delay, onComplete, appState);
+    VerifyOrReturnError(timer != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    if (mTimerList.Add(timer) == timer)
+    {
+        // The new timer is the earliest, so the time until the next event has probably changed.
+        Signal();
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR LayerImplEpoll::ExtendTimerTo(Clock::Timeout delay, TimerCompleteCallback onComplete, void * appState)
+{
+    VerifyOrReturnError(delay.count() > 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    assertChipStackLockedByCurrentThread();
+
+    Clock::Timeout remainingTime = mTimerList.GetRemainingTime(onComplete, appState);
+    if (remainingTime.count() < delay.count())
+    {
+        if (remainingTime == Clock::kZero)
+        {
+            // If remaining time is Clock::kZero, it might possible that our timer is in
+            // the mExpiredTimers list and about to be fired. Remove it from that list, since we are extending it.
+            mExpiredTimers.Remove(onComplete, appState);
+        }
+        return StartTimer(delay, onComplete, appState);
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+bool LayerImplEpoll::IsTimerActive(TimerCompleteCallback onComplete, void * appState)
+{
+    bool timerIsActive = (mTimerList.GetRemainingTime(onComplete, appState) > Clock::kZero);
+
+    if (!timerIsActive)
+    {
+        // check if the timer is in the mExpiredTimers list about to be fired.
+        timerIsActive = (mExpiredTimers.Find(onComplete, appState) != nullptr);
+    }
+
+    return timerIsActive;
+}
+
+void LayerImplEpoll::CancelTimer(TimerCompleteCallback onComplete, void * appState)
+{
+    assertChipStackLockedByCurrentThread();
+
+    VerifyOrReturn(mLayerState.IsInitialized());
+
+    TimerList::Node * timer = mTimerList.Remove(onComplete, appState);
+    if (timer == nullptr)
+    {
+        // The timer was not in our "will fire in the future" list, but it might
+        // be in the "we're about to fire these" chunk we already grabbed from
+        // that list.  Check for it there too, and if found there we still want
+        // to cancel it.
+        timer = mExpiredTimers.Remove(onComplete, appState);
+    }
+    VerifyOrReturn(timer != nullptr);
+
+    mTimerPool.Release(timer);
+    Signal();
+}
+
+CHIP_ERROR LayerImplEpoll::ScheduleWork(TimerCompleteCallback onComplete, void * appState)
+{
+    assertChipStackLockedByCurrentThread();
+
+    VerifyOrReturnError(mLayerState.IsInitialized(), CHIP_ERROR_INCORRECT_STATE);
+
+    // As in LayerImplSelect, use an expires-ASAP timer as a closure that captures `this`, onComplete and appState,
+    // without cancelling existing timers with the same callback and appState.
+    TimerList::Node * timer = mTimerPool.Create(*this, SystemClock().GetMonotonicTimestamp(), onComplete, appState);
+    VerifyOrReturnError(timer != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    if (mTimerList.Add(timer) == timer)
+    {
+        // The new timer is the earliest, so the time until the next event has probably changed.
+        Signal();
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR LayerImplEpoll::StartWatchingSocket(int fd, SocketWatchToken * tokenOut)
+{
+    VerifyOrReturnError(fd >= 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+    // Duplicate registration is an error; the fd only reaches the kernel once a callback is requested,
+    // so check the pool rather than relying on EEXIST from epoll_ctl().
+    for (auto & w : mSocketWatchPool)
+    {
+        VerifyOrReturnError(w.mFD != fd, CHIP_ERROR_INVALID_ARGUMENT);
+    }
+
+    SocketWatch * watch = mFreeSocketWatch;
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_ENDPOINT_POOL_FULL);
+    mFreeSocketWatch = watch->mNextFree;
+
+    watch->mFD = fd;
+
+    *tokenOut = reinterpret_cast<SocketWatchToken>(watch);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR LayerImplEpoll::SetCallback(SocketWatchToken token, SocketWatchCallback callback, intptr_t data)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(token);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    watch->mCallback     = callback;
+    watch->mCallbackData = data;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR LayerImplEpoll::RequestCallbackOnPendingRead(SocketWatchToken token)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(token);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    watch->mPendingIO.Set(SocketEventFlags::kRead);
+    return UpdateInterest(*watch);
+}
+
+CHIP_ERROR LayerImplEpoll::RequestCallbackOnPendingWrite(SocketWatchToken token)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(token);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    watch->mPendingIO.Set(SocketEventFlags::kWrite);
+    return UpdateInterest(*watch);
+}
+
+CHIP_ERROR LayerImplEpoll::ClearCallbackOnPendingRead(SocketWatchToken token)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(token);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    watch->mPendingIO.Clear(SocketEventFlags::kRead);
+    return UpdateInterest(*watch);
+}
+
+CHIP_ERROR LayerImplEpoll::ClearCallbackOnPendingWrite(SocketWatchToken token)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(token);
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    watch->mPendingIO.Clear(SocketEventFlags::kWrite);
+    return UpdateInterest(*watch);
+}
+
+CHIP_ERROR LayerImplEpoll::StopWatchingSocket(SocketWatchToken * tokenInOut)
+{
+    SocketWatch * watch = reinterpret_cast<SocketWatch *>(*tokenInOut);
+    *tokenInOut         = InvalidSocketWatchToken();
+
+    VerifyOrReturnError(watch != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(watch->mFD >= 0, CHIP_ERROR_INCORRECT_STATE);
+
+    if (watch->mRegistered)
+    {
+        // Kernels before 2.6.9 require a non-null event even for EPOLL_CTL_DEL.
+        struct epoll_event event = {};
+        if (::epoll_ctl(mEpollFd, EPOLL_CTL_DEL, watch->mFD, &event) != 0)
+        {
+            ChipLogError(chipSystemLayer, "epoll_ctl(DEL) failed: %" CHIP_ERROR_FORMAT, CHIP_ERROR_POSIX(errno).Format());
+        }
+    }
+
+    // The watch may still be referenced by events gathered in the current epoll_wait() pass; drop those so that
+    // HandleEvents() does not dispatch to a released (or re-used) watch.
+    for (int i = 0; i < mEventCount; i++)
+    {
+        if (mEvents[i].data.ptr == watch)
+        {
+            mEvents[i].events = 0;
+        }
+    }
+
+    watch->Clear();
+    watch->mNextFree = mFreeSocketWatch;
+    mFreeSocketWatch = watch;
+
+    return CHIP_NO_ERROR;
+}
+
+/**
+ *  Synchronize the epoll interest list with the pending I/O requested for a watch.
+ *
+ *  The file descriptor is only registered while at least one of read or write is requested, since epoll
+ *  always reports error and hang-up conditions and a level-triggered registration with no consumer would
+ *  otherwise wake the loop continuously.
+ */
+CHIP_ERROR LayerImplEpoll::UpdateInterest(SocketWatch & watch)
+{
+    VerifyOrReturnError(watch.mFD >= 0, CHIP_ERROR_INCORRECT_STATE);
+
+    struct epoll_event event = {};
+    event.data.ptr           = &watch;
+    if (watch.mPendingIO.Has(SocketEventFlags::kRead))
+    {
+        event.events |= EPOLLIN;
+    }
+    if (watch.mPendingIO.Has(SocketEventFlags::kWrite))
+    {
+        event.events |= EPOLLOUT;
+    }
+
+    int op;
+    if (event.events == 0)
+    {
+        if (!watch.mRegistered)
+        {
+            return CHIP_NO_ERROR;
+        }
+        op = EPOLL_CTL_DEL;
+    }
+    else
+    {
+        op = watch.mRegistered ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+    }
+
+    VerifyOrReturnError(::epoll_ctl(mEpollFd, op, watch.mFD, &event) == 0, CHIP_ERROR_POSIX(errno));
+    watch.mRegistered = (op != EPOLL_CTL_DEL);
+    return CHIP_NO_ERROR;
+}
+
+void LayerImplEpoll::ArmTimerFd(Clock::Timeout sleepTime)
+{
+    // A zero it_value disarms the timer fd, which is what we want when no timer is pending or the
+    // earliest one is already due (in which case epoll_wait() does not block at all).
+    const Clock::Microseconds64 usec = sleepTime;
+    struct itimerspec spec           = {};
+    spec.it_value.tv_sec             = static_cast<time_t>(usec.count() / kMicrosecondsPerSecond);
+    spec.it_value.tv_nsec            = static_cast<long>((usec.count() % kMicrosecondsPerSecond) * kNanosecondsPerMicrosecond);
+
+    if (::timerfd_settime(mTimerFd, 0, &spec, nullptr) != 0)
+    {
+        ChipLogError(chipSystemLayer, "timerfd_settime failed: %" CHIP_ERROR_FORMAT, CHIP_ERROR_POSIX(errno).Format());
+    }
+}
+
+void LayerImplEpoll::PrepareEvents()
+{
+    assertChipStackLockedByCurrentThread();
+
+    Clock::Timeout sleepTime = Clock::kZero;
+    mWaitTimeoutMs           = -1;
+
+    TimerList::Node * timer = mTimerList.Earliest();
+    if (timer != nullptr)
+    {
+        const Clock::Timestamp currentTime = SystemClock().GetMonotonicTimestamp();
+        if (timer->AwakenTime() > currentTime)
+        {
+            sleepTime = timer->AwakenTime() - currentTime;
+        }
+        else
+        {
+            mWaitTimeoutMs = 0;
+        }
+    }
+
+    ArmTimerFd(sleepTime);
+}
+
+void LayerImplEpoll::WaitForEvents()
+{
+    mEventCount = ::epoll_wait(mEpollFd, mEvents, kMaxEventsPerWait, mWaitTimeoutMs);
+}
+
+void LayerImplEpoll::HandleEvents()
+{
+    assertChipStackLockedByCurrentThread();
+
+    if (!IsSelectResultValid())
+    {
+        if (errno != EINTR)
+        {
+            ChipLogError(DeviceLayer, "epoll_wait failed: %" CHIP_ERROR_FORMAT, CHIP_ERROR_POSIX(errno).Format());
+        }
+        mEventCount = 0;
+        return;
+    }
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    mHandleSelectThread = pthread_self();
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+    // Obtain the list of currently expired timers. Any new timers added by timer callback are NOT handled on this pass,
+    // since that could result in infinite handling of new timers blocking any other progress.
+    VerifyOrDieWithMsg(mExpiredTimers.Empty(), DeviceLayer, "Re-entry into HandleEvents from a timer callback?");
+    mExpiredTimers          = mTimerList.ExtractEarlier(Clock::Timeout(1) + SystemClock().GetMonotonicTimestamp());
+    TimerList::Node * timer = nullptr;
+    while ((timer = mExpiredTimers.PopEarliest()) != nullptr)
+    {
+        mTimerPool.Invoke(timer);
+    }
+
+    // Only sockets that are actually ready are visited, and each event maps directly to its watch.
+    for (int i = 0; i < mEventCount; i++)
+    {
+        const uint32_t revents = mEvents[i].events;
+        SocketWatch * watch    = static_cast<SocketWatch *>(mEvents[i].data.ptr);
+
+        if (watch == nullptr)
+        {
+            // Timer fd: drain the expiration count; expired timers were handled above.
+            uint64_t expirations;
+            if (::read(mTimerFd, &expirations, sizeof(expirations)) < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+            {
+                ChipLogError(chipSystemLayer, "timerfd read failed: %" CHIP_ERROR_FORMAT, CHIP_ERROR_POSIX(errno).Format());
+            }
+            continue;
+        }
+
+        SocketEvents events;
+        if (revents & EPOLLIN)
+        {
+            events.Set(SocketEventFlags::kRead);
+        }
+        if (revents & EPOLLOUT)
+        {
+            events.Set(SocketEventFlags::kWrite);
+        }
+        if (revents & (EPOLLERR | EPOLLHUP))
+        {
+            // select() reports a socket with a pending error as readable/writable, so that the owner discovers the
+            // error on its next I/O call. Preserve that for whatever the owner asked for.
+            events.Set(SocketEventFlags::kExcept);
+            events.Set(watch->mPendingIO);
+        }
+
+        if (events.HasAny() && watch->mCallback != nullptr)
+        {
+            watch->mCallback(events, watch->mCallbackData);
+        }
+    }
+    mEventCount = 0;
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    mHandleSelectThread = PTHREAD_NULL;
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+}
+
+void LayerImplEpoll::SocketWatch::Clear()
+{
+    mFD = kInvalidFd;
+    mPendingIO.ClearAll();
+    mRegistered   = false;
+    mCallback     = nullptr;
+    mCallbackData = 0;
+    mNextFree     = nullptr;
+}
+
+} // namespace System
+} // namespace chip
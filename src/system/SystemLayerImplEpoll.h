@@ -0,0 +1,141 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file declares an implementation of System::Layer using Linux epoll().
+ *
+ *      Unlike the select() based implementation, the cost of a wakeup is proportional
+ *      to the number of ready sockets rather than the number of watched sockets, and
+ *      file descriptors are not limited by FD_SETSIZE.
+ */
+
+#pragma once
+
+#include "system/SystemConfig.h"
+
+#if !CHIP_SYSTEM_CONFIG_USE_POSIX_SOCKETS || CHIP_SYSTEM_CONFIG_USE_DISPATCH || CHIP_SYSTEM_CONFIG_USE_LIBEV
+#error "The epoll System::Layer requires POSIX sockets and is exclusive with dispatch and libev"
+#endif
+
+#include <sys/epoll.h>
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+#include <atomic>
+#include <pthread.h>
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+#include <lib/support/ObjectLifeCycle.h>
+#include <system/SystemLayer.h>
+#include <system/SystemTimer.h>
+#include <system/WakeEvent.h>
+
+namespace chip {
+namespace System {
+
+class LayerImplEpoll : public LayerSocketsLoop
+{
+public:
+    LayerImplEpoll() = default;
+    ~LayerImplEpoll() override { VerifyOrDie(mLayerState.Destroy()); }
+
+    // Layer overrides.
+    CHIP_ERROR Init() override;
+    void Shutdown() override;
+    bool IsInitialized() const override { return mLayerState.IsInitialized(); }
+    CHIP_ERROR StartTimer(Clock::Timeout delay, TimerCompleteCallback onComplete, void * appState) override;
+    CHIP_ERROR ExtendTimerTo(Clock::Timeout delay, TimerCompleteCallback onComplete, void * appState) override;
+    bool IsTimerActive(TimerCompleteCallback onComplete, void * appState) override;
+    void CancelTimer(TimerCompleteCallback onComplete, void * appState) override;
+    CHIP_ERROR ScheduleWork(TimerCompleteCallback onComplete, void * appState) override;
+
+    // LayerSocket overrides.
+    CHIP_ERROR StartWatchingSocket(int fd, SocketWatchToken * tokenOut) override;
+    CHIP_ERROR SetCallback(SocketWatchToken token, SocketWatchCallback callback, intptr_t data) override;
+    CHIP_ERROR RequestCallbackOnPendingRead(SocketWatchToken token) override;
+    CHIP_ERROR RequestCallbackOnPendingWrite(SocketWatchToken token) override;
+    CHIP_ERROR ClearCallbackOnPendingRead(SocketWatchToken token) override;
+    CHIP_ERROR ClearCallbackOnPendingWrite(SocketWatchToken token) override;
+    CHIP_ERROR StopWatchingSocket(SocketWatchToken * tokenInOut) override;
+    SocketWatchToken InvalidSocketWatchToken() override { return reinterpret_cast<SocketWatchToken>(nullptr); }
+
+    // LayerSocketLoop overrides.
+    void Signal() override;
+    void EventLoopBegins() override {}
+    void PrepareEvents() override;
+    void WaitForEvents() override;
+    void HandleEvents() override;
+    void EventLoopEnds() override {}
+
+    // Expose the result of WaitForEvents() for non-blocking socket implementations.
+    bool IsSelectResultValid() const { return mEventCount >= 0; }
+
+protected:
+    static constexpr int kSocketWatchMax = (INET_CONFIG_ENABLE_TCP_ENDPOINT ? INET_CONFIG_NUM_TCP_ENDPOINTS : 0) +
+        (INET_CONFIG_ENABLE_UDP_ENDPOINT ? INET_CONFIG_NUM_UDP_ENDPOINTS : 0);
+
+    // One slot per socket watch, plus one for the timer file descriptor.
+    static constexpr int kMaxEventsPerWait = kSocketWatchMax + 1;
+
+    struct SocketWatch
+    {
+        void Clear();
+        int mFD;
+        SocketEvents mPendingIO;
+        // Whether mFD is currently part of the epoll interest list.
+        bool mRegistered;
+        SocketWatchCallback mCallback;
+        intptr_t mCallbackData;
+        // Next free watch, valid only while mFD == kInvalidFd.
+        SocketWatch * mNextFree;
+    };
+
+    CHIP_ERROR UpdateInterest(SocketWatch & watch);
+    void ArmTimerFd(Clock::Timeout sleepTime);
+
+    SocketWatch mSocketWatchPool[kSocketWatchMax];
+    SocketWatch * mFreeSocketWatch;
+
+    TimerPool<TimerList::Node> mTimerPool;
+    TimerList mTimerList;
+    // List of expired timers being processed right now.  Stored in a member so
+    // we can cancel them.
+    TimerList mExpiredTimers;
+
+    int mEpollFd = kInvalidFd;
+    int mTimerFd = kInvalidFd;
+
+    // Timeout passed to epoll_wait(): 0 when a timer is already due, -1 when the timer fd will wake us up.
+    int mWaitTimeoutMs;
+
+    // Ready events, carried between WaitForEvents() and HandleEvents().
+    struct epoll_event mEvents[kMaxEventsPerWait];
+    // Return value from epoll_wait(), carried between WaitForEvents() and HandleEvents().
+    int mEventCount;
+
+    ObjectLifeCycle mLayerState;
+    WakeEvent mWakeEvent;
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    std::atomic<pthread_t> mHandleSelectThread;
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+};
+
+using LayerImpl = LayerImplEpoll;
+
+} // namespace System
+} // namespace chip
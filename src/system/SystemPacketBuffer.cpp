@@ -126,6 +126,108 @@ void PacketBuffer::InternalCheck(const PacketBuffer * buffer)
 }
 #endif // CHIP_SYSTEM_PACKETBUFFER_HAS_CHECK
 
+#if CHIP_SYSTEM_PACKETBUFFER_HAS_HEAP_CACHE
+namespace {
+
+// Size classes for heap buffers, as AllocSize() upper bounds. A buffer whose AllocSize() fits a class is always allocated at the
+// full class size, so that any cached block of that class can satisfy any later request mapping to it.
+constexpr uint16_t kHeapCacheClassSizes[] = { 256, 512, PacketBuffer::kMaxSizeWithoutReserve };
+constexpr size_t kHeapCacheClassCount     = ArraySize(kHeapCacheClassSizes);
+constexpr size_t kNoHeapCacheClass        = kHeapCacheClassCount;
+
+size_t HeapCacheClass(size_t aAllocSize)
+{
+    for (size_t i = 0; i < kHeapCacheClassCount; i++)
+    {
+        if (aAllocSize <= kHeapCacheClassSizes[i])
+        {
+            return i;
+        }
+    }
+    return kNoHeapCacheClass;
+}
+
+// A freed block on a cache list. The link overlays the start of the (cleared) pbuf header.
+struct CachedBlock
+{
+    CachedBlock * next;
+};
+
+// Freed blocks kept by one thread. Being per-thread, the lists need no locking; a block freed on a different thread from the one
+// that allocated it simply moves to the freeing thread's cache.
+struct HeapCache
+{
+    ~HeapCache()
+    {
+        // Platform memory may already be shut down when a thread exits. The cache is only enabled when Platform::MemoryAlloc
+        // is malloc, so the blocks go straight back to the C heap.
+        for (size_t i = 0; i < kHeapCacheClassCount; i++)
+        {
+            while (mFreeList[i] != nullptr)
+            {
+                CachedBlock * block = mFreeList[i];
+                mFreeList[i]        = block->next;
+                SYSTEM_STATS_DECREMENT(chip::System::Stats::kSystemLayer_NumCachedPacketBufs);
+                free(block);
+            }
+        }
+    }
+
+    CachedBlock * mFreeList[kHeapCacheClassCount] = {};
+    size_t mCount[kHeapCacheClassCount]           = {};
+};
+
+thread_local HeapCache sHeapCache;
+
+} // namespace
+#endif // CHIP_SYSTEM_PACKETBUFFER_HAS_HEAP_CACHE
+
+// Allocates a heap block for a PacketBuffer with aAllocSize bytes of buffer space after the header.
+PacketBuffer * PacketBuffer::AllocateHeapBuffer(size_t aAllocSize)
+{
+#if CHIP_SYSTEM_PACKETBUFFER_HAS_HEAP_CACHE
+    const size_t sizeClass = HeapCacheClass(aAllocSize);
+    if (sizeClass != kNoHeapCacheClass)
+    {
+        HeapCache & cache   = sHeapCache;
+        CachedBlock * block = cache.mFreeList[sizeClass];
+        if (block != nullptr)
+        {
+            cache.mFreeList[sizeClass] = block->next;
+            cache.mCount[sizeClass]--;
+            SYSTEM_STATS_DECREMENT(chip::System::Stats::kSystemLayer_NumCachedPacketBufs);
+            return reinterpret_cast<PacketBuffer *>(block);
+        }
+        aAllocSize = kHeapCacheClassSizes[sizeClass];
+    }
+#endif // CHIP_SYSTEM_PACKETBUFFER_HAS_HEAP_CACHE
+
+    return reinterpret_cast<PacketBuffer *>(chip::Platform::MemoryAlloc(PacketBuffer::kStructureSize + aAllocSize));
+}
+
+// Releases a block obtained from AllocateHeapBuffer(aAllocSize).
+void PacketBuffer::FreeHeapBuffer(PacketBuffer * aBuffer, size_t aAllocSize)
+{
+#if CHIP_SYSTEM_PACKETBUFFER_HAS_HEAP_CACHE
+    const size_t sizeClass = HeapCacheClass(aAllocSize);
+    if (sizeClass != kNoHeapCacheClass)
+    {
+        HeapCache & cache = sHeapCache;
+        if (cache.mCount[sizeClass] < CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SIZE)
+        {
+            CachedBlock * block        = reinterpret_cast<CachedBlock *>(aBuffer);
+            block->next                = cache.mFreeList[sizeClass];
+            cache.mFreeList[sizeClass] = block;
+            cache.mCount[sizeClass]++;
+            SYSTEM_STATS_INCREMENT(chip::System::Stats::kSystemLayer_NumCachedPacketBufs);
+            return;
+        }
+    }
+#endif // CHIP_SYSTEM_PACKETBUFFER_HAS_HEAP_CACHE
+
+    chip::Platform::MemoryFree(aBuffer);
+}
+
 // Number of unused bytes below which \c RightSize() won't bother reallocating.
 constexpr uint16_t kRightSizingThreshold = 16;
 
@@ -145,9 +247,15 @@ void PacketBufferHandle::InternalRightSize()
     {
         return;
     }
+#if CHIP_SYSTEM_PACKETBUFFER_HAS_HEAP_CACHE
+    // A smaller buffer in the same size class would occupy the same block.
+    if (HeapCacheClass(usedSize) == HeapCacheClass(mBuffer->alloc_size))
+    {
+        return;
+    }
+#endif // CHIP_SYSTEM_PACKETBUFFER_HAS_HEAP_CACHE
 
-    const size_t blockSize   = usedSize + PacketBuffer::kStructureSize;
-    PacketBuffer * newBuffer = reinterpret_cast<PacketBuffer *>(chip::Platform::MemoryAlloc(blockSize));
+    PacketBuffer * newBuffer = PacketBuffer::AllocateHeapBuffer(usedSize);
     if (newBuffer == nullptr)
     {
         ChipLogError(chipSystemLayer, "PacketBuffer: pool EMPTY.");
@@ -527,7 +635,7 @@ PacketBufferHandle PacketBufferHandle::New(size_t aAvailableSize, uint16_t aRese
 
 #elif CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
 
-    lPacket = reinterpret_cast<PacketBuffer *>(chip::Platform::MemoryAlloc(lBlockSize));
+    lPacket = PacketBuffer::AllocateHeapBuffer(lAllocSize);
     SYSTEM_STATS_INCREMENT(chip::System::Stats::kSystemLayer_NumPacketBufs);
 
 #else
@@ -606,13 +714,14 @@ void PacketBuffer::Free(PacketBuffer * aPacket)
             SYSTEM_STATS_DECREMENT(chip::System::Stats::kSystemLayer_NumPacketBufs);
 #if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
             ::chip::Platform::MemoryDebugCheckPointer(aPacket, aPacket->alloc_size + kStructureSize);
+            const uint16_t lAllocSize = aPacket->alloc_size;
 #endif
             aPacket->Clear();
 #if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL
             aPacket->next = sFreeList;
             sFreeList     = aPacket;
 #elif CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
-            chip::Platform::MemoryFree(aPacket);
+            FreeHeapBuffer(aPacket, lAllocSize);
 #endif
             aPacket       = lNextPacket;
         }
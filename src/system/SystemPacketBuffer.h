@@ -369,6 +369,11 @@ private:
     static PacketBuffer * BuildFreeList();
 #endif // CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL || defined(DOXYGEN)
 
+#if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
+    static PacketBuffer * AllocateHeapBuffer(size_t aAllocSize);
+    static void FreeHeapBuffer(PacketBuffer * aBuffer, size_t aAllocSize);
+#endif // CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
+
 #if CHIP_SYSTEM_PACKETBUFFER_HAS_CHECK
     static void InternalCheck(const PacketBuffer * buffer);
 #endif
@@ -110,6 +110,17 @@
 #define CHIP_SYSTEM_PACKETBUFFER_HAS_RIGHTSIZE 0
 #endif
 
+/**
+ * CHIP_SYSTEM_PACKETBUFFER_HAS_HEAP_CACHE
+ *
+ * True if freed heap packet buffers are kept in per-thread size-class caches.
+ */
+#if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP && CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SIZE > 0 && CHIP_CONFIG_MEMORY_MGMT_MALLOC
+#define CHIP_SYSTEM_PACKETBUFFER_HAS_HEAP_CACHE 1
+#else
+#define CHIP_SYSTEM_PACKETBUFFER_HAS_HEAP_CACHE 0
+#endif
+
 /**
  * CHIP_SYSTEM_PACKETBUFFER_HAS_CHECK
  *
@@ -44,6 +44,7 @@ static const Label sStatsStrings[chip::System::Stats::kNumEntries] = {
 #undef LWIP_PBUF_MEMPOOL
 #else
     "Packet Buffers",
+    "Cached packet buffers",
 #endif
     "Timers",
 #if INET_CONFIG_NUM_TCP_ENDPOINTS
@@ -54,6 +55,7 @@ static const Label sStatsStrings[chip::System::Stats::kNumEntries] = {
 #endif
     "Exchange contexts",
     "Unsolicited message handlers",
+    "Retransmission table entries",
     "Platform events",
 };
 
@@ -58,6 +58,7 @@ enum
 #undef LWIP_PBUF_MEMPOOL
 #else
     kSystemLayer_NumPacketBufs,
+    kSystemLayer_NumCachedPacketBufs,
 #endif
     kSystemLayer_NumTimers,
 #if INET_CONFIG_NUM_TCP_ENDPOINTS
@@ -68,6 +69,7 @@ enum
 #endif
     kExchangeMgr_NumContexts,
     kExchangeMgr_NumUMHandlers,
+    kExchangeMgr_NumRetransEntries,
     kPlatformMgr_NumEvents,
     kNumEntries
 };
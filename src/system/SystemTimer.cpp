@@ -38,83 +38,175 @@
 namespace chip {
 namespace System {
 
-TimerList::Node * TimerList::Add(TimerList::Node * add)
+bool TimerList::IsEarlier(const Node * a, const Node * b)
 {
-    VerifyOrDie(add != mEarliestTimer);
-    if (mEarliestTimer == nullptr || (add->AwakenTime() < mEarliestTimer->AwakenTime()))
+    if (a->AwakenTime() != b->AwakenTime())
     {
-        add->mNextTimer = mEarliestTimer;
-        mEarliestTimer  = add;
+        return a->AwakenTime() < b->AwakenTime();
     }
-    else
+    // Sequence numbers may wrap around.
+    return static_cast<int32_t>(a->mSequence - b->mSequence) < 0;
+}
+
+TimerList::Node * TimerList::Meld(Node * a, Node * b)
+{
+    if (IsEarlier(b, a))
     {
-        TimerList::Node * lTimer = mEarliestTimer;
-        while (lTimer->mNextTimer)
+        Node * tmp = a;
+        a          = b;
+        b          = tmp;
+    }
+
+    // b becomes the first child of a.
+    b->mSibling  = a->mChild;
+    b->mPrevious = a;
+    if (a->mChild != nullptr)
+    {
+        a->mChild->mPrevious = b;
+    }
+    a->mChild    = b;
+    a->mSibling  = nullptr;
+    a->mPrevious = nullptr;
+    return a;
+}
+
+TimerList::Node * TimerList::MergePairs(Node * first)
+{
+    // First pass: meld the subtrees by pairs, from left to right, and stack the results.
+    Node * pairs = nullptr;
+    while (first != nullptr)
+    {
+        Node * a = first;
+        Node * b = a->mSibling;
+        first    = (b != nullptr) ? b->mSibling : nullptr;
+
+        a->mSibling  = nullptr;
+        a->mPrevious = nullptr;
+        if (b != nullptr)
         {
-            VerifyOrDie(lTimer->mNextTimer != add);
-            if (add->AwakenTime() < lTimer->mNextTimer->AwakenTime())
-            {
-                // found the insert location.
-                break;
-            }
-            lTimer = lTimer->mNextTimer;
+            b->mSibling  = nullptr;
+            b->mPrevious = nullptr;
+            a            = Meld(a, b);
         }
-        add->mNextTimer    = lTimer->mNextTimer;
-        lTimer->mNextTimer = add;
+        a->mSibling = pairs;
+        pairs       = a;
     }
-    return mEarliestTimer;
+
+    // Second pass: meld the results, from right to left.
+    Node * result = nullptr;
+    while (pairs != nullptr)
+    {
+        Node * next     = pairs->mSibling;
+        pairs->mSibling = nullptr;
+        result          = (result == nullptr) ? pairs : Meld(result, pairs);
+        pairs           = next;
+    }
+    return result;
 }
 
-TimerList::Node * TimerList::Remove(TimerList::Node * remove)
+size_t TimerList::BucketIndex(const void * appState)
+{
+    // Fibonacci hashing; the low bits of pointers are mostly zero.
+    const uint64_t hash = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(appState)) * UINT64_C(0x9E3779B97F4A7C15);
+    return static_cast<size_t>(hash >> 32) & (kNumBuckets - 1);
+}
+
+TimerList::Node * TimerList::FindInBucket(TimerCompleteCallback aOnComplete, void * aAppState) const
+{
+    Node * found = nullptr;
+    for (Node * timer = mBuckets[BucketIndex(aAppState)]; timer != nullptr; timer = timer->mNextInBucket)
+    {
+        if (timer->GetCallback().GetOnComplete() == aOnComplete && timer->GetCallback().GetAppState() == aAppState &&
+            (found == nullptr || IsEarlier(timer, found)))
+        {
+            found = timer;
+        }
+    }
+    return found;
+}
+
+void TimerList::Insert(Node * timer)
 {
-    if (mEarliestTimer != nullptr && remove != nullptr)
+    timer->mChild    = nullptr;
+    timer->mSibling  = nullptr;
+    timer->mPrevious = nullptr;
+    mEarliestTimer   = (mEarliestTimer == nullptr) ? timer : Meld(mEarliestTimer, timer);
+
+    Node *& bucket       = mBuckets[BucketIndex(timer->GetCallback().GetAppState())];
+    timer->mNextInBucket = bucket;
+    bucket               = timer;
+}
+
+void TimerList::Unlink(Node * timer)
+{
+    if (timer == mEarliestTimer)
+    {
+        mEarliestTimer = MergePairs(timer->mChild);
+    }
+    else
     {
-        if (remove == mEarliestTimer)
+        // Detach the subtree rooted at timer, then meld its children back into the heap.
+        if (timer->mPrevious->mChild == timer)
         {
-            mEarliestTimer = remove->mNextTimer;
+            timer->mPrevious->mChild = timer->mSibling;
         }
         else
         {
-            TimerList::Node * lTimer = mEarliestTimer;
-
-            while (lTimer->mNextTimer)
-            {
-                if (remove == lTimer->mNextTimer)
-                {
-                    lTimer->mNextTimer = remove->mNextTimer;
-                    break;
-                }
-
-                lTimer = lTimer->mNextTimer;
-            }
+            timer->mPrevious->mSibling = timer->mSibling;
         }
+        if (timer->mSibling != nullptr)
+        {
+            timer->mSibling->mPrevious = timer->mPrevious;
+        }
+
+        Node * children = MergePairs(timer->mChild);
+        if (children != nullptr)
+        {
+            mEarliestTimer = Meld(mEarliestTimer, children);
+        }
+    }
+    timer->mChild    = nullptr;
+    timer->mSibling  = nullptr;
+    timer->mPrevious = nullptr;
 
-        remove->mNextTimer = nullptr;
+    for (Node ** link = &mBuckets[BucketIndex(timer->GetCallback().GetAppState())]; *link != nullptr;
+         link         = &(*link)->mNextInBucket)
+    {
+        if (*link == timer)
+        {
+            *link = timer->mNextInBucket;
+            break;
+        }
+    }
+    timer->mNextInBucket = nullptr;
+}
+
+TimerList::Node * TimerList::Add(TimerList::Node * add)
+{
+    VerifyOrDie(add != mEarliestTimer);
+    add->mSequence = mNextSequence++;
+    Insert(add);
+    return mEarliestTimer;
+}
+
+TimerList::Node * TimerList::Remove(TimerList::Node * remove)
+{
+    // A timer is in the list if it is the root of the heap or has a parent or sibling before it.
+    if (remove != nullptr && (remove == mEarliestTimer || remove->mPrevious != nullptr))
+    {
+        Unlink(remove);
     }
     return mEarliestTimer;
 }
 
 TimerList::Node * TimerList::Remove(TimerCompleteCallback aOnComplete, void * aAppState)
 {
-    TimerList::Node * previous = nullptr;
-    for (TimerList::Node * timer = mEarliestTimer; timer != nullptr; timer = timer->mNextTimer)
+    Node * timer = FindInBucket(aOnComplete, aAppState);
+    if (timer != nullptr)
     {
-        if (timer->GetCallback().GetOnComplete() == aOnComplete && timer->GetCallback().GetAppState() == aAppState)
-        {
-            if (previous == nullptr)
-            {
-                mEarliestTimer = timer->mNextTimer;
-            }
-            else
-            {
-                previous->mNextTimer = timer->mNextTimer;
-            }
-            timer->mNextTimer = nullptr;
-            return timer;
-        }
-        previous = timer;
+        Unlink(timer);
     }
-    return nullptr;
+    return timer;
 }
 
 TimerList::Node * TimerList::PopEarliest()
@@ -124,8 +216,7 @@ TimerList::Node * TimerList::PopEarliest()
         return nullptr;
     }
     TimerList::Node * earliest = mEarliestTimer;
-    mEarliestTimer             = mEarliestTimer->mNextTimer;
-    earliest->mNextTimer       = nullptr;
+    Unlink(earliest);
     return earliest;
 }
 
@@ -135,44 +226,59 @@ TimerList::Node * TimerList::PopIfEarlier(Clock::Timestamp t)
     {
         return nullptr;
     }
-    TimerList::Node * earliest = mEarliestTimer;
-    mEarliestTimer             = mEarliestTimer->mNextTimer;
-    earliest->mNextTimer       = nullptr;
-    return earliest;
+    return PopEarliest();
 }
 
 TimerList TimerList::ExtractEarlier(Clock::Timestamp t)
 {
     TimerList out;
 
-    if ((mEarliestTimer != nullptr) && (mEarliestTimer->AwakenTime() < t))
+    // Keep the order of the timers, including the ones that expire at the same time.
+    out.mNextSequence = mNextSequence;
+    TimerList::Node * timer;
+    while ((timer = PopIfEarlier(t)) != nullptr)
+    {
+        out.Insert(timer);
+    }
+
+    return out;
+}
+
+void TimerList::Clear()
+{
+    // Every timer is in exactly one bucket; forget about the heap links too, so that a removed timer is not mistaken for one
+    // that is still in the list.
+    for (Node *& bucket : mBuckets)
     {
-        out.mEarliestTimer    = mEarliestTimer;
-        TimerList::Node * end = mEarliestTimer;
-        while ((end->mNextTimer != nullptr) && (end->mNextTimer->AwakenTime() < t))
+        while (bucket != nullptr)
         {
-            end = end->mNextTimer;
+            Node * timer         = bucket;
+            bucket               = timer->mNextInBucket;
+            timer->mChild        = nullptr;
+            timer->mSibling      = nullptr;
+            timer->mPrevious     = nullptr;
+            timer->mNextInBucket = nullptr;
         }
-        mEarliestTimer  = end->mNextTimer;
-        end->mNextTimer = nullptr;
     }
+    mEarliestTimer = nullptr;
+    mNextSequence  = 0;
+}
 
-    return out;
+TimerList::Node * TimerList::Find(TimerCompleteCallback aOnComplete, void * aAppState) const
+{
+    return FindInBucket(aOnComplete, aAppState);
 }
 
 Clock::Timeout TimerList::GetRemainingTime(TimerCompleteCallback aOnComplete, void * aAppState)
 {
-    for (TimerList::Node * timer = mEarliestTimer; timer != nullptr; timer = timer->mNextTimer)
+    TimerList::Node * timer = FindInBucket(aOnComplete, aAppState);
+    if (timer != nullptr)
     {
-        if (timer->GetCallback().GetOnComplete() == aOnComplete && timer->GetCallback().GetAppState() == aAppState)
-        {
-            Clock::Timestamp currentTime = SystemClock().GetMonotonicTimestamp();
+        Clock::Timestamp currentTime = SystemClock().GetMonotonicTimestamp();
 
-            if (currentTime < timer->AwakenTime())
-            {
-                return Clock::Timeout(timer->AwakenTime() - currentTime);
-            }
-            return Clock::kZero;
+        if (currentTime < timer->AwakenTime())
+        {
+            return Clock::Timeout(timer->AwakenTime() - currentTime);
         }
     }
     return Clock::kZero;
@@ -105,7 +105,13 @@ private:
 };
 
 /**
- * List of `Timer`s ordered by expiration time.
+ * Set of `Timer`s ordered by expiration time.
+ *
+ * Timers are kept in an intrusive pairing heap, so that adding a timer takes constant time and removing one takes
+ * logarithmic amortized time, and are also hashed by application state so that a timer can be found by its callback
+ * without visiting every pending timer. Timers with the same expiration time are ordered by insertion.
+ *
+ * A timer can be in at most one list at a time.
  */
 class TimerList
 {
@@ -114,12 +120,20 @@ public:
     {
     public:
         Node(Layer & systemLayer, System::Clock::Timestamp awakenTime, TimerCompleteCallback onComplete, void * appState) :
-            TimerData(systemLayer, awakenTime, onComplete, appState), mNextTimer(nullptr)
+            TimerData(systemLayer, awakenTime, onComplete, appState)
         {}
-        Node * mNextTimer;
+
+    private:
+        friend class TimerList;
+
+        Node * mChild        = nullptr; // Earliest child in the heap.
+        Node * mSibling      = nullptr; // Next sibling in the heap.
+        Node * mPrevious     = nullptr; // Parent if this is the first child, previous sibling otherwise.
+        Node * mNextInBucket = nullptr;
+        uint32_t mSequence   = 0; // Orders timers with the same expiration time.
     };
 
-    TimerList() : mEarliestTimer(nullptr) {}
+    TimerList() : mEarliestTimer(nullptr), mBuckets(), mNextSequence(0) {}
 
     /**
      * Add a timer to the list
@@ -177,7 +191,14 @@ public:
     /**
      * Remove all timers.
      */
-    void Clear() { mEarliestTimer = nullptr; }
+    void Clear();
+
+    /**
+     * Find the first timer with the given properties, if present.
+     *
+     * @return  The timer, or nullptr if the list contains no matching timer.
+     */
+    Node * Find(TimerCompleteCallback aOnComplete, void * aAppState) const;
 
     /**
      * Find the timer with the given properties, if present, and return its remaining time
@@ -187,7 +208,21 @@ public:
     Clock::Timeout GetRemainingTime(TimerCompleteCallback aOnComplete, void * aAppState);
 
 private:
+    static constexpr size_t kNumBuckets = CHIP_SYSTEM_CONFIG_TIMER_LIST_BUCKETS;
+    static_assert(kNumBuckets > 0 && (kNumBuckets & (kNumBuckets - 1)) == 0, "The number of buckets must be a power of two");
+
+    static bool IsEarlier(const Node * a, const Node * b);
+    static Node * Meld(Node * a, Node * b);
+    static Node * MergePairs(Node * first);
+    static size_t BucketIndex(const void * appState);
+
+    Node * FindInBucket(TimerCompleteCallback aOnComplete, void * aAppState) const;
+    void Insert(Node * timer);
+    void Unlink(Node * timer);
+
     Node * mEarliestTimer;
+    Node * mBuckets[kNumBuckets];
+    uint32_t mNextSequence;
 };
 
 /**
@@ -40,6 +40,7 @@
 #include <lib/support/UnitTestRegistration.h>
 #include <platform/CHIPDeviceLayer.h>
 #include <system/SystemPacketBuffer.h>
+#include <system/SystemStats.h>
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
 #include <lwip/init.h>
@@ -132,6 +133,7 @@ public:
     static void CheckHandleAdvance(nlTestSuite * inSuite, void * inContext);
     static void CheckHandleRightSize(nlTestSuite * inSuite, void * inContext);
     static void CheckHandleCloneData(nlTestSuite * inSuite, void * inContext);
+    static void CheckHeapCache(nlTestSuite * inSuite, void * inContext);
     static void CheckPacketBufferWriter(nlTestSuite * inSuite, void * inContext);
     static void CheckBuildFreeList(nlTestSuite * inSuite, void * inContext);
 
@@ -1937,6 +1939,62 @@ void PacketBufferTest::CheckHandleCloneData(nlTestSuite * inSuite, void * inCont
 #endif // CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
 }
 
+void PacketBufferTest::CheckHeapCache(nlTestSuite * inSuite, void * inContext)
+{
+    struct TestContext * const theContext = static_cast<struct TestContext *>(inContext);
+    PacketBufferTest * const test         = theContext->test;
+    NL_TEST_ASSERT(inSuite, test->mContext == theContext);
+
+#if CHIP_SYSTEM_PACKETBUFFER_HAS_HEAP_CACHE
+
+    // A freed buffer is handed out again for any request in the same size class.
+    PacketBufferHandle handle = PacketBufferHandle::New(100, 0);
+    NL_TEST_ASSERT(inSuite, !handle.IsNull());
+    const PacketBuffer * const small = handle.mBuffer;
+    handle                           = nullptr;
+
+    handle = PacketBufferHandle::New(200, 10);
+    NL_TEST_ASSERT(inSuite, handle.mBuffer == small);
+    NL_TEST_ASSERT(inSuite, handle->AvailableDataLength() == 200);
+    NL_TEST_ASSERT(inSuite, handle->ReservedSize() == 10);
+    handle = nullptr;
+
+    // Requests in other size classes do not use it.
+    handle = PacketBufferHandle::New(PacketBuffer::kMaxSize);
+    NL_TEST_ASSERT(inSuite, !handle.IsNull());
+    NL_TEST_ASSERT(inSuite, handle.mBuffer != small);
+    const PacketBuffer * const large = handle.mBuffer;
+    handle                           = nullptr;
+
+    handle = PacketBufferHandle::New(400, 0);
+    NL_TEST_ASSERT(inSuite, handle.mBuffer != small && handle.mBuffer != large);
+    handle = nullptr;
+
+    // The cache is bounded; buffers beyond its size are released to the heap.
+    std::vector<PacketBufferHandle> buffers;
+    for (int i = 0; i < CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SIZE + 2; i++)
+    {
+        buffers.push_back(PacketBufferHandle::New(PacketBuffer::kMaxSize));
+        NL_TEST_ASSERT(inSuite, !buffers.back().IsNull());
+    }
+    buffers.clear();
+
+#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    const chip::System::Stats::count_t * const inUse = chip::System::Stats::GetResourcesInUse();
+    const int cached                                 = inUse[chip::System::Stats::kSystemLayer_NumCachedPacketBufs];
+    for (int i = 0; i < CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SIZE + 1; i++)
+    {
+        buffers.push_back(PacketBufferHandle::New(PacketBuffer::kMaxSize));
+    }
+    NL_TEST_ASSERT(inSuite,
+                   cached - inUse[chip::System::Stats::kSystemLayer_NumCachedPacketBufs] ==
+                       CHIP_SYSTEM_CONFIG_PACKETBUFFER_HEAP_CACHE_SIZE);
+    buffers.clear();
+#endif // CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+
+#endif // CHIP_SYSTEM_PACKETBUFFER_HAS_HEAP_CACHE
+}
+
 void PacketBufferTest::CheckPacketBufferWriter(nlTestSuite * inSuite, void * inContext)
 {
     struct TestContext * const theContext = static_cast<struct TestContext *>(inContext);
@@ -2005,6 +2063,7 @@ const nlTest sTests[] =
     NL_TEST_DEF("PacketBuffer::HandleAdvance",          PacketBufferTest::CheckHandleAdvance),
     NL_TEST_DEF("PacketBuffer::HandleRightSize",        PacketBufferTest::CheckHandleRightSize),
     NL_TEST_DEF("PacketBuffer::HandleCloneData",        PacketBufferTest::CheckHandleCloneData),
+    NL_TEST_DEF("PacketBuffer::HeapCache",              PacketBufferTest::CheckHeapCache),
     NL_TEST_DEF("PacketBuffer::PacketBufferWriter",     PacketBufferTest::CheckPacketBufferWriter),
 
     NL_TEST_SENTINEL()
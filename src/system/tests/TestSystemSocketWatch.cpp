@@ -0,0 +1,245 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This is a unit test suite for the socket watches of the event loop based
+ *      implementations of <tt>chip::System::Layer</tt>.
+ *
+ */
+
+#include <system/SystemConfig.h>
+
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <nlunit-test.h>
+#include <system/SystemLayerImpl.h>
+
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS && !CHIP_SYSTEM_CONFIG_USE_DISPATCH && !CHIP_SYSTEM_CONFIG_USE_LIBEV
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace chip;
+using namespace chip::System;
+
+namespace {
+
+struct Watch
+{
+    int mFds[2] = { -1, -1 };
+    SocketWatchToken mToken = {};
+    int mCallbackCount = 0;
+    SocketEvents mEvents;
+    // Watch to stop from the callback, if any.
+    Watch * mStopOther = nullptr;
+};
+
+struct TestContext
+{
+    LayerImpl mLayer;
+};
+
+TestContext sContext;
+
+void OnSocketEvent(SocketEvents events, intptr_t data)
+{
+    Watch & watch = *reinterpret_cast<Watch *>(data);
+    watch.mCallbackCount++;
+    watch.mEvents = events;
+
+    if (watch.mStopOther != nullptr)
+    {
+        sContext.mLayer.StopWatchingSocket(&watch.mStopOther->mToken);
+    }
+}
+
+void OnTimer(Layer * aLayer, void * aAppState) {}
+
+bool OpenWatch(TestContext & ctx, Watch & watch)
+{
+    VerifyOrReturnValue(::socketpair(AF_UNIX, SOCK_DGRAM, 0, watch.mFds) == 0, false);
+    VerifyOrReturnValue(ctx.mLayer.StartWatchingSocket(watch.mFds[0], &watch.mToken) == CHIP_NO_ERROR, false);
+    return ctx.mLayer.SetCallback(watch.mToken, OnSocketEvent, reinterpret_cast<intptr_t>(&watch)) == CHIP_NO_ERROR;
+}
+
+void CloseWatch(TestContext & ctx, Watch & watch)
+{
+    if (watch.mToken != ctx.mLayer.InvalidSocketWatchToken())
+    {
+        ctx.mLayer.StopWatchingSocket(&watch.mToken);
+    }
+    ::close(watch.mFds[0]);
+    ::close(watch.mFds[1]);
+}
+
+void MakeReadable(Watch & watch)
+{
+    const uint8_t datagram = 0x42;
+    VerifyOrDie(::write(watch.mFds[1], &datagram, sizeof(datagram)) == sizeof(datagram));
+}
+
+// Runs one pass of the event loop, bounded by a short timer so that it does not
+// block when no socket is ready.
+void ServiceEvents(TestContext & ctx)
+{
+    ctx.mLayer.StartTimer(Clock::Milliseconds32(5), OnTimer, nullptr);
+    ctx.mLayer.PrepareEvents();
+    ctx.mLayer.WaitForEvents();
+    ctx.mLayer.HandleEvents();
+    ctx.mLayer.CancelTimer(OnTimer, nullptr);
+}
+
+void CheckReadCallback(nlTestSuite * inSuite, void * aContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(aContext);
+
+    Watch watch;
+    NL_TEST_ASSERT(inSuite, OpenWatch(ctx, watch));
+    NL_TEST_ASSERT(inSuite, ctx.mLayer.RequestCallbackOnPendingRead(watch.mToken) == CHIP_NO_ERROR);
+
+    // Nothing to read yet
+    ServiceEvents(ctx);
+    NL_TEST_ASSERT(inSuite, watch.mCallbackCount == 0);
+
+    MakeReadable(watch);
+    ServiceEvents(ctx);
+    NL_TEST_ASSERT(inSuite, watch.mCallbackCount == 1);
+    NL_TEST_ASSERT(inSuite, watch.mEvents.Has(SocketEventFlags::kRead));
+    NL_TEST_ASSERT(inSuite, !watch.mEvents.Has(SocketEventFlags::kWrite));
+
+    // The datagram is still pending, but the read request is gone
+    NL_TEST_ASSERT(inSuite, ctx.mLayer.ClearCallbackOnPendingRead(watch.mToken) == CHIP_NO_ERROR);
+    ServiceEvents(ctx);
+    NL_TEST_ASSERT(inSuite, watch.mCallbackCount == 1);
+
+    CloseWatch(ctx, watch);
+}
+
+void CheckWriteCallback(nlTestSuite * inSuite, void * aContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(aContext);
+
+    Watch watch;
+    NL_TEST_ASSERT(inSuite, OpenWatch(ctx, watch));
+    NL_TEST_ASSERT(inSuite, ctx.mLayer.RequestCallbackOnPendingWrite(watch.mToken) == CHIP_NO_ERROR);
+
+    ServiceEvents(ctx);
+    NL_TEST_ASSERT(inSuite, watch.mCallbackCount == 1);
+    NL_TEST_ASSERT(inSuite, watch.mEvents.Has(SocketEventFlags::kWrite));
+    NL_TEST_ASSERT(inSuite, !watch.mEvents.Has(SocketEventFlags::kRead));
+
+    NL_TEST_ASSERT(inSuite, ctx.mLayer.ClearCallbackOnPendingWrite(watch.mToken) == CHIP_NO_ERROR);
+    ServiceEvents(ctx);
+    NL_TEST_ASSERT(inSuite, watch.mCallbackCount == 1);
+
+    CloseWatch(ctx, watch);
+}
+
+void CheckStopWatchingFromCallback(nlTestSuite * inSuite, void * aContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(aContext);
+
+    // Both sockets are ready in the same pass; whichever callback runs first stops
+    // watching the other socket, whose callback must then not run.
+    Watch first;
+    Watch second;
+    first.mStopOther  = &second;
+    second.mStopOther = &first;
+    NL_TEST_ASSERT(inSuite, OpenWatch(ctx, first));
+    NL_TEST_ASSERT(inSuite, OpenWatch(ctx, second));
+    NL_TEST_ASSERT(inSuite, ctx.mLayer.RequestCallbackOnPendingRead(first.mToken) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, ctx.mLayer.RequestCallbackOnPendingRead(second.mToken) == CHIP_NO_ERROR);
+
+    MakeReadable(first);
+    MakeReadable(second);
+    ServiceEvents(ctx);
+    NL_TEST_ASSERT(inSuite, first.mCallbackCount + second.mCallbackCount == 1);
+
+    CloseWatch(ctx, first);
+    CloseWatch(ctx, second);
+}
+
+void CheckWatchReuse(nlTestSuite * inSuite, void * aContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(aContext);
+
+    // Watches are returned to the layer and can be taken again, many more times
+    // than the layer has watches.
+    for (int i = 0; i < 100; i++)
+    {
+        Watch watch;
+        NL_TEST_ASSERT(inSuite, OpenWatch(ctx, watch));
+        NL_TEST_ASSERT(inSuite, ctx.mLayer.RequestCallbackOnPendingRead(watch.mToken) == CHIP_NO_ERROR);
+
+        MakeReadable(watch);
+        ServiceEvents(ctx);
+        NL_TEST_ASSERT(inSuite, watch.mCallbackCount == 1);
+
+        CloseWatch(ctx, watch);
+    }
+}
+
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("SocketWatch::ReadCallback",             CheckReadCallback),
+    NL_TEST_DEF("SocketWatch::WriteCallback",            CheckWriteCallback),
+    NL_TEST_DEF("SocketWatch::StopWatchingFromCallback", CheckStopWatchingFromCallback),
+    NL_TEST_DEF("SocketWatch::WatchReuse",               CheckWatchReuse),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int TestSetup(void * aContext)
+{
+    VerifyOrReturnError(Platform::MemoryInit() == CHIP_NO_ERROR, FAILURE);
+
+    VerifyOrReturnError(sContext.mLayer.Init() == CHIP_NO_ERROR, FAILURE);
+    return SUCCESS;
+}
+
+int TestTeardown(void * aContext)
+{
+    sContext.mLayer.Shutdown();
+
+    Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+} // namespace
+
+int TestSystemSocketWatch()
+{
+    nlTestSuite theSuite = { "chip-system-socket-watch", &sTests[0], TestSetup, TestTeardown };
+
+    // Run test suite against one context.
+    nlTestRunner(&theSuite, &sContext);
+    return nlTestRunnerStats(&theSuite);
+}
+
+#else // CHIP_SYSTEM_CONFIG_USE_SOCKETS && !CHIP_SYSTEM_CONFIG_USE_DISPATCH && !CHIP_SYSTEM_CONFIG_USE_LIBEV
+
+int TestSystemSocketWatch()
+{
+    return SUCCESS;
+}
+
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS && !CHIP_SYSTEM_CONFIG_USE_DISPATCH && !CHIP_SYSTEM_CONFIG_USE_LIBEV
+
+CHIP_REGISTER_TEST_SUITE(TestSystemSocketWatch)
@@ -30,6 +30,7 @@
 #include <system/SystemConfig.h>
 
 #include <lib/core/ErrorStr.h>
+#include <lib/support/CHIPMem.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/UnitTestContext.h>
 #include <lib/support/UnitTestRegistration.h>
@@ -439,6 +440,7 @@ class TestTimer
 {
 public:
     static void CheckTimerPool(nlTestSuite * inSuite, void * aContext);
+    static void CheckTimerListChurn(nlTestSuite * inSuite, void * aContext);
 };
 } // namespace System
 } // namespace chip
@@ -580,6 +582,95 @@ void chip::System::TestTimer::CheckTimerPool(nlTestSuite * inSuite, void * aCont
     NL_TEST_ASSERT(suite, SYSTEM_STATS_TEST_HIGH_WATER_MARK(Stats::kSystemLayer_NumTimers, 4));
 }
 
+// Start, reschedule and cancel many timers, as a controller with many subscriptions and exchanges does, and check that they
+// still expire in order.
+void chip::System::TestTimer::CheckTimerListChurn(nlTestSuite * inSuite, void * aContext)
+{
+    TestContext & testContext = *static_cast<TestContext *>(aContext);
+    Layer & systemLayer       = *testContext.mLayer;
+    nlTestSuite * const suite = testContext.mTestSuite;
+
+    using Timer = TimerList::Node;
+    struct TestState
+    {
+        static void Callback(Layer * layer, void * state) {}
+    };
+
+    constexpr size_t kNumTimers = 1000;
+    Timer * timers[kNumTimers];
+    uint32_t addOrder[kNumTimers];
+    uint8_t appStates[kNumTimers];
+    uint32_t nextAddOrder = 0;
+    TimerList list;
+
+    // Few distinct expiration times, so that many timers expire together.
+    auto awakenTime = [](size_t i, size_t round) {
+        return Clock::Timestamp(static_cast<uint64_t>((i * 7919 + round * 104729) % 97));
+    };
+
+    for (size_t i = 0; i < kNumTimers; i++)
+    {
+        timers[i] = chip::Platform::New<Timer>(systemLayer, awakenTime(i, 0), TestState::Callback, &appStates[i]);
+        NL_TEST_ASSERT(suite, timers[i] != nullptr);
+        list.Add(timers[i]);
+        addOrder[i] = nextAddOrder++;
+    }
+
+    for (size_t round = 1; round <= 3; round++)
+    {
+        for (size_t i = round; i < kNumTimers; i += 3)
+        {
+            // Cancel by callback, or by timer, then start again with a new expiration time.
+            Timer * timer = timers[i];
+            if (i % 2 == 0)
+            {
+                NL_TEST_ASSERT(suite, list.Remove(TestState::Callback, &appStates[i]) == timer);
+            }
+            else
+            {
+                list.Remove(timer);
+            }
+            NL_TEST_ASSERT(suite, list.Find(TestState::Callback, &appStates[i]) == nullptr);
+            list.Remove(timer); // Not in the list anymore: no-op.
+
+            timers[i] = chip::Platform::New<Timer>(systemLayer, awakenTime(i, round), TestState::Callback, &appStates[i]);
+            chip::Platform::Delete(timer);
+            NL_TEST_ASSERT(suite, timers[i] != nullptr);
+            list.Add(timers[i]);
+            addOrder[i] = nextAddOrder++;
+            NL_TEST_ASSERT(suite, list.Find(TestState::Callback, &appStates[i]) == timers[i]);
+        }
+    }
+
+    // Timers expire by time, then in the order they were started.
+    TimerList early  = list.ExtractEarlier(Clock::Timestamp(48));
+    size_t count     = 0;
+    Timer * previous = nullptr;
+    for (TimerList * current : { &early, &list })
+    {
+        Timer * timer;
+        while ((timer = current->PopEarliest()) != nullptr)
+        {
+            const size_t i = static_cast<size_t>(static_cast<uint8_t *>(timer->GetCallback().GetAppState()) - appStates);
+            NL_TEST_ASSERT(suite, timers[i] == timer);
+            NL_TEST_ASSERT(suite, (current == &early) == (timer->AwakenTime() < Clock::Timestamp(48)));
+            if (previous != nullptr)
+            {
+                const size_t j = static_cast<size_t>(static_cast<uint8_t *>(previous->GetCallback().GetAppState()) - appStates);
+                NL_TEST_ASSERT(suite,
+                               previous->AwakenTime() < timer->AwakenTime() ||
+                                   (previous->AwakenTime() == timer->AwakenTime() && addOrder[j] < addOrder[i]));
+                chip::Platform::Delete(previous);
+            }
+            previous = timer;
+            count++;
+        }
+    }
+    chip::Platform::Delete(previous);
+    NL_TEST_ASSERT(suite, count == kNumTimers);
+    NL_TEST_ASSERT(suite, list.Empty() && early.Empty());
+}
+
 static void ExtendTimerToTest(nlTestSuite * inSuite, void * aContext)
 {
     if (!LayerEvents<LayerImpl>::HasServiceEvents())
@@ -723,6 +814,7 @@ static const nlTest sTests[] =
     NL_TEST_DEF("Timer::TestTimerOrder",           CheckOrder),
     NL_TEST_DEF("Timer::TestTimerCancellation",    CheckCancellation),
     NL_TEST_DEF("Timer::TestTimerPool",            chip::System::TestTimer::CheckTimerPool),
+    NL_TEST_DEF("Timer::TestTimerListChurn",       chip::System::TestTimer::CheckTimerListChurn),
     NL_TEST_DEF("Timer::TestCancelTimer",          CancelTimerTest::Test),
     NL_TEST_DEF("Timer::ExtendTimerTo",            ExtendTimerToTest),
     NL_TEST_DEF("Timer::TestIsTimerActive",        IsTimerActiveTest),
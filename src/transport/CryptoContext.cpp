@@ -55,6 +55,9 @@ CryptoContext::CryptoContext() : mKeyAvailable(false) {}
 
 CryptoContext::~CryptoContext()
 {
+    mEncryptionCipher.Clear();
+    mDecryptionCipher.Clear();
+
     if (mKeystore)
     {
         mKeystore->DestroyKey(mEncryptionKey);
@@ -105,6 +108,20 @@ CHIP_ERROR CryptoContext::InitFromSecret(SessionKeystore & keystore, const ByteS
 
 #endif
 
+    CHIP_ERROR err = mEncryptionCipher.Init(mEncryptionKey);
+    if (err == CHIP_NO_ERROR)
+    {
+        err = mDecryptionCipher.Init(mDecryptionKey);
+    }
+    if (err != CHIP_NO_ERROR)
+    {
+        mEncryptionCipher.Clear();
+        mDecryptionCipher.Clear();
+        keystore.DestroyKey(mEncryptionKey);
+        keystore.DestroyKey(mDecryptionKey);
+        return err;
+    }
+
     mKeyAvailable = true;
     mSessionRole  = role;
     mKeystore     = &keystore;
@@ -196,7 +213,7 @@ CHIP_ERROR CryptoContext::Encrypt(const uint8_t * input, size_t input_length, ui
     {
         VerifyOrReturnError(mKeyAvailable, CHIP_ERROR_INVALID_USE_OF_SESSION_KEY);
         ReturnErrorOnFailure(
-            AES_CCM_encrypt(input, input_length, AAD, aadLen, mEncryptionKey, nonce.data(), nonce.size(), output, tag, taglen));
+            mEncryptionCipher.Encrypt(input, input_length, AAD, aadLen, nonce.data(), nonce.size(), output, tag, taglen));
     }
 
     mac.SetTag(&header, tag, taglen);
@@ -231,7 +248,7 @@ CHIP_ERROR CryptoContext::Decrypt(const uint8_t * input, size_t input_length, ui
     {
         VerifyOrReturnError(mKeyAvailable, CHIP_ERROR_INVALID_USE_OF_SESSION_KEY);
         ReturnErrorOnFailure(
-            AES_CCM_decrypt(input, input_length, AAD, aadLen, tag, taglen, mDecryptionKey, nonce.data(), nonce.size(), output));
+            mDecryptionCipher.Decrypt(input, input_length, AAD, aadLen, tag, taglen, nonce.data(), nonce.size(), output));
     }
     return CHIP_NO_ERROR;
 }
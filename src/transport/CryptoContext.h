@@ -162,6 +162,8 @@ private:
     bool mKeyAvailable;
     Crypto::Aes128KeyHandle mEncryptionKey;
     Crypto::Aes128KeyHandle mDecryptionKey;
+    Crypto::Aes128CcmContext mEncryptionCipher;
+    Crypto::Aes128CcmContext mDecryptionCipher;
     Crypto::AttestationChallenge mAttestationChallenge;
     Crypto::SessionKeystore * mKeystore       = nullptr;
     Crypto::SymmetricKeyContext * mKeyContext = nullptr;
@@ -54,7 +54,10 @@ Optional<SessionHandle> SecureSessionTable::CreateNewSecureSessionForTest(Secure
 
     SecureSession * result = mEntries.CreateObject(*this, secureSessionType, localSessionId, localNodeId, peerNodeId, peerCATs,
                                                    peerSessionId, fabricIndex, config);
-    return result != nullptr ? MakeOptional<SessionHandle>(*result) : Optional<SessionHandle>::Missing();
+    VerifyOrReturnValue(result != nullptr, Optional<SessionHandle>::Missing());
+
+    AddToIndexes(result);
+    return MakeOptional<SessionHandle>(*result);
 }
 
 Optional<SessionHandle> SecureSessionTable::CreateNewSecureSession(SecureSession::Type secureSessionType,
@@ -82,6 +85,8 @@ Optional<SessionHandle> SecureSessionTable::CreateNewSecureSession(SecureSession
 
     VerifyOrReturnValue(allocated != nullptr, Optional<SessionHandle>::Missing());
 
+    AddToIndexes(allocated);
+
     rv             = MakeOptional<SessionHandle>(*allocated);
     mNextSessionId = sessionId.Value() == kMaxSessionID ? static_cast<uint16_t>(kUnsecuredSessionId + 1)
                                                         : static_cast<uint16_t>(sessionId.Value() + 1);
@@ -337,67 +342,45 @@ void SecureSessionTable::DefaultEvictionPolicy(EvictionPolicyContext & evictionC
     });
 }
 
-Optional<SessionHandle> SecureSessionTable::FindSecureSessionByLocalKey(uint16_t localSessionId)
+SecureSession * SecureSessionTable::FindByLocalSessionId(uint16_t localSessionId)
 {
     SecureSession * result = nullptr;
-    mEntries.ForEachActiveObject([&](auto session) {
-        if (session->GetLocalSessionId() == localSessionId)
-        {
-            result = session;
-            return Loop::Break;
-        }
-        return Loop::Continue;
-    });
+    auto match             = [&](SecureSession * session) {
+        result = session;
+        return Loop::Break;
+    };
+
+    mLocalSessionIdIndex.ForEachMatching(localSessionId, match);
+    if (result == nullptr && mSessionsOutsideLocalSessionIdIndex > 0)
+    {
+        mEntries.ForEachActiveObject([&](SecureSession * session) {
+            return session->GetLocalSessionId() == localSessionId ? match(session) : Loop::Continue;
+        });
+    }
+    return result;
+}
+
+Optional<SessionHandle> SecureSessionTable::FindSecureSessionByLocalKey(uint16_t localSessionId)
+{
+    SecureSession * result = FindByLocalSessionId(localSessionId);
     return result != nullptr ? MakeOptional<SessionHandle>(*result) : Optional<SessionHandle>::Missing();
 }
 
 Optional<uint16_t> SecureSessionTable::FindUnusedSessionId()
 {
-    uint16_t candidate_base = 0;
-    uint64_t candidate_mask = 0;
-    for (uint32_t i = 0; i <= kMaxSessionID; i += 64)
+    uint16_t candidate = mNextSessionId;
+    for (uint32_t i = 0; i <= kMaxSessionID; i++, candidate++)
     {
-        // candidate_base is the base session ID we are searching from.
-        // We have a 64-bit mask anchored at this ID and iterate over the
-        // whole session table, setting bits in the mask for in-use IDs.
-        // If we can iterate through the entire session table and have
-        // any bits clear in the mask, we have available session IDs.
-        candidate_base = static_cast<uint16_t>(i + mNextSessionId);
-        candidate_mask = 0;
+        // kUnsecuredSessionId is never available.
+        if (candidate == kUnsecuredSessionId)
         {
-            uint16_t shift = static_cast<uint16_t>(kUnsecuredSessionId - candidate_base);
-            if (shift <= 63)
-            {
-                candidate_mask |= (1ULL << shift); // kUnsecuredSessionId is never available
-            }
-        }
-        mEntries.ForEachActiveObject([&](auto session) {
-            uint16_t shift = static_cast<uint16_t>(session->GetLocalSessionId() - candidate_base);
-            if (shift <= 63)
-            {
-                candidate_mask |= (1ULL << shift);
-            }
-            if (candidate_mask == UINT64_MAX)
-            {
-                return Loop::Break; // No bits clear means this bucket is full.
-            }
-            return Loop::Continue;
-        });
-        if (candidate_mask != UINT64_MAX)
-        {
-            break; // Any bit clear means we have an available ID in this bucket.
+            continue;
         }
-    }
-    if (candidate_mask != UINT64_MAX)
-    {
-        uint16_t offset = 0;
-        while (candidate_mask & 1)
+
+        if (FindByLocalSessionId(candidate) == nullptr)
         {
-            candidate_mask >>= 1;
-            ++offset;
+            return MakeOptional<uint16_t>(candidate);
         }
-        uint16_t available = static_cast<uint16_t>(candidate_base + offset);
-        return MakeOptional<uint16_t>(available);
     }
 
     return NullOptional;
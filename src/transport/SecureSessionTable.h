@@ -29,6 +29,24 @@ namespace Transport {
 inline constexpr uint16_t kMaxSessionID       = UINT16_MAX;
 inline constexpr uint16_t kUnsecuredSessionId = 0;
 
+namespace detail {
+
+// Smallest power of two that keeps the session indexes of a SecureSessionTable at most half full.  This has to live
+// outside of the class: a constexpr member function cannot be evaluated before its class is complete.
+constexpr size_t ComputeSessionIndexCapacity()
+{
+    size_t capacity = 1;
+    while (capacity < 2 * CHIP_CONFIG_SECURE_SESSION_POOL_SIZE)
+    {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+inline constexpr size_t kSessionIndexCapacity = ComputeSessionIndexCapacity();
+
+} // namespace detail
+
 /**
  * Handles a set of sessions.
  *
@@ -39,7 +57,14 @@ inline constexpr uint16_t kUnsecuredSessionId = 0;
 class SecureSessionTable
 {
 public:
-    ~SecureSessionTable() { mEntries.ReleaseAll(); }
+    ~SecureSessionTable()
+    {
+        mLocalSessionIdIndex.Clear();
+        mPeerIndex.Clear();
+        mSessionsOutsideLocalSessionIdIndex = 0;
+        mSessionsOutsidePeerIndex           = 0;
+        mEntries.ReleaseAll();
+    }
 
     void Init() { mNextSessionId = chip::Crypto::GetRandU16(); }
 
@@ -76,7 +101,15 @@ public:
     CHECK_RETURN_VALUE
     Optional<SessionHandle> CreateNewSecureSession(SecureSession::Type secureSessionType, ScopedNodeId sessionEvictionHint);
 
-    void ReleaseSession(SecureSession * session) { mEntries.ReleaseObject(session); }
+    void ReleaseSession(SecureSession * session)
+    {
+        if (!mLocalSessionIdIndex.Remove(session))
+        {
+            mSessionsOutsideLocalSessionIdIndex--;
+        }
+        RemoveFromPeerIndex(session);
+        mEntries.ReleaseObject(session);
+    }
 
     template <typename Function>
     Loop ForEachSession(Function && function)
@@ -94,6 +127,26 @@ public:
     CHECK_RETURN_VALUE
     Optional<SessionHandle> FindSecureSessionByLocalKey(uint16_t localSessionId);
 
+    /**
+     * Iterate over the sessions whose peer matches the given ScopedNodeId, without walking the whole table.
+     *
+     * Sessions with an undefined peer node ID (i.e. still being established) are never visited.
+     *
+     * The function must not release sessions (e.g. by evicting them), since that would modify the index while it is being
+     * walked. Use ForEachSession for that.
+     */
+    template <typename Function>
+    Loop ForEachSessionForPeer(const ScopedNodeId & peer, Function && function)
+    {
+        if (mSessionsOutsidePeerIndex > 0)
+        {
+            return mEntries.ForEachActiveObject([&](SecureSession * session) {
+                return (IsIndexedByPeer(*session) && session->GetPeer() == peer) ? function(session) : Loop::Continue;
+            });
+        }
+        return mPeerIndex.ForEachMatching(peer, std::forward<Function>(function));
+    }
+
     // Select SessionHolders which are pointing to a session with the same peer as the given session. Shift them to the given
     // session.
     // This is an internal API, using raw pointer to a session is allowed here.
@@ -121,8 +174,153 @@ public:
     }
 
 private:
+    friend class SecureSession;
     friend class TestSecureSessionTable;
 
+    /**
+     * Open-addressing (linear probing) index over the sessions in mEntries.
+     *
+     * KeyTraits provides the Key type, `static Key GetKey(const SecureSession &)` and `static uint32_t Hash(const Key &)`.
+     * Several sessions may share a key, so lookups walk the probe sequence until they reach an empty slot. The capacity is at
+     * least twice the pool size to keep probe sequences short, and removal uses backward-shift deletion so that no tombstones
+     * accumulate.
+     *
+     * A heap-backed pool can hold more sessions than the index has room for.  Insert then fails and the table keeps the session
+     * outside of the index, falling back to scanning the pool until all such sessions are released.
+     *
+     * The key of an indexed session must not change; sessions are removed before and re-inserted after any such change.
+     */
+    template <typename KeyTraits>
+    class SessionIndex
+    {
+    public:
+        using Key = typename KeyTraits::Key;
+
+        void Clear()
+        {
+            for (auto & slot : mSlots)
+            {
+                slot = nullptr;
+            }
+            mCount = 0;
+        }
+
+        bool Insert(SecureSession * session)
+        {
+            // Always keep one slot empty so that every probe sequence terminates.
+            VerifyOrReturnValue(mCount < kCapacity - 1, false);
+
+            size_t i = SlotFor(KeyTraits::GetKey(*session));
+            while (mSlots[i] != nullptr)
+            {
+                i = (i + 1) & kMask;
+            }
+            mSlots[i] = session;
+            mCount++;
+            return true;
+        }
+
+        // Returns false if the session was not in the index.
+        bool Remove(SecureSession * session)
+        {
+            size_t i = SlotFor(KeyTraits::GetKey(*session));
+            for (; mSlots[i] != session; i = (i + 1) & kMask)
+            {
+                VerifyOrReturnValue(mSlots[i] != nullptr, false);
+            }
+
+            // Backward-shift deletion: pull later entries of the cluster into the hole if their home slot allows it.
+            mSlots[i] = nullptr;
+            mCount--;
+            for (size_t j = (i + 1) & kMask; mSlots[j] != nullptr; j = (j + 1) & kMask)
+            {
+                size_t home = SlotFor(KeyTraits::GetKey(*mSlots[j]));
+                // Move the entry unless its home lies cyclically in (i, j].
+                if (((j - home) & kMask) >= ((j - i) & kMask))
+                {
+                    mSlots[i] = mSlots[j];
+                    mSlots[j] = nullptr;
+                    i         = j;
+                }
+            }
+            return true;
+        }
+
+        template <typename Function>
+        Loop ForEachMatching(const Key & key, Function && function) const
+        {
+            for (size_t i = SlotFor(key); mSlots[i] != nullptr; i = (i + 1) & kMask)
+            {
+                if (KeyTraits::GetKey(*mSlots[i]) == key && function(mSlots[i]) == Loop::Break)
+                {
+                    return Loop::Break;
+                }
+            }
+            return Loop::Finish;
+        }
+
+    private:
+        static constexpr size_t kCapacity = detail::kSessionIndexCapacity;
+        static constexpr size_t kMask     = kCapacity - 1;
+
+        static size_t SlotFor(const Key & key) { return static_cast<size_t>(KeyTraits::Hash(key)) & kMask; }
+
+        SecureSession * mSlots[kCapacity] = {};
+        size_t mCount                     = 0;
+    };
+
+    struct LocalSessionIdKeyTraits
+    {
+        using Key = uint16_t;
+        static Key GetKey(const SecureSession & session) { return session.GetLocalSessionId(); }
+        // Session IDs are handed out sequentially; scatter them so that they do not form a single probe cluster.
+        static uint32_t Hash(const Key & key) { return (static_cast<uint32_t>(key) * 2654435761u) >> 16; }
+    };
+
+    struct PeerKeyTraits
+    {
+        using Key = ScopedNodeId;
+        static Key GetKey(const SecureSession & session) { return session.GetPeer(); }
+        static uint32_t Hash(const Key & key)
+        {
+            uint64_t h = key.GetNodeId() ^ (static_cast<uint64_t>(key.GetFabricIndex()) << 56);
+            h *= 0x9E3779B97F4A7C15ull;
+            return static_cast<uint32_t>(h >> 32);
+        }
+    };
+
+    static bool IsIndexedByPeer(const SecureSession & session) { return session.GetPeer().GetNodeId() != kUndefinedNodeId; }
+
+    /**
+     * Track a newly allocated session in the lookup indexes.
+     */
+    void AddToIndexes(SecureSession * session)
+    {
+        if (!mLocalSessionIdIndex.Insert(session))
+        {
+            mSessionsOutsideLocalSessionIdIndex++;
+        }
+        AddToPeerIndex(session);
+    }
+
+    // Called by SecureSession around any change to the value returned by its GetPeer().
+    void RemoveFromPeerIndex(SecureSession * session)
+    {
+        if (IsIndexedByPeer(*session) && !mPeerIndex.Remove(session))
+        {
+            mSessionsOutsidePeerIndex--;
+        }
+    }
+    void AddToPeerIndex(SecureSession * session)
+    {
+        if (IsIndexedByPeer(*session) && !mPeerIndex.Insert(session))
+        {
+            mSessionsOutsidePeerIndex++;
+        }
+    }
+
+    SecureSession * FindByLocalSessionId(uint16_t localSessionId);
+
     /**
      * This provides a sortable wrapper for a SecureSession object. A SecureSession
      * isn't directly sortable since it is not swappable (i.e meet criteria for ValueSwappable).
@@ -243,13 +441,10 @@ private:
     /**
      * Find an available session ID that is unused in the secure session table.
      *
-     * The search algorithm iterates over the session ID space in the outer loop
-     * and the session table in the inner loop to locate an available session ID
-     * from the starting mNextSessionId clue.
-     *
-     * The outer-loop considers 64 session IDs in each iteration to give a
-     * runtime complexity of O(CHIP_CONFIG_PEER_CONNECTION_POOL_SIZE^2/64).  Speed up could be
-     * achieved with a sorted session table or additional storage.
+     * Session IDs are probed in order starting from the mNextSessionId clue,
+     * each probe being a lookup in the local session ID index.  Since only one
+     * ID per session in the table is in use, this terminates after at most that
+     * many probes.
      *
      * @return an unused session ID if any is found, else NullOptional
      */
@@ -257,7 +452,12 @@ private:
     Optional<uint16_t> FindUnusedSessionId();
 
     bool mRunningEvictionLogic = false;
-    ObjectPool<SecureSession, CHIP_CONFIG_SECURE_SESSION_POOL_SIZE> mEntries;
+    ObjectPool<SecureSession, CHIP_CONFIG_SECURE_SESSION_POOL_SIZE, ObjectPoolMem::kDefaultIterable> mEntries;
+    SessionIndex<LocalSessionIdKeyTraits> mLocalSessionIdIndex;
+    SessionIndex<PeerKeyTraits> mPeerIndex;
+    // Sessions that did not fit in an index; lookups scan mEntries while there are any.
+    size_t mSessionsOutsideLocalSessionIdIndex = 0;
+    size_t mSessionsOutsidePeerIndex           = 0;
 
     size_t GetMaxSessionTableSize() const
     {
@@ -338,6 +338,19 @@ CHIP_ERROR SessionManager::SendPreparedMessage(const SessionHandle & sessionHand
     VerifyOrReturnError(mState == State::kInitialized, CHIP_ERROR_INCORRECT_STATE);
     VerifyOrReturnError(!preparedMessage.IsNull(), CHIP_ERROR_INVALID_ARGUMENT);
 
+    return SendPreparedBuffer(sessionHandle, preparedMessage.CastToWritable());
+}
+
+CHIP_ERROR SessionManager::SendPreparedMessage(const SessionHandle & sessionHandle, EncryptedPacketBufferHandle && preparedMessage)
+{
+    VerifyOrReturnError(mState == State::kInitialized, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(!preparedMessage.IsNull(), CHIP_ERROR_INVALID_ARGUMENT);
+
+    return SendPreparedBuffer(sessionHandle, std::move(preparedMessage).ReleaseAsWritable());
+}
+
+CHIP_ERROR SessionManager::SendPreparedBuffer(const SessionHandle & sessionHandle, System::PacketBufferHandle && msgBuf)
+{
     Transport::PeerAddress multicastAddress; // Only used for the group case
     const Transport::PeerAddress * destination;
 
@@ -373,7 +386,6 @@ CHIP_ERROR SessionManager::SendPreparedMessage(const SessionHandle & sessionHand
         return CHIP_ERROR_INTERNAL;
     }
 
-    PacketBufferHandle msgBuf = preparedMessage.CastToWritable();
     VerifyOrReturnError(!msgBuf.IsNull(), CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrReturnError(!msgBuf->HasChainedBuffer(), CHIP_ERROR_INVALID_MESSAGE_LENGTH);
 
@@ -396,10 +408,9 @@ CHIP_ERROR SessionManager::SendPreparedMessage(const SessionHandle & sessionHand
                 {
                     ChipLogDetail(Inet, "Interface %s has a link local address", name);
 
+                    // Endpoints that modify a buffer while sending it copy it themselves when it is shared.
                     interfaceFound             = true;
-                    PacketBufferHandle tempBuf = msgBuf.CloneData();
-                    VerifyOrReturnError(!tempBuf.IsNull(), CHIP_ERROR_INVALID_ARGUMENT);
-                    VerifyOrReturnError(!tempBuf->HasChainedBuffer(), CHIP_ERROR_INVALID_MESSAGE_LENGTH);
+                    PacketBufferHandle tempBuf = msgBuf.Retain();
 
                     destination = &(multicastAddress.SetInterface(interfaceId));
                     if (mTransportMgr != nullptr)
@@ -482,9 +493,8 @@ void SessionManager::ExpireAllPASESessions()
 
 void SessionManager::MarkSessionsAsDefunct(const ScopedNodeId & node, const Optional<Transport::SecureSession::Type> & type)
 {
-    mSecureSessions.ForEachSession([&node, &type](auto session) {
-        if (session->IsActiveSession() && session->GetPeer() == node &&
-            (!type.HasValue() || type.Value() == session->GetSecureSessionType()))
+    mSecureSessions.ForEachSessionForPeer(node, [&type](auto session) {
+        if (session->IsActiveSession() && (!type.HasValue() || type.Value() == session->GetSecureSessionType()))
         {
             session->MarkAsDefunct();
         }
@@ -494,10 +504,10 @@ void SessionManager::MarkSessionsAsDefunct(const ScopedNodeId & node, const Opti
 
 void SessionManager::UpdateAllSessionsPeerAddress(const ScopedNodeId & node, const Transport::PeerAddress & addr)
 {
-    mSecureSessions.ForEachSession([&node, &addr](auto session) {
+    mSecureSessions.ForEachSessionForPeer(node, [&addr](auto session) {
         // Arguably we should only be updating active and defunct sessions, but there is no harm
         // in updating evicted sessions.
-        if (session->GetPeer() == node && Transport::SecureSession::Type::kCASE == session->GetSecureSessionType())
+        if (Transport::SecureSession::Type::kCASE == session->GetSecureSessionType())
         {
             session->SetPeerAddress(addr);
         }
@@ -787,15 +797,83 @@ void SessionManager::SecureUnicastMessageDispatch(const PacketHeader & partialPa
     }
 }
 
+/**
+ * Helper function to decrypt the payload of a groupcast message whose packet header has already been
+ * deobfuscated, leaving the received message untouched.
+ *
+ * @param[out] packetHeaderCopy A copy of the packet header, to be filled with privacy decrypted fields
+ * @param[out] payloadHeader The payload header of the decrypted message
+ * @param[in] msg The received message
+ * @param[in,out] plaintext Scratch buffer shared by all attempts, filled with the decrypted message
+ * @param[in] mac The MAC of the message
+ * @param[in] context The crypto context of the group key
+ * @param[in] groupId The group of the group key
+ *
+ * @return true if the message was decrypted successfully
+ * @return false if the message could not be decrypted
+ */
+static bool GroupKeyDecryptPayload(PacketHeader & packetHeaderCopy, PayloadHeader & payloadHeader,
+                                   const System::PacketBufferHandle & msg, System::PacketBufferHandle & plaintext,
+                                   const MessageAuthenticationCode & mac, const CryptoContext & context, GroupId groupId)
+{
+    uint16_t headerSize = 0;
+    if (packetHeaderCopy.Decode(msg->Start(), msg->DataLength(), &headerSize) != CHIP_NO_ERROR)
+    {
+        ChipLogError(Inet, "Failed to decode Groupcast packet header. Discarding.");
+        return false;
+    }
+
+    // Optimization to reduce number of decryption attempts
+    if (packetHeaderCopy.GetDestinationGroupId().Value() != groupId)
+    {
+        return false;
+    }
+
+    uint16_t footerLen = packetHeaderCopy.MICTagLength();
+    VerifyOrReturnValue(headerSize + footerLen <= msg->DataLength(), false);
+    uint16_t len = static_cast<uint16_t>(msg->DataLength() - headerSize - footerLen);
+
+    if (plaintext.IsNull())
+    {
+        plaintext = System::PacketBufferHandle::New(msg->DataLength());
+        if (plaintext.IsNull())
+        {
+            ChipLogError(Inet, "Failed to allocate Groupcast message buffer. Discarding.");
+            return false;
+        }
+    }
+    VerifyOrReturnValue(len <= plaintext->MaxDataLength(), false);
+
+    CryptoContext::NonceStorage nonce;
+    CryptoContext::BuildNonce(nonce, packetHeaderCopy.GetSecurityFlags(), packetHeaderCopy.GetMessageCounter(),
+                              packetHeaderCopy.GetSourceNodeId().Value());
+    VerifyOrReturnValue(CHIP_NO_ERROR ==
+                            context.Decrypt(msg->Start() + headerSize, len, plaintext->Start(), nonce, packetHeaderCopy, mac),
+                        false);
+
+    // Only consume the payload header once the whole attempt succeeded: the next key must decrypt
+    // to the same start of the shared plaintext buffer.
+    uint16_t payloadHeaderSize = 0;
+    VerifyOrReturnValue(CHIP_NO_ERROR == payloadHeader.Decode(plaintext->Start(), len, &payloadHeaderSize), false);
+
+    plaintext->SetDataLength(len);
+    plaintext->ConsumeHead(payloadHeaderSize);
+    return true;
+}
+
 /**
  * Helper function to implement a single attempt to decrypt a groupcast message
  * using the given group key and privacy setting.
  *
+ * The received message is not modified by a failed attempt, so it can be retried with the next
+ * candidate key without being copied.
+ *
  * @param[in] partialPacketHeader The partial packet header with non-obfuscated message fields (result of calling DecodeFixed).
  * @param[out] packetHeaderCopy A copy of the packet header, to be filled with privacy decrypted fields
  * @param[out] payloadHeader The payload header of the decrypted message
  * @param[in] applyPrivacy Whether to apply privacy deobfuscation
- * @param[out] msgCopy A copy of the message, to be filled with the decrypted message
+ * @param[in] msg The received message
+ * @param[in,out] plaintext Scratch buffer shared by all attempts, filled with the decrypted message
  * @param[in] mac The MAC of the message
  * @param[in] groupContext The group context to use for decryption key material
  *
@@ -803,42 +881,33 @@ void SessionManager::SecureUnicastMessageDispatch(const PacketHeader & partialPa
  * @return false if the message could not be decrypted
  */
 static bool GroupKeyDecryptAttempt(const PacketHeader & partialPacketHeader, PacketHeader & packetHeaderCopy,
-                                   PayloadHeader & payloadHeader, bool applyPrivacy, System::PacketBufferHandle & msgCopy,
-                                   const MessageAuthenticationCode & mac,
+                                   PayloadHeader & payloadHeader, bool applyPrivacy, const System::PacketBufferHandle & msg,
+                                   System::PacketBufferHandle & plaintext, const MessageAuthenticationCode & mac,
                                    const Credentials::GroupDataProvider::GroupSession & groupContext)
 {
-    bool decrypted = false;
     CryptoContext context(groupContext.keyContext);
 
-    if (applyPrivacy)
+    if (!applyPrivacy)
     {
-        // Perform privacy deobfuscation, if applicable.
-        uint8_t * privacyHeader = partialPacketHeader.PrivacyHeader(msgCopy->Start());
-        size_t privacyLength    = partialPacketHeader.PrivacyHeaderLength();
-        if (CHIP_NO_ERROR != context.PrivacyDecrypt(privacyHeader, privacyLength, privacyHeader, partialPacketHeader, mac))
-        {
-            return false;
-        }
+        return GroupKeyDecryptPayload(packetHeaderCopy, payloadHeader, msg, plaintext, mac, context, groupContext.group_id);
     }
 
-    if (packetHeaderCopy.DecodeAndConsume(msgCopy) != CHIP_NO_ERROR)
-    {
-        ChipLogError(Inet, "Failed to decode Groupcast packet header. Discarding.");
-        return false;
-    }
+    // Perform privacy deobfuscation in place, keeping the received bytes to restore them if this key does not match.
+    uint8_t obfuscatedHeader[PacketHeader::kPrivacyHeaderMinLength + 2 * sizeof(NodeId)];
+    uint8_t * privacyHeader = partialPacketHeader.PrivacyHeader(msg->Start());
+    size_t privacyLength    = partialPacketHeader.PrivacyHeaderLength();
+    VerifyOrReturnValue(privacyLength <= sizeof(obfuscatedHeader), false);
+    VerifyOrReturnValue(PacketHeader::kPrivacyHeaderOffset + privacyLength <= msg->DataLength(), false);
+    memcpy(obfuscatedHeader, privacyHeader, privacyLength);
 
-    // Optimization to reduce number of decryption attempts
-    GroupId groupId = packetHeaderCopy.GetDestinationGroupId().Value();
-    if (groupId != groupContext.group_id)
+    bool decrypted =
+        (CHIP_NO_ERROR == context.PrivacyDecrypt(privacyHeader, privacyLength, privacyHeader, partialPacketHeader, mac)) &&
+        GroupKeyDecryptPayload(packetHeaderCopy, payloadHeader, msg, plaintext, mac, context, groupContext.group_id);
+
+    if (!decrypted)
     {
-        return false;
+        memcpy(privacyHeader, obfuscatedHeader, privacyLength);
     }
-
-    CryptoContext::NonceStorage nonce;
-    CryptoContext::BuildNonce(nonce, packetHeaderCopy.GetSecurityFlags(), packetHeaderCopy.GetMessageCounter(),
-                              packetHeaderCopy.GetSourceNodeId().Value());
-    decrypted = (CHIP_NO_ERROR == SecureMessageCodec::Decrypt(context, nonce, payloadHeader, packetHeaderCopy, msgCopy));
-
     return decrypted;
 }
 
@@ -848,8 +917,8 @@ void SessionManager::SecureGroupMessageDispatch(const PacketHeader & partialPack
     MATTER_TRACE_SCOPE("Group Message Dispatch", "SessionManager");
 
     PayloadHeader payloadHeader;
-    PacketHeader packetHeaderCopy; /// Packet header decoded per group key, with privacy decrypted fields
-    System::PacketBufferHandle msgCopy;
+    PacketHeader packetHeaderCopy;        /// Packet header decoded per group key, with privacy decrypted fields
+    System::PacketBufferHandle plaintext; /// Decrypted message, allocated on the first decryption attempt
     Credentials::GroupDataProvider * groups = Credentials::GetGroupDataProvider();
     VerifyOrReturn(nullptr != groups);
     CHIP_ERROR err = CHIP_NO_ERROR;
@@ -889,30 +958,16 @@ void SessionManager::SecureGroupMessageDispatch(const PacketHeader & partialPack
     bool decrypted = false;
     while (!decrypted && iter->Next(groupContext))
     {
-        CryptoContext context(groupContext.keyContext);
-        msgCopy = msg.CloneData();
-        if (msgCopy.IsNull())
-        {
-            ChipLogError(Inet, "Failed to clone Groupcast message buffer. Discarding.");
-            return;
-        }
-
         bool privacy = partialPacketHeader.HasPrivacyFlag();
-        decrypted =
-            GroupKeyDecryptAttempt(partialPacketHeader, packetHeaderCopy, payloadHeader, privacy, msgCopy, mac, groupContext);
+        decrypted = GroupKeyDecryptAttempt(partialPacketHeader, packetHeaderCopy, payloadHeader, privacy, msg, plaintext, mac,
+                                           groupContext);
 
 #if CHIP_CONFIG_PRIVACY_ACCEPT_NONSPEC_SVE2
         if (privacy && !decrypted)
         {
             // Try processing the P=1 message again without privacy as a work-around for invalid early-SVE2 nodes.
-            msgCopy = msg.CloneData();
-            if (msgCopy.IsNull())
-            {
-                ChipLogError(Inet, "Failed to clone Groupcast message buffer. Discarding.");
-                return;
-            }
-            decrypted =
-                GroupKeyDecryptAttempt(partialPacketHeader, packetHeaderCopy, payloadHeader, false, msgCopy, mac, groupContext);
+            decrypted = GroupKeyDecryptAttempt(partialPacketHeader, packetHeaderCopy, payloadHeader, false, msg, plaintext, mac,
+                                               groupContext);
         }
 #endif // CHIP_CONFIG_PRIVACY_ACCEPT_NONSPEC_SVE2
     }
@@ -923,7 +978,7 @@ void SessionManager::SecureGroupMessageDispatch(const PacketHeader & partialPack
         ChipLogError(Inet, "Failed to decrypt group message. Discarding everything");
         return;
     }
-    msg = std::move(msgCopy);
+    msg = std::move(plaintext);
 
     // MCSP check
     if (packetHeaderCopy.IsValidMCSPMsg())
@@ -1010,9 +1065,8 @@ Optional<SessionHandle> SessionManager::FindSecureSessionForNode(ScopedNodeId pe
 {
     SecureSession * found = nullptr;
 
-    mSecureSessions.ForEachSession([&peerNodeId, &type, &found](auto session) {
-        if (session->IsActiveSession() && session->GetPeer() == peerNodeId &&
-            (!type.HasValue() || type.Value() == session->GetSecureSessionType()))
+    mSecureSessions.ForEachSessionForPeer(peerNodeId, [&type, &found](auto session) {
+        if (session->IsActiveSession() && (!type.HasValue() || type.Value() == session->GetSecureSessionType()))
         {
             //
             // Select the active session with the most recent activity to return back to the caller.
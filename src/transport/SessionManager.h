@@ -117,6 +117,13 @@ public:
      */
     PacketBufferHandle CastToWritable() const { return PacketBufferHandle::Retain(); }
 
+    /**
+     * Give up this handle's reference as a writable handle, for a buffer that
+     * will not be sent again.  Unlike CastToWritable(), the returned handle
+     * is the buffer's only owner if this one was.
+     */
+    PacketBufferHandle ReleaseAsWritable() && { return PacketBufferHandle(std::move(*this)); }
+
 private:
     EncryptedPacketBufferHandle(PacketBufferHandle && aBuffer) : PacketBufferHandle(std::move(aBuffer)) {}
 };
@@ -147,6 +154,15 @@ public:
      */
     CHIP_ERROR SendPreparedMessage(const SessionHandle & session, const EncryptedPacketBufferHandle & preparedMessage);
 
+    /**
+     * @brief
+     *   Send a prepared message that will not be retransmitted.  The buffer is
+     *   handed over to the transport instead of being shared with it, so a
+     *   transport that needs to modify it (e.g. LwIP UDP prepending its
+     *   headers) does not have to copy it first.
+     */
+    CHIP_ERROR SendPreparedMessage(const SessionHandle & session, EncryptedPacketBufferHandle && preparedMessage);
+
     /// @brief Set the delegate for handling incoming messages. There can be only one message delegate (probably the
     /// ExchangeManager)
     void SetMessageDelegate(SessionMessageDelegate * cb) { mCB = cb; }
@@ -517,6 +533,13 @@ private:
 
     void OnReceiveError(CHIP_ERROR error, const Transport::PeerAddress & source);
 
+    /**
+     * @brief Send the bytes of a prepared message to the session's peer.
+     *
+     * @param msgBuf The encrypted message. It is shared with the caller when the message may be retransmitted.
+     */
+    CHIP_ERROR SendPreparedBuffer(const SessionHandle & session, System::PacketBufferHandle && msgBuf);
+
     static bool IsControlMessage(PayloadHeader & payloadHeader)
     {
         return payloadHeader.HasMessageType(Protocols::SecureChannel::MsgType::MsgCounterSyncReq) ||
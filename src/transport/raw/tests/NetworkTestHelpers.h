@@ -135,7 +135,18 @@ public:
             return CHIP_NO_ERROR;
         }
 
-        System::PacketBufferHandle receivedMessage = msgBuf.CloneData();
+        // A buffer the sender still holds (e.g. for retransmission) must not be handed to the receiver, which
+        // decrypts in place; one the sender gave up is delivered as-is.
+        System::PacketBufferHandle receivedMessage;
+        if (msgBuf.HasSoleOwnership())
+        {
+            receivedMessage = std::move(msgBuf);
+        }
+        else
+        {
+            receivedMessage = msgBuf.CloneData();
+            mCopiedMessageCount++;
+        }
         mPendingMessageQueue.push(PendingMessageItem(address, std::move(receivedMessage)));
         return mSystemLayer->ScheduleWork(OnMessageReceived, this);
     }
@@ -148,6 +159,7 @@ public:
         mNumMessagesToDrop                = 0;
         mDroppedMessageCount              = 0;
         mSentMessageCount                 = 0;
+        mCopiedMessageCount               = 0;
         mNumMessagesToAllowBeforeDropping = 0;
         mNumMessagesToAllowBeforeError    = 0;
         mMessageSendError                 = CHIP_NO_ERROR;
@@ -168,6 +180,7 @@ public:
     uint32_t mNumMessagesToDrop                = 0;
     uint32_t mDroppedMessageCount              = 0;
     uint32_t mSentMessageCount                 = 0;
+    uint32_t mCopiedMessageCount               = 0;
     uint32_t mNumMessagesToAllowBeforeDropping = 0;
     uint32_t mNumMessagesToAllowBeforeError    = 0;
     CHIP_ERROR mMessageSendError               = CHIP_NO_ERROR;
@@ -132,6 +132,145 @@ void TestFindByKeyId(nlTestSuite * inSuite, void * inContext)
     System::Clock::Internal::SetSystemClockForTesting(realClock);
 }
 
+void TestIndexedLookups(nlTestSuite * inSuite, void * inContext)
+{
+    SecureSessionTable connections;
+    System::Clock::Internal::MockClock clock;
+    System::Clock::ClockBase * realClock = &System::SystemClock();
+    System::Clock::Internal::SetSystemClockForTesting(&clock);
+
+    const ScopedNodeId peer1(kCasePeer1NodeId, kFabricIndex);
+    const ScopedNodeId peer2(kCasePeer2NodeId, kFabricIndex);
+
+    auto countSessionsForPeer = [&connections](const ScopedNodeId & peer) {
+        int count = 0;
+        connections.ForEachSessionForPeer(peer, [&count, &peer](auto session) {
+            VerifyOrDie(session->GetPeer() == peer);
+            count++;
+            return Loop::Continue;
+        });
+        return count;
+    };
+
+    //
+    // Fill up the session table, alternating between two peers. Sessions are not retained by the test, so that
+    // marking them for eviction releases them from the table.
+    //
+    int peer1Count = 0;
+    for (int i = 0; i < CHIP_CONFIG_SECURE_SESSION_POOL_SIZE; ++i)
+    {
+        bool forPeer1        = (i % 2) == 0;
+        auto optionalSession = connections.CreateNewSecureSessionForTest(
+            SecureSession::Type::kCASE, static_cast<uint16_t>(static_cast<uint16_t>(i) + 1u), kLocalNodeId,
+            forPeer1 ? kCasePeer1NodeId : kCasePeer2NodeId, forPeer1 ? kPeer1CATs : kPeer2CATs, 1, kFabricIndex,
+            GetDefaultMRPConfig());
+        NL_TEST_ASSERT(inSuite, optionalSession.HasValue());
+        peer1Count += forPeer1 ? 1 : 0;
+    }
+
+    NL_TEST_ASSERT(inSuite, countSessionsForPeer(peer1) == peer1Count);
+    NL_TEST_ASSERT(inSuite, countSessionsForPeer(peer2) == CHIP_CONFIG_SECURE_SESSION_POOL_SIZE - peer1Count);
+    NL_TEST_ASSERT(inSuite, countSessionsForPeer(ScopedNodeId(kCasePeer1NodeId, static_cast<FabricIndex>(kFabricIndex + 1))) == 0);
+
+    //
+    // Release every third session and make sure the remaining ones are still reachable through both indexes.
+    //
+    for (int i = 0; i < CHIP_CONFIG_SECURE_SESSION_POOL_SIZE; i += 3)
+    {
+        auto optionalSession = connections.FindSecureSessionByLocalKey(static_cast<uint16_t>(i + 1));
+        NL_TEST_ASSERT(inSuite, optionalSession.HasValue());
+        SecureSession * session = optionalSession.Value()->AsSecureSession();
+        optionalSession.ClearValue();
+        session->MarkForEviction();
+        peer1Count -= ((i % 2) == 0) ? 1 : 0;
+    }
+
+    int remaining = 0;
+    for (int i = 0; i < CHIP_CONFIG_SECURE_SESSION_POOL_SIZE; ++i)
+    {
+        bool released = (i % 3) == 0;
+        NL_TEST_ASSERT(inSuite, connections.FindSecureSessionByLocalKey(static_cast<uint16_t>(i + 1)).HasValue() == !released);
+        remaining += released ? 0 : 1;
+    }
+    NL_TEST_ASSERT(inSuite, countSessionsForPeer(peer1) == peer1Count);
+    NL_TEST_ASSERT(inSuite, countSessionsForPeer(peer1) + countSessionsForPeer(peer2) == remaining);
+
+    //
+    // Newly allocated sessions get an ID that is not in use.
+    //
+    auto optionalSession = connections.CreateNewSecureSession(SecureSession::Type::kCASE, ScopedNodeId());
+    NL_TEST_ASSERT(inSuite, optionalSession.HasValue());
+    uint16_t newId = optionalSession.Value()->AsSecureSession()->GetLocalSessionId();
+    NL_TEST_ASSERT(inSuite, newId != kUnsecuredSessionId);
+    NL_TEST_ASSERT(inSuite, newId > CHIP_CONFIG_SECURE_SESSION_POOL_SIZE || ((newId - 1) % 3) == 0);
+
+    System::Clock::Internal::SetSystemClockForTesting(realClock);
+}
+
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+void TestIndexOverflow(nlTestSuite * inSuite, void * inContext)
+{
+    // A heap-backed pool can hold more sessions than the indexes have room for
+    constexpr size_t kSessionCount = Transport::detail::kSessionIndexCapacity + 4;
+
+    SecureSessionTable connections;
+    System::Clock::Internal::MockClock clock;
+    System::Clock::ClockBase * realClock = &System::SystemClock();
+    System::Clock::Internal::SetSystemClockForTesting(&clock);
+
+    const ScopedNodeId peer1(kCasePeer1NodeId, kFabricIndex);
+    const ScopedNodeId peer2(kCasePeer2NodeId, kFabricIndex);
+
+    auto countSessionsForPeer = [&connections](const ScopedNodeId & peer) {
+        size_t count = 0;
+        connections.ForEachSessionForPeer(peer, [&count, &peer](auto session) {
+            VerifyOrDie(session->GetPeer() == peer);
+            count++;
+            return Loop::Continue;
+        });
+        return count;
+    };
+
+    for (size_t i = 0; i < kSessionCount; ++i)
+    {
+        bool forPeer1        = (i % 2) == 0;
+        auto optionalSession = connections.CreateNewSecureSessionForTest(
+            SecureSession::Type::kCASE, static_cast<uint16_t>(i + 1), kLocalNodeId, forPeer1 ? kCasePeer1NodeId : kCasePeer2NodeId,
+            forPeer1 ? kPeer1CATs : kPeer2CATs, 1, kFabricIndex, GetDefaultMRPConfig());
+        NL_TEST_ASSERT(inSuite, optionalSession.HasValue());
+    }
+
+    // Sessions past the capacity of the indexes are still found
+    for (size_t i = 0; i < kSessionCount; ++i)
+    {
+        NL_TEST_ASSERT(inSuite, connections.FindSecureSessionByLocalKey(static_cast<uint16_t>(i + 1)).HasValue());
+    }
+    NL_TEST_ASSERT(inSuite, !connections.FindSecureSessionByLocalKey(static_cast<uint16_t>(kSessionCount + 1)).HasValue());
+    NL_TEST_ASSERT(inSuite, countSessionsForPeer(peer1) == kSessionCount / 2);
+    NL_TEST_ASSERT(inSuite, countSessionsForPeer(peer2) == kSessionCount / 2);
+
+    // Release the first sessions, which are in the indexes, then the last ones, which are not
+    for (size_t i : { size_t(0), size_t(1), kSessionCount - 2, kSessionCount - 1 })
+    {
+        auto optionalSession = connections.FindSecureSessionByLocalKey(static_cast<uint16_t>(i + 1));
+        NL_TEST_ASSERT(inSuite, optionalSession.HasValue());
+        SecureSession * session = optionalSession.Value()->AsSecureSession();
+        optionalSession.ClearValue();
+        session->MarkForEviction();
+        NL_TEST_ASSERT(inSuite, !connections.FindSecureSessionByLocalKey(static_cast<uint16_t>(i + 1)).HasValue());
+    }
+
+    for (size_t i = 2; i < kSessionCount - 2; ++i)
+    {
+        NL_TEST_ASSERT(inSuite, connections.FindSecureSessionByLocalKey(static_cast<uint16_t>(i + 1)).HasValue());
+    }
+    NL_TEST_ASSERT(inSuite, countSessionsForPeer(peer1) == kSessionCount / 2 - 2);
+    NL_TEST_ASSERT(inSuite, countSessionsForPeer(peer2) == kSessionCount / 2 - 2);
+
+    System::Clock::Internal::SetSystemClockForTesting(realClock);
+}
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+
 struct ExpiredCallInfo
 {
     int callCount                   = 0;
@@ -158,6 +297,10 @@ static const nlTest sTests[] =
 {
     NL_TEST_DEF("BasicFunctionality", TestBasicFunctionality),
     NL_TEST_DEF("FindByKeyId", TestFindByKeyId),
+    NL_TEST_DEF("IndexedLookups", TestIndexedLookups),
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    NL_TEST_DEF("IndexOverflow", TestIndexOverflow),
+#endif // CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
     NL_TEST_SENTINEL()
 };
 // clang-format on
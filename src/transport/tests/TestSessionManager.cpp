@@ -213,12 +213,33 @@ void CheckMessageTest(nlTestSuite * inSuite, void * inContext)
     err = sessionManager.PrepareMessage(aliceToBobSession.Get().Value(), payloadHeader, std::move(buffer), preparedMessage);
     NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
 
+    ctx.GetLoopback().mCopiedMessageCount = 0;
+
     err = sessionManager.SendPreparedMessage(aliceToBobSession.Get().Value(), preparedMessage);
     NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
 
     ctx.DrainAndServiceIO();
     NL_TEST_ASSERT(inSuite, callback.ReceiveHandlerCallCount == 1);
 
+    // The prepared message is still held here, so the transport had to copy it.
+    NL_TEST_ASSERT(inSuite, ctx.GetLoopback().mCopiedMessageCount == 1);
+    NL_TEST_ASSERT(inSuite, !preparedMessage.IsNull());
+
+    // A message that will not be sent again is handed over to the transport without a copy.
+    buffer = chip::MessagePacketBuffer::NewWithData(PAYLOAD, payload_len);
+    NL_TEST_ASSERT(inSuite, !buffer.IsNull());
+
+    err = sessionManager.PrepareMessage(aliceToBobSession.Get().Value(), payloadHeader, std::move(buffer), preparedMessage);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = sessionManager.SendPreparedMessage(aliceToBobSession.Get().Value(), std::move(preparedMessage));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, preparedMessage.IsNull());
+
+    ctx.DrainAndServiceIO();
+    NL_TEST_ASSERT(inSuite, callback.ReceiveHandlerCallCount == 2);
+    NL_TEST_ASSERT(inSuite, ctx.GetLoopback().mCopiedMessageCount == 1);
+
     // Let's send the max sized message and make sure it is received
     chip::System::PacketBufferHandle large_buffer = chip::MessagePacketBuffer::NewWithData(LARGE_PAYLOAD, kMaxAppMessageLen);
     NL_TEST_ASSERT(inSuite, !large_buffer.IsNull());
@@ -232,7 +253,7 @@ void CheckMessageTest(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
 
     ctx.DrainAndServiceIO();
-    NL_TEST_ASSERT(inSuite, callback.ReceiveHandlerCallCount == 2);
+    NL_TEST_ASSERT(inSuite, callback.ReceiveHandlerCallCount == 3);
 
     uint16_t large_payload_len = sizeof(LARGE_PAYLOAD);
 